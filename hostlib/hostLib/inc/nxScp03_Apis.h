@@ -10,6 +10,24 @@
 /* ************************************************************************** */
 /* Defines                                                                    */
 /* ************************************************************************** */
+
+/**
+ * Wrap commands straight into the transmit buffer, and unwrap responses in
+ * the receive buffer, without intermediate copies.
+ * Set to 0 to use the copying wrap/unwrap path. Both produce the same APDUs.
+ */
+#ifndef NX_SCP03_FUSED_WRAP
+#define NX_SCP03_FUSED_WRAP 1
+#endif
+
+/**
+ * Compute the response ICV of a command and the ICV of the next command
+ * while the SE processes the command, see ::nxScp03_Precompute_ICV.
+ * Set to 0 to compute each ICV when it is needed.
+ */
+#ifndef NX_SCP03_PIPELINED_ICV
+#define NX_SCP03_PIPELINED_ICV 1
+#endif
 /* ************************************************************************** */
 /* Includes                                                                   */
 /* ************************************************************************** */
@@ -54,6 +72,22 @@ sss_status_t nxScp03_HostLocal_CalculateHostCryptogram(
 */
 sss_status_t nxSCP03_Encrypt_CommandAPDU(
     NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *cmdBuf, size_t *cmdBufLen);
+
+/**
+* Length of a command after padding, i.e. of the encrypted command data
+*/
+size_t nxSCP03_Padded_Length(size_t cmdBufLen);
+
+/**
+* To encrypt a command into another buffer, e.g. the transmit buffer.
+* cmdBuf is padded in place, and must have room for the padding.
+* On input pEncBufLen is the size of encBuf, on output the length of the encrypted command.
+*/
+sss_status_t nxSCP03_Encrypt_CommandAPDU_To(NXSCP03_DynCtx_t *pdySCP03SessCtx,
+    uint8_t *cmdBuf,
+    size_t cmdBufLen,
+    uint8_t *encBuf,
+    size_t *pEncBufLen);
 /**
 *  To provide additional Security with MAC as CRC
 */
@@ -83,6 +117,19 @@ sss_status_t nxScp03_Generate_SessionKey(
 */
 void nxpSCP03_Inc_CommandCounter(NXSCP03_DynCtx_t *pdySCP03SessCtx);
 
+/**
+* To release the host crypto contexts kept for the session keys.
+* Call when the session ends or before new session keys are set.
+*/
+void nxScp03_Free_HostContexts(NXSCP03_DynCtx_t *pdySCP03SessCtx);
+
+/**
+* To compute the ICVs needed after the command in flight: the ICV of its
+* response and the ICV of the next command. Both only depend on the command
+* counter. Meant as ::smCom_IdleWork_t, pCtx is the NXSCP03_DynCtx_t.
+*/
+void nxScp03_Precompute_ICV(void *pCtx);
+
 #ifdef __cplusplus
 } /* extern "c"*/
 #endif
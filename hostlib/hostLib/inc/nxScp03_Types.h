@@ -100,6 +100,25 @@ typedef struct
 
     /** Handle differnt types of auth.. PlatformSCP / AppletSCP */
     SE_AuthType_t authType;
+
+    /* Host crypto contexts of the session keys. Set up on the first wrapped
+     * APDU and kept until ::nxScp03_Free_HostContexts, so that wrapping and
+     * unwrapping does not allocate and release backend objects every time. */
+    sss_symmetric_t encCtx; //!< AES-CBC encrypt with Enc: ICVs and command data
+    sss_symmetric_t decCtx; //!< AES-CBC decrypt with Enc: response data
+    sss_mac_t macCtx;       //!< CMAC with Mac: command MAC
+    sss_mac_t rmacCtx;      //!< CMAC with Rmac: response MAC
+    /** Points to this context once the contexts above are set up. Stale or
+     * uninitialized memory does not read as set up. */
+    void *hostCtxOwner;
+
+    /* ICVs computed ahead by ::nxScp03_Precompute_ICV, valid as long as the
+     * contexts above are set up */
+    uint8_t icvBlock[2][16]; //!< Counter blocks of the command and the response ICV
+    uint8_t icv[2][16];      //!< Command and response ICV
+    uint8_t icvValid;        //!< Bit n set: icv[n] is valid
+    uint32_t icvHits;        //!< ICVs taken from the precomputed ones
+    uint32_t icvMisses;      //!< ICVs computed when needed
 } NXSCP03_DynCtx_t;
 
 /**
@@ -148,6 +167,9 @@ typedef struct
     sss_object_t SeEcPubKey;
     /** Host master Secret */
     sss_object_t masterSec;
+    /** Host ephemeral key pairs generated ahead of session open,
+     * see ::nxECKey_StartEphemeralPool. NULL if not used. */
+    struct _nxECKey_ephemeral_pool *pEphemeralPool;
 } NXECKey03_StaticCtx_t;
 
 /** Keys to connect for a ECKey Connection */
@@ -41,6 +41,12 @@
 #define SE05X_MAX_BUF_SIZE_RSP (892)
 #endif
 
+/* The transformed command is kept in one buffer up to the wire. Room in front
+ * of it for CLA INS P1 P2 and an extended Lc, and room behind it for an
+ * extended Le, so that the APDU is completed in place. */
+#define SE05X_TXN_HEADROOM (4 + 3)
+#define SE05X_TXN_TAILROOM (2)
+
 #define SE050_MODULE_UNIQUE_ID_LEN 18
 
 #define SE05X_I2CM_MAX_BUF_SIZE_CMD (271)
@@ -66,6 +72,21 @@
 #define CIPHER_BLOCK_SIZE 16
 #define DES_BLOCK_SIZE 8
 #define CIPHER_UPDATE_MAX_DATA 448
+/* Largest CipherUpdate input that fits SE05X_MAX_BUF_SIZE_CMD (and _RSP) once
+ * TLV encoded (8) and wrapped by up to two secure channel layers (8 byte MAC
+ * and up to 16 byte padding each), in full blocks */
+#ifndef CIPHER_UPDATE_MAX_CHUNK
+#define CIPHER_UPDATE_MAX_CHUNK (((SE05X_MAX_BUF_SIZE_CMD - 8 - (2 * (8 + 16))) / CIPHER_BLOCK_SIZE) * CIPHER_BLOCK_SIZE)
+#endif
+/* Same budget for DigestUpdate and MACUpdate input */
+#ifndef DIGEST_UPDATE_MAX_CHUNK
+#define DIGEST_UPDATE_MAX_CHUNK CIPHER_UPDATE_MAX_CHUNK
+#endif
+/* Largest GetRandom output that fits SE05X_MAX_BUF_SIZE_RSP once TLV encoded
+ * (4), with status word (2) and wrapped by up to two secure channel layers */
+#ifndef GET_RANDOM_MAX_CHUNK
+#define GET_RANDOM_MAX_CHUNK (SE05X_MAX_BUF_SIZE_RSP - 4 - 2 - (2 * (8 + 16)))
+#endif
 #define AEAD_UPDATE_MAX_DATA 800
 #define AEAD_BLOCK_SIZE 16
 #define BINARY_WRITE_MAX_LEN 500
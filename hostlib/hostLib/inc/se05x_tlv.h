@@ -179,7 +179,10 @@ typedef struct Se05xSession
      *
      * if pTunnelCtx is Null, directly call smCom_TransceiveRaw()
      *
-     * Or an API part of tunnel ctx that can do PlatformSCP */
+     * Or an API part of tunnel ctx that can do PlatformSCP
+     *
+     * cmdBuf is preceded by SE05X_TXN_HEADROOM and followed by
+     * SE05X_TXN_TAILROOM bytes which this API may overwrite. */
     smStatus_t (*fp_RawTXn)(void *conn_ctx,
         struct _sss_se05x_tunnel_context *pChannelCtx,
         SE_AuthType_t currAuth,
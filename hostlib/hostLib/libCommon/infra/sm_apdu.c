@@ -41,7 +41,8 @@ static U8 sharedApduBuffer[MAX_APDU_BUF_LENGTH];
  * Associates a memory buffer with the APDU buffer.
  *
  * By default (determined at compile time) the buffer is not allocated with each call, but a reference
- * is made to a static data structure.
+ * is made to a static data structure. This buffer is shared by all connections; callers building
+ * APDUs for several secure elements concurrently have to set pApdu->pBuf to a buffer of their own.
  *
  * \param[in,out] pApdu         APDU buffer
  * \returns always returns 0
@@ -630,6 +630,7 @@ U16 SM_Close(void *conn_ctx, U8 mode)
     AX_UNUSED_ARG(mode);
     smComNxpNfcRdLib_Close();
 #endif
+    smCom_ReleaseDevice(conn_ctx);
     smCom_DeInit();
 
     return sw;
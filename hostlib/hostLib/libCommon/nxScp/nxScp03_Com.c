@@ -74,6 +74,24 @@ static uint16_t nxpSCP03_RestoreSw_RAPDU(
 */
 static void nxpSCP03_Dec_CommandCounter(uint8_t *pCtrblock);
 
+/**
+* Set up the host crypto contexts of the session keys, once per session
+*/
+static sss_status_t nxScp03_Init_HostContexts(NXSCP03_DynCtx_t *pdySCP03SessCtx);
+
+/**
+* ICV = AES(S-ENC, counter block), precomputed if possible
+*/
+static sss_status_t nxScp03_Calculate_ICV(NXSCP03_DynCtx_t *pdySCP03SessCtx, const uint8_t *pBlock, uint8_t *pIcv);
+
+/**
+* Increment a counter block
+*/
+static void nxpSCP03_Inc_CounterBlock(uint8_t *pCtrblock);
+
+#define NX_SCP03_ICV_CMD 0
+#define NX_SCP03_ICV_RSP 1
+
 sss_status_t nxSCP03_Encrypt_CommandAPDU(NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *cmdBuf, size_t *pCmdBufLen)
 {
     sss_status_t sss_status = kStatus_SSS_Fail;
@@ -84,32 +102,23 @@ sss_status_t nxSCP03_Encrypt_CommandAPDU(NXSCP03_DynCtx_t *pdySCP03SessCtx, uint
     LOG_MAU8_D(" Input:cmdBuf", cmdBuf, *pCmdBufLen);
 
     if (*pCmdBufLen != 0) {
-        sss_symmetric_t symm;
         uint8_t iv[16] = {0};
         uint8_t *pIv = (uint8_t *)iv;
-        uint8_t apduPayloadToEncrypt[NX_SCP03_MAX_BUFFER_SIZE] = {0};
 
         /* Prior to encrypting the data, the data shall be padded as defined in section 4.1.4.
         This padding becomes part of the data field.*/
         nxSCP03_PadCommandAPDU(cmdBuf, pCmdBufLen);
         sss_status = nxSCP03_Calculate_CommandICV(pdySCP03SessCtx, pIv);
         ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
-        memcpy(apduPayloadToEncrypt, cmdBuf, *pCmdBufLen);
 
-        sss_status = sss_host_symmetric_context_init(&symm,
-            pdySCP03SessCtx->Enc.keyStore->session,
-            &pdySCP03SessCtx->Enc,
-            kAlgorithm_SSS_AES_CBC,
-            kMode_SSS_Encrypt);
-        ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
         dataLen = *pCmdBufLen;
         LOG_D("Encrypt CommandAPDU");
         pIv = (uint8_t *)iv;
-        sss_status = sss_host_cipher_one_go(&symm, pIv, SCP_KEY_SIZE, apduPayloadToEncrypt, cmdBuf, dataLen);
+        /* CBC encryption in place, each block is read before it is overwritten */
+        sss_status = sss_host_cipher_one_go(&pdySCP03SessCtx->encCtx, pIv, SCP_KEY_SIZE, cmdBuf, cmdBuf, dataLen);
         ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
         LOG_AU8_D(cmdBuf, dataLen);
         LOG_MAU8_D("Output: EncryptedcmdBuf", cmdBuf, dataLen);
-        sss_host_symmetric_context_free(&symm);
     }
     else {
         /* Nothing to encrypt */
@@ -121,14 +130,57 @@ cleanup:
     return sss_status;
 }
 
+size_t nxSCP03_Padded_Length(size_t cmdBufLen)
+{
+    if (cmdBufLen == 0) {
+        return 0;
+    }
+    /* At least the 0x80 delimiter, then zeros up to the block boundary */
+    return ((cmdBufLen / SCP_KEY_SIZE) + 1) * SCP_KEY_SIZE;
+}
+
+sss_status_t nxSCP03_Encrypt_CommandAPDU_To(
+    NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *cmdBuf, size_t cmdBufLen, uint8_t *encBuf, size_t *pEncBufLen)
+{
+    sss_status_t sss_status = kStatus_SSS_Fail;
+    uint8_t iv[SCP_IV_SIZE] = {0};
+    size_t dataLen = cmdBufLen;
+
+    ENSURE_OR_GO_CLEANUP(pdySCP03SessCtx != NULL);
+    ENSURE_OR_GO_CLEANUP(pEncBufLen != NULL);
+    LOG_D("FN: %s", __FUNCTION__);
+
+    if (cmdBufLen == 0) {
+        /* Nothing to encrypt */
+        *pEncBufLen = 0;
+        sss_status = kStatus_SSS_Success;
+        goto cleanup;
+    }
+    ENSURE_OR_GO_CLEANUP(cmdBuf != NULL);
+    ENSURE_OR_GO_CLEANUP(encBuf != NULL);
+    ENSURE_OR_GO_CLEANUP(nxSCP03_Padded_Length(cmdBufLen) <= *pEncBufLen);
+    LOG_MAU8_D(" Input:cmdBuf", cmdBuf, cmdBufLen);
+
+    nxSCP03_PadCommandAPDU(cmdBuf, &dataLen);
+    ENSURE_OR_GO_CLEANUP(dataLen == nxSCP03_Padded_Length(cmdBufLen));
+
+    sss_status = nxSCP03_Calculate_CommandICV(pdySCP03SessCtx, iv);
+    ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
+
+    sss_status = sss_host_cipher_one_go(&pdySCP03SessCtx->encCtx, iv, SCP_KEY_SIZE, cmdBuf, encBuf, dataLen);
+    ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
+    LOG_MAU8_D("Output: EncryptedcmdBuf", encBuf, dataLen);
+    *pEncBufLen = dataLen;
+
+cleanup:
+    return sss_status;
+}
+
 uint16_t nxpSCP03_Decrypt_ResponseAPDU(
     NXSCP03_DynCtx_t *pdySCP03SessCtx, size_t cmdBufLen, uint8_t *rspBuf, size_t *pRspBufLen, uint8_t hasle)
 {
     sss_status_t sss_status = kStatus_SSS_Fail;
     uint16_t status = SCP_FAIL;
-    sss_algorithm_t algorithm = kAlgorithm_SSS_CMAC_AES;
-    sss_mode_t mode = kMode_SSS_Mac;
-    sss_mac_t macCtx;
     uint8_t sw[SCP_GP_SW_LEN];
     uint8_t respMac[SCP_CMAC_SIZE] = {0};
     size_t signatureLen = sizeof(respMac);
@@ -136,11 +188,9 @@ uint16_t nxpSCP03_Decrypt_ResponseAPDU(
     size_t macSize = SCP_CMAC_SIZE;
     uint8_t iv[SCP_IV_SIZE] = {0};
     uint8_t *pIv = (uint8_t *)iv;
-    uint8_t response[NX_SCP03_MAX_BUFFER_SIZE];
-    uint8_t plaintextResponse[NX_SCP03_MAX_BUFFER_SIZE]={0};
-    sss_algorithm_t algorithm_aes = kAlgorithm_SSS_AES_CBC;
-    sss_mode_t mode_aes = kMode_SSS_Decrypt;
-    sss_symmetric_t symm;
+#if !NX_SCP03_FUSED_WRAP
+    uint8_t plaintextResponse[NX_SCP03_MAX_BUFFER_SIZE];
+#endif
     size_t actualRespLen = 0;
 
     AX_UNUSED_ARG(hasle);
@@ -156,27 +206,26 @@ uint16_t nxpSCP03_Decrypt_ResponseAPDU(
     if (*pRspBufLen >= (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN)) {
         memcpy(sw, &(rspBuf[*pRspBufLen - SCP_GP_SW_LEN]), SCP_GP_SW_LEN);
 
-        sss_status = sss_host_mac_context_init(
-            &macCtx, pdySCP03SessCtx->Rmac.keyStore->session, &pdySCP03SessCtx->Rmac, algorithm, mode);
+        sss_status = nxScp03_Init_HostContexts(pdySCP03SessCtx);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_mac_init(&macCtx);
+        sss_status = sss_host_mac_init(&pdySCP03SessCtx->rmacCtx);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_mac_update(&macCtx, pdySCP03SessCtx->MCV, macSize);
+        sss_status = sss_host_mac_update(&pdySCP03SessCtx->rmacCtx, pdySCP03SessCtx->MCV, macSize);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_mac_update(&macCtx, rspBuf, *pRspBufLen - SCP_COMMAND_MAC_SIZE - SCP_GP_SW_LEN);
+        sss_status = sss_host_mac_update(
+            &pdySCP03SessCtx->rmacCtx, rspBuf, *pRspBufLen - SCP_COMMAND_MAC_SIZE - SCP_GP_SW_LEN);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_mac_update(&macCtx, sw, SCP_GP_SW_LEN);
+        sss_status = sss_host_mac_update(&pdySCP03SessCtx->rmacCtx, sw, SCP_GP_SW_LEN);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_mac_finish(&macCtx, respMac, &signatureLen);
+        sss_status = sss_host_mac_finish(&pdySCP03SessCtx->rmacCtx, respMac, &signatureLen);
 
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
         LOG_MAU8_D(" Calculated RMAC :", respMac, signatureLen);
-        sss_host_mac_context_free(&macCtx);
         LOG_D("Verify MAC");
         // Do a comparison of the received and the calculated mac
         compareoffset = *pRspBufLen - SCP_COMMAND_MAC_SIZE - SCP_GP_SW_LEN;
@@ -192,13 +241,9 @@ uint16_t nxpSCP03_Decrypt_ResponseAPDU(
     if (*pRspBufLen > (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN)) {
         // There is data payload in response
         size_t dataLen = 0;
-        if (*pRspBufLen > (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN)) {
-            memcpy(response, rspBuf, (*pRspBufLen) - (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN));
-            //LOG_MAU8_D(" EncResponse", response, (*pRspBufLen) - 10);
-        }
-        else {
-            goto exit;
-        }
+#if !NX_SCP03_FUSED_WRAP
+        ENSURE_OR_GO_EXIT(((*pRspBufLen) - (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN)) <= sizeof(plaintextResponse));
+#endif
         memcpy(sw, &(rspBuf[*pRspBufLen - SCP_GP_SW_LEN]), SCP_GP_SW_LEN);
         LOG_MAU8_D("Status Word: ", sw, 2);
 
@@ -206,22 +251,30 @@ uint16_t nxpSCP03_Decrypt_ResponseAPDU(
         sss_status = nxpSCP03_Get_ResponseICV(pdySCP03SessCtx, pIv, cmdBufLen == 0 ? FALSE : TRUE);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-        sss_status = sss_host_symmetric_context_init(
-            &symm, pdySCP03SessCtx->Enc.keyStore->session, &pdySCP03SessCtx->Enc, algorithm_aes, mode_aes);
-        ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
-
         dataLen = (*pRspBufLen) - (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN);
         LOG_D("Decrypt the response");
-        // Decrypt the response
-        sss_status = sss_host_cipher_one_go(&symm, pIv, SCP_KEY_SIZE, response, plaintextResponse, dataLen);
+#if NX_SCP03_FUSED_WRAP
+        // The R-MAC is verified, the ciphertext is not needed any more: decrypt in place
+        sss_status = sss_host_cipher_one_go(&pdySCP03SessCtx->decCtx, pIv, SCP_KEY_SIZE, rspBuf, rspBuf, dataLen);
+        ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
+
+        LOG_MAU8_D("PlainText", rspBuf, dataLen);
+        actualRespLen = dataLen;
+        /*Remove the padding, in place*/
+        sss_status = kStatus_SSS_Fail;
+        status = nxpSCP03_RestoreSw_RAPDU(rspBuf, pRspBufLen, rspBuf, actualRespLen, sw);
+#else
+        // Decrypt the response, straight from the receive buffer
+        sss_status = sss_host_cipher_one_go(
+            &pdySCP03SessCtx->decCtx, pIv, SCP_KEY_SIZE, rspBuf, plaintextResponse, dataLen);
         ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
         LOG_MAU8_D("PlainText", plaintextResponse, (*pRspBufLen) - (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN));
-        sss_host_symmetric_context_free(&symm);
         actualRespLen = (*pRspBufLen) - (SCP_COMMAND_MAC_SIZE + SCP_GP_SW_LEN);
         /*Remove the padding from the plaintextResponse*/
         sss_status = kStatus_SSS_Fail;
         status = nxpSCP03_RestoreSw_RAPDU(rspBuf, pRspBufLen, plaintextResponse, actualRespLen, sw);
+#endif
         if (status == SCP_OK) {
             sss_status = kStatus_SSS_Success;
         }
@@ -271,7 +324,9 @@ static uint16_t nxpSCP03_RestoreSw_RAPDU(
         else if (plaintextResponse[i - 1] == SCP_DATA_PAD_BYTE) {
             // We have found padding delimitor
             memcpy(&plaintextResponse[i - 1], sw, SCP_GP_SW_LEN);
-            memcpy(rspBuf, plaintextResponse, i + 1);
+            if (rspBuf != plaintextResponse) {
+                memcpy(rspBuf, plaintextResponse, i + 1);
+            }
             *pRspBufLen = (i + 1);
             removePaddingOk = 1;
             LOG_MAU8_D("PlainText+SW", rspBuf, *pRspBufLen);
@@ -295,11 +350,7 @@ exit:
 
 static sss_status_t nxpSCP03_Get_ResponseICV(NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *pIcv, bool hasCmd)
 {
-    uint8_t ivZero[SCP_IV_SIZE] = {
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
     sss_status_t status = kStatus_SSS_Fail;
-    sss_symmetric_t symm;
-    size_t dataLen = 0;
     uint8_t paddedCounterBlock[SCP_IV_SIZE] = {
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
@@ -314,37 +365,37 @@ static sss_status_t nxpSCP03_Get_ResponseICV(NXSCP03_DynCtx_t *pdySCP03SessCtx,
 
     LOG_MAU8_D(" Input:Data", paddedCounterBlock, SCP_KEY_SIZE);
 
-    status = sss_host_symmetric_context_init(&symm,
-        pdySCP03SessCtx->Enc.keyStore->session,
-        &pdySCP03SessCtx->Enc,
-        kAlgorithm_SSS_AES_CBC,
-        kMode_SSS_Encrypt);
+    status = nxScp03_Calculate_ICV(pdySCP03SessCtx, paddedCounterBlock, pIcv);
     ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
-    dataLen = SCP_KEY_SIZE;
-    status = sss_host_cipher_one_go(&symm, ivZero, SCP_KEY_SIZE, paddedCounterBlock, pIcv, dataLen);
-    sss_host_symmetric_context_free(&symm);
-    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
-    LOG_MAU8_D(" Output:RespICV", pIcv, dataLen);
+    LOG_MAU8_D(" Output:RespICV", pIcv, SCP_IV_SIZE);
 exit:
     return status;
 }
 
 void nxpSCP03_Inc_CommandCounter(NXSCP03_DynCtx_t *pdySCP03SessCtx)
 {
-    int i = 15;
     ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
+    nxpSCP03_Inc_CounterBlock(pdySCP03SessCtx->cCounter);
+
+    LOG_MAU8_D("Inc_CommandCounter value ", pdySCP03SessCtx->cCounter, SCP_KEY_SIZE);
+exit:
+    return;
+}
+
+static void nxpSCP03_Inc_CounterBlock(uint8_t *pCtrblock)
+{
+    int i = 15;
+    ENSURE_OR_GO_EXIT(pCtrblock != NULL);
     while (i > 0) {
-        if (pdySCP03SessCtx->cCounter[i] < 255) {
-            pdySCP03SessCtx->cCounter[i] += 1;
+        if (pCtrblock[i] < 255) {
+            pCtrblock[i] += 1;
             break;
         }
         else {
-            pdySCP03SessCtx->cCounter[i] = 0;
+            pCtrblock[i] = 0;
             i--;
         }
     }
-
-    LOG_MAU8_D("Inc_CommandCounter value ", pdySCP03SessCtx->cCounter, SCP_KEY_SIZE);
 exit:
     return;
 }
@@ -371,32 +422,27 @@ sss_status_t nxpSCP03_CalculateMac_CommandAPDU(
     NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *pCmdBuf, size_t cmdBufLen, uint8_t *mac, size_t *macLen)
 {
     sss_status_t sss_status = kStatus_SSS_Fail;
-    sss_mac_t macCtx;
-    sss_algorithm_t algorithm = kAlgorithm_SSS_CMAC_AES;
-    sss_mode_t mode = kMode_SSS_Mac;
 
     ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
     ENSURE_OR_GO_EXIT(mac != NULL);
     LOG_D("FN: %s", __FUNCTION__);
     LOG_MAU8_D("Input: cmdBuf", pCmdBuf, cmdBufLen);
 
-    sss_status =
-        sss_host_mac_context_init(&macCtx, pdySCP03SessCtx->Mac.keyStore->session, &pdySCP03SessCtx->Mac, algorithm, mode);
+    sss_status = nxScp03_Init_HostContexts(pdySCP03SessCtx);
     ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-    sss_status = sss_host_mac_init(&macCtx);
+    sss_status = sss_host_mac_init(&pdySCP03SessCtx->macCtx);
     ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-    sss_status = sss_host_mac_update(&macCtx, pdySCP03SessCtx->MCV, SCP_KEY_SIZE);
+    sss_status = sss_host_mac_update(&pdySCP03SessCtx->macCtx, pdySCP03SessCtx->MCV, SCP_KEY_SIZE);
     ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-    sss_status = sss_host_mac_update(&macCtx, pCmdBuf, cmdBufLen);
+    sss_status = sss_host_mac_update(&pdySCP03SessCtx->macCtx, pCmdBuf, cmdBufLen);
     ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
 
-    sss_status = sss_host_mac_finish(&macCtx, mac, macLen);
+    sss_status = sss_host_mac_finish(&pdySCP03SessCtx->macCtx, mac, macLen);
     ENSURE_OR_GO_EXIT(sss_status == kStatus_SSS_Success);
     LOG_MAU8_D("Output: mac", mac, SCP_COMMAND_MAC_SIZE);
-    sss_host_mac_context_free(&macCtx);
     // Store updated mcv!
     memcpy(pdySCP03SessCtx->MCV, mac, SCP_MCV_LEN);
 
@@ -406,31 +452,157 @@ exit:
 
 static sss_status_t nxSCP03_Calculate_CommandICV(NXSCP03_DynCtx_t *pdySCP03SessCtx, uint8_t *pIcv)
 {
-    uint8_t ivZero[SCP_KEY_SIZE] = {
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
     sss_status_t status = kStatus_SSS_Fail;
-    sss_symmetric_t symm;
-    size_t dataLen = 0;
 
     ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
     LOG_D("FN: %s", __FUNCTION__);
 
+    status = nxScp03_Calculate_ICV(pdySCP03SessCtx, pdySCP03SessCtx->cCounter, pIcv);
+    LOG_MAU8_D(" Output:", pIcv, SCP_COMMAND_MAC_SIZE);
+exit:
+    return status;
+}
+
+static sss_status_t nxScp03_Calculate_ICV(NXSCP03_DynCtx_t *pdySCP03SessCtx, const uint8_t *pBlock, uint8_t *pIcv)
+{
+    uint8_t ivZero[SCP_IV_SIZE] = {0};
+    sss_status_t status = kStatus_SSS_Fail;
+    size_t i;
+
+    status = nxScp03_Init_HostContexts(pdySCP03SessCtx);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
 
-    status = sss_host_symmetric_context_init(&symm,
+    for (i = 0; i < sizeof(pdySCP03SessCtx->icv) / sizeof(pdySCP03SessCtx->icv[0]); i++) {
+        if ((pdySCP03SessCtx->icvValid & (1u << i)) &&
+            (memcmp(pdySCP03SessCtx->icvBlock[i], pBlock, SCP_IV_SIZE) == 0)) {
+            memcpy(pIcv, pdySCP03SessCtx->icv[i], SCP_IV_SIZE);
+            pdySCP03SessCtx->icvValid &= (uint8_t)(~(1u << i));
+            pdySCP03SessCtx->icvHits++;
+            goto exit;
+        }
+    }
+
+    /* (const) input is only read */
+    status = sss_host_cipher_one_go(
+        &pdySCP03SessCtx->encCtx, ivZero, SCP_IV_SIZE, (uint8_t *)pBlock, pIcv, SCP_IV_SIZE);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    pdySCP03SessCtx->icvMisses++;
+exit:
+    return status;
+}
+
+void nxScp03_Precompute_ICV(void *pCtx)
+{
+    NXSCP03_DynCtx_t *pdySCP03SessCtx = (NXSCP03_DynCtx_t *)pCtx;
+    uint8_t ivZero[SCP_IV_SIZE] = {0};
+    uint8_t block[SCP_IV_SIZE];
+    sss_status_t status = kStatus_SSS_Fail;
+
+    ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
+    status = nxScp03_Init_HostContexts(pdySCP03SessCtx);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    /* Response to the command in flight, see nxpSCP03_Get_ResponseICV */
+    memcpy(block, pdySCP03SessCtx->cCounter, SCP_IV_SIZE);
+    block[0] = SCP_DATA_PAD_BYTE;
+    pdySCP03SessCtx->icvValid &= (uint8_t)(~(1u << NX_SCP03_ICV_RSP));
+    status = sss_host_cipher_one_go(&pdySCP03SessCtx->encCtx,
+        ivZero,
+        SCP_IV_SIZE,
+        block,
+        pdySCP03SessCtx->icv[NX_SCP03_ICV_RSP],
+        SCP_IV_SIZE);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    memcpy(pdySCP03SessCtx->icvBlock[NX_SCP03_ICV_RSP], block, SCP_IV_SIZE);
+    pdySCP03SessCtx->icvValid |= (uint8_t)(1u << NX_SCP03_ICV_RSP);
+
+    /* Next command, the counter is incremented once the response is in */
+    memcpy(block, pdySCP03SessCtx->cCounter, SCP_IV_SIZE);
+    nxpSCP03_Inc_CounterBlock(block);
+    pdySCP03SessCtx->icvValid &= (uint8_t)(~(1u << NX_SCP03_ICV_CMD));
+    status = sss_host_cipher_one_go(&pdySCP03SessCtx->encCtx,
+        ivZero,
+        SCP_IV_SIZE,
+        block,
+        pdySCP03SessCtx->icv[NX_SCP03_ICV_CMD],
+        SCP_IV_SIZE);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    memcpy(pdySCP03SessCtx->icvBlock[NX_SCP03_ICV_CMD], block, SCP_IV_SIZE);
+    pdySCP03SessCtx->icvValid |= (uint8_t)(1u << NX_SCP03_ICV_CMD);
+exit:
+    return;
+}
+
+static sss_status_t nxScp03_Init_HostContexts(NXSCP03_DynCtx_t *pdySCP03SessCtx)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+
+    ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
+    if (pdySCP03SessCtx->hostCtxOwner == pdySCP03SessCtx) {
+        return kStatus_SSS_Success;
+    }
+    LOG_D("FN: %s", __FUNCTION__);
+
+    memset(&pdySCP03SessCtx->encCtx, 0, sizeof(pdySCP03SessCtx->encCtx));
+    memset(&pdySCP03SessCtx->decCtx, 0, sizeof(pdySCP03SessCtx->decCtx));
+    memset(&pdySCP03SessCtx->macCtx, 0, sizeof(pdySCP03SessCtx->macCtx));
+    memset(&pdySCP03SessCtx->rmacCtx, 0, sizeof(pdySCP03SessCtx->rmacCtx));
+    /* Free releases whatever has been set up so far if one of these fails */
+    pdySCP03SessCtx->hostCtxOwner = pdySCP03SessCtx;
+    pdySCP03SessCtx->icvValid = 0;
+
+    status = sss_host_symmetric_context_init(&pdySCP03SessCtx->encCtx,
         pdySCP03SessCtx->Enc.keyStore->session,
         &pdySCP03SessCtx->Enc,
         kAlgorithm_SSS_AES_CBC,
         kMode_SSS_Encrypt);
     ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
 
-    dataLen = SCP_KEY_SIZE;
-    status = sss_host_cipher_one_go(&symm, ivZero, SCP_KEY_SIZE, pdySCP03SessCtx->cCounter, pIcv, dataLen);
-    sss_host_symmetric_context_free(&symm);
-    LOG_MAU8_D(" Output:", pIcv, SCP_COMMAND_MAC_SIZE);
+    status = sss_host_symmetric_context_init(&pdySCP03SessCtx->decCtx,
+        pdySCP03SessCtx->Enc.keyStore->session,
+        &pdySCP03SessCtx->Enc,
+        kAlgorithm_SSS_AES_CBC,
+        kMode_SSS_Decrypt);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    status = sss_host_mac_context_init(&pdySCP03SessCtx->macCtx,
+        pdySCP03SessCtx->Mac.keyStore->session,
+        &pdySCP03SessCtx->Mac,
+        kAlgorithm_SSS_CMAC_AES,
+        kMode_SSS_Mac);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    status = sss_host_mac_context_init(&pdySCP03SessCtx->rmacCtx,
+        pdySCP03SessCtx->Rmac.keyStore->session,
+        &pdySCP03SessCtx->Rmac,
+        kAlgorithm_SSS_CMAC_AES,
+        kMode_SSS_Mac);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
 exit:
+    if ((status != kStatus_SSS_Success) && (pdySCP03SessCtx != NULL)) {
+        nxScp03_Free_HostContexts(pdySCP03SessCtx);
+    }
     return status;
 }
 
+void nxScp03_Free_HostContexts(NXSCP03_DynCtx_t *pdySCP03SessCtx)
+{
+    ENSURE_OR_GO_EXIT(pdySCP03SessCtx != NULL);
+    if (pdySCP03SessCtx->hostCtxOwner != pdySCP03SessCtx) {
+        goto exit;
+    }
+    /* Contexts not set up yet are all zero, free is a no-op for them */
+    sss_host_symmetric_context_free(&pdySCP03SessCtx->encCtx);
+    sss_host_symmetric_context_free(&pdySCP03SessCtx->decCtx);
+    sss_host_mac_context_free(&pdySCP03SessCtx->macCtx);
+    sss_host_mac_context_free(&pdySCP03SessCtx->rmacCtx);
+    pdySCP03SessCtx->icvValid = 0;
+    pdySCP03SessCtx->hostCtxOwner = NULL;
+exit:
+    return;
+}
+
 static void nxSCP03_PadCommandAPDU(uint8_t *cmdBuf, size_t *pCmdBufLen)
 {
     uint16_t zeroBytesToPad = 0;
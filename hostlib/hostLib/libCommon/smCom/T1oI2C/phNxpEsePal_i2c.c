@@ -152,6 +152,38 @@ int phPalEse_i2c_read(void *pDevHandle, uint8_t *pBuffer, int nNbBytesToRead)
     return numRead;
 }
 
+/*******************************************************************************
+**
+** Function         phPalEse_i2c_read_poll
+**
+** Description      Reads once from the device, without retries or back off
+**                  delay on a NACK. Used to poll densely while a response is
+**                  due.
+**
+** param[in]       pDevHandle       - valid device handle
+** param[in]       pBuffer          - buffer for read data
+** param[in]       nNbBytesToRead   - number of bytes requested to be read
+**
+** Returns          numRead   - number of successfully read bytes
+**                  -1        - read operation failure
+**
+*******************************************************************************/
+int phPalEse_i2c_read_poll(void *pDevHandle, uint8_t *pBuffer, int nNbBytesToRead)
+{
+    unsigned int ret = 0;
+    LOG_D("%s Read Requested %d bytes ", __FUNCTION__, nNbBytesToRead);
+#if AX_EMBEDDED
+    ret = axI2CRead(pDevHandle, I2C_BUS_0, SMCOM_I2C_ADDRESS, pBuffer, nNbBytesToRead);
+#else
+    ret = axI2CReadNoBackoff(pDevHandle, I2C_BUS_0, SMCOM_I2C_ADDRESS, pBuffer, nNbBytesToRead);
+#endif
+    if (ret != I2C_OK) {
+        LOG_D("_i2c_read() error : %d ", ret);
+        return -1;
+    }
+    return nNbBytesToRead;
+}
+
 /*******************************************************************************
 **
 ** Function         phPalEse_i2c_write
@@ -91,6 +91,7 @@ typedef struct phPalEse_Config
 void phPalEse_i2c_close(void *pDevHandle);
 ESESTATUS phPalEse_i2c_open_and_configure(pphPalEse_Config_t pConfig);
 int phPalEse_i2c_read(void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead);
+int phPalEse_i2c_read_poll(void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead);
 int phPalEse_i2c_write(void *pDevHandle,uint8_t * pBuffer, int nNbBytesToWrite);
 /** @} */
 #endif  /*  _PHNXPESE_PAL_I2C_H    */
@@ -0,0 +1,396 @@
+/*
+ * Copyright 2025 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <phNxpEsePoll.h>
+#include "sm_types.h"
+#include "sm_timer.h"
+#include <string.h>
+
+#ifdef FLOW_VERBOSE
+#define NX_LOG_ENABLE_SMCOM_DEBUG 1
+#endif
+
+#include "nxLog_smCom.h"
+#include "nxEnsure.h"
+
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+
+/**
+ * \addtogroup eSe_Poll
+ *
+ * @{ */
+
+#define POLL_PCB_RS_BLOCK      0x80 /* R-block or S-block */
+#define POLL_PCB_CHAINING      0x20
+#define POLL_PCB_WTX_REQ       0xC3
+#define POLL_KEY_BUCKET_MASK   0xFF
+
+/* Smoothing as in TCP RTO estimation (RFC 6298): gain 1/8 for mean, 1/4 for deviation */
+#define POLL_MEAN_GAIN_SHIFT   3
+#define POLL_DEV_GAIN_SHIFT    2
+
+static uint32_t phNxpEsePoll_SizeBucket(uint32_t len)
+{
+    uint32_t bucket = 0;
+    while (len != 0) {
+        bucket++;
+        len >>= 1;
+    }
+    return bucket;
+}
+
+static uint32_t phNxpEsePoll_ClassKey(const uint8_t *pApdu, uint32_t apduLen)
+{
+    /* Low byte is never 0, so that an all-zero entry is an unused entry */
+    return ((uint32_t)pApdu[1] << 24) | ((uint32_t)pApdu[2] << 16) | ((uint32_t)pApdu[3] << 8) |
+           (phNxpEsePoll_SizeBucket(apduLen) + 1);
+}
+
+static phNxpEsePoll_Entry_t *phNxpEsePoll_Lookup(phNxpEsePoll_Model_t *pModel, uint32_t key)
+{
+    phNxpEsePoll_Entry_t *pVictim = &pModel->entries[0];
+    size_t i;
+
+    pModel->useClock++;
+    for (i = 0; i < T1OI2C_POLL_MODEL_ENTRIES; i++) {
+        phNxpEsePoll_Entry_t *pEntry = &pModel->entries[i];
+        if (pEntry->key == key) {
+            pEntry->lastUse = pModel->useClock;
+            return pEntry;
+        }
+        if (pEntry->key == 0) {
+            pVictim = pEntry;
+            break;
+        }
+        /* Wrap safe: the older entry has the larger age */
+        if ((uint32_t)(pModel->useClock - pEntry->lastUse) > (uint32_t)(pModel->useClock - pVictim->lastUse)) {
+            pVictim = pEntry;
+        }
+    }
+
+    memset(pVictim, 0, sizeof(*pVictim));
+    pVictim->key     = key;
+    pVictim->lastUse = pModel->useClock;
+    return pVictim;
+}
+
+static void phNxpEsePoll_Learn(phNxpEsePoll_Entry_t *pEntry, uint32_t observedUs, uint32_t predictedUs, uint32_t polls)
+{
+    int64_t error;
+    uint32_t absError;
+
+    if (pEntry->samples == 0) {
+        pEntry->expectedUs    = observedUs;
+        pEntry->deviationUs   = observedUs / 2;
+        pEntry->minObservedUs = observedUs;
+        pEntry->maxObservedUs = observedUs;
+    }
+    else {
+        error    = (int64_t)observedUs - (int64_t)pEntry->expectedUs;
+        absError = (uint32_t)((error < 0) ? -error : error);
+        pEntry->expectedUs  = (uint32_t)((int64_t)pEntry->expectedUs + (error / (1 << POLL_MEAN_GAIN_SHIFT)));
+        pEntry->deviationUs = (uint32_t)((int64_t)pEntry->deviationUs +
+                                         (((int64_t)absError - (int64_t)pEntry->deviationUs) / (1 << POLL_DEV_GAIN_SHIFT)));
+        if (observedUs < pEntry->minObservedUs) {
+            pEntry->minObservedUs = observedUs;
+        }
+        if (observedUs > pEntry->maxObservedUs) {
+            pEntry->maxObservedUs = observedUs;
+        }
+    }
+
+    if (pEntry->samples < UINT32_MAX) {
+        pEntry->samples++;
+    }
+    pEntry->sumObservedUs += observedUs;
+    pEntry->polls += polls;
+    if (predictedUs != 0) {
+        pEntry->predictions++;
+        pEntry->sumPredictedUs += predictedUs;
+        pEntry->sumAbsErrorUs += (observedUs > predictedUs) ? (observedUs - predictedUs) : (predictedUs - observedUs);
+    }
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_StartCommand
+ *
+ * Description      Select the command class of the C-APDU that is about to be
+ *                  sent. Classes are keyed on INS, P1, P2 and the log2 of the
+ *                  APDU length.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ * param[in]        uint8_t: C-APDU
+ * param[in]        uint32_t: C-APDU length
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEsePoll_StartCommand(phNxpEsePoll_Model_t *pModel, const uint8_t *pApdu, uint32_t apduLen)
+{
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+
+    pModel->armed       = FALSE;
+    pModel->predictedUs = 0;
+    pModel->polls       = 0;
+    pModel->pCurrent    = NULL;
+    if ((pApdu == NULL) || (apduLen < 4)) {
+        goto exit;
+    }
+    pModel->pCurrent = phNxpEsePoll_Lookup(pModel, phNxpEsePoll_ClassKey(pApdu, apduLen));
+exit:
+    return;
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_EndCommand
+ *
+ * Description      Detach the model from the command in flight. Frames that
+ *                  are exchanged outside of an APDU (S-frames on open/close)
+ *                  are not tracked.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEsePoll_EndCommand(phNxpEsePoll_Model_t *pModel)
+{
+    phNxpEsePoll_StartCommand(pModel, NULL, 0);
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_FrameSent
+ *
+ * Description      Start the completion timer once the last (non chained)
+ *                  I-frame of the command in flight has been written.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ * param[in]        uint8_t: T=1 frame written to the SE
+ * param[in]        uint32_t: frame length
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEsePoll_FrameSent(phNxpEsePoll_Model_t *pModel, const uint8_t *pFrame, uint32_t frameLen)
+{
+    uint8_t pcb;
+
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+    ENSURE_OR_GO_EXIT(pFrame != NULL);
+    if ((pModel->pCurrent == NULL) || (frameLen < 2)) {
+        goto exit;
+    }
+
+    pcb = pFrame[1];
+    if ((pcb & POLL_PCB_RS_BLOCK) || (pcb & POLL_PCB_CHAINING)) {
+        goto exit;
+    }
+
+    pModel->txTimeUs  = sm_get_time_us();
+    pModel->armed     = (pModel->txTimeUs != 0) ? TRUE : FALSE;
+    pModel->polls     = 0;
+    pModel->finePolls = 0;
+    if (pModel->pCurrent->samples >= T1OI2C_POLL_MODEL_MIN_SAMPLES) {
+        pModel->predictedUs = pModel->pCurrent->expectedUs;
+    }
+    else {
+        pModel->predictedUs = 0;
+    }
+exit:
+    return;
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_WaitForResponse
+ *
+ * Description      Sleep until shortly before the predicted completion of
+ *                  the command in flight. Caller then polls densely.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ *
+ * Returns          TRUE if a predictive sleep was done, FALSE otherwise.
+ *
+ ******************************************************************************/
+bool_t phNxpEsePoll_WaitForResponse(phNxpEsePoll_Model_t *pModel)
+{
+    bool_t slept = FALSE;
+    uint64_t elapsedUs;
+    uint32_t marginUs;
+    uint32_t targetUs;
+    uint32_t sleepUs;
+
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+    if ((!pModel->armed) || (pModel->predictedUs == 0) || (pModel->pCurrent == NULL)) {
+        goto exit;
+    }
+
+    marginUs = T1OI2C_POLL_MODEL_DEV_MARGIN * pModel->pCurrent->deviationUs;
+    if (marginUs >= pModel->predictedUs) {
+        goto exit;
+    }
+    targetUs = pModel->predictedUs - marginUs;
+    if (targetUs > T1OI2C_POLL_MODEL_MAX_SLEEP_US) {
+        targetUs = T1OI2C_POLL_MODEL_MAX_SLEEP_US;
+    }
+
+    elapsedUs = sm_get_time_us() - pModel->txTimeUs;
+    if (elapsedUs >= targetUs) {
+        goto exit;
+    }
+
+    sleepUs = targetUs - (uint32_t)elapsedUs;
+    LOG_D("%s sleeping %uus (expected %uus)", __FUNCTION__, sleepUs, pModel->predictedUs);
+    if (sleepUs >= 1000) {
+        sm_sleep(sleepUs / 1000);
+    }
+    sm_usleep(sleepUs % 1000);
+    slept = TRUE;
+exit:
+    return slept;
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_FineStep
+ *
+ * Description      Interval of the next poll while the response in flight is
+ *                  due, i.e. until the predicted completion plus the
+ *                  deviation margin. Caller polls without the I2C back off
+ *                  delay then.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ *
+ * Returns          Poll interval in microseconds, 0 to poll every
+ *                  ESE_POLL_DELAY_MS.
+ *
+ ******************************************************************************/
+uint32_t phNxpEsePoll_FineStep(phNxpEsePoll_Model_t *pModel)
+{
+    uint32_t stepUs = 0;
+    uint64_t elapsedUs;
+    uint64_t dueUs;
+
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+    if ((!pModel->armed) || (pModel->predictedUs == 0) || (pModel->pCurrent == NULL)) {
+        goto exit;
+    }
+    if (pModel->finePolls >= T1OI2C_POLL_MODEL_FINE_POLLS_MAX) {
+        goto exit;
+    }
+    dueUs     = pModel->predictedUs + (uint64_t)T1OI2C_POLL_MODEL_DEV_MARGIN * pModel->pCurrent->deviationUs;
+    elapsedUs = sm_get_time_us() - pModel->txTimeUs;
+    if (elapsedUs >= dueUs) {
+        goto exit;
+    }
+    pModel->finePolls++;
+    stepUs = T1OI2C_POLL_MODEL_FINE_STEP_US;
+exit:
+    return stepUs;
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_FrameReceived
+ *
+ * Description      Account a received T=1 frame. On the first I-frame after
+ *                  the command was sent, the observed completion time is fed
+ *                  into the model. WTX requests keep the timer running.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ * param[in]        uint8_t: T=1 frame read from the SE
+ * param[in]        int: number of I2C header reads needed for this frame
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEsePoll_FrameReceived(phNxpEsePoll_Model_t *pModel, const uint8_t *pFrame, int nPolls)
+{
+    uint64_t observedUs;
+    uint8_t pcb;
+
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+    ENSURE_OR_GO_EXIT(pFrame != NULL);
+    if ((!pModel->armed) || (pModel->pCurrent == NULL)) {
+        goto exit;
+    }
+
+    if (nPolls > 0) {
+        pModel->polls += (uint32_t)nPolls;
+    }
+    pcb = pFrame[1];
+    if (pcb == POLL_PCB_WTX_REQ) {
+        /* SE still processing, keep measuring from the I-frame */
+        goto exit;
+    }
+
+    pModel->armed = FALSE;
+    if (pcb & POLL_PCB_RS_BLOCK) {
+        /* R-block / S-block: command is repeated or aborted, not a completion */
+        goto exit;
+    }
+
+    observedUs = sm_get_time_us() - pModel->txTimeUs;
+    if (observedUs > UINT32_MAX) {
+        goto exit;
+    }
+    phNxpEsePoll_Learn(pModel->pCurrent, (uint32_t)observedUs, pModel->predictedUs, pModel->polls);
+exit:
+    return;
+}
+
+/******************************************************************************
+ * Function         phNxpEsePoll_DumpStats
+ *
+ * Description      Log predicted vs. observed completion time per command class.
+ *
+ * param[in]        phNxpEsePoll_Model_t: latency model of the connection
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEsePoll_DumpStats(const phNxpEsePoll_Model_t *pModel)
+{
+    size_t i;
+
+    ENSURE_OR_GO_EXIT(pModel != NULL);
+
+    LOG_I("T=1oI2C polling model (times in us):");
+    LOG_I("INS P1 P2 maxLen   samples expected    dev  obs.avg  obs.min  obs.max pred.avg  err.avg polls/cmd");
+    for (i = 0; i < T1OI2C_POLL_MODEL_ENTRIES; i++) {
+        const phNxpEsePoll_Entry_t *pEntry = &pModel->entries[i];
+        uint32_t bucket;
+        uint32_t avgPred = 0;
+        uint32_t avgErr  = 0;
+
+        if ((pEntry->key == 0) || (pEntry->samples == 0)) {
+            continue;
+        }
+        bucket = (pEntry->key & POLL_KEY_BUCKET_MASK) - 1;
+        if (pEntry->predictions != 0) {
+            avgPred = (uint32_t)(pEntry->sumPredictedUs / pEntry->predictions);
+            avgErr  = (uint32_t)(pEntry->sumAbsErrorUs / pEntry->predictions);
+        }
+        LOG_I("%02X  %02X %02X %6u %9u %8u %6u %8u %8u %8u %8u %8u %6u.%02u",
+            (pEntry->key >> 24) & 0xFF,
+            (pEntry->key >> 16) & 0xFF,
+            (pEntry->key >> 8) & 0xFF,
+            (bucket >= 32) ? UINT32_MAX : ((1u << bucket) - 1),
+            pEntry->samples,
+            pEntry->expectedUs,
+            pEntry->deviationUs,
+            (uint32_t)(pEntry->sumObservedUs / pEntry->samples),
+            pEntry->minObservedUs,
+            pEntry->maxObservedUs,
+            avgPred,
+            avgErr,
+            pEntry->polls / pEntry->samples,
+            ((pEntry->polls % pEntry->samples) * 100) / pEntry->samples);
+    }
+exit:
+    return;
+}
+
+/** @} */
+
+#endif /* T1OI2C_ADAPTIVE_POLLING */
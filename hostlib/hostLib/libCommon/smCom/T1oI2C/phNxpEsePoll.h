@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * \addtogroup eSe_Poll
+ * \brief Latency model driven response polling for T=1 over I2C
+ *
+ * The SE processing time of a command mostly depends on the instruction
+ * (INS, P1, P2) and on the amount of data sent with it. This module learns
+ * the expected completion time for each such command class at runtime and
+ * lets the reader sleep for most of it, instead of polling the I2C bus every
+ * ESE_POLL_DELAY_MS from the moment the last I-frame of the command is sent.
+ *
+ * Enabled with T1OI2C_ADAPTIVE_POLLING.
+ * @{ */
+
+#ifndef _PHNXPESEPOLL_H_
+#define _PHNXPESEPOLL_H_
+
+#include <phEseTypes.h>
+
+/*!
+ * \brief Number of command classes tracked per connection.
+ * Least recently used class is evicted when table is full.
+ */
+#define T1OI2C_POLL_MODEL_ENTRIES 24
+
+/*!
+ * \brief Samples required before the prediction of a class is used.
+ */
+#define T1OI2C_POLL_MODEL_MIN_SAMPLES 2
+
+/*!
+ * \brief Upper limit for one predictive sleep (in microseconds).
+ * Keeps us well below the 1 sec WTX interval of the SE.
+ */
+#define T1OI2C_POLL_MODEL_MAX_SLEEP_US (500 * 1000)
+
+/*!
+ * \brief Deviation multiplier subtracted from the expected time,
+ * so that we wake up a bit before the predicted completion.
+ */
+#define T1OI2C_POLL_MODEL_DEV_MARGIN 2
+
+/*!
+ * \brief Poll interval around the predicted completion (in microseconds).
+ * Used from the end of the predictive sleep until the predicted time plus
+ * the deviation margin, instead of ESE_POLL_DELAY_MS.
+ */
+#define T1OI2C_POLL_MODEL_FINE_STEP_US 100
+
+/*!
+ * \brief Upper limit of fine polls per response, coarse polling follows.
+ */
+#define T1OI2C_POLL_MODEL_FINE_POLLS_MAX 40
+
+/*!
+ * \brief Learned latency of one command class
+ */
+typedef struct phNxpEsePoll_Entry
+{
+    uint32_t key;            /*!< INS | P1 | P2 | log2 payload size */
+    uint32_t lastUse;        /*!< value of the use clock at the last lookup */
+    uint32_t expectedUs;     /*!< smoothed completion time */
+    uint32_t deviationUs;    /*!< smoothed mean deviation of completion time */
+    uint32_t samples;        /*!< number of completed observations */
+    uint64_t sumObservedUs;  /*!< sum of observed completion times */
+    uint64_t sumPredictedUs; /*!< sum of predicted completion times (only when model was used) */
+    uint64_t sumAbsErrorUs;  /*!< sum of |observed - predicted| (only when model was used) */
+    uint32_t predictions;    /*!< number of observations where the model was used */
+    uint32_t polls;          /*!< number of I2C header reads, all observations */
+    uint32_t minObservedUs;  /*!< fastest observation */
+    uint32_t maxObservedUs;  /*!< slowest observation */
+} phNxpEsePoll_Entry_t;
+
+/*!
+ * \brief Per connection latency model
+ */
+typedef struct phNxpEsePoll_Model
+{
+    phNxpEsePoll_Entry_t entries[T1OI2C_POLL_MODEL_ENTRIES];
+    phNxpEsePoll_Entry_t *pCurrent; /*!< Class of the command in flight */
+    uint64_t txTimeUs;              /*!< Time at which last I-frame of the command was sent */
+    uint32_t predictedUs;           /*!< Prediction used for the command in flight, 0 if none */
+    uint32_t polls;                 /*!< I2C header reads for the command in flight */
+    uint32_t finePolls;             /*!< Fine polls for the response in flight */
+    uint32_t useClock;              /*!< Incremented on each lookup, for LRU eviction */
+    bool_t armed;                   /*!< Waiting for the response of the command in flight */
+} phNxpEsePoll_Model_t;
+
+void phNxpEsePoll_StartCommand(phNxpEsePoll_Model_t *pModel, const uint8_t *pApdu, uint32_t apduLen);
+void phNxpEsePoll_EndCommand(phNxpEsePoll_Model_t *pModel);
+void phNxpEsePoll_FrameSent(phNxpEsePoll_Model_t *pModel, const uint8_t *pFrame, uint32_t frameLen);
+bool_t phNxpEsePoll_WaitForResponse(phNxpEsePoll_Model_t *pModel);
+uint32_t phNxpEsePoll_FineStep(phNxpEsePoll_Model_t *pModel);
+void phNxpEsePoll_FrameReceived(phNxpEsePoll_Model_t *pModel, const uint8_t *pFrame, int nPolls);
+void phNxpEsePoll_DumpStats(const phNxpEsePoll_Model_t *pModel);
+
+/** @} */
+#endif /* _PHNXPESEPOLL_H_ */
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <phNxpEseProto7816_3.h>
+#include <phNxpEse_Internal.h>
 #include <phNxpEsePal_i2c.h>
 #include <phEseTypes.h>
 #include "sm_types.h"
@@ -23,8 +24,6 @@
  *
  * @{ */
 
-phNxpEseProto7816_t phNxpEseProto7816_3_Var;
-
 /******************************************************************************
 \section Introduction Introduction
 
@@ -33,21 +32,75 @@ phNxpEseProto7816_t phNxpEseProto7816_3_Var;
  ******************************************************************************/
 static bool_t phNxpEseProto7816_SendRawFrame(void* conn_ctx, uint32_t data_len, uint8_t *p_data);
 static bool_t phNxpEseProto7816_GetRawFrame(void* conn_ctx, uint32_t *data_len, uint8_t **pp_data);
-static uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t offset,
-        uint32_t length);
 static bool_t phNxpEseProto7816_CheckCRC(uint32_t data_len, uint8_t *p_data);
 static bool_t phNxpEseProto7816_SendSFrame(void* conn_ctx, sFrameInfo_t sFrameData);
 static bool_t phNxpEseProto7816_SendIframe(void* conn_ctx, iFrameInfo_t iFrameData);
 static bool_t phNxpEseProto7816_sendRframe(void* conn_ctx, rFrameTypes_t rFrameType);
-static bool_t phNxpEseProto7816_SetFirstIframeContxt(void);
-static bool_t phNxpEseProto7816_SetNextIframeContxt(void);
-static bool_t phNxpEseProro7816_SaveRxframeData(uint8_t *p_data, uint32_t data_len);
-static bool_t phNxpEseProto7816_ResetRecovery(void);
-static bool_t phNxpEseProto7816_RecoverySteps(void);
-static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len);
+static bool_t phNxpEseProto7816_SetFirstIframeContxt(void* conn_ctx);
+static bool_t phNxpEseProto7816_SetNextIframeContxt(void* conn_ctx);
+static bool_t phNxpEseProro7816_SaveRxframeData(void* conn_ctx, uint8_t *p_data, uint32_t data_len);
+static bool_t phNxpEseProto7816_ResetRecovery(void* conn_ctx);
+static bool_t phNxpEseProto7816_RecoverySteps(void* conn_ctx);
+static bool_t phNxpEseProto7816_DecodeFrame(void* conn_ctx, uint8_t *p_data, uint32_t data_len);
 static bool_t phNxpEseProto7816_ProcessResponse(void* conn_ctx);
 static bool_t TransceiveProcess(void* conn_ctx);
 static bool_t phNxpEseProto7816_RSync(void* conn_ctx);
+static void phNxpEseProto7816_NegotiateIfsc(void* conn_ctx, const phNxpEse_data *pAtr);
+
+/* Largest INF the host can put in one frame (frame buffer of MAX_DATA_LEN) */
+#if defined(T1oI2C_UM11225)
+#define PH_PROTO_7816_HOST_MAX_IFSC \
+    (((MAX_DATA_LEN - PH_PROTO_7816_HEADER_LEN - PH_PROTO_7816_CRC_LEN) < 0xFE) ? \
+        (MAX_DATA_LEN - PH_PROTO_7816_HEADER_LEN - PH_PROTO_7816_CRC_LEN) : 0xFE)
+#elif defined(T1oI2C_GP1_0)
+#define PH_PROTO_7816_HOST_MAX_IFSC (MAX_DATA_LEN - PH_PROTO_7816_HEADER_LEN - PH_PROTO_7816_CRC_LEN)
+#endif
+
+#if !defined(T1OI2C_CRC_BITWISE)
+/* CRC-16/X.25 (reflected polynomial 0x8408), one entry per byte value.
+ * Define T1OI2C_CRC_BITWISE to save the 512 bytes on very small targets. */
+static const uint16_t phNxpEseProto7816_CrcTable[256] = {
+    0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+    0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+    0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+    0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+    0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+    0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+    0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+    0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+    0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+    0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+    0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+    0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+    0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+    0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+    0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+    0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+    0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+    0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+    0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+    0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+    0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+    0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+    0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+    0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+    0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+    0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+    0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+    0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+    0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+    0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+    0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+    0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78,
+};
+#endif
+
+/* Protocol stack instance is part of the connection context (see phNxpEse_Context_t) */
+static phNxpEseProto7816_t *phNxpEseProto7816_GetCtx(void* conn_ctx)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    return &nxpese_ctxt->proto7816;
+}
 
 /******************************************************************************
  * Function         phNxpEseProto7816_SendRawFrame
@@ -103,16 +156,17 @@ static bool_t phNxpEseProto7816_GetRawFrame(void* conn_ctx, uint32_t *data_len,
 /******************************************************************************
  * Function         phNxpEseProto7816_ComputeCRC
  *
- * Description      This internal function is called compute the CRC
+ * Description      This function is called compute the CRC-16/X.25 of a
+ *                  frame
  *
  * param[in]        unsigned char: data buffer
  * param[in]        uint32_t : offset from which CRC to be calculated
  * param[in]        uint32_t : total length of frame
  *
- * Returns          On success return TRUE or else FALSE.
+ * Returns          CRC, in the byte order in which it is sent.
  *
  ******************************************************************************/
-static uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t offset,
+uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t offset,
         uint32_t length)
 {
     uint16_t CAL_CRC = 0xFFFF, CRC = 0x0000;
@@ -121,6 +175,7 @@ static uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t off
     ENSURE_OR_GO_EXIT(p_buff != NULL);
     for (i = offset; i < length; i++)
     {
+#if defined(T1OI2C_CRC_BITWISE)
         CAL_CRC ^= p_buff[i];
         for (int bit = 8; bit > 0; --bit)
         {
@@ -133,7 +188,9 @@ static uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t off
                 CAL_CRC >>= 1;
             }
         }
-
+#else
+        CAL_CRC = (uint16_t)((CAL_CRC >> 8) ^ phNxpEseProto7816_CrcTable[(CAL_CRC ^ p_buff[i]) & 0xFF]);
+#endif
     }
     CAL_CRC ^=0xFFFF;
 #if defined(T1oI2C_UM11225)
@@ -216,6 +273,7 @@ uint8_t getMaxSupportedSendIFrameSize(void)
  ******************************************************************************/
 static bool_t phNxpEseProto7816_SendSFrame(void* conn_ctx, sFrameInfo_t sFrameData)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = ESESTATUS_FAILED;
     uint32_t frame_len = 0;
     uint8_t p_framebuff[7] = {0};
@@ -223,7 +281,7 @@ static bool_t phNxpEseProto7816_SendSFrame(void* conn_ctx, sFrameInfo_t sFrameDa
     sFrameInfo_t sframeData = sFrameData;
     uint16_t calc_crc=0;
     /* This update is helpful in-case a R-NACK is transmitted from the MW */
-    phNxpEseProto7816_3_Var.lastSentNonErrorframeType = SFRAME;
+    pProto->lastSentNonErrorframeType = SFRAME;
     switch(sframeData.sFrameType)
     {
         case RESYNCH_REQ:
@@ -365,6 +423,7 @@ static bool_t phNxpEseProto7816_SendSFrame(void* conn_ctx, sFrameInfo_t sFrameDa
  ******************************************************************************/
 static  bool_t phNxpEseProto7816_sendRframe(void* conn_ctx, rFrameTypes_t rFrameType)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
 #if defined(T1oI2C_UM11225)
     uint8_t recv_ack[5]= {0x5A,0x80,0x00,0x00,0x00};
@@ -372,8 +431,8 @@ static  bool_t phNxpEseProto7816_sendRframe(void* conn_ctx, rFrameTypes_t rFrame
     uint8_t recv_ack[6]= {0x5A,0x80,0x00,0x00,0x00,0x00};
 #endif
     uint16_t calc_crc=0;
-    iFrameInfo_t *pRx_lastRcvdIframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdIframeInfo;
-    rFrameInfo_t *pNextTx_RframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.RframeInfo;
+    iFrameInfo_t *pRx_lastRcvdIframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdIframeInfo;
+    rFrameInfo_t *pNextTx_RframeInfo = &pProto->phNxpEseNextTx_Cntx.RframeInfo;
     if(RNACK == rFrameType) /* R-NACK */
     {
         switch(pNextTx_RframeInfo->errCode)
@@ -398,7 +457,7 @@ static  bool_t phNxpEseProto7816_sendRframe(void* conn_ctx, rFrameTypes_t rFrame
     else /* R-ACK*/
     {
         /* This update is helpful in-case a R-NACK is transmitted from the MW */
-        phNxpEseProto7816_3_Var.lastSentNonErrorframeType = RFRAME;
+        pProto->lastSentNonErrorframeType = RFRAME;
     }
 
     recv_ack[PH_PROPTO_7816_PCB_OFFSET] |= ((pRx_lastRcvdIframeInfo->seqNo ^ 1) << 4);
@@ -424,12 +483,13 @@ static  bool_t phNxpEseProto7816_sendRframe(void* conn_ctx, rFrameTypes_t rFrame
  ******************************************************************************/
 static bool_t phNxpEseProto7816_SendIframe(void* conn_ctx, iFrameInfo_t iFrameData)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
     uint32_t frame_len = 0;
     uint8_t p_framebuff[MAX_DATA_LEN];
     uint8_t pcb_byte = 0;
     uint16_t calc_crc = 0;
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
 
     if (0 == iFrameData.sendDataLen)
     {
@@ -437,7 +497,7 @@ static bool_t phNxpEseProto7816_SendIframe(void* conn_ctx, iFrameInfo_t iFrameDa
         return FALSE;
     }
     /* This update is helpful in-case a R-NACK is transmitted from the MW */
-    phNxpEseProto7816_3_Var.lastSentNonErrorframeType = IFRAME;
+    pProto->lastSentNonErrorframeType = IFRAME;
     ENSURE_OR_GO_EXIT(iFrameData.sendDataLen <= (UINT_MAX - (PH_PROTO_7816_HEADER_LEN + PH_PROTO_7816_CRC_LEN)))
     frame_len = (iFrameData.sendDataLen+ PH_PROTO_7816_HEADER_LEN + PH_PROTO_7816_CRC_LEN);
 
@@ -486,21 +546,22 @@ exit:
  * Description      This internal function is called to set the context for next I-frame.
  *                  Not applicable for the first I-frame of the transceive
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProto7816_SetFirstIframeContxt(void)
+static bool_t phNxpEseProto7816_SetFirstIframeContxt(void* conn_ctx)
 {
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
-    iFrameInfo_t *pLastTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.IframeInfo;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
+    iFrameInfo_t *pLastTx_IframeInfo = &pProto->phNxpEseLastTx_Cntx.IframeInfo;
 
     pNextTx_IframeInfo->dataOffset = 0;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = IFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType = IFRAME;
     pNextTx_IframeInfo->seqNo = pLastTx_IframeInfo->seqNo ^ 1;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
     pRx_EseCntx->responseBytesRcvd = 0;
     if (pNextTx_IframeInfo->totalDataLen > pNextTx_IframeInfo->maxDataLen) {
         pNextTx_IframeInfo->isChained = TRUE;
@@ -522,19 +583,20 @@ static bool_t phNxpEseProto7816_SetFirstIframeContxt(void)
  * Description      This internal function is called to set the context for next I-frame.
  *                  Not applicable for the first I-frame of the transceive
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProto7816_SetNextIframeContxt(void)
+static bool_t phNxpEseProto7816_SetNextIframeContxt(void* conn_ctx)
 {
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
-    iFrameInfo_t *pLastTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.IframeInfo;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
+    iFrameInfo_t *pLastTx_IframeInfo = &pProto->phNxpEseLastTx_Cntx.IframeInfo;
 
     /* Expecting to reach here only after first of chained I-frame is sent and before the last chained is sent */
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = IFRAME;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType = IFRAME;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
 
     pNextTx_IframeInfo->seqNo = pLastTx_IframeInfo->seqNo ^ 1;
     if((UINT_MAX - pLastTx_IframeInfo->dataOffset) < pLastTx_IframeInfo->maxDataLen)
@@ -566,15 +628,17 @@ static bool_t phNxpEseProto7816_SetNextIframeContxt(void)
  *
  * Description      This internal function is called to save recv frame data
  *
+ * param[in]        void* conn_ctx
  * param[in]        uint8_t: data buffer
  * param[in]        uint32_t: buffer length
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProro7816_SaveRxframeData(uint8_t *p_data, uint32_t data_len)
+static bool_t phNxpEseProro7816_SaveRxframeData(void* conn_ctx, uint8_t *p_data, uint32_t data_len)
 {
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
     if (p_data == NULL) {
         return FALSE;
@@ -606,14 +670,15 @@ static bool_t phNxpEseProro7816_SaveRxframeData(uint8_t *p_data, uint32_t data_l
  *
  * Description      This internal function is called to do reset the recovery pareameters
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProto7816_ResetRecovery(void)
+static bool_t phNxpEseProto7816_ResetRecovery(void* conn_ctx)
 {
-    phNxpEseProto7816_3_Var.recoveryCounter = 0;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    pProto->recoveryCounter = 0;
     return TRUE;
 }
 
@@ -624,33 +689,34 @@ static bool_t phNxpEseProto7816_ResetRecovery(void)
  *                  after PH_PROTO_7816_FRAME_RETRY_COUNT, and the interface has to be
  *                  recovered
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProto7816_RecoverySteps(void)
+static bool_t phNxpEseProto7816_RecoverySteps(void* conn_ctx)
 {
-    sFrameInfo_t *pRx_lastRcvdSframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdSframeInfo;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    sFrameInfo_t *pRx_lastRcvdSframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdSframeInfo;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
 
-    if(phNxpEseProto7816_3_Var.recoveryCounter <= PH_PROTO_7816_FRAME_RETRY_COUNT)
+    if(pProto->recoveryCounter <= PH_PROTO_7816_FRAME_RETRY_COUNT)
     {
 #if defined(T1oI2C_UM11225)
         pRx_lastRcvdSframeInfo->sFrameType = INTF_RESET_REQ;
-        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+        pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
         pNextTx_SframeInfo->sFrameType = INTF_RESET_REQ;
-        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
+        pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
 #elif defined(T1oI2C_GP1_0)
         pRx_lastRcvdSframeInfo->sFrameType = SWR_REQ;
-        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+        pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
         pNextTx_SframeInfo->sFrameType = SWR_REQ;
-        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
+        pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
 #endif
     }
     else
     { /* If recovery fails */
-        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+        pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
     }
     return TRUE;
 }
@@ -704,26 +770,28 @@ exit:
                        3.3 R-NACK: Re-send the last frame
                     4. If the received frame is S-frame, send back the correct S-frame response.
  *
+ * param[in]        void* conn_ctx
  * param[in]        uint8_t : data buffer
  * param[in]        uint32_t : buffer length
  *
  * Returns          On success return TRUE or else FALSE.
  *
  ******************************************************************************/
-static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
+static bool_t phNxpEseProto7816_DecodeFrame(void* conn_ctx, uint8_t *p_data, uint32_t data_len)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = TRUE;
     uint8_t pcb;
-    iFrameInfo_t *pRx_lastRcvdIframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdIframeInfo;
-    rFrameInfo_t *pNextTx_RframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.RframeInfo;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    iFrameInfo_t *pLastTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.IframeInfo;
-    sFrameInfo_t *pLastTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.SframeInfo;
-    rFrameInfo_t *pRx_lastRcvdRframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdRframeInfo;
-    sFrameInfo_t *pRx_lastRcvdSframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdSframeInfo;
+    iFrameInfo_t *pRx_lastRcvdIframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdIframeInfo;
+    rFrameInfo_t *pNextTx_RframeInfo = &pProto->phNxpEseNextTx_Cntx.RframeInfo;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    iFrameInfo_t *pLastTx_IframeInfo = &pProto->phNxpEseLastTx_Cntx.IframeInfo;
+    sFrameInfo_t *pLastTx_SframeInfo = &pProto->phNxpEseLastTx_Cntx.SframeInfo;
+    rFrameInfo_t *pRx_lastRcvdRframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdRframeInfo;
+    sFrameInfo_t *pRx_lastRcvdSframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdSframeInfo;
     int32_t frameType = 0;
 
-    LOG_D("Retry Counter = %d ", phNxpEseProto7816_3_Var.recoveryCounter);
+    LOG_D("Retry Counter = %d ", pProto->recoveryCounter);
 
     ENSURE_OR_GO_EXIT(p_data != NULL);
 
@@ -736,33 +804,33 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
     if (!(pcb & 0x80)) /* I-FRAME decoded should come here */
     {
         LOG_D("%s I-Frame Received ", __FUNCTION__);
-        phNxpEseProto7816_3_Var.wtx_counter = 0;
-        phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = IFRAME ;
+        pProto->wtx_counter = 0;
+        pProto->phNxpEseRx_Cntx.lastRcvdFrameType = IFRAME ;
 
         if (pRx_lastRcvdIframeInfo->seqNo != ((pcb & 0x40) >> 6))
         {
             LOG_D("%s I-Frame lastRcvdIframeInfo.seqNo:0x%x ", __FUNCTION__, ((pcb & 0x40) >> 6));
-            phNxpEseProto7816_ResetRecovery();
+            phNxpEseProto7816_ResetRecovery(conn_ctx);
             pRx_lastRcvdIframeInfo->seqNo = 0x00;
             pRx_lastRcvdIframeInfo->seqNo |= ((pcb & 0x40) >> 6);
 
             if (pcb & 0x20)
             {
                 pRx_lastRcvdIframeInfo->isChained = TRUE;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = RFRAME;
+                pProto->phNxpEseNextTx_Cntx.FrameType = RFRAME;
                 pNextTx_RframeInfo->errCode = NO_ERROR;
-                if (FALSE == phNxpEseProro7816_SaveRxframeData(&p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED)) {
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                if (FALSE == phNxpEseProro7816_SaveRxframeData(conn_ctx, &p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED)) {
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     LOG_E("phNxpEseProro7816_SaveRxframeData Failed");
                     return FALSE;
                 }
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_ACK ;
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_ACK ;
             }
             else
             {
                 pRx_lastRcvdIframeInfo->isChained = FALSE;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
-                if (FALSE == phNxpEseProro7816_SaveRxframeData(&p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED)) {
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                if (FALSE == phNxpEseProro7816_SaveRxframeData(conn_ctx, &p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED)) {
                     LOG_E("phNxpEseProro7816_SaveRxframeData Failed");
                     return FALSE;
                 }
@@ -771,34 +839,34 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
         else
         {
             sm_sleep(DELAY_ERROR_RECOVERY/1000);
-            if(phNxpEseProto7816_3_Var.recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
+            if(pProto->recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
             {
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = RFRAME;
+                pProto->phNxpEseNextTx_Cntx.FrameType = RFRAME;
                 pNextTx_RframeInfo->errCode = OTHER_ERROR;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
+                pProto->recoveryCounter++;
             }
             else
             {
-                phNxpEseProto7816_RecoverySteps();
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                phNxpEseProto7816_RecoverySteps(conn_ctx);
+                pProto->recoveryCounter++;
             }
         }
     }
     else if ((pcb & 0x80) && (!(0x40 & pcb))) /* R-FRAME decoded should come here */
     {
-        phNxpEseProto7816_3_Var.wtx_counter = 0;
-        phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = RFRAME;
+        pProto->wtx_counter = 0;
+        pProto->phNxpEseRx_Cntx.lastRcvdFrameType = RFRAME;
         pRx_lastRcvdRframeInfo->seqNo = 0; // = 0;
         pRx_lastRcvdRframeInfo->seqNo |= ((pcb & 0x10) >> 4);
 
         if ((!(pcb & 0x01)) && (!(pcb & 0x02)))
         {
             pRx_lastRcvdRframeInfo->errCode = NO_ERROR;
-            phNxpEseProto7816_ResetRecovery();
+            phNxpEseProto7816_ResetRecovery(conn_ctx);
             if (pRx_lastRcvdRframeInfo->seqNo != pLastTx_IframeInfo->seqNo) {
-                phNxpEseProto7816_SetNextIframeContxt();
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
+                phNxpEseProto7816_SetNextIframeContxt(conn_ctx);
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
             }
 
         } /* Error handling 1 : Parity error */
@@ -813,55 +881,55 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
             else {
                 pRx_lastRcvdRframeInfo->errCode = PARITY_ERROR;
             }
-            if(phNxpEseProto7816_3_Var.recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
+            if(pProto->recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
             {
-                if(phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType == IFRAME)
+                if(pProto->phNxpEseLastTx_Cntx.FrameType == IFRAME)
                 {
-                    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx;
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
-                    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = IFRAME;
+                    pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx;
+                    pProto->phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
+                    pProto->phNxpEseNextTx_Cntx.FrameType = IFRAME;
                 }
-                else if(phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType == RFRAME)
+                else if(pProto->phNxpEseLastTx_Cntx.FrameType == RFRAME)
                 {
                     /* Usecase to reach the below case:
                     I-frame sent first, followed by R-NACK and we receive a R-NACK with
                     last sent I-frame sequence number*/
                     if ((pRx_lastRcvdRframeInfo->seqNo == pLastTx_IframeInfo->seqNo) &&
-                        (phNxpEseProto7816_3_Var.lastSentNonErrorframeType == IFRAME)) {
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = IFRAME;
+                        (pProto->lastSentNonErrorframeType == IFRAME)) {
+                        pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_IFRAME;
+                        pProto->phNxpEseNextTx_Cntx.FrameType = IFRAME;
                     }
                     /* Usecase to reach the below case:
                     R-frame sent first, followed by R-NACK and we receive a R-NACK with
                     next expected I-frame sequence number*/
                     else if ((pRx_lastRcvdRframeInfo->seqNo != pLastTx_IframeInfo->seqNo) &&
-                             (phNxpEseProto7816_3_Var.lastSentNonErrorframeType == RFRAME)) {
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = RFRAME;
+                             (pProto->lastSentNonErrorframeType == RFRAME)) {
+                        pProto->phNxpEseNextTx_Cntx.FrameType = RFRAME;
                         pNextTx_RframeInfo->errCode = NO_ERROR;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_ACK ;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_ACK ;
                     }
                     /* Usecase to reach the below case:
                     I-frame sent first, followed by R-NACK and we receive a R-NACK with
                     next expected I-frame sequence number + all the other unexpected scenarios */
                     else
                     {
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= RFRAME;
+                        pProto->phNxpEseNextTx_Cntx.FrameType= RFRAME;
                         pNextTx_RframeInfo->errCode = OTHER_ERROR;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
                     }
                 }
-                else if(phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType == SFRAME)
+                else if(pProto->phNxpEseLastTx_Cntx.FrameType == SFRAME)
                 {
                     /* Copy the last S frame sent */
-                    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx;
+                    pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx;
                 }
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                pProto->recoveryCounter++;
             }
             else
             {
-                phNxpEseProto7816_RecoverySteps();
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                phNxpEseProto7816_RecoverySteps(conn_ctx);
+                pProto->recoveryCounter++;
             }
             //resend previously send I frame
         }
@@ -869,16 +937,16 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
         else if ((pcb & 0x01) && (pcb & 0x02))
         {
             sm_sleep(DELAY_ERROR_RECOVERY/1000);
-            if(phNxpEseProto7816_3_Var.recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
+            if(pProto->recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
             {
                 pRx_lastRcvdRframeInfo->errCode = SOF_MISSED_ERROR;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx;
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx;
+                pProto->recoveryCounter++;
             }
             else
             {
-                phNxpEseProto7816_RecoverySteps();
-                phNxpEseProto7816_3_Var.recoveryCounter++;
+                phNxpEseProto7816_RecoverySteps(conn_ctx);
+                pProto->recoveryCounter++;
             }
         }
     }
@@ -886,64 +954,64 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
     {
         LOG_D("%s S-Frame Received ", __FUNCTION__);
         frameType = (int32_t)(pcb & 0x3F); /*discard upper 2 bits */
-        phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = SFRAME;
+        pProto->phNxpEseRx_Cntx.lastRcvdFrameType = SFRAME;
         if(frameType!=WTX_REQ)
         {
-            phNxpEseProto7816_3_Var.wtx_counter = 0;
+            pProto->wtx_counter = 0;
         }
         switch(frameType)
         {
             case RESYNCH_RSP:
                 pRx_lastRcvdSframeInfo->sFrameType = RESYNCH_RSP;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             case IFSC_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = IFSC_RES;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE ;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE ;
                 break;
             case ABORT_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = ABORT_RES;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE ;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE ;
                 break;
             case WTX_REQ:
-                phNxpEseProto7816_3_Var.wtx_counter++;
-                LOG_D("%s Wtx_counter value - %lu ", __FUNCTION__, phNxpEseProto7816_3_Var.wtx_counter);
-                LOG_D("%s Wtx_counter wtx_counter_limit - %lu ", __FUNCTION__, phNxpEseProto7816_3_Var.wtx_counter_limit);
+                pProto->wtx_counter++;
+                LOG_D("%s Wtx_counter value - %lu ", __FUNCTION__, pProto->wtx_counter);
+                LOG_D("%s Wtx_counter wtx_counter_limit - %lu ", __FUNCTION__, pProto->wtx_counter_limit);
                 /* Previous sent frame is some S-frame but not WTX response S-frame */
                 if (pLastTx_SframeInfo->sFrameType != WTX_RSP &&
-                    phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType ==
+                    pProto->phNxpEseLastTx_Cntx.FrameType ==
                         SFRAME) { /* Goto recovery if it keep coming here for more than recovery counter max. value */
-                    if(phNxpEseProto7816_3_Var.recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
+                    if(pProto->recoveryCounter < PH_PROTO_7816_FRAME_RETRY_COUNT)
                     {   /* Re-transmitting the previous sent S-frame */
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx;
-                        phNxpEseProto7816_3_Var.recoveryCounter++;
+                        pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx;
+                        pProto->recoveryCounter++;
                     }
                     else
                     {
-                        phNxpEseProto7816_RecoverySteps();
-                        phNxpEseProto7816_3_Var.recoveryCounter++;
+                        phNxpEseProto7816_RecoverySteps(conn_ctx);
+                        pProto->recoveryCounter++;
                     }
                 }
                 else
                 {   /* Checking for WTX counter with max. allowed WTX count */
-                    if(phNxpEseProto7816_3_Var.wtx_counter == phNxpEseProto7816_3_Var.wtx_counter_limit)
+                    if(pProto->wtx_counter == pProto->wtx_counter_limit)
                     {
 #if defined(T1oI2C_UM11225)
-                        phNxpEseProto7816_3_Var.wtx_counter = 0;
+                        pProto->wtx_counter = 0;
                         pRx_lastRcvdSframeInfo->sFrameType = INTF_RESET_REQ;
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+                        pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
                         pNextTx_SframeInfo->sFrameType = INTF_RESET_REQ;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
                         LOG_E("%s Interface Reset to eSE wtx count reached!!! ", __FUNCTION__);
 #elif defined(T1oI2C_GP1_0)
-                        phNxpEseProto7816_3_Var.wtx_counter = 0;
+                        pProto->wtx_counter = 0;
                         pRx_lastRcvdSframeInfo->sFrameType = SWR_REQ;
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+                        pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
                         pNextTx_SframeInfo->sFrameType = SWR_REQ;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
                         LOG_E("%s Software Reset to eSE wtx count reached!!! ", __FUNCTION__);
 #endif
                     }
@@ -951,9 +1019,9 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                     {
                         sm_sleep(DELAY_ERROR_RECOVERY/1000);
                         pRx_lastRcvdSframeInfo->sFrameType = WTX_REQ;
-                        phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+                        pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
                         pNextTx_SframeInfo->sFrameType = WTX_RSP;
-                        phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_WTX_RSP ;
+                        pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_WTX_RSP ;
                     }
                 }
                 break;
@@ -962,23 +1030,23 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                if (FALSE == phNxpEseProro7816_SaveRxframeData(&p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
+                if (FALSE == phNxpEseProro7816_SaveRxframeData(conn_ctx, &p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
                 {
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     LOG_E("phNxpEseProro7816_SaveRxframeData Failed");
                     return FALSE;
                 }
-                if(phNxpEseProto7816_3_Var.recoveryCounter > PH_PROTO_7816_FRAME_RETRY_COUNT){
+                if(pProto->recoveryCounter > PH_PROTO_7816_FRAME_RETRY_COUNT){
                     /*Max recovery counter reached, send failure to APDU layer  */
                     LOG_E("%s Max retry count reached!!! ", __FUNCTION__);
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     status = FALSE;
                 }
                 else{
-                    phNxpEseProto7816_ResetProtoParams();
+                    phNxpEseProto7816_ResetProtoParams(conn_ctx);
                     pRx_lastRcvdSframeInfo->sFrameType = INTF_RESET_RSP;
-                    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 }
                 break;
             case PROP_END_APDU_RSP:
@@ -986,30 +1054,30 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             case ATR_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = ATR_RES;
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                if (FALSE == phNxpEseProro7816_SaveRxframeData(&p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
+                if (FALSE == phNxpEseProro7816_SaveRxframeData(conn_ctx, &p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
                 {
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     LOG_E("phNxpEseProro7816_SaveRxframeData Failed");
                     return FALSE;
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             case CHIP_RESET_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = CHIP_RESET_RES;
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
 #endif
 #if defined(T1oI2C_GP1_0)
@@ -1017,17 +1085,17 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                if(phNxpEseProto7816_3_Var.recoveryCounter > PH_PROTO_7816_FRAME_RETRY_COUNT){
+                if(pProto->recoveryCounter > PH_PROTO_7816_FRAME_RETRY_COUNT){
                     /*Max recovery counter reached, send failure to APDU layer  */
                     LOG_E("%s Max retry count reached!!! ", __FUNCTION__);
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     status = FALSE;
                 }
                 else{
-                    phNxpEseProto7816_ResetProtoParams();
+                    phNxpEseProto7816_ResetProtoParams(conn_ctx);
                     pRx_lastRcvdSframeInfo->sFrameType = SWR_RSP;
-                    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 }
                 break;
             case RELEASE_RES:
@@ -1035,30 +1103,30 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             case CIP_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = CIP_RES;
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                if (FALSE == phNxpEseProro7816_SaveRxframeData(&p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
+                if (FALSE == phNxpEseProro7816_SaveRxframeData(conn_ctx, &p_data[PH_PROPTO_7816_INF_BYTE_OFFSET], data_len - PH_PROTO_7816_INF_FILED))
                 {
-                    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                     LOG_E("phNxpEseProro7816_SaveRxframeData Failed");
                     return FALSE;
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             case COLD_RESET_RES:
                 pRx_lastRcvdSframeInfo->sFrameType = COLD_RESET_RES;
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
 #endif
             case DEEP_PWR_DOWN_RES:
@@ -1066,8 +1134,8 @@ static bool_t phNxpEseProto7816_DecodeFrame(uint8_t *p_data, uint32_t data_len)
                 if(p_data[PH_PROPTO_7816_FRAME_LENGTH_OFFSET] > 0) {
                     phNxpEseProto7816_DecodeSFrameData(p_data);
                 }
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseNextTx_Cntx.FrameType= UNKNOWN;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
             default:
                 LOG_E("%s Wrong S-Frame Received ", __FUNCTION__);
@@ -1096,46 +1164,47 @@ exit:
  ******************************************************************************/
 static bool_t phNxpEseProto7816_ProcessResponse(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     uint32_t data_len = 0;
     uint8_t *p_data = NULL;
     bool_t status = FALSE;
     bool_t checkCrcPass = TRUE;
-    iFrameInfo_t *pRx_lastRcvdIframeInfo = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdIframeInfo;
-    rFrameInfo_t *pNextTx_RframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.RframeInfo;
-    sFrameInfo_t *pLastTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.SframeInfo;
+    iFrameInfo_t *pRx_lastRcvdIframeInfo = &pProto->phNxpEseRx_Cntx.lastRcvdIframeInfo;
+    rFrameInfo_t *pNextTx_RframeInfo = &pProto->phNxpEseNextTx_Cntx.RframeInfo;
+    sFrameInfo_t *pLastTx_SframeInfo = &pProto->phNxpEseLastTx_Cntx.SframeInfo;
 
     status = phNxpEseProto7816_GetRawFrame(conn_ctx, &data_len, &p_data);
     LOG_D("%s p_data ----> %p len ----> 0x%lx ", __FUNCTION__,p_data, data_len);
     if(TRUE == status)
     {
         /* Resetting the timeout counter */
-        phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+        pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
         /* CRC check followed */
         checkCrcPass = phNxpEseProto7816_CheckCRC(data_len, p_data);
         if(checkCrcPass == TRUE)
         {
             /* Resetting the RNACK retry counter */
-            phNxpEseProto7816_3_Var.rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
-            status = phNxpEseProto7816_DecodeFrame(p_data, data_len);
+            pProto->rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
+            status = phNxpEseProto7816_DecodeFrame(conn_ctx, p_data, data_len);
         }
         else
         {
             LOG_E("%s CRC Check failed ", __FUNCTION__);
-            if(phNxpEseProto7816_3_Var.rnack_retry_counter < phNxpEseProto7816_3_Var.rnack_retry_limit)
+            if(pProto->rnack_retry_counter < pProto->rnack_retry_limit)
             {
-                phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= RFRAME;
+                pProto->phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
+                pProto->phNxpEseNextTx_Cntx.FrameType= RFRAME;
                 pNextTx_RframeInfo->errCode = PARITY_ERROR;
                 pNextTx_RframeInfo->seqNo = (!pRx_lastRcvdIframeInfo->seqNo) << 4;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
-                phNxpEseProto7816_3_Var.rnack_retry_counter++;
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
+                pProto->rnack_retry_counter++;
             }
             else
             {
-                phNxpEseProto7816_3_Var.rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
                 /* Re-transmission failed completely, Going to exit */
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
-                phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
                 status = FALSE;
             }
         }
@@ -1143,65 +1212,65 @@ static bool_t phNxpEseProto7816_ProcessResponse(void* conn_ctx)
     else
     {
         LOG_E("%s phNxpEseProto7816_GetRawFrame failed starting recovery", __FUNCTION__);
-        if ((SFRAME == phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType) &&
+        if ((SFRAME == pProto->phNxpEseLastTx_Cntx.FrameType) &&
             ((WTX_RSP == pLastTx_SframeInfo->sFrameType) || (RESYNCH_RSP == pLastTx_SframeInfo->sFrameType))) {
-            if(phNxpEseProto7816_3_Var.rnack_retry_counter < phNxpEseProto7816_3_Var.rnack_retry_limit)
+            if(pProto->rnack_retry_counter < pProto->rnack_retry_limit)
             {
                 phNxpEse_clearReadBuffer(conn_ctx);
-                phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= RFRAME;
+                pProto->phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
+                pProto->phNxpEseNextTx_Cntx.FrameType= RFRAME;
                 pNextTx_RframeInfo->errCode = OTHER_ERROR;
                 pNextTx_RframeInfo->seqNo = (!pRx_lastRcvdIframeInfo->seqNo) << 4;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
-                phNxpEseProto7816_3_Var.rnack_retry_counter++;
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
+                pProto->rnack_retry_counter++;
             }
             else
             {
                 LOG_E("%s Recovery failed completely, Going to exit ", __FUNCTION__);
-                phNxpEseProto7816_3_Var.rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
                 /* Recovery failed completely, Going to exit */
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
-                phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
             }
         }
         /*ISO7816-3 Rule 7.1 Implementation*/
-        else if (IFRAME == phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType)
+        else if (IFRAME == pProto->phNxpEseLastTx_Cntx.FrameType)
         {
-            if(phNxpEseProto7816_3_Var.rnack_retry_counter < phNxpEseProto7816_3_Var.rnack_retry_limit)
+            if(pProto->rnack_retry_counter < pProto->rnack_retry_limit)
             {
                 phNxpEse_clearReadBuffer(conn_ctx);
-                phNxpEseProto7816_3_Var.phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= RFRAME;
+                pProto->phNxpEseRx_Cntx.lastRcvdFrameType = INVALID ;
+                pProto->phNxpEseNextTx_Cntx.FrameType= RFRAME;
                 pNextTx_RframeInfo->errCode = PARITY_ERROR;
                 pNextTx_RframeInfo->seqNo = (!pRx_lastRcvdIframeInfo->seqNo) << 4;
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
-                phNxpEseProto7816_3_Var.rnack_retry_counter++;
+                pProto->phNxpEseProto7816_nextTransceiveState = SEND_R_NACK ;
+                pProto->rnack_retry_counter++;
             }
             else
             {
                 LOG_E("%s Recovery failed completely, Going to exit ", __FUNCTION__);
-                phNxpEseProto7816_3_Var.rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
                 /* Recovery failed completely, Going to exit */
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
-                phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
             }
         }
         else
         {
             sm_sleep(DELAY_ERROR_RECOVERY/1000);
             /* re transmit the frame */
-            if(phNxpEseProto7816_3_Var.timeoutCounter < PH_PROTO_7816_TIMEOUT_RETRY_COUNT)
+            if(pProto->timeoutCounter < PH_PROTO_7816_TIMEOUT_RETRY_COUNT)
             {
-                phNxpEseProto7816_3_Var.timeoutCounter++;
+                pProto->timeoutCounter++;
                 LOG_E("%s re-transmitting the previous frame ", __FUNCTION__);
-                phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx ;
+                pProto->phNxpEseNextTx_Cntx = pProto->phNxpEseLastTx_Cntx ;
             }
             else
             {
                 /* Recovery failed completely, Going to exit */
                 LOG_E("%s Recovery failed completely, Going to exit ", __FUNCTION__);
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
-                phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
             }
         }
     }
@@ -1223,17 +1292,18 @@ static bool_t phNxpEseProto7816_ProcessResponse(void* conn_ctx)
  ******************************************************************************/
 static bool_t TransceiveProcess(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
     sFrameInfo_t sFrameInfo;
     sFrameInfo.sFrameType = INVALID_REQ_RES;
 
-    while(phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState != IDLE_STATE)
+    while(pProto->phNxpEseProto7816_nextTransceiveState != IDLE_STATE)
     {
-        LOG_D("%s nextTransceiveState %x ", __FUNCTION__, phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState);
-        switch(phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState)
+        LOG_D("%s nextTransceiveState %x ", __FUNCTION__, pProto->phNxpEseProto7816_nextTransceiveState);
+        switch(pProto->phNxpEseProto7816_nextTransceiveState)
         {
             case SEND_IFRAME:
-                status = phNxpEseProto7816_SendIframe(conn_ctx, phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo);
+                status = phNxpEseProto7816_SendIframe(conn_ctx, pProto->phNxpEseNextTx_Cntx.IframeInfo);
                 break;
             case SEND_R_ACK:
                 status = phNxpEseProto7816_sendRframe(conn_ctx, RACK);
@@ -1291,18 +1361,18 @@ static bool_t TransceiveProcess(void* conn_ctx)
 #error Either T1oI2C_UM11225 or T1oI2C_GP1_0 must be defined.
 #endif
             default:
-                phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+                pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
                 break;
         }
         if(TRUE == status)
         {
-            phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx = phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx;
+            pProto->phNxpEseLastTx_Cntx = pProto->phNxpEseNextTx_Cntx;
             status = phNxpEseProto7816_ProcessResponse(conn_ctx);
         }
         else
         {
             LOG_E("%s Transceive send failed, going to recovery! ", __FUNCTION__);
-            phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+            pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
         }
     };
     return status;
@@ -1325,21 +1395,22 @@ static bool_t TransceiveProcess(void* conn_ctx)
  ******************************************************************************/
 bool_t phNxpEseProto7816_Transceive(void* conn_ctx, phNxpEse_data *pCmd, phNxpEse_data *pRsp)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
 
     LOG_D("Enter %s  ", __FUNCTION__);
     if((NULL == pCmd) || (NULL == pRsp) ||
-            (phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState != PH_NXP_ESE_PROTO_7816_IDLE))
+            (pProto->phNxpEseProto7816_CurrentState != PH_NXP_ESE_PROTO_7816_IDLE))
         return status;
     /* Updating the transceive information to the protocol stack */
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
     pNextTx_IframeInfo->p_data = pCmd->p_data;
     pNextTx_IframeInfo->totalDataLen = pCmd->len;
     pRx_EseCntx->pRsp = pRsp;
     LOG_D("Transceive data ptr 0x%p len:%ld ", pCmd->p_data, pCmd->len);
-    phNxpEseProto7816_SetFirstIframeContxt();
+    phNxpEseProto7816_SetFirstIframeContxt(conn_ctx);
     status = TransceiveProcess(conn_ctx);
     if(FALSE == status)
     {
@@ -1350,7 +1421,7 @@ bool_t phNxpEseProto7816_Transceive(void* conn_ctx, phNxpEse_data *pCmd, phNxpEs
         return FALSE;
     }
     pRsp->len = pRx_EseCntx->responseBytesRcvd;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status;
 }
 
@@ -1366,16 +1437,17 @@ bool_t phNxpEseProto7816_Transceive(void* conn_ctx, phNxpEse_data *pCmd, phNxpEs
  ******************************************************************************/
 static bool_t phNxpEseProto7816_RSync(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
     /* send the end of session s-frame */
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = RESYNCH_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_RSYNC;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_RSYNC;
     status = TransceiveProcess(conn_ctx);
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status;
 }
 
@@ -1384,32 +1456,37 @@ static bool_t phNxpEseProto7816_RSync(void* conn_ctx)
  *
  * Description      This function is used to reset the 7816 protocol stack instance
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          Always return TRUE.
  *
  ******************************************************************************/
-bool_t phNxpEseProto7816_ResetProtoParams(void)
+bool_t phNxpEseProto7816_ResetProtoParams(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     unsigned long int tmpWTXCountlimit = PH_PROTO_7816_VALUE_ZERO;
     unsigned long int tmpRNACKCountlimit = PH_PROTO_7816_VALUE_ZERO;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
-    iFrameInfo_t *pLastTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.IframeInfo;
-
-    tmpWTXCountlimit = phNxpEseProto7816_3_Var.wtx_counter_limit;
-    tmpRNACKCountlimit = phNxpEseProto7816_3_Var.rnack_retry_limit;
-    phNxpEse_memset(&phNxpEseProto7816_3_Var, PH_PROTO_7816_VALUE_ZERO, sizeof(phNxpEseProto7816_t));
-    phNxpEseProto7816_3_Var.wtx_counter_limit = tmpWTXCountlimit;
-    phNxpEseProto7816_3_Var.rnack_retry_limit = tmpRNACKCountlimit;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
+    uint16_t tmpIfsc = 0;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
+    iFrameInfo_t *pLastTx_IframeInfo = &pProto->phNxpEseLastTx_Cntx.IframeInfo;
+
+    tmpWTXCountlimit = pProto->wtx_counter_limit;
+    tmpRNACKCountlimit = pProto->rnack_retry_limit;
+    tmpIfsc = pProto->ifsc;
+    phNxpEse_memset(pProto, PH_PROTO_7816_VALUE_ZERO, sizeof(phNxpEseProto7816_t));
+    pProto->wtx_counter_limit = tmpWTXCountlimit;
+    pProto->rnack_retry_limit = tmpRNACKCountlimit;
+    /* Negotiated frame size survives resets of the protocol state */
+    pProto->ifsc = tmpIfsc;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_nextTransceiveState = IDLE_STATE;
     pRx_EseCntx->lastRcvdFrameType = INVALID;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType = INVALID;
-    pNextTx_IframeInfo->maxDataLen = IFSC_SIZE_SEND;
+    pProto->phNxpEseNextTx_Cntx.FrameType = INVALID;
+    pNextTx_IframeInfo->maxDataLen = (tmpIfsc != 0) ? tmpIfsc : IFSC_SIZE_SEND;
     pNextTx_IframeInfo->p_data = NULL;
-    phNxpEseProto7816_3_Var.phNxpEseLastTx_Cntx.FrameType = INVALID;
-    pLastTx_IframeInfo->maxDataLen = IFSC_SIZE_SEND;
+    pProto->phNxpEseLastTx_Cntx.FrameType = INVALID;
+    pLastTx_IframeInfo->maxDataLen = pNextTx_IframeInfo->maxDataLen;
     pLastTx_IframeInfo->p_data = NULL;
     /* Initialized with sequence number of the last I-frame sent */
     pNextTx_IframeInfo->seqNo = PH_PROTO_7816_VALUE_ONE;
@@ -1417,12 +1494,12 @@ bool_t phNxpEseProto7816_ResetProtoParams(void)
     pRx_EseCntx->lastRcvdIframeInfo.seqNo = PH_PROTO_7816_VALUE_ONE;
     /* Initialized with sequence number of the last I-frame received */
     pLastTx_IframeInfo->seqNo = PH_PROTO_7816_VALUE_ONE;
-    phNxpEseProto7816_3_Var.recoveryCounter = PH_PROTO_7816_VALUE_ZERO;
-    phNxpEseProto7816_3_Var.timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
-    phNxpEseProto7816_3_Var.wtx_counter = PH_PROTO_7816_VALUE_ZERO;
+    pProto->recoveryCounter = PH_PROTO_7816_VALUE_ZERO;
+    pProto->timeoutCounter = PH_PROTO_7816_VALUE_ZERO;
+    pProto->wtx_counter = PH_PROTO_7816_VALUE_ZERO;
     /* This update is helpful in-case a R-NACK is transmitted from the MW */
-    phNxpEseProto7816_3_Var.lastSentNonErrorframeType = UNKNOWN;
-    phNxpEseProto7816_3_Var.rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
+    pProto->lastSentNonErrorframeType = UNKNOWN;
+    pProto->rnack_retry_counter = PH_PROTO_7816_VALUE_ZERO;
     pRx_EseCntx->pRsp = NULL;
     return TRUE;
 }
@@ -1433,16 +1510,16 @@ bool_t phNxpEseProto7816_ResetProtoParams(void)
  *
  * Description      This function is used to reset the 7816 protocol stack instance
  *
- * param[in]        void
+ * param[in]        void* conn_ctx
  *
  * Returns          On success return TRUE or else FALSE.
  *
  ******************************************************************************/
-bool_t phNxpEseProto7816_Reset(void)
+bool_t phNxpEseProto7816_Reset(void* conn_ctx)
 {
     bool_t status = FALSE;
     /* Resetting host protocol instance */
-    status = phNxpEseProto7816_ResetProtoParams();
+    status = phNxpEseProto7816_ResetProtoParams(conn_ctx);
     /* Resynchronising ESE protocol instance */
     //status = phNxpEseProto7816_RSync();
     return status;
@@ -1461,13 +1538,14 @@ bool_t phNxpEseProto7816_Reset(void)
  ******************************************************************************/
 bool_t phNxpEseProto7816_Open(void* conn_ctx, phNxpEseProto7816InitParam_t initParam, phNxpEse_data *AtrRsp)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
-    status = phNxpEseProto7816_ResetProtoParams();
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
+    status = phNxpEseProto7816_ResetProtoParams(conn_ctx);
     LOG_D("%s: First open completed", __FUNCTION__);
     /* Update WTX max. limit */
-    phNxpEseProto7816_3_Var.wtx_counter_limit = initParam.wtx_counter_limit;
-    phNxpEseProto7816_3_Var.rnack_retry_limit = initParam.rnack_retry_limit;
+    pProto->wtx_counter_limit = initParam.wtx_counter_limit;
+    pProto->rnack_retry_limit = initParam.rnack_retry_limit;
     /*Intialise the buffers before hand so that we are able to receive data
     if RSync goes to recovery handling*/
     pRx_EseCntx->pRsp = AtrRsp;
@@ -1517,28 +1595,29 @@ bool_t phNxpEseProto7816_Open(void* conn_ctx, phNxpEseProto7816InitParam_t initP
  ******************************************************************************/
 bool_t phNxpEseProto7816_Close(void* conn_ctx)
 {
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
     bool_t status = FALSE;
     /*Explicitly Initilising to NULL as the Application layer does not intend to receive a response*/
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
     pRx_EseCntx->pRsp = NULL;
 
-    if(phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState != PH_NXP_ESE_PROTO_7816_IDLE) {
+    if(pProto->phNxpEseProto7816_CurrentState != PH_NXP_ESE_PROTO_7816_IDLE) {
         return status;
     }
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_DEINIT;
-    phNxpEseProto7816_3_Var.recoveryCounter = 0;
-    phNxpEseProto7816_3_Var.wtx_counter = 0;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_DEINIT;
+    pProto->recoveryCounter = 0;
+    pProto->wtx_counter = 0;
 #if defined(T1oI2C_UM11225)
     /* send the end of session s-frame */
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = PROP_END_APDU_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_EOS;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_EOS;
 #elif defined(T1oI2C_GP1_0)
     /* send the release request s-frame */
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = RELEASE_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_RELEASE;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_RELEASE;
 #endif
     status = TransceiveProcess(conn_ctx);
     if(FALSE == status)
@@ -1546,7 +1625,7 @@ bool_t phNxpEseProto7816_Close(void* conn_ctx)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status;
 }
 
@@ -1565,15 +1644,16 @@ bool_t phNxpEseProto7816_Close(void* conn_ctx)
  ******************************************************************************/
 bool_t phNxpEseProto7816_IntfReset(void* conn_ctx, phNxpEse_data *AtrRsp)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
     ENSURE_OR_GO_EXIT(AtrRsp != NULL);
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = INTF_RESET_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_INTF_RST;
     pRx_EseCntx->pRsp = AtrRsp;
     pRx_EseCntx->pRsp->len = AtrRsp->len;
     pRx_EseCntx->responseBytesRcvd = 0;
@@ -1585,8 +1665,12 @@ bool_t phNxpEseProto7816_IntfReset(void* conn_ctx, phNxpEse_data *AtrRsp)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
+    else
+    {
+        phNxpEseProto7816_NegotiateIfsc(conn_ctx, AtrRsp);
+    }
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
 exit:
     return status ;
 }
@@ -1604,14 +1688,15 @@ exit:
  ******************************************************************************/
 bool_t phNxpEseProto7816_ChipReset(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = CHIP_RESET_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_CHIP_RST;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_CHIP_RST;
     pRx_EseCntx->pRsp = NULL;
     status = TransceiveProcess(conn_ctx);
     if(FALSE == status)
@@ -1619,7 +1704,7 @@ bool_t phNxpEseProto7816_ChipReset(void* conn_ctx)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status ;
 }
 #endif
@@ -1637,14 +1722,15 @@ bool_t phNxpEseProto7816_ChipReset(void* conn_ctx)
  ******************************************************************************/
 bool_t phNxpEseProto7816_SoftReset(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = SWR_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_SWR;
     pRx_EseCntx->pRsp = NULL;
     phNxpEse_clearReadBuffer(conn_ctx);
     status = TransceiveProcess(conn_ctx);
@@ -1654,7 +1740,7 @@ bool_t phNxpEseProto7816_SoftReset(void* conn_ctx)
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status ;
 }
 
@@ -1670,14 +1756,15 @@ bool_t phNxpEseProto7816_SoftReset(void* conn_ctx)
  ******************************************************************************/
 bool_t phNxpEseProto7816_ColdReset(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = COLD_RESET_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_COLD_RST;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_COLD_RST;
     pRx_EseCntx->pRsp = NULL;
     status = TransceiveProcess(conn_ctx);
     if(FALSE == status)
@@ -1685,7 +1772,7 @@ bool_t phNxpEseProto7816_ColdReset(void* conn_ctx)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status ;
 }
 #endif
@@ -1694,18 +1781,87 @@ bool_t phNxpEseProto7816_ColdReset(void* conn_ctx)
  *
  * Description      This function is used to set the max T=1 data send size
  *
+ * param[in]        void* conn_ctx
  * param[in]        uint16_t IFSC_Size
  *
  * Returns          Always return TRUE (1).
  *
  ******************************************************************************/
-bool_t phNxpEseProto7816_SetIfscSize(uint16_t IFSC_Size)
+bool_t phNxpEseProto7816_SetIfscSize(void* conn_ctx, uint16_t IFSC_Size)
 {
-    iFrameInfo_t *pNextTx_IframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.IframeInfo;
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    iFrameInfo_t *pNextTx_IframeInfo = &pProto->phNxpEseNextTx_Cntx.IframeInfo;
     pNextTx_IframeInfo->maxDataLen = IFSC_Size;
+    pProto->ifsc = IFSC_Size;
     return TRUE;
 }
 
+/******************************************************************************
+ * Function         phNxpEseProto7816_GetIfscSize
+ *
+ * Description      This function returns the max T=1 data send size in use
+ *
+ * param[in]        void* conn_ctx
+ *
+ * Returns          Max. INF length of I-frames sent to ESE
+ *
+ ******************************************************************************/
+uint16_t phNxpEseProto7816_GetIfscSize(void* conn_ctx)
+{
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
+    return (pProto->ifsc != 0) ? pProto->ifsc : IFSC_SIZE_SEND;
+}
+
+/******************************************************************************
+ * Function         phNxpEseProto7816_NegotiateIfsc
+ *
+ * Description      This internal function takes the IFSC advertised in the
+ *                  data link layer parameters (DLLP) of the ATR (UM11225) or
+ *                  CIP (GP1.0), limited to what fits in the host frame buffer.
+ *
+ *                  ATR: PVER(1) VID(5) DLLP_LEN(1) DLLP ...
+ *                  CIP: PVER(1) IIN_LEN(1) IIN PLID(1) PLP_LEN(1) PLP DLLP_LEN(1) DLLP ...
+ *                  DLLP: BWT(2) IFSC(2)
+ *
+ * param[in]        void* conn_ctx
+ * param[in]        phNxpEse_data: ATR / CIP
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void phNxpEseProto7816_NegotiateIfsc(void* conn_ctx, const phNxpEse_data *pAtr)
+{
+    size_t offset = 0;
+    size_t dllpLen = 0;
+    uint16_t seIfsc = 0;
+    uint16_t ifsc = 0;
+
+    ENSURE_OR_GO_EXIT(pAtr != NULL);
+    ENSURE_OR_GO_EXIT(pAtr->p_data != NULL);
+#if defined(T1oI2C_UM11225)
+    offset = 1 + 5;
+#elif defined(T1oI2C_GP1_0)
+    offset = 1;
+    ENSURE_OR_GO_EXIT(offset < pAtr->len);
+    offset += 1 + pAtr->p_data[offset]; /* IIN */
+    offset += 1;                        /* PLID */
+    ENSURE_OR_GO_EXIT(offset < pAtr->len);
+    offset += 1 + pAtr->p_data[offset]; /* PLP */
+#endif
+    ENSURE_OR_GO_EXIT(offset < pAtr->len);
+    dllpLen = pAtr->p_data[offset++];
+    ENSURE_OR_GO_EXIT(dllpLen >= 4);
+    ENSURE_OR_GO_EXIT((offset + 4) <= pAtr->len);
+    seIfsc = (uint16_t)((pAtr->p_data[offset + 2] << 8) | pAtr->p_data[offset + 3]);
+    ENSURE_OR_GO_EXIT(seIfsc != 0);
+
+    ifsc = (seIfsc < PH_PROTO_7816_HOST_MAX_IFSC) ? seIfsc : PH_PROTO_7816_HOST_MAX_IFSC;
+    LOG_D("%s ESE IFSC %d, using %d ", __FUNCTION__, seIfsc, ifsc);
+    phNxpEseProto7816_SetIfscSize(conn_ctx, ifsc);
+exit:
+    return;
+}
+
 /******************************************************************************
  * Function         phNxpEseProto7816_WTXRsp
  *
@@ -1757,15 +1913,16 @@ bool_t phNxpEseProto7816_SendRSync(void* conn_ctx)
  ******************************************************************************/
 bool_t phNxpEseProto7816_GetAtr(void* conn_ctx, phNxpEse_data *pRsp)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
 
     ENSURE_OR_GO_EXIT(pRsp != NULL);
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = ATR_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_ATR;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_ATR;
     pRx_EseCntx->pRsp = pRsp;
     pRx_EseCntx->pRsp->len = pRsp->len;
     pRx_EseCntx->responseBytesRcvd = 0;
@@ -1776,7 +1933,11 @@ bool_t phNxpEseProto7816_GetAtr(void* conn_ctx, phNxpEse_data *pRsp)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    else
+    {
+        phNxpEseProto7816_NegotiateIfsc(conn_ctx, pRsp);
+    }
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
 exit:
     return status ;
 }
@@ -1796,15 +1957,16 @@ exit:
  ******************************************************************************/
 bool_t phNxpEseProto7816_GetCip(void* conn_ctx, phNxpEse_data *pRsp)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    phNxpEseRx_Cntx_t *pRx_EseCntx = &phNxpEseProto7816_3_Var.phNxpEseRx_Cntx;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
+    phNxpEseRx_Cntx_t *pRx_EseCntx = &pProto->phNxpEseRx_Cntx;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
 
     ENSURE_OR_GO_EXIT(pRsp != NULL);
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = CIP_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_S_CIP;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_S_CIP;
     pRx_EseCntx->pRsp = pRsp;
     pRx_EseCntx->pRsp->len = pRsp->len;
     pRx_EseCntx->responseBytesRcvd = 0;
@@ -1815,8 +1977,12 @@ bool_t phNxpEseProto7816_GetCip(void* conn_ctx, phNxpEse_data *pRsp)
         /* reset all the structures */
         LOG_E("%s TransceiveProcess failed  ", __FUNCTION__);
     }
+    else
+    {
+        phNxpEseProto7816_NegotiateIfsc(conn_ctx, pRsp);
+    }
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
 exit:
     return status ;
 }
@@ -1834,16 +2000,17 @@ exit:
  ******************************************************************************/
 bool_t phNxpEseProto7816_Deep_Pwr_Down(void* conn_ctx)
 {
+    phNxpEseProto7816_t *pProto = phNxpEseProto7816_GetCtx(conn_ctx);
     bool_t status = FALSE;
-    sFrameInfo_t *pNextTx_SframeInfo = &phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.SframeInfo;
+    sFrameInfo_t *pNextTx_SframeInfo = &pProto->phNxpEseNextTx_Cntx.SframeInfo;
 
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_TRANSCEIVE;
     /* send the end of session s-frame */
-    phNxpEseProto7816_3_Var.phNxpEseNextTx_Cntx.FrameType= SFRAME;
+    pProto->phNxpEseNextTx_Cntx.FrameType= SFRAME;
     pNextTx_SframeInfo->sFrameType = DEEP_PWR_DOWN_REQ;
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_nextTransceiveState = SEND_DEEP_PWR_DOWN;
+    pProto->phNxpEseProto7816_nextTransceiveState = SEND_DEEP_PWR_DOWN;
     status = TransceiveProcess(conn_ctx);
-    phNxpEseProto7816_3_Var.phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
+    pProto->phNxpEseProto7816_CurrentState = PH_NXP_ESE_PROTO_7816_IDLE;
     return status;
 }
 
@@ -5,7 +5,7 @@
  */
 #ifndef _PHNXPESEPROTO7816_3_H_
 #define _PHNXPESEPROTO7816_3_H_
-#include <phNxpEse_Internal.h>
+#include <phNxpEse_Api.h>
 
 
 /**
@@ -231,6 +231,7 @@ typedef struct phNxpEseProto7816
   phNxpEseProto7816_FrameTypes_t lastSentNonErrorframeType; /*!< Copy of the last sent non-error frame type: R-ACK, S-frame, I-frame */
   unsigned long int rnack_retry_limit;
   unsigned long int rnack_retry_counter;
+  uint16_t ifsc; /*!< Max. INF length of I-frames sent to ESE, from ATR/CIP or set by host. 0: IFSC_SIZE_SEND */
 }phNxpEseProto7816_t;
 
 /*!
@@ -247,9 +248,9 @@ typedef struct phNxpEseProto7816InitParam
 }phNxpEseProto7816InitParam_t;
 
 /*!
- * \brief 7816_3 protocol stack instance
+ * \brief 7816_3 protocol stack instance is held per connection,
+ * in phNxpEse_Context_t
  */
-//phNxpEseProto7816_t phNxpEseProto7816_3_Var;
 
 /*!
  * \brief Max. size of the frame that can be sent
@@ -409,9 +410,10 @@ bool_t phNxpEseProto7816_ChipReset(void* conn_ctx);
 bool_t phNxpEseProto7816_Close(void* conn_ctx);
 bool_t phNxpEseProto7816_Open(void* conn_ctx, phNxpEseProto7816InitParam_t initParam , phNxpEse_data *AtrRsp);
 bool_t phNxpEseProto7816_Transceive(void* conn_ctx, phNxpEse_data *pCmd, phNxpEse_data *pRsp);
-bool_t phNxpEseProto7816_Reset(void);
-bool_t phNxpEseProto7816_SetIfscSize(uint16_t IFSC_Size);
-bool_t phNxpEseProto7816_ResetProtoParams(void);
+bool_t phNxpEseProto7816_Reset(void* conn_ctx);
+bool_t phNxpEseProto7816_SetIfscSize(void* conn_ctx, uint16_t IFSC_Size);
+uint16_t phNxpEseProto7816_GetIfscSize(void* conn_ctx);
+bool_t phNxpEseProto7816_ResetProtoParams(void* conn_ctx);
 #if defined(T1oI2C_GP1_0)
 bool_t phNxpEseProto7816_SoftReset(void* conn_ctx);
 bool_t phNxpEseProto7816_GetCip(void* conn_ctx, phNxpEse_data *pRsp);
@@ -421,5 +423,6 @@ uint8_t getMaxSupportedSendIFrameSize(void);
 bool_t phNxpEseProto7816_WTXRsp(void* conn_ctx);
 bool_t phNxpEseProto7816_SendRSync(void* conn_ctx);
 bool_t phNxpEseProto7816_Deep_Pwr_Down(void* conn_ctx);
+uint16_t phNxpEseProto7816_ComputeCRC(unsigned char *p_buff, uint32_t offset, uint32_t length);
 /** @} */
 #endif /* _PHNXPESEPROTO7816_3_H_ */
@@ -5,6 +5,7 @@
  */
 #include <phEseTypes.h>
 #include <phNxpEseProto7816_3.h>
+#include <phNxpEse_Internal.h>
 #include <phNxpEsePal_i2c.h>
 #include "sm_types.h"
 #include "sm_timer.h"
@@ -16,6 +17,7 @@
 
 #include "nxLog_smCom.h"
 #include "nxEnsure.h"
+#include "smCom.h"
 
 #if defined(USE_RTOS) && USE_RTOS == 1
 #include "FreeRTOSConfig.h"
@@ -26,8 +28,13 @@
 #define CHAINED_PACKET_WITHSEQN         0x60
 #define CHAINED_PACKET_WITHOUTSEQN      0x20
 #define WTX_REQ_ID                      0xC3
+/* First read of a frame: length of the shortest frame (header + CRC), never reads past its end */
+#define ESE_FIRST_READ_LEN              (PH_PROTO_7816_HEADER_LEN + PH_PROTO_7816_CRC_LEN)
 static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead);
-static int poll_sof_chained_delay = 0;
+static int phNxpEse_i2cRead(phNxpEse_Context_t* nxpese_ctxt, void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead);
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+static int phNxpEse_i2cPoll(phNxpEse_Context_t* nxpese_ctxt, void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead);
+#endif
 
 /* Duration for which session open should wait for previous transaction to complete */
 #define T1OI2C_WAIT_FOR_PREV_TXN        40
@@ -225,7 +232,14 @@ ESESTATUS phNxpEse_Transceive(void* conn_ctx, phNxpEse_data *pCmd, phNxpEse_data
 #endif //#ifdef T1OI2C_SEND_SHORT_APDU
 
         nxpese_ctxt->EseLibStatus = ESE_STATUS_BUSY;
+        nxpese_ctxt->busStats.apdus++;
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+        phNxpEsePoll_StartCommand(&nxpese_ctxt->pollModel, pCmd->p_data, pCmd->len);
+#endif
         bStatus = phNxpEseProto7816_Transceive((void*)nxpese_ctxt, pCmd, pRsp);
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+        phNxpEsePoll_EndCommand(&nxpese_ctxt->pollModel);
+#endif
         if(TRUE == bStatus)
         {
             status = ESESTATUS_SUCCESS;
@@ -315,7 +329,7 @@ ESESTATUS phNxpEse_chipReset(void* conn_ctx)
     bool_t bStatus = FALSE;
     phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
 
-    bStatus = phNxpEseProto7816_Reset();
+    bStatus = phNxpEseProto7816_Reset((void*)nxpese_ctxt);
     if(!bStatus)
     {
         LOG_E("phNxpEseProto7816_Reset Failed");
@@ -576,17 +590,49 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
 {
     int ret = -1;
     int sof_counter = 0;/* one read may take 1 ms*/
-    int total_count = 0 ,numBytesToRead=0, headerIndex=0;
+    int frameLen = 0, bytesInBuffer = 0;
+    bool_t frameFound = FALSE, nadError = FALSE;
     phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    bool_t skipPollDelay = FALSE;
+    uint32_t fineStepUs = 0;
 
     ENSURE_OR_GO_EXIT(pBuffer != NULL);
+    ENSURE_OR_GO_EXIT(nNbBytesToRead >= ESE_FIRST_READ_LEN);
     memset(pBuffer,0,nNbBytesToRead);
+    /* The command is sent, let the caller use the time the SE needs for it */
+    smCom_RunIdleWork();
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+    /* Sleep most of the expected SE processing time, then poll without initial delay */
+    skipPollDelay = phNxpEsePoll_WaitForResponse(&nxpese_ctxt->pollModel);
+#endif
     do
     {
         sof_counter++;
         ret = -1;
-        sm_sleep(ESE_POLL_DELAY_MS); /* 1ms delay to give ESE polling delay */
-        ret = phPalEse_i2c_read(pDevHandle, pBuffer, 2); /*read NAD PCB byte first*/
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+        /* Around the predicted completion, poll in short steps and without back off */
+        fineStepUs = phNxpEsePoll_FineStep(&nxpese_ctxt->pollModel);
+#endif
+        if (skipPollDelay) {
+            skipPollDelay = FALSE;
+        }
+        else if (fineStepUs != 0) {
+            sm_usleep(fineStepUs);
+        }
+        else {
+            sm_sleep(ESE_POLL_DELAY_MS); /* 1ms delay to give ESE polling delay */
+        }
+        /* Poll with the length of the shortest frame, so that short frames
+         * (S/R-blocks, empty I-blocks) are complete after one read */
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+        if (fineStepUs != 0) {
+            ret = phNxpEse_i2cPoll(nxpese_ctxt, pDevHandle, pBuffer, ESE_FIRST_READ_LEN);
+        }
+        else
+#endif
+        {
+            ret = phNxpEse_i2cRead(nxpese_ctxt, pDevHandle, pBuffer, ESE_FIRST_READ_LEN);
+        }
         if (ret < 0)
         {
             /*Polling for read on i2c, hence Debug log*/
@@ -594,28 +640,19 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
         }
         if(pBuffer[0] == RECIEVE_PACKET_SOF)
         {
-            /* Read the HEADR of Two bytes*/
             LOG_D("%s Read HDR", __FUNCTION__);
-            pBuffer[0] = RECIEVE_PACKET_SOF;
-#if defined(T1oI2C_UM11225)
-            numBytesToRead = 1;
-#elif defined(T1oI2C_GP1_0)
-            numBytesToRead = 2;
-#endif
-            headerIndex = 1;
+            bytesInBuffer = ESE_FIRST_READ_LEN;
+            frameFound = TRUE;
             break;
         }
         if(pBuffer[1] == RECIEVE_PACKET_SOF)
         {
-            /* Read the HEADR of Two bytes*/
+            /* Frame starts after one padding byte, realign it */
             LOG_D("%s Read HDR", __FUNCTION__);
-            pBuffer[0] = RECIEVE_PACKET_SOF;
-#if defined(T1oI2C_UM11225)
-            numBytesToRead = 2;
-#elif defined(T1oI2C_GP1_0)
-            numBytesToRead = 3;
-#endif
-            headerIndex = 0;
+            memmove(pBuffer, &pBuffer[1], ESE_FIRST_READ_LEN - 1);
+            pBuffer[ESE_FIRST_READ_LEN - 1] = 0;
+            bytesInBuffer = ESE_FIRST_READ_LEN - 1;
+            frameFound = TRUE;
             break;
         }
         /*if host writes invalid frame and host and SE are out of sync*/
@@ -624,35 +661,18 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
             LOG_W("%s Recieved NAD byte 0x%x ",__FUNCTION__,pBuffer[0]);
             LOG_W("%s NAD error, clearing the read buffer ", __FUNCTION__);
             /*retry to get all data*/
-#if defined(T1oI2C_UM11225)
-            numBytesToRead = 1;
-#elif defined(T1oI2C_GP1_0)
-            numBytesToRead = 2;
-#endif
-            headerIndex = 1;
-            ret = phPalEse_i2c_read(pDevHandle, &pBuffer[1+headerIndex], numBytesToRead);
-#if defined(T1oI2C_UM11225)
-            total_count = 3;
-            nNbBytesToRead = pBuffer[2];
-#elif defined(T1oI2C_GP1_0)
-            total_count = 4;
-            nNbBytesToRead = (pBuffer[2] << 8 & 0xFF00) | (pBuffer[3] & 0xFF) ;
-#endif
-            /* Read the Complete data + two byte CRC*/
-            ret = phPalEse_i2c_read(pDevHandle,&pBuffer[PH_PROTO_7816_HEADER_LEN], (nNbBytesToRead+PH_PROTO_7816_CRC_LEN));
-            if (ret < 0)
-            {
-                LOG_D("_i2c_read() [HDR]errno : %x ret : %X", errno, ret);
-                ret = -1;
-            }
-            else
-            {
-                ret = (total_count + (nNbBytesToRead + PH_PROTO_7816_CRC_LEN));
-            }
+            bytesInBuffer = ESE_FIRST_READ_LEN;
+            frameFound = TRUE;
+            nadError = TRUE;
             break;
         }
+        nxpese_ctxt->busStats.emptyPolls++;
+        if (fineStepUs != 0)
+        {
+            continue;
+        }
         /*If it is Chained packet wait for 1 ms*/
-        if(poll_sof_chained_delay == 1)
+        if(nxpese_ctxt->poll_sof_chained_delay == 1)
         {
             LOG_D("%s Chained Pkt, delay read %dms",__FUNCTION__,ESE_POLL_DELAY_MS * CHAINED_PKT_SCALER);
             sm_sleep(ESE_POLL_DELAY_MS);
@@ -663,34 +683,39 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
             sm_sleep(ESE_POLL_DELAY_MS);
         }
     } while ((sof_counter < ESE_NAD_POLLING_MAX) && (nxpese_ctxt->EseLibStatus!= ESE_STATUS_CLOSE));
-    if((pBuffer[0] == RECIEVE_PACKET_SOF) && (ret > 0))
+    if(frameFound && (ret > 0))
     {
         LOG_D("%s SOF FOUND", __FUNCTION__);
-        /* Read the HEADR of one/Two bytes based on how two bytes read A5 PCB or 00 A5*/
-        ret = phPalEse_i2c_read(pDevHandle, &pBuffer[1+headerIndex], numBytesToRead);
-        if (ret < 0)
+        if (!nadError)
         {
-            LOG_D("_i2c_read() [HDR]errno : %x ret : %X", errno, ret);
+            if((pBuffer[1] == CHAINED_PACKET_WITHOUTSEQN) || (pBuffer[1] == CHAINED_PACKET_WITHSEQN))
+            {
+                nxpese_ctxt->poll_sof_chained_delay = 1;
+                LOG_D("poll_sof_chained_delay value is %d ", nxpese_ctxt->poll_sof_chained_delay);
+            }
+            else
+            {
+                nxpese_ctxt->poll_sof_chained_delay = 0;
+                LOG_D("poll_sof_chained_delay value is %d ", nxpese_ctxt->poll_sof_chained_delay);
+            }
         }
-        if((pBuffer[1] == CHAINED_PACKET_WITHOUTSEQN) || (pBuffer[1] == CHAINED_PACKET_WITHSEQN))
+#if defined(T1oI2C_UM11225)
+        frameLen = pBuffer[2];
+#elif defined(T1oI2C_GP1_0)
+        frameLen = (pBuffer[2] << 8 & 0xFF00) | (pBuffer[3] & 0xFF) ;
+#endif
+        frameLen += PH_PROTO_7816_HEADER_LEN + PH_PROTO_7816_CRC_LEN;
+        if (frameLen > nNbBytesToRead)
         {
-            poll_sof_chained_delay = 1;
-            LOG_D("poll_sof_chained_delay value is %d ", poll_sof_chained_delay);
+            LOG_E("%s Frame length %d exceeds buffer", __FUNCTION__, frameLen);
+            ret = -1;
+            goto exit;
         }
-        else
+        /* Read the rest of the data + two byte CRC*/
+        if (frameLen > bytesInBuffer)
         {
-            poll_sof_chained_delay = 0;
-            LOG_D("poll_sof_chained_delay value is %d ", poll_sof_chained_delay);
+            ret = phNxpEse_i2cRead(nxpese_ctxt, pDevHandle, &pBuffer[bytesInBuffer], (frameLen - bytesInBuffer));
         }
-#if defined(T1oI2C_UM11225)
-        total_count = 3;
-        nNbBytesToRead = pBuffer[2];
-#elif defined(T1oI2C_GP1_0)
-        total_count = 4;
-        nNbBytesToRead = (pBuffer[2] << 8 & 0xFF00) | (pBuffer[3] & 0xFF) ;
-#endif
-        /* Read the Complete data + two byte CRC*/
-        ret = phPalEse_i2c_read(pDevHandle, &pBuffer[PH_PROTO_7816_HEADER_LEN], (nNbBytesToRead+PH_PROTO_7816_CRC_LEN));
         if (ret < 0)
         {
             LOG_D("_i2c_read() [HDR]errno : %x ret : %X", errno, ret);
@@ -698,7 +723,14 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
         }
         else
         {
-            ret = (total_count + (nNbBytesToRead+PH_PROTO_7816_CRC_LEN));
+            ret = frameLen;
+            nxpese_ctxt->busStats.framesRx++;
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+            if (!nadError)
+            {
+                phNxpEsePoll_FrameReceived(&nxpese_ctxt->pollModel, pBuffer, sof_counter);
+            }
+#endif
         }
    }
    else
@@ -708,6 +740,50 @@ static int phNxpEse_readPacket(void* conn_ctx, void *pDevHandle, uint8_t * pBuff
 exit:
     return ret;
 }
+
+/******************************************************************************
+ * Function         phNxpEse_i2cRead
+ *
+ * Description      This function reads from the ESE device and counts the
+ *                  read transaction.
+ *
+ * param[in]        phNxpEse_Context_t*: ESE context
+ * param[in]        void: device handle
+ * param[in]        uint8_t: pointer to read buffer
+ * param[in]        int : number of bytes to read
+ *
+ * Returns          number of read bytes, -1 on failure
+ *
+ ******************************************************************************/
+static int phNxpEse_i2cRead(phNxpEse_Context_t* nxpese_ctxt, void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead)
+{
+    nxpese_ctxt->busStats.reads++;
+    return phPalEse_i2c_read(pDevHandle, pBuffer, nNbBytesToRead);
+}
+
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+/******************************************************************************
+ * Function         phNxpEse_i2cPoll
+ *
+ * Description      This function reads once from the ESE device, without
+ *                  retry or back off on a NACK, and counts the read
+ *                  transaction.
+ *
+ * param[in]        phNxpEse_Context_t*: ESE context
+ * param[in]        void: device handle
+ * param[in]        uint8_t: pointer to read buffer
+ * param[in]        int : number of bytes to read
+ *
+ * Returns          number of read bytes, -1 on failure
+ *
+ ******************************************************************************/
+static int phNxpEse_i2cPoll(phNxpEse_Context_t* nxpese_ctxt, void *pDevHandle, uint8_t * pBuffer, int nNbBytesToRead)
+{
+    nxpese_ctxt->busStats.reads++;
+    return phPalEse_i2c_read_poll(pDevHandle, pBuffer, nNbBytesToRead);
+}
+#endif
+
 /******************************************************************************
  * Function         phNxpEse_WriteFrame
  *
@@ -743,6 +819,7 @@ ESESTATUS phNxpEse_WriteFrame(void* conn_ctx, uint32_t data_len, const uint8_t *
                             nxpese_ctxt->p_cmd_data,
                             nxpese_ctxt->cmd_len
                             );
+        nxpese_ctxt->busStats.writes++;
         if (-1 == dwNoBytesWrRd)
         {
             LOG_E(" - Error in I2C Write.....");
@@ -755,6 +832,9 @@ ESESTATUS phNxpEse_WriteFrame(void* conn_ctx, uint32_t data_len, const uint8_t *
         else
         {
             status = ESESTATUS_SUCCESS;
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+            phNxpEsePoll_FrameSent(&nxpese_ctxt->pollModel, nxpese_ctxt->p_cmd_data, nxpese_ctxt->cmd_len);
+#endif
             LOG_MAU8_D("RAW Tx>",nxpese_ctxt->p_cmd_data, nxpese_ctxt->cmd_len );
         }
     }
@@ -768,15 +848,17 @@ ESESTATUS phNxpEse_WriteFrame(void* conn_ctx, uint32_t data_len, const uint8_t *
  *
  * Description      This function sets the IFSC size to 240/254 support JCOP OS Update.
  *
+ * param[in]        void* conn_ctx
  * param[in]        uint16_t IFSC_Size
  *
  * Returns          Always return ESESTATUS_SUCCESS (0).
  *
  ******************************************************************************/
-ESESTATUS phNxpEse_setIfsc(uint16_t IFSC_Size)
+ESESTATUS phNxpEse_setIfsc(void* conn_ctx, uint16_t IFSC_Size)
 {
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
     /*SET the IFSC size to 240 bytes*/
-    phNxpEseProto7816_SetIfscSize(IFSC_Size);
+    phNxpEseProto7816_SetIfscSize((void*)nxpese_ctxt, IFSC_Size);
     return ESESTATUS_SUCCESS;
 }
 
@@ -898,6 +980,117 @@ ESESTATUS phNxpEse_getCip(void* conn_ctx, phNxpEse_data *pRsp)
 }
 #endif
 
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+/******************************************************************************
+ * Function         phNxpEse_dumpPollStats
+ *
+ * Description      This function logs predicted vs. observed SE processing
+ *                  time for each command class seen on this connection.
+ *
+ * param[in]        void*: connection context
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEse_dumpPollStats(void* conn_ctx)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    phNxpEsePoll_DumpStats(&nxpese_ctxt->pollModel);
+}
+
+/******************************************************************************
+ * Function         phNxpEse_resetPollModel
+ *
+ * Description      This function forgets the learned SE processing times of
+ *                  this connection. Until the model has learned again, the
+ *                  reader polls every ESE_POLL_DELAY_MS.
+ *
+ * param[in]        void*: connection context
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEse_resetPollModel(void* conn_ctx)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    phNxpEse_memset(&nxpese_ctxt->pollModel, 0x00, sizeof(nxpese_ctxt->pollModel));
+}
+#endif
+
+/******************************************************************************
+ * Function         phNxpEse_getBusStats
+ *
+ * Description      This function returns the I2C transaction counters of
+ *                  this connection.
+ *
+ * param[in]        void*: connection context
+ * param[out]       phNxpEse_BusStats_t: counters
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEse_getBusStats(void* conn_ctx, phNxpEse_BusStats_t *pStats)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    if (pStats != NULL) {
+        *pStats = nxpese_ctxt->busStats;
+    }
+}
+
+/******************************************************************************
+ * Function         phNxpEse_resetBusStats
+ *
+ * Description      This function clears the I2C transaction counters of
+ *                  this connection.
+ *
+ * param[in]        void*: connection context
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEse_resetBusStats(void* conn_ctx)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    phNxpEse_memset(&nxpese_ctxt->busStats, 0x00, sizeof(nxpese_ctxt->busStats));
+}
+
+/******************************************************************************
+ * Function         phNxpEse_dumpBusStats
+ *
+ * Description      This function logs the I2C transactions per APDU and per
+ *                  frame of this connection.
+ *
+ * param[in]        void*: connection context
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+void phNxpEse_dumpBusStats(void* conn_ctx)
+{
+    phNxpEse_Context_t* nxpese_ctxt = (conn_ctx == NULL) ? &gnxpese_ctxt : (phNxpEse_Context_t*)conn_ctx;
+    phNxpEse_BusStats_t stats;
+    uint32_t transactions;
+    uint32_t frames;
+
+    phNxpEse_getBusStats(conn_ctx, &stats);
+    transactions = stats.reads + stats.writes;
+    frames = stats.framesRx + stats.writes;
+    LOG_I("T=1oI2C bus: IFSC %u, %u APDUs, %u frames received, %u reads (%u empty polls), %u writes",
+        phNxpEseProto7816_GetIfscSize((void*)nxpese_ctxt), stats.apdus, stats.framesRx, stats.reads,
+        stats.emptyPolls, stats.writes);
+    if (stats.apdus > 0) {
+        LOG_I("T=1oI2C bus: %u.%02u transactions/APDU",
+            transactions / stats.apdus, ((transactions % stats.apdus) * 100) / stats.apdus);
+        LOG_I("T=1oI2C bus: %u.%02u frames/APDU (sent and received)",
+            frames / stats.apdus, ((frames % stats.apdus) * 100) / stats.apdus);
+    }
+    if (stats.framesRx > 0) {
+        LOG_I("T=1oI2C bus: %u.%02u reads/frame without empty polls",
+            (stats.reads - stats.emptyPolls) / stats.framesRx,
+            (((stats.reads - stats.emptyPolls) % stats.framesRx) * 100) / stats.framesRx);
+    }
+}
+
 /******************************************************************************
  * Function         phNxpEse_deepPwrDown
  *
@@ -44,6 +44,20 @@ typedef struct phNxpEse_initParams
     phNxpEse_initMode initMode; /*!< Ese communication mode */
 } phNxpEse_initParams;
 
+/**
+ *
+ * \brief I2C transaction counters of one connection
+ *
+ */
+typedef struct phNxpEse_BusStats
+{
+    uint32_t apdus;      /*!< APDUs exchanged */
+    uint32_t framesRx;   /*!< Frames received */
+    uint32_t reads;      /*!< I2C read transactions, including polls */
+    uint32_t emptyPolls; /*!< Reads that found no frame start */
+    uint32_t writes;     /*!< I2C write transactions, one per frame sent */
+} phNxpEse_BusStats_t;
+
 
 ESESTATUS phNxpEse_init(void *conn_ctx, phNxpEse_initParams initParams, phNxpEse_data *AtrRsp);
 ESESTATUS phNxpEse_open(void **conn_ctx, phNxpEse_initParams initParams, const char *pConnString);
@@ -52,7 +66,7 @@ ESESTATUS phNxpEse_deInit(void* conn_ctx);
 ESESTATUS phNxpEse_close(void* conn_ctx);
 ESESTATUS phNxpEse_reset(void* conn_ctx);
 ESESTATUS phNxpEse_chipReset(void* conn_ctx);
-ESESTATUS phNxpEse_setIfsc(uint16_t IFSC_Size);
+ESESTATUS phNxpEse_setIfsc(void* conn_ctx, uint16_t IFSC_Size);
 ESESTATUS phNxpEse_EndOfApdu(void* conn_ctx);
 void* phNxpEse_memset(void *buff, int val, size_t len);
 void* phNxpEse_memcpy(void *dest, const void *src, size_t len);
@@ -61,5 +75,12 @@ void phNxpEse_free(void* ptr);
 ESESTATUS phNxpEse_getAtr(void* conn_ctx, phNxpEse_data *pRsp);
 ESESTATUS phNxpEse_getCip(void* conn_ctx, phNxpEse_data *pRsp);
 ESESTATUS phNxpEse_deepPwrDown(void* conn_ctx);
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+void phNxpEse_dumpPollStats(void* conn_ctx);
+void phNxpEse_resetPollModel(void* conn_ctx);
+#endif
+void phNxpEse_getBusStats(void* conn_ctx, phNxpEse_BusStats_t *pStats);
+void phNxpEse_resetBusStats(void* conn_ctx);
+void phNxpEse_dumpBusStats(void* conn_ctx);
 /** @} */
 #endif /* _PHNXPESE_API_H_ */
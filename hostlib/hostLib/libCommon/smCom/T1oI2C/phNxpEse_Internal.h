@@ -7,7 +7,11 @@
 #define _PHNXPESE_INTERNAL_H_
 
 #include <phNxpEse_Api.h>
+#include <phNxpEseProto7816_3.h>
 #include <i2c_a7.h>
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+#include <phNxpEsePoll.h>
+#endif
 
 #ifdef T1oI2C_UM1225_SE050
 /* MW version 02.13.00 onwards */
@@ -35,8 +39,16 @@ typedef struct phNxpEse_Context
     uint16_t cmd_len;
     uint8_t p_cmd_data[MAX_DATA_LEN];
     phNxpEse_initParams initParams;
+    phNxpEseProto7816_t proto7816;          /* T=1 protocol stack instance of this connection */
+    int poll_sof_chained_delay;             /* Last received frame was chained */
+    phNxpEse_BusStats_t busStats;           /* I2C transactions on this connection */
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+    phNxpEsePoll_Model_t pollModel;         /* Learned SE processing time per command class */
+#endif
 } phNxpEse_Context_t;
 
+/* Context used when no connection context is passed (single session) */
+extern phNxpEse_Context_t gnxpese_ctxt;
 
 ESESTATUS phNxpEse_WriteFrame(void* conn_ctx, uint32_t data_len, const uint8_t *p_data);
 ESESTATUS phNxpEse_read(void* conn_ctx, uint32_t *data_len, uint8_t **pp_data);
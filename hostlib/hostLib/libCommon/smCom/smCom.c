@@ -9,8 +9,15 @@
  * Implements installable communication layer to exchange APDU's between Host and Secure Module.
  * Allows the top half of the Host Library to be independent of the actual interconnect
  * between Host and Secure Module
+ *
+ * On hosts with pthreads, access to each device is granted by a scheduler:
+ * requests are queued per priority class and served first by class, then in
+ * arrival order. A lower class waiting too long is served ahead of higher
+ * classes (see ::SMCOM_SCHED_AGING_LIMIT), so background traffic is delayed
+ * but never starved.
  */
 #include <stdio.h>
+#include <string.h>
 #include "smCom.h"
 #include "nxLog_smCom.h"
 
@@ -34,9 +41,17 @@ static SemaphoreHandle_t gSmComlock;
 static SemaphoreHandle_t gSmComNoSessions;
 #elif (__GNUC__ && !AX_EMBEDDED)
 #include<pthread.h>
-    /* Only for base session with os */
-    static pthread_mutex_t gSmComlock;
+#include <errno.h>
+#include <time.h>
+#include "sm_timer.h"
+    /* Protects the scheduler state, only held for queue bookkeeping */
+    static pthread_mutex_t gSmComlock = PTHREAD_MUTEX_INITIALIZER;
     static pthread_mutex_t gSmComNoSessions = PTHREAD_MUTEX_INITIALIZER;
+#define SMCOM_USE_SCHEDULER 1
+#endif
+
+#ifndef SMCOM_USE_SCHEDULER
+#define SMCOM_USE_SCHEDULER 0
 #endif
 
 #if (__GNUC__ && !AX_EMBEDDED) || (USE_RTOS) || defined(USE_THREADX_RTOS)
@@ -79,20 +94,8 @@ uint8_t g_no_of_session = 0;
     else {                                      \
         LOG_D("LOCK Releasing failed");         \
     }
-#elif (__GNUC__ && !AX_EMBEDDED)
-#define LOCK_TXN()                                               \
-    LOG_D("Trying to Acquire Lock thread: %ld", pthread_self()); \
-    if (pthread_mutex_lock(&gSmComlock) != 0) {                  \
-        LOG_W("pthread_mutex_lock failed");                      \
-    }                                                            \
-    LOG_D("LOCK Acquired by thread: %ld", pthread_self());
-
-#define UNLOCK_TXN()                                                 \
-    LOG_D("Trying to Released Lock by thread: %ld", pthread_self()); \
-    if (pthread_mutex_unlock(&gSmComlock) != 0) {                    \
-        LOG_W("pthread_mutex_unlock failed");                        \
-    }                                                                \
-    LOG_D("LOCK Released by thread: %ld", pthread_self());
+#elif SMCOM_USE_SCHEDULER
+/* Device access is granted by smCom_SchedAcquire() / smCom_SchedRelease() */
 #else
 #define LOCK_TXN() LOG_D("no lock mode");
 #define UNLOCK_TXN() LOG_D("no lock mode");
@@ -141,6 +144,313 @@ uint8_t g_no_of_session = 0;
 static ApduTransceiveFunction_t pSmCom_Transceive = NULL;
 static ApduTransceiveRawFunction_t pSmCom_TransceiveRaw = NULL;
 
+#if SMCOM_USE_SCHEDULER
+
+/* Request waiting for a device, lives on the stack of the waiting thread */
+typedef struct smCom_SchedWaiter
+{
+    pthread_cond_t cond;
+    pthread_t thread;
+    int granted;
+    uint64_t enqueuedUs;
+    struct smCom_SchedWaiter *pNext;
+} smCom_SchedWaiter_t;
+
+typedef struct
+{
+    void *conn_ctx;
+    int used;
+    int busy;          /* Device granted to owner */
+    pthread_t owner;
+    U32 depth;         /* Nesting of owner (atomic sections and APDUs within them) */
+    smCom_SchedWaiter_t *pHead[SMCOM_PRIO_CLASSES];
+    smCom_SchedWaiter_t *pTail[SMCOM_PRIO_CLASSES];
+    U32 bypassed[SMCOM_PRIO_CLASSES]; /* Grants to higher classes while this class was waiting */
+    smCom_SchedStats_t stats;
+} smCom_SchedDevice_t;
+
+static smCom_SchedDevice_t gSmComSched[SMCOM_SCHED_MAX_DEVICES];
+
+static __thread smCom_Priority_t gSmComThreadPrio = SMCOM_PRIO_NORMAL;
+static __thread U32 gSmComThreadDeadlineMs        = 0;
+
+/* Called with gSmComlock held. Returns NULL if the device has no slot. */
+static smCom_SchedDevice_t *smCom_SchedFind(void *conn_ctx)
+{
+    int i;
+
+    for (i = 0; i < SMCOM_SCHED_MAX_DEVICES; i++) {
+        if (gSmComSched[i].used && (gSmComSched[i].conn_ctx == conn_ctx)) {
+            return &gSmComSched[i];
+        }
+    }
+    return NULL;
+}
+
+/* Called with gSmComlock held. Takes a free slot for a new device, returns
+ * NULL if the table is full. */
+static smCom_SchedDevice_t *smCom_SchedLookup(void *conn_ctx)
+{
+    smCom_SchedDevice_t *pDev = smCom_SchedFind(conn_ctx);
+    int i;
+
+    if (pDev != NULL) {
+        return pDev;
+    }
+    for (i = 0; i < SMCOM_SCHED_MAX_DEVICES; i++) {
+        if (!gSmComSched[i].used) {
+            pDev           = &gSmComSched[i];
+            pDev->used     = 1;
+            pDev->conn_ctx = conn_ctx;
+            return pDev;
+        }
+    }
+    return NULL;
+}
+
+static int smCom_SchedHasWaiters(smCom_SchedDevice_t *pDev)
+{
+    int prio;
+    for (prio = 0; prio < SMCOM_PRIO_CLASSES; prio++) {
+        if (pDev->pHead[prio] != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Dequeue the request to be served next. Called with gSmComlock held. */
+static smCom_SchedWaiter_t *smCom_SchedNext(smCom_SchedDevice_t *pDev)
+{
+    smCom_SchedWaiter_t *pWaiter = NULL;
+    int selected                 = -1;
+    int prio;
+
+    /* Classes that were passed over too often go first */
+    for (prio = 0; prio < SMCOM_PRIO_CLASSES; prio++) {
+        if ((pDev->pHead[prio] != NULL) && (pDev->bypassed[prio] >= SMCOM_SCHED_AGING_LIMIT)) {
+            selected = prio;
+            break;
+        }
+    }
+    if (selected < 0) {
+        for (prio = 0; prio < SMCOM_PRIO_CLASSES; prio++) {
+            if (pDev->pHead[prio] != NULL) {
+                selected = prio;
+                break;
+            }
+        }
+    }
+    if (selected < 0) {
+        return NULL;
+    }
+
+    pWaiter               = pDev->pHead[selected];
+    pDev->pHead[selected] = pWaiter->pNext;
+    if (pDev->pHead[selected] == NULL) {
+        pDev->pTail[selected] = NULL;
+    }
+    pDev->stats.prio[selected].queueDepth--;
+    pDev->bypassed[selected] = 0;
+    for (prio = selected + 1; prio < SMCOM_PRIO_CLASSES; prio++) {
+        if (pDev->pHead[prio] != NULL) {
+            pDev->bypassed[prio]++;
+        }
+    }
+    return pWaiter;
+}
+
+/* Called with gSmComlock held, after a timeout */
+static void smCom_SchedRemove(smCom_SchedDevice_t *pDev, smCom_Priority_t prio, smCom_SchedWaiter_t *pWaiter)
+{
+    smCom_SchedWaiter_t *pPrev = NULL;
+    smCom_SchedWaiter_t *pIter = pDev->pHead[prio];
+
+    while ((pIter != NULL) && (pIter != pWaiter)) {
+        pPrev = pIter;
+        pIter = pIter->pNext;
+    }
+    if (pIter == NULL) {
+        return;
+    }
+    if (pPrev == NULL) {
+        pDev->pHead[prio] = pWaiter->pNext;
+    }
+    else {
+        pPrev->pNext = pWaiter->pNext;
+    }
+    if (pDev->pTail[prio] == pWaiter) {
+        pDev->pTail[prio] = pPrev;
+    }
+    pDev->stats.prio[prio].queueDepth--;
+}
+
+static U32 smCom_SchedAcquire(void *conn_ctx)
+{
+    U32 ret                          = SMCOM_OK;
+    smCom_Priority_t prio            = gSmComThreadPrio;
+    U32 deadlineMs                   = gSmComThreadDeadlineMs;
+    smCom_SchedDevice_t *pDev        = NULL;
+    smCom_SchedClassStats_t *pStats  = NULL;
+    smCom_SchedWaiter_t waiter;
+    struct timespec deadline;
+    uint64_t waitUs;
+
+    if (pthread_mutex_lock(&gSmComlock) != 0) {
+        LOG_W("pthread_mutex_lock failed");
+    }
+    pDev = smCom_SchedLookup(conn_ctx);
+    if (pDev == NULL) {
+        ret = SMCOM_NO_DEVICE_SLOT;
+        goto exit;
+    }
+    pStats = &pDev->stats.prio[prio];
+
+    if (pDev->busy && pthread_equal(pDev->owner, pthread_self())) {
+        /* Nested in an atomic section of this thread */
+        pDev->depth++;
+        goto exit;
+    }
+    if (!pDev->busy && !smCom_SchedHasWaiters(pDev)) {
+        pDev->busy  = 1;
+        pDev->owner = pthread_self();
+        pDev->depth = 1;
+        pStats->granted++;
+        goto exit;
+    }
+
+    memset(&waiter, 0, sizeof(waiter));
+    pthread_cond_init(&waiter.cond, NULL);
+    waiter.thread     = pthread_self();
+    waiter.enqueuedUs = sm_get_time_us();
+    if (pDev->pTail[prio] != NULL) {
+        pDev->pTail[prio]->pNext = &waiter;
+    }
+    else {
+        pDev->pHead[prio] = &waiter;
+    }
+    pDev->pTail[prio] = &waiter;
+    pStats->queueDepth++;
+    if (pStats->queueDepth > pStats->maxQueueDepth) {
+        pStats->maxQueueDepth = pStats->queueDepth;
+    }
+
+    if (deadlineMs > 0) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += deadlineMs / 1000;
+        deadline.tv_nsec += (long)(deadlineMs % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    /* The releasing thread hands the device over by setting granted */
+    while (!waiter.granted) {
+        if (deadlineMs > 0) {
+            if ((pthread_cond_timedwait(&waiter.cond, &gSmComlock, &deadline) == ETIMEDOUT) && !waiter.granted) {
+                smCom_SchedRemove(pDev, prio, &waiter);
+                pStats->deadlineMissed++;
+                ret = SMCOM_DEADLINE_MISSED;
+                break;
+            }
+        }
+        else {
+            pthread_cond_wait(&waiter.cond, &gSmComlock);
+        }
+    }
+    pthread_cond_destroy(&waiter.cond);
+
+    if (ret == SMCOM_OK) {
+        waitUs = sm_get_time_us() - waiter.enqueuedUs;
+        pStats->granted++;
+        pStats->totalWaitUs += waitUs;
+        if (waitUs > pStats->maxWaitUs) {
+            pStats->maxWaitUs = waitUs;
+        }
+    }
+
+exit:
+    if (pthread_mutex_unlock(&gSmComlock) != 0) {
+        LOG_W("pthread_mutex_unlock failed");
+    }
+    if (ret == SMCOM_DEADLINE_MISSED) {
+        LOG_W("smCom: device not granted within %ums", deadlineMs);
+    }
+    else if (ret == SMCOM_NO_DEVICE_SLOT) {
+        LOG_E("smCom: more than %d devices open", SMCOM_SCHED_MAX_DEVICES);
+    }
+    return ret;
+}
+
+static void smCom_SchedRelease(void *conn_ctx)
+{
+    smCom_SchedDevice_t *pDev    = NULL;
+    smCom_SchedWaiter_t *pWaiter = NULL;
+
+    if (pthread_mutex_lock(&gSmComlock) != 0) {
+        LOG_W("pthread_mutex_lock failed");
+    }
+    pDev = smCom_SchedFind(conn_ctx);
+    if ((pDev == NULL) || !pDev->busy || !pthread_equal(pDev->owner, pthread_self())) {
+        LOG_W("smCom: device released by thread not owning it");
+        goto exit;
+    }
+    pDev->depth--;
+    if (pDev->depth > 0) {
+        goto exit;
+    }
+
+    pWaiter = smCom_SchedNext(pDev);
+    if (pWaiter != NULL) {
+        pDev->owner     = pWaiter->thread;
+        pDev->depth     = 1;
+        pWaiter->granted = 1;
+        pthread_cond_signal(&pWaiter->cond);
+    }
+    else {
+        pDev->busy = 0;
+    }
+
+exit:
+    if (pthread_mutex_unlock(&gSmComlock) != 0) {
+        LOG_W("pthread_mutex_unlock failed");
+    }
+}
+
+#endif // SMCOM_USE_SCHEDULER
+
+/* The idle work belongs to the thread that sends the command, the
+ * communication layer runs on that same thread while it waits. */
+#if (__GNUC__ && !AX_EMBEDDED)
+static __thread smCom_IdleWork_t gSmComIdleWork = NULL;
+static __thread void *gSmComIdleWorkCtx         = NULL;
+#else
+static smCom_IdleWork_t gSmComIdleWork = NULL;
+static void *gSmComIdleWorkCtx         = NULL;
+#endif
+
+static U32 smCom_Lock(void *conn_ctx)
+{
+#if SMCOM_USE_SCHEDULER
+    return smCom_SchedAcquire(conn_ctx);
+#else
+    AX_UNUSED_ARG(conn_ctx);
+    LOCK_TXN();
+    return SMCOM_OK;
+#endif
+}
+
+static void smCom_Unlock(void *conn_ctx)
+{
+#if SMCOM_USE_SCHEDULER
+    smCom_SchedRelease(conn_ctx);
+#else
+    AX_UNUSED_ARG(conn_ctx);
+    UNLOCK_TXN();
+#endif
+}
+
 /**
  * Install interconnect and protocol specific implementation of APDU transfer functions.
  *
@@ -171,12 +481,6 @@ U16 smCom_Init(ApduTransceiveFunction_t pTransceive, ApduTransceiveRawFunction_t
             LOG_E("\n xSemaphoreCreateMutex failed");
             return ret;
         }
-    #elif (__GNUC__ && !AX_EMBEDDED)
-        if (pthread_mutex_init(&gSmComlock, NULL) != 0)
-        {
-            LOG_E("\n mutex init has failed");
-            return ret;
-        }
     #endif
         pSmCom_Transceive = pTransceive;
         pSmCom_TransceiveRaw = pTransceiveRaw;
@@ -207,10 +511,15 @@ void smCom_DeInit(void)
             vSemaphoreDelete(gSmComlock);
             gSmComlock = NULL;
         }
-#elif (__GNUC__ && !AX_EMBEDDED)
-        if (pthread_mutex_destroy(&gSmComlock) != 0) {
-            return;
+#elif SMCOM_USE_SCHEDULER
+        int i;
+        pthread_mutex_lock(&gSmComlock);
+        for (i = 0; i < SMCOM_SCHED_MAX_DEVICES; i++) {
+            if (!gSmComSched[i].busy && !smCom_SchedHasWaiters(&gSmComSched[i])) {
+                memset(&gSmComSched[i], 0, sizeof(gSmComSched[i]));
+            }
         }
+        pthread_mutex_unlock(&gSmComlock);
 #endif
     }
 
@@ -225,15 +534,19 @@ void smCom_DeInit(void)
  * @retval ::SMCOM_OK          Operation successful
  * @retval ::SMCOM_SND_FAILED  Send Failed
  * @retval ::SMCOM_RCV_FAILED  Receive Failed
+ * @retval ::SMCOM_DEADLINE_MISSED  Device not granted in time, nothing sent
  */
 U32 smCom_Transceive(void *conn_ctx, apdu_t * pApdu)
 {
     U32 ret = SMCOM_NO_PRIOR_INIT;
     if (pSmCom_Transceive != NULL)
     {
-        LOCK_TXN();
+        ret = smCom_Lock(conn_ctx);
+        if (ret != SMCOM_OK) {
+            return ret;
+        }
         ret = pSmCom_Transceive(conn_ctx, pApdu);
-        UNLOCK_TXN();
+        smCom_Unlock(conn_ctx);
     }
     return ret;
 }
@@ -249,19 +562,150 @@ U32 smCom_Transceive(void *conn_ctx, apdu_t * pApdu)
  * @retval ::SMCOM_OK          Operation successful
  * @retval ::SMCOM_SND_FAILED  Send Failed
  * @retval ::SMCOM_RCV_FAILED  Receive Failed
+ * @retval ::SMCOM_DEADLINE_MISSED  Device not granted in time, nothing sent
  */
 U32 smCom_TransceiveRaw(void *conn_ctx, U8 * pTx, U16 txLen, U8 * pRx, U32 * pRxLen)
 {
     U32 ret = SMCOM_NO_PRIOR_INIT;
     if (pSmCom_TransceiveRaw != NULL)
     {
-        LOCK_TXN();
+        ret = smCom_Lock(conn_ctx);
+        if (ret != SMCOM_OK) {
+            return ret;
+        }
         ret = pSmCom_TransceiveRaw(conn_ctx, pTx, txLen, pRx, pRxLen);
-        UNLOCK_TXN();
+        smCom_Unlock(conn_ctx);
     }
     return ret;
 }
 
+void smCom_SetPriority(smCom_Priority_t prio, U32 deadlineMs)
+{
+#if SMCOM_USE_SCHEDULER
+    if ((prio < SMCOM_PRIO_HIGH) || (prio >= SMCOM_PRIO_CLASSES)) {
+        LOG_W("smCom: invalid priority class %d", prio);
+        prio = SMCOM_PRIO_NORMAL;
+    }
+    gSmComThreadPrio       = prio;
+    gSmComThreadDeadlineMs = deadlineMs;
+#else
+    AX_UNUSED_ARG(prio);
+    AX_UNUSED_ARG(deadlineMs);
+#endif
+}
+
+void smCom_SetIdleWork(smCom_IdleWork_t fn, void *ctx)
+{
+    gSmComIdleWork    = fn;
+    gSmComIdleWorkCtx = (fn != NULL) ? ctx : NULL;
+}
+
+void smCom_RunIdleWork(void)
+{
+    smCom_IdleWork_t fn = gSmComIdleWork;
+    void *ctx           = gSmComIdleWorkCtx;
+
+    if (fn != NULL) {
+        /* Cleared first, the work may exchange APDUs of its own */
+        gSmComIdleWork    = NULL;
+        gSmComIdleWorkCtx = NULL;
+        fn(ctx);
+    }
+}
+
+U32 smCom_BeginAtomic(void *conn_ctx)
+{
+#if SMCOM_USE_SCHEDULER
+    return smCom_SchedAcquire(conn_ctx);
+#else
+    /* Without scheduler, sequences are not protected */
+    AX_UNUSED_ARG(conn_ctx);
+    return SMCOM_OK;
+#endif
+}
+
+void smCom_EndAtomic(void *conn_ctx)
+{
+#if SMCOM_USE_SCHEDULER
+    smCom_SchedRelease(conn_ctx);
+#else
+    AX_UNUSED_ARG(conn_ctx);
+#endif
+}
+
+void smCom_ReleaseDevice(void *conn_ctx)
+{
+#if SMCOM_USE_SCHEDULER
+    smCom_SchedDevice_t *pDev = NULL;
+
+    pthread_mutex_lock(&gSmComlock);
+    pDev = smCom_SchedFind(conn_ctx);
+    if (pDev != NULL) {
+        if (pDev->busy || smCom_SchedHasWaiters(pDev)) {
+            /* Kept, the slot is still in use */
+            LOG_W("smCom: device closed while in use");
+        }
+        else {
+            memset(pDev, 0, sizeof(*pDev));
+        }
+    }
+    pthread_mutex_unlock(&gSmComlock);
+#else
+    AX_UNUSED_ARG(conn_ctx);
+#endif
+}
+
+U32 smCom_GetSchedStats(void *conn_ctx, smCom_SchedStats_t *pStats)
+{
+    U32 ret = SMCOM_NO_PRIOR_INIT;
+#if SMCOM_USE_SCHEDULER
+    smCom_SchedDevice_t *pDev = NULL;
+#endif
+
+    if (pStats == NULL) {
+        return SMCOM_NO_PRIOR_INIT;
+    }
+#if SMCOM_USE_SCHEDULER
+    memset(pStats, 0, sizeof(*pStats));
+    pthread_mutex_lock(&gSmComlock);
+    pDev = smCom_SchedFind(conn_ctx);
+    if (pDev != NULL) {
+        *pStats = pDev->stats;
+        ret     = SMCOM_OK;
+    }
+    pthread_mutex_unlock(&gSmComlock);
+    return ret;
+#else
+    AX_UNUSED_ARG(conn_ctx);
+    memset(pStats, 0, sizeof(*pStats));
+    return ret;
+#endif
+}
+
+void smCom_DumpSchedStats(void *conn_ctx)
+{
+    static const char *const className[SMCOM_PRIO_CLASSES] = {"high", "normal", "low"};
+    smCom_SchedStats_t stats;
+    int prio;
+
+    if (smCom_GetSchedStats(conn_ctx, &stats) != SMCOM_OK) {
+        return;
+    }
+    LOG_I("smCom scheduler (times in us):");
+    LOG_I("class    queued max.queued    granted  missed   wait.avg   wait.max");
+    for (prio = 0; prio < SMCOM_PRIO_CLASSES; prio++) {
+        smCom_SchedClassStats_t *pClass = &stats.prio[prio];
+        LOG_I("%-8s %6u %10u %10u %7u %10lu %10lu",
+            className[prio],
+            pClass->queueDepth,
+            pClass->maxQueueDepth,
+            pClass->granted,
+            pClass->deadlineMissed,
+            (unsigned long)(pClass->granted ? (pClass->totalWaitUs / pClass->granted) : 0),
+            (unsigned long)pClass->maxWaitUs);
+    }
+}
+
 #if defined(SMCOM_JRCP_V2)
 void smCom_Echo(void *conn_ctx, const char *comp, const char *level, const char *buffer)
 {
@@ -272,8 +716,10 @@ void smCom_Echo(void *conn_ctx, const char *comp, const char *level, const char
         return;
     }
 #endif
-    LOCK_TXN();
+    if (smCom_Lock(conn_ctx) != SMCOM_OK) {
+        return;
+    }
     smComJRCP_Echo(conn_ctx, comp, level, buffer);
-    UNLOCK_TXN();
+    smCom_Unlock(conn_ctx);
 }
 #endif
\ No newline at end of file
@@ -28,9 +28,45 @@ extern "C" {
 #define SMCOM_NO_PRIOR_INIT   0x7015  //!< The callbacks doing the actual transfer have not been installed
 #define SMCOM_COM_ALREADY_OPEN      0x7016  //!< Communication link is already open with device
 #define SMCOM_COM_INIT_FAILED       0x7017  //!< Communication init failed
+#define SMCOM_DEADLINE_MISSED       0x7018  //!< Device not granted before the deadline of the calling thread
+#define SMCOM_NO_DEVICE_SLOT        0x7019  //!< Scheduler table full, see ::SMCOM_SCHED_MAX_DEVICES
 #define SMCOM_ERR_APDU_THROUGHPUT   0x66A6  //!< APDU Limit error code
 
 
+/** Maximum number of devices (connection contexts) open at the same time.
+ * Requests to further devices fail with ::SMCOM_NO_DEVICE_SLOT. */
+#define SMCOM_SCHED_MAX_DEVICES     8
+
+/** A waiting request is served at the latest after this many requests of
+ * higher priority classes were served ahead of it. */
+#define SMCOM_SCHED_AGING_LIMIT     4
+
+/** Priority class of the requests of a thread, see ::smCom_SetPriority */
+typedef enum
+{
+    SMCOM_PRIO_HIGH = 0,    //!< Latency critical, e.g. TLS handshake
+    SMCOM_PRIO_NORMAL,      //!< Default
+    SMCOM_PRIO_LOW,         //!< Background, e.g. provisioning, key generation, DeleteAll
+    SMCOM_PRIO_CLASSES
+} smCom_Priority_t;
+
+/** Counters of one priority class of one device */
+typedef struct
+{
+    U32 queueDepth;      //!< Requests waiting right now
+    U32 maxQueueDepth;   //!< Highest number of waiting requests seen
+    U32 granted;         //!< Requests that got the device
+    U32 deadlineMissed;  //!< Requests that gave up waiting
+    uint64_t totalWaitUs;     //!< Sum of the wait times of granted requests
+    uint64_t maxWaitUs;       //!< Longest wait time of a granted request
+} smCom_SchedClassStats_t;
+
+/** Counters of one device, indexed by ::smCom_Priority_t */
+typedef struct
+{
+    smCom_SchedClassStats_t prio[SMCOM_PRIO_CLASSES];
+} smCom_SchedStats_t;
+
 /* ------------------------------------------------------------------------- */
 typedef U32 (*ApduTransceiveFunction_t) (void* conn_ctx, apdu_t * pAdpu);
 typedef U32 (*ApduTransceiveRawFunction_t) (void* conn_ctx, U8 * pTx, U16 txLen, U8 * pRx, U32 * pRxLen);
@@ -40,6 +76,57 @@ void smCom_DeInit(void);
 U32 smCom_Transceive(void *conn_ctx, apdu_t *pApdu);
 U32 smCom_TransceiveRaw(void *conn_ctx, U8 *pTx, U16 txLen, U8 *pRx, U32 *pRxLen);
 
+/**
+ * Set priority class and deadline of the requests of the calling thread.
+ *
+ * Requests of a higher class are served first, requests of one class in
+ * arrival order. With a deadline, a request that did not get the device within
+ * deadlineMs fails with ::SMCOM_DEADLINE_MISSED without being sent.
+ *
+ * @param[in] prio        Priority class
+ * @param[in] deadlineMs  Maximum wait time per request, 0 for no deadline
+ */
+void smCom_SetPriority(smCom_Priority_t prio, U32 deadlineMs);
+
+/**
+ * Reserve the device for a sequence of APDUs of the calling thread, e.g. all
+ * chunks of one update call. Other threads are queued until
+ * ::smCom_EndAtomic and are served between two sequences. Calls can be nested.
+ * End the sequence before returning to the application, do not keep the
+ * device across calls.
+ *
+ * @retval ::SMCOM_OK               Device reserved
+ * @retval ::SMCOM_DEADLINE_MISSED  Device not granted in time, do not call ::smCom_EndAtomic
+ */
+U32 smCom_BeginAtomic(void *conn_ctx);
+void smCom_EndAtomic(void *conn_ctx);
+
+/** Work of the calling thread that can run while the Secure Module processes a command */
+typedef void (*smCom_IdleWork_t)(void *ctx);
+
+/**
+ * Hand work to the communication layer to run while it waits for the
+ * response to the next command of the calling thread, e.g. to precompute
+ * secure channel IVs. The work runs at most once, after the command is sent
+ * and before polling for the response. Layers that do not poll never run it,
+ * so clear it with fn = NULL after the exchange.
+ *
+ * @param[in] fn   Work to run, NULL to clear
+ * @param[in] ctx  Passed to fn
+ */
+void smCom_SetIdleWork(smCom_IdleWork_t fn, void *ctx);
+
+/** Run and clear the idle work of the calling thread. Called by the communication layers. */
+void smCom_RunIdleWork(void);
+
+/** Give back the scheduler slot of a device, called when its connection is closed */
+void smCom_ReleaseDevice(void *conn_ctx);
+
+/** Read the scheduler counters of one device */
+U32 smCom_GetSchedStats(void *conn_ctx, smCom_SchedStats_t *pStats);
+/** Log the scheduler counters of one device */
+void smCom_DumpSchedStats(void *conn_ctx);
+
 #if defined(SMCOM_JRCP_V2)
 void smCom_Echo(void *conn_ctx, const char *comp, const char *level, const char *buffer);
 #endif
@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @par Description
+ * Asynchronous APDU submission: per connection worker thread driving
+ * ::smCom_Transceive / ::smCom_TransceiveRaw, or running queued functions.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "smComAsync.h"
+#include "nxLog_smCom.h"
+#include "nxEnsure.h"
+
+#if (__GNUC__ && !AX_EMBEDDED)
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+struct smComAsync_Worker
+{
+    void *conn_ctx;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t queued;    /* Signalled on submit and stop */
+    pthread_cond_t completed; /* Broadcast on every completion */
+    smComAsync_Request_t *pHead;
+    smComAsync_Request_t *pTail;
+    int stop;
+    int eventFd;
+};
+
+static void smComAsync_Complete(smComAsync_Worker_t *pWorker, smComAsync_Request_t *pReq, U32 status)
+{
+    /* Waiters only read status once done is set */
+    pReq->status = status;
+    if (pReq->callback != NULL) {
+        pReq->callback(pReq, pReq->userCtx);
+    }
+
+    /* Once done is set, a waiting thread may free the request */
+    pthread_mutex_lock(&pWorker->lock);
+    pReq->done = 1;
+    pthread_cond_broadcast(&pWorker->completed);
+    pthread_mutex_unlock(&pWorker->lock);
+
+#if defined(__linux__)
+    if (pWorker->eventFd >= 0) {
+        uint64_t one = 1;
+        if (write(pWorker->eventFd, &one, sizeof(one)) != sizeof(one)) {
+            LOG_W("smComAsync: eventfd write failed");
+        }
+    }
+#endif
+}
+
+static void *smComAsync_Thread(void *arg)
+{
+    smComAsync_Worker_t *pWorker = (smComAsync_Worker_t *)arg;
+    smComAsync_Request_t *pReq   = NULL;
+    U32 status;
+
+    for (;;) {
+        pthread_mutex_lock(&pWorker->lock);
+        while ((pWorker->pHead == NULL) && (!pWorker->stop)) {
+            pthread_cond_wait(&pWorker->queued, &pWorker->lock);
+        }
+        if (pWorker->stop) {
+            pthread_mutex_unlock(&pWorker->lock);
+            break;
+        }
+        pReq           = pWorker->pHead;
+        pWorker->pHead = pReq->pNext;
+        if (pWorker->pHead == NULL) {
+            pWorker->pTail = NULL;
+        }
+        pthread_mutex_unlock(&pWorker->lock);
+
+        if (pReq->fn != NULL) {
+            status = pReq->fn(pReq->fnCtx);
+        }
+        else if (pReq->pApdu != NULL) {
+            status = smCom_Transceive(pWorker->conn_ctx, pReq->pApdu);
+        }
+        else {
+            status = smCom_TransceiveRaw(pWorker->conn_ctx, pReq->pTx, pReq->txLen, pReq->pRx, &pReq->rxLen);
+        }
+        smComAsync_Complete(pWorker, pReq, status);
+    }
+    return NULL;
+}
+
+U16 smComAsync_Start(void *conn_ctx, smComAsync_Worker_t **ppWorker)
+{
+    U16 ret                      = SMCOM_COM_INIT_FAILED;
+    smComAsync_Worker_t *pWorker = NULL;
+
+    ENSURE_OR_GO_EXIT(ppWorker != NULL);
+
+    pWorker = (smComAsync_Worker_t *)malloc(sizeof(*pWorker));
+    ENSURE_OR_GO_EXIT(pWorker != NULL);
+    memset(pWorker, 0, sizeof(*pWorker));
+    pWorker->conn_ctx = conn_ctx;
+    pWorker->eventFd  = -1;
+
+    if (pthread_mutex_init(&pWorker->lock, NULL) != 0) {
+        LOG_E("smComAsync: mutex init has failed");
+        free(pWorker);
+        goto exit;
+    }
+    pthread_cond_init(&pWorker->queued, NULL);
+    pthread_cond_init(&pWorker->completed, NULL);
+#if defined(__linux__)
+    pWorker->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pWorker->eventFd < 0) {
+        LOG_W("smComAsync: eventfd not available");
+    }
+#endif
+
+    if (pthread_create(&pWorker->thread, NULL, &smComAsync_Thread, pWorker) != 0) {
+        LOG_E("smComAsync: worker thread could not be created");
+#if defined(__linux__)
+        if (pWorker->eventFd >= 0) {
+            close(pWorker->eventFd);
+        }
+#endif
+        pthread_cond_destroy(&pWorker->queued);
+        pthread_cond_destroy(&pWorker->completed);
+        pthread_mutex_destroy(&pWorker->lock);
+        free(pWorker);
+        goto exit;
+    }
+
+    *ppWorker = pWorker;
+    ret       = SMCOM_OK;
+exit:
+    return ret;
+}
+
+void smComAsync_Stop(smComAsync_Worker_t *pWorker)
+{
+    smComAsync_Request_t *pPending = NULL;
+
+    if (pWorker == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pWorker->lock);
+    pWorker->stop = 1;
+    pthread_cond_signal(&pWorker->queued);
+    pthread_mutex_unlock(&pWorker->lock);
+    pthread_join(pWorker->thread, NULL);
+
+    /* Thread is gone, no locking needed for the queue any more */
+    pPending       = pWorker->pHead;
+    pWorker->pHead = NULL;
+    pWorker->pTail = NULL;
+    while (pPending != NULL) {
+        smComAsync_Request_t *pNext = pPending->pNext;
+        smComAsync_Complete(pWorker, pPending, SMCOM_SND_FAILED);
+        pPending = pNext;
+    }
+
+#if defined(__linux__)
+    if (pWorker->eventFd >= 0) {
+        close(pWorker->eventFd);
+    }
+#endif
+    pthread_cond_destroy(&pWorker->queued);
+    pthread_cond_destroy(&pWorker->completed);
+    pthread_mutex_destroy(&pWorker->lock);
+    free(pWorker);
+}
+
+U32 smComAsync_Submit(smComAsync_Worker_t *pWorker, smComAsync_Request_t *pReq)
+{
+    U32 ret = SMCOM_NO_PRIOR_INIT;
+
+    ENSURE_OR_GO_EXIT(pWorker != NULL);
+    ENSURE_OR_GO_EXIT(pReq != NULL);
+    ENSURE_OR_GO_EXIT((pReq->fn != NULL) || (pReq->pApdu != NULL) || ((pReq->pTx != NULL) && (pReq->pRx != NULL)));
+
+    pReq->done   = 0;
+    pReq->status = SMCOM_NO_PRIOR_INIT;
+    pReq->pNext  = NULL;
+
+    pthread_mutex_lock(&pWorker->lock);
+    if (!pWorker->stop) {
+        if (pWorker->pTail != NULL) {
+            pWorker->pTail->pNext = pReq;
+        }
+        else {
+            pWorker->pHead = pReq;
+        }
+        pWorker->pTail = pReq;
+        pthread_cond_signal(&pWorker->queued);
+        ret = SMCOM_OK;
+    }
+    pthread_mutex_unlock(&pWorker->lock);
+
+exit:
+    return ret;
+}
+
+U32 smComAsync_Wait(smComAsync_Worker_t *pWorker, smComAsync_Request_t *pReq)
+{
+    U32 ret = SMCOM_NO_PRIOR_INIT;
+
+    ENSURE_OR_GO_EXIT(pWorker != NULL);
+    ENSURE_OR_GO_EXIT(pReq != NULL);
+
+    pthread_mutex_lock(&pWorker->lock);
+    while (!pReq->done) {
+        pthread_cond_wait(&pWorker->completed, &pWorker->lock);
+    }
+    ret = pReq->status;
+    pthread_mutex_unlock(&pWorker->lock);
+
+exit:
+    return ret;
+}
+
+int smComAsync_GetEventFd(smComAsync_Worker_t *pWorker)
+{
+    return (pWorker != NULL) ? pWorker->eventFd : -1;
+}
+
+#endif // (__GNUC__ && !AX_EMBEDDED)
@@ -0,0 +1,115 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @par Description
+ * Asynchronous APDU submission on top of the installable communication layer.
+ *
+ * A worker thread per connection drives the exchange through ::smCom_Transceive /
+ * ::smCom_TransceiveRaw, so the calling thread can queue commands and continue
+ * with host side work while the Secure Module processes them. Completion is
+ * reported by callback, by waiting on the request, or through an eventfd that
+ * can be added to an epoll set.
+ *
+ * A request either carries an APDU, passed as-is to the communication layer
+ * (session level wrapping, e.g. SCP03, must already be applied), or a
+ * function that the worker runs instead. Use the latter to run a complete
+ * SSS call, e.g. sss_asymmetric_sign_digest(), on the worker: it goes through
+ * the transceive function of its session, with the session's secure channel.
+ */
+
+#ifndef _SMCOMASYNC_H_
+#define _SMCOMASYNC_H_
+
+#include "smCom.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (__GNUC__ && !AX_EMBEDDED)
+
+struct smComAsync_Request;
+
+/** Called from the worker thread once a request is complete, with status and
+ * response valid. Runs before smComAsync_Request_t::done is set, so pReq stays
+ * valid until the callback returns, also if another thread waits for it. */
+typedef void (*smComAsync_Callback_t)(struct smComAsync_Request *pReq, void *userCtx);
+
+/** Work run by the worker thread instead of an APDU exchange, e.g. an SSS call.
+ * @return status of the request, e.g. SMCOM_OK */
+typedef U32 (*smComAsync_Fn_t)(void *fnCtx);
+
+/**
+ * One queued command. Memory is owned by the caller and must stay valid until
+ * the request is complete.
+ */
+typedef struct smComAsync_Request
+{
+    smComAsync_Fn_t fn;             //!< IN: Function to run on the worker, or NULL for an APDU exchange
+    void *fnCtx;                    //!< IN: Passed to fn
+    apdu_t *pApdu;                  //!< IN: APDU to exchange with ::smCom_Transceive, or NULL for a raw exchange
+    U8 *pTx;                        //!< IN: Raw command (pApdu == NULL)
+    U16 txLen;                      //!< IN: Length of raw command
+    U8 *pRx;                        //!< IN: Buffer for raw response
+    U32 rxLen;                      //!< IN: Size of pRx; OUT: Length of raw response
+    smComAsync_Callback_t callback; //!< IN: Optional completion callback
+    void *userCtx;                  //!< IN: Passed to callback
+    U32 status;                     //!< OUT: Result of the exchange, SMCOM_OK on success
+    volatile int done;              //!< OUT: Set once status and response are valid, after the callback
+    struct smComAsync_Request *pNext;
+} smComAsync_Request_t;
+
+typedef struct smComAsync_Worker smComAsync_Worker_t;
+
+/**
+ * Start the worker thread of one connection.
+ *
+ * @param[in]  conn_ctx   Connection context as used for ::smCom_TransceiveRaw
+ * @param[out] ppWorker   Worker handle
+ *
+ * @retval ::SMCOM_OK             Worker started
+ * @retval ::SMCOM_COM_INIT_FAILED Thread or memory could not be allocated
+ */
+U16 smComAsync_Start(void *conn_ctx, smComAsync_Worker_t **ppWorker);
+
+/**
+ * Stop the worker thread. The request in progress is completed, requests
+ * still queued complete with ::SMCOM_SND_FAILED.
+ * No other thread may use the worker (e.g. in ::smComAsync_Wait) after this call.
+ */
+void smComAsync_Stop(smComAsync_Worker_t *pWorker);
+
+/**
+ * Queue a request. Requests of one worker are run in submission order.
+ * The callback of a request returns before the next request starts.
+ *
+ * @retval ::SMCOM_OK             Queued
+ * @retval ::SMCOM_NO_PRIOR_INIT  Worker not running
+ */
+U32 smComAsync_Submit(smComAsync_Worker_t *pWorker, smComAsync_Request_t *pReq);
+
+/**
+ * Block until a request is complete. Its callback has returned by then.
+ *
+ * @return status of the exchange
+ */
+U32 smComAsync_Wait(smComAsync_Worker_t *pWorker, smComAsync_Request_t *pReq);
+
+/**
+ * File descriptor that becomes readable when requests complete (Linux eventfd).
+ * Read it to reset the counter, then check smComAsync_Request_t::done.
+ *
+ * @return file descriptor, or -1 if not available on this platform
+ */
+int smComAsync_GetEventFd(smComAsync_Worker_t *pWorker);
+
+#endif // (__GNUC__ && !AX_EMBEDDED)
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -215,6 +215,18 @@ exit:
 }
 // LCOV_EXCL_STOP
 
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+void smComT1oI2C_DumpPollStats(void *conn_ctx)
+{
+    phNxpEse_dumpPollStats(conn_ctx);
+}
+#endif
+
+void smComT1oI2C_DumpBusStats(void *conn_ctx)
+{
+    phNxpEse_dumpBusStats(conn_ctx);
+}
+
 U16 smComT1oI2C_ComReset(void* conn_ctx)
 {
     ESESTATUS status = ESESTATUS_SUCCESS;
@@ -74,6 +74,20 @@ U16 smComT1oI2C_Init(void **conn_ctx, const char *pConnString);
 */
 U16 smComT1oI2C_Resume(void **conn_ctx, const char *pConnString);
 
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+/**
+* Log predicted vs. observed SE processing time per command class.
+* @param conn_ctx      IN: connection context
+*/
+void smComT1oI2C_DumpPollStats(void *conn_ctx);
+#endif
+
+/**
+* Log I2C read/write transactions per APDU and per frame.
+* @param conn_ctx      IN: connection context
+*/
+void smComT1oI2C_DumpBusStats(void *conn_ctx);
+
 #if defined(__cplusplus)
 }
 #endif
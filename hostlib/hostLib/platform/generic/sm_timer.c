@@ -77,3 +77,22 @@ void sm_usleep(uint32_t microsec)
 	//#warning "No sm_usleep implemented"
 #endif
 }
+
+/**
+ * Monotonic time stamp in microseconds, used to measure elapsed time.
+ * Returns 0 on platforms where no monotonic time source is available.
+ */
+uint64_t sm_get_time_us(void)
+{
+#if defined(__gnu_linux__) || defined __clang__
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u);
+#elif defined(USE_RTOS) && USE_RTOS == 1
+    return ((uint64_t)xTaskGetTickCount() * 1000000u) / configTICK_RATE_HZ;
+#else
+    return 0;
+#endif
+}
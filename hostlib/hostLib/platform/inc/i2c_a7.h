@@ -113,6 +113,15 @@ i2c_error_t axI2CInit(void **conn_ctx, const char *pDevName);
  */
 void axI2CTerm(void* conn_ctx, int mode);
 
+#if !AX_EMBEDDED
+/** Reset the read back off delay of the default device only, i.e. the device
+ * opened last by axI2CInit(). Nothing is done once that device is closed.
+ *
+ *  The delay of every other opened device is reset by its next successful read.
+ */
+void resetBackoffDelay(void);
+#endif
+
 #if AX_EMBEDDED
 /** Smarter handling of back off logic
  *
@@ -152,6 +161,12 @@ i2c_error_t axI2CWrite(void* conn_ctx, unsigned char bus, unsigned char addr, un
  *
  * Needed only for T=1 over I2C */
 i2c_error_t axI2CRead(void* conn_ctx, unsigned char bus, unsigned char addr, unsigned char * pRx, unsigned short rxLen);
+#if !AX_EMBEDDED
+/** As axI2CRead(), but returns at once when the SE NACKs, without the back off delay
+ * and without changing it. For polling while a response is due. */
+i2c_error_t axI2CReadNoBackoff(
+    void* conn_ctx, unsigned char bus, unsigned char addr, unsigned char * pRx, unsigned short rxLen);
+#endif
 #endif /* T1oI2C */
 #if defined(__cplusplus)
 }
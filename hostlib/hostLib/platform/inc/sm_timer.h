@@ -24,6 +24,7 @@ extern "C" {
 uint32_t sm_initSleep(void);
 void sm_sleep(uint32_t msec);
 void sm_usleep(uint32_t microsec);
+uint64_t sm_get_time_us(void);
 
 #ifdef __cplusplus
 }
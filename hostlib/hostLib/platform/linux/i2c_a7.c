@@ -33,17 +33,32 @@ static int default_axSmDevice_addr = 0x48;      // 7-bit address
 
 #define DEV_NAME_BUFFER_SIZE 64
 
-static int gBackoffDelay = 0;
+/* Per device state, returned as conn_ctx by axI2CInit */
+typedef struct
+{
+    int fd;           /* File descriptor of the opened i2c bus */
+    int backoffDelay; /* Back off delay (in ms) after failed reads */
+} axI2CDevice_t;
+
+/* Default device: the one opened last by axI2CInit, used by resetBackoffDelay() */
+static axI2CDevice_t *gpDefaultDevice = NULL;
 
-void resetBackoffDelay() {
-    gBackoffDelay = 0;
+static void resetDeviceBackoffDelay(axI2CDevice_t *pDevice) {
+    pDevice->backoffDelay = 0;
 }
 
-static void BackOffDelay_Wait() {
-    if (gBackoffDelay < 200 ) {
-        gBackoffDelay += 1;
+/* Kept for existing callers, acts on the default device only */
+void resetBackoffDelay(void) {
+    if (gpDefaultDevice != NULL) {
+        resetDeviceBackoffDelay(gpDefaultDevice);
     }
-    usleep(gBackoffDelay * 1000);
+}
+
+static void BackOffDelay_Wait(axI2CDevice_t *pDevice) {
+    if (pDevice->backoffDelay < 200 ) {
+        pDevice->backoffDelay += 1;
+    }
+    usleep(pDevice->backoffDelay * 1000);
 }
 
 /**
@@ -153,7 +168,7 @@ i2c_error_t axI2CInit(void **conn_ctx, const char *pDevName)
         }
     }
 
-    *conn_ctx = malloc(sizeof(int));
+    *conn_ctx = malloc(sizeof(axI2CDevice_t));
     if(*conn_ctx == NULL)
     {
         LOG_E("I2C driver: Memory allocation failed!\n");
@@ -161,7 +176,9 @@ i2c_error_t axI2CInit(void **conn_ctx, const char *pDevName)
         return I2C_FAILED;
     }
     else{
-        *(int*)(*conn_ctx) = axSmDevice;
+        ((axI2CDevice_t*)(*conn_ctx))->fd = axSmDevice;
+        ((axI2CDevice_t*)(*conn_ctx))->backoffDelay = 0;
+        gpDefaultDevice = (axI2CDevice_t*)(*conn_ctx);
         return I2C_OK;
     }
 }
@@ -172,13 +189,16 @@ i2c_error_t axI2CInit(void **conn_ctx, const char *pDevName)
 void axI2CTerm(void* conn_ctx, int mode)
 {
     AX_UNUSED_ARG(mode);
-    // printf("axI2CTerm (enter) i2c device =  %d\n", *(int*)(conn_ctx));
+    // printf("axI2CTerm (enter) i2c device =  %d\n", ((axI2CDevice_t*)conn_ctx)->fd);
     if (conn_ctx != NULL) {
-        if (close(*(int*)(conn_ctx)) != 0) {
-            LOG_E("Failed to close i2c device %d.\n", *(int*)(conn_ctx));
+        if (close(((axI2CDevice_t*)conn_ctx)->fd) != 0) {
+            LOG_E("Failed to close i2c device %d.\n", ((axI2CDevice_t*)conn_ctx)->fd);
         }
         else {
-            LOG_D("Close i2c device %d.\n", *(int*)(conn_ctx));
+            LOG_D("Close i2c device %d.\n", ((axI2CDevice_t*)conn_ctx)->fd);
+        }
+        if (gpDefaultDevice == (axI2CDevice_t*)conn_ctx) {
+            gpDefaultDevice = NULL;
         }
         free(conn_ctx);
     }
@@ -198,7 +218,7 @@ i2c_error_t axI2CWriteByte(void* conn_ctx, unsigned char bus, unsigned char addr
 {
     int nrWritten = -1;
     i2c_error_t rv;
-    int axSmDevice = *(int*)conn_ctx;
+    int axSmDevice = ((axI2CDevice_t*)conn_ctx)->fd;
 
     if (bus != I2C_BUS_0)
     {
@@ -232,7 +252,7 @@ i2c_error_t axI2CWrite(void* conn_ctx, unsigned char bus, unsigned char addr, un
 {
     int nrWritten = -1;
     i2c_error_t rv;
-    int axSmDevice = *(int*)conn_ctx;
+    int axSmDevice = ((axI2CDevice_t*)conn_ctx)->fd;
 #ifdef LOG_I2C
     int i = 0;
 #endif
@@ -278,7 +298,7 @@ i2c_error_t axI2CWriteRead(void* conn_ctx, unsigned char bus, unsigned char addr
     struct i2c_msg messages[2];
     int r = 0;
     int i = 0;
-    int axSmDevice = *(int*)conn_ctx;
+    int axSmDevice = ((axI2CDevice_t*)conn_ctx)->fd;
 
     if(pTx == NULL || txLen > MAX_DATA_LEN)
     {
@@ -374,7 +394,7 @@ i2c_error_t axI2CRead(void* conn_ctx, unsigned char bus, unsigned char addr, uns
 {
     int nrRead = -1;
     i2c_error_t rv;
-    int axSmDevice = *(int*)conn_ctx;
+    int axSmDevice = ((axI2CDevice_t*)conn_ctx)->fd;
 
     if(pRx == NULL || rxLen > MAX_DATA_LEN)
     {
@@ -391,23 +411,48 @@ i2c_error_t axI2CRead(void* conn_ctx, unsigned char bus, unsigned char addr, uns
     {
         //LOG_E("Failed Read data (nrRead=%d).\n", nrRead);
         rv = I2C_FAILED;
-        BackOffDelay_Wait();
+        BackOffDelay_Wait((axI2CDevice_t*)conn_ctx);
     }
     else
     {
         if (nrRead == rxLen) // okay
         {
             rv = I2C_OK;
-            resetBackoffDelay();
+            resetDeviceBackoffDelay((axI2CDevice_t*)conn_ctx);
         }
         else
         {
             rv = I2C_FAILED;
-            BackOffDelay_Wait();
+            BackOffDelay_Wait((axI2CDevice_t*)conn_ctx);
         }
     }
     LOG_D("Done with rv = %02x ", rv);
     LOG_MAU8_D("TX (axI2CRead): ",pRx,rxLen);
     return rv;
 }
+
+i2c_error_t axI2CReadNoBackoff(void* conn_ctx, unsigned char bus, unsigned char addr, unsigned char * pRx, unsigned short rxLen)
+{
+    int nrRead = -1;
+    int axSmDevice = ((axI2CDevice_t*)conn_ctx)->fd;
+
+    if(pRx == NULL || rxLen > MAX_DATA_LEN)
+    {
+        return I2C_FAILED;
+    }
+
+    if (bus != I2C_BUS_0)
+    {
+        LOG_E("axI2CReadNoBackoff on wrong bus %x (addr %x)\n", bus, addr);
+    }
+
+    nrRead = read(axSmDevice, pRx, rxLen);
+    if (nrRead != rxLen)
+    {
+        return I2C_FAILED;
+    }
+    resetDeviceBackoffDelay((axI2CDevice_t*)conn_ctx);
+    LOG_MAU8_D("TX (axI2CReadNoBackoff): ",pRx,rxLen);
+    return I2C_OK;
+}
 #endif // T1oI2C
@@ -910,6 +910,9 @@ smStatus_t se05x_Transform_scp(struct Se05xSession *pSession,
     size_t macLen           = 16;
     size_t i                = 0;
     Se05xApdu_t se05xApdu   = {0};
+#if NX_SCP03_FUSED_WRAP
+    size_t encLen = 0;
+#endif
 
 #if SSSFTR_SE05X_AuthECKey || SSSFTR_SE05X_AuthSession
     uint8_t *wsCmd = NULL;
@@ -921,9 +924,15 @@ smStatus_t se05x_Transform_scp(struct Se05xSession *pSession,
     se05xApdu.se05xCmd      = cmdApduBuf;
     se05xApdu.se05xCmdLen   = cmdApduBufLen;
 
+#if NX_SCP03_FUSED_WRAP
+    /* The header only needs the padded length. The command is encrypted
+     * straight into the Tx buffer, behind the header. */
+    se05xApdu.se05xCmdLen = nxSCP03_Padded_Length(cmdApduBufLen);
+#else
     /*Encrypt the Tx APDU */
     sss_status = nxSCP03_Encrypt_CommandAPDU(pSession->pdynScp03Ctx, se05xApdu.se05xCmd, &(se05xApdu.se05xCmdLen));
     ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
+#endif
 
     if (pSession->hasSession) {
 #if SSSFTR_SE05X_AuthECKey || SSSFTR_SE05X_AuthSession
@@ -998,7 +1007,16 @@ smStatus_t se05x_Transform_scp(struct Se05xSession *pSession,
                 wsCmd[i++] = 0xFFu & (se05xApdu.se05xCmdLC);
             }
         }
+#if NX_SCP03_FUSED_WRAP
+        ENSURE_OR_GO_CLEANUP(i <= *ptxBufLen);
+        encLen     = *ptxBufLen - i;
+        sss_status = nxSCP03_Encrypt_CommandAPDU_To(
+            pSession->pdynScp03Ctx, se05xApdu.se05xCmd, cmdApduBufLen, &wsCmd[i], &encLen);
+        ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
+        ENSURE_OR_GO_CLEANUP(encLen == se05xApdu.se05xCmdLen);
+#else
         memcpy(&wsCmd[i], se05xApdu.se05xCmd, se05xApdu.se05xCmdLen);
+#endif
         ENSURE_OR_GO_CLEANUP((SIZE_MAX - i) >= se05xApdu.se05xCmdLen);
         i += se05xApdu.se05xCmdLen;
         se05xApdu.wsSe05x_cmdLen = i;
@@ -1040,7 +1058,15 @@ smStatus_t se05x_Transform_scp(struct Se05xSession *pSession,
         if (i > (*ptxBufLen)) {
             goto cleanup;
         }
+#if NX_SCP03_FUSED_WRAP
+        encLen     = *ptxBufLen - i;
+        sss_status = nxSCP03_Encrypt_CommandAPDU_To(
+            pSession->pdynScp03Ctx, se05xApdu.se05xCmd, cmdApduBufLen, &txBuf[i], &encLen);
+        ENSURE_OR_GO_CLEANUP(sss_status == kStatus_SSS_Success);
+        ENSURE_OR_GO_CLEANUP(encLen == se05xApdu.se05xCmdLen);
+#else
         memcpy(&txBuf[i], se05xApdu.se05xCmd, se05xApdu.se05xCmdLen);
+#endif
         i += se05xApdu.se05xCmdLen;
     }
 
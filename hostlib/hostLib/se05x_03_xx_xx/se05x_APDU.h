@@ -42,6 +42,9 @@ extern "C" {
  * Kindly see the Implementation of is API Se05x_API_DeleteAll_Iterative to see
  * the list of ranges that are skipped.
  *
+ * When used on the session of an SSS SE05x session, call
+ * sss_se05x_session_flush_object_cache() afterwards.
+ *
  * @param[in]  session_ctx  Session Context
  *
  * @return     The status of API.
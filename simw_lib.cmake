@@ -8,6 +8,7 @@ FILE(
     SIMW_SE_SOURCES
     ${SIMW_LIB_DIR}/sss/ex/src/ex_sss_boot.c
     ${SIMW_LIB_DIR}/sss/ex/src/ex_sss_boot_connectstring.c
+    ${SIMW_LIB_DIR}/sss/ex/src/ex_sss_pool.c
     ${SIMW_LIB_DIR}/sss/ex/src/ex_sss_se05x.c
     ${SIMW_LIB_DIR}/sss/ex/src/ex_sss_se05x_auth.c
     ${SIMW_LIB_DIR}/sss/src/*.c
@@ -17,6 +18,7 @@ FILE(
     ${SIMW_LIB_DIR}/hostlib/hostLib/libCommon/infra/*.c
     ${SIMW_LIB_DIR}/hostlib/hostLib/libCommon/log/nxLog.c
     ${SIMW_LIB_DIR}/hostlib/hostLib/libCommon/smCom/smCom.c
+    ${SIMW_LIB_DIR}/hostlib/hostLib/libCommon/smCom/smComAsync.c
     ${SIMW_LIB_DIR}/hostlib/hostLib/platform/rsp/se05x_reset.c
     ${SIMW_LIB_DIR}/hostlib/hostLib/platform/generic/sm_timer.c
     ${SIMW_LIB_DIR}/hostlib/hostLib/se05x/src/se05x_ECC_curves.c
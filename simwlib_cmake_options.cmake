@@ -16,6 +16,8 @@ SET_PROPERTY(CACHE PTMW_SE05X_Auth PROPERTY STRINGS "None;UserID;PlatfSCP03;AESK
 
 OPTION(WithCodeCoverage "Compile with Code Coverage" OFF)
 
+OPTION(PTMW_T1oI2C_AdaptivePolling "T=1oI2C: Learn SE processing time per command and sleep before polling" ON)
+
 #########################################################
 
 IF("${PTMW_Applet}" STREQUAL "SE05X_A")
@@ -182,6 +184,11 @@ ENDIF()
 
 SET(SSS_HAVE_SE_RESET_LOGIC_1 "1")
 
+#########################################################
+IF(PTMW_T1oI2C_AdaptivePolling)
+    ADD_DEFINITIONS(-DT1OI2C_ADAPTIVE_POLLING)
+ENDIF()
+
 #########################################################
 IF(WithCodeCoverage)
     IF(CMAKE_COMPILER_IS_GNUCXX)
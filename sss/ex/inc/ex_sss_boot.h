@@ -167,7 +167,11 @@ sss_status_t ex_sss_boot_open(ex_sss_boot_ctx_t *pCtx, const char *portName);
 /** Open an example cc session */
 sss_status_t ex_sss_boot_open_on_id(ex_sss_boot_ctx_t *pCtx, const char *portName, const int32_t authId);
 
-/** Open an example session */
+/** Delete the objects created by the examples.
+ *
+ * The object cache of the session is flushed. Keys registered with
+ * ::sss_hybrid_add_key are not removed.
+ */
 sss_status_t ex_sss_boot_factory_reset(ex_sss_boot_ctx_t *pCtx);
 
 /** Close an example session */
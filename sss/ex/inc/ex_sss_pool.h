@@ -0,0 +1,176 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/** @file
+ *
+ * ex_sss_pool.h:  Pool of SE05x devices with load balanced dispatch
+ *
+ * Opens several secure elements (e.g. on different I2C buses / addresses)
+ * and dispatches crypto operations to the least loaded healthy device that
+ * holds the requested key. The same key id provisioned on several devices
+ * forms a replica set that serves one logical key.
+ */
+
+#ifndef SSS_EX_INC_EX_SSS_POOL_H_
+#define SSS_EX_INC_EX_SSS_POOL_H_
+
+/* *****************************************************************************************************************
+ *   Includes
+ * ***************************************************************************************************************** */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ex_sss_boot.h"
+
+#if (__GNUC__ && !AX_EMBEDDED)
+#include <pthread.h>
+#endif
+
+/* *****************************************************************************************************************
+ * MACROS/Defines
+ * ***************************************************************************************************************** */
+
+/** Maximum number of secure elements in a pool */
+#define EX_SSS_POOL_MAX_DEVICES 8
+
+/** Maximum number of logical keys tracked by a pool */
+#define EX_SSS_POOL_MAX_KEYS 32
+
+/** Consecutive failed operations after which a device is taken out of rotation */
+#define EX_SSS_POOL_FAIL_THRESHOLD 3
+
+/** Use any device of the pool, no key needed (e.g. random number generation) */
+#define EX_SSS_POOL_ANY_KEY 0u
+
+/* *****************************************************************************************************************
+ * Types/Structure Declarations
+ * ***************************************************************************************************************** */
+
+/** One secure element of the pool */
+typedef struct
+{
+    ex_sss_boot_ctx_t boot; //!< Sessions and key store of this device
+    const char *portName;   //!< Connection string used to open the device
+#if (__GNUC__ && !AX_EMBEDDED)
+    pthread_mutex_t lock; //!< Serializes operations on this device
+#endif
+    uint32_t inFlight;            //!< Operations dispatched and not yet completed
+    uint32_t consecutiveFailures; //!< Reset on every successful operation
+    bool healthy;                 //!< Device is in rotation
+    bool recovering;              //!< Being reopened by ::ex_sss_pool_health_check
+    uint32_t opCount;             //!< Completed operations
+    uint32_t failCount;           //!< Failed operations
+} ex_sss_pool_device_t;
+
+/** Replica set of one logical key */
+typedef struct
+{
+    uint32_t keyId;       //!< Key id, identical on all replicas
+    uint32_t replicaMask; //!< Bit n set: device n holds the key
+    sss_object_t object[EX_SSS_POOL_MAX_DEVICES]; //!< Key object per replica
+} ex_sss_pool_key_t;
+
+/** Pool of secure elements */
+typedef struct
+{
+    ex_sss_pool_device_t device[EX_SSS_POOL_MAX_DEVICES];
+    size_t deviceCount;
+    ex_sss_pool_key_t key[EX_SSS_POOL_MAX_KEYS];
+    size_t keyCount;
+#if (__GNUC__ && !AX_EMBEDDED)
+    pthread_mutex_t lock; //!< Protects load and health bookkeeping
+#endif
+} ex_sss_pool_t;
+
+/** Operation run on the device selected by ::ex_sss_pool_dispatch
+ *
+ * @param pCtx       Sessions of the selected device
+ * @param pKeyObject Key object on the selected device, NULL for ::EX_SSS_POOL_ANY_KEY
+ * @param arg        Caller context
+ */
+typedef sss_status_t (*ex_sss_pool_fn_t)(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg);
+
+/* *****************************************************************************************************************
+ *   Function Prototypes
+ * ***************************************************************************************************************** */
+
+/** Open all devices of a pool.
+ *
+ * Devices that fail to open are kept out of rotation and can be brought back
+ * with ::ex_sss_pool_health_check.
+ *
+ * @param pPool      Pool to open
+ * @param portNames  Connection strings, e.g. "/dev/i2c-1:0x48"
+ * @param count      Number of connection strings
+ * @return kStatus_SSS_Success if at least one device could be opened
+ */
+sss_status_t ex_sss_pool_open(ex_sss_pool_t *pPool, const char *portNames[], size_t count);
+
+/** Close all devices of a pool */
+void ex_sss_pool_close(ex_sss_pool_t *pPool);
+
+/** Register a logical key, and find the devices holding it.
+ *
+ * @return kStatus_SSS_Success if at least one device holds the key
+ */
+sss_status_t ex_sss_pool_add_key(ex_sss_pool_t *pPool, uint32_t keyId);
+
+/** Run an operation on the least loaded healthy device holding keyId.
+ *
+ * Use ::EX_SSS_POOL_ANY_KEY for operations that need no key.
+ */
+sss_status_t ex_sss_pool_dispatch(ex_sss_pool_t *pPool, uint32_t keyId, ex_sss_pool_fn_t fn, void *arg);
+
+/** Load balanced ::sss_asymmetric_sign_digest */
+sss_status_t ex_sss_pool_asymmetric_sign_digest(ex_sss_pool_t *pPool,
+    uint32_t keyId,
+    sss_algorithm_t algorithm,
+    uint8_t *digest,
+    size_t digestLen,
+    uint8_t *signature,
+    size_t *signatureLen);
+
+/** Load balanced ::sss_asymmetric_verify_digest */
+sss_status_t ex_sss_pool_asymmetric_verify_digest(ex_sss_pool_t *pPool,
+    uint32_t keyId,
+    sss_algorithm_t algorithm,
+    uint8_t *digest,
+    size_t digestLen,
+    uint8_t *signature,
+    size_t signatureLen);
+
+/** Load balanced ::sss_derive_key_dh (ECDH).
+ *
+ * otherPartyKeyObject and derivedKeyObject must not be bound to one device,
+ * i.e. they are host key objects.
+ */
+sss_status_t ex_sss_pool_derive_key_dh(
+    ex_sss_pool_t *pPool, uint32_t keyId, sss_object_t *otherPartyKeyObject, sss_object_t *derivedKeyObject);
+
+/** Load balanced ::sss_rng_get_random */
+sss_status_t ex_sss_pool_rng_get_random(ex_sss_pool_t *pPool, uint8_t *random_data, size_t dataLen);
+
+/** Probe every device that is not busy, take failing devices out of rotation
+ * and bring recovered devices back.
+ *
+ * Callers are never blocked by a probe. A failing device is reopened only
+ * once it is out of rotation and idle, without holding its lock. Call this
+ * periodically from a maintenance thread.
+ *
+ * @return Number of healthy devices
+ */
+size_t ex_sss_pool_health_check(ex_sss_pool_t *pPool);
+
+/** Log load and health of all devices */
+void ex_sss_pool_dump_stats(ex_sss_pool_t *pPool);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SSS_EX_INC_EX_SSS_POOL_H_ */
@@ -0,0 +1,1045 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/** @file
+ *
+ * ex_sss_kat.c:  Known answer tests of host side middleware code
+ *
+ * Runs against the host crypto only, no secure element is needed.
+ *
+ * Usage: ex_sss_kat
+ *
+ * Returns non zero if any test fails, so it can run as a CI check.
+ */
+
+/* ************************************************************************** */
+/* Includes                                                                   */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <fsl_sss_api.h>
+#include <fsl_sss_se05x_apis.h>
+#include <nxEnsure.h>
+#include <nxLog_App.h>
+
+#if SSS_HAVE_SCP_SCP03_SSS
+#include <nxScp03_Apis.h>
+#include <se05x_tlv.h>
+#endif
+
+#if SSS_HAVE_SCP_SCP03_SSS && SSSFTR_SE05X_AuthECKey && SSSFTR_SE05X_AuthSession && SSS_HAVE_SE05X_VER_GTE_07_02
+#define KAT_ECKEY_REOPEN 1
+#include <ex_sss_boot.h>
+#include <ex_sss_objid.h>
+#include <fsl_sss_se05x_scp03.h>
+#include <nxScp03_Const.h>
+#else
+#define KAT_ECKEY_REOPEN 0
+#endif
+
+#if (__GNUC__ && !AX_EMBEDDED)
+#include "sm_timer.h"
+#include "smComAsync.h"
+#endif
+
+#if defined(T1oI2C)
+#include "i2c_a7.h"
+#include "phNxpEse_Api.h"
+#include "phNxpEseProto7816_3.h"
+#endif
+
+/* ************************************************************************** */
+/* Local Defines                                                              */
+/* ************************************************************************** */
+
+/** Longest command / response of the SCP03 wrapping test */
+#define KAT_SCP03_MAX_DATA 880
+
+/** Room for session tag, header, Lc, padding, MAC and Le around the data */
+#define KAT_SCP03_BUF_SIZE (KAT_SCP03_MAX_DATA + 64)
+
+/** Length of the DER header in front of a raw NIST P-256 public key */
+#define KAT_ECKEY_DER_HEADER_LEN 26
+
+/** Raw NIST P-256 public key, 04 || X || Y */
+#define KAT_ECKEY_PUB_LEN 65
+
+/** Longest answer of the stub secure element, TLVs and status word. The
+ * smallest response buffer is the one of INTERNAL AUTHENTICATE. */
+#define KAT_ECKEY_RSP_MAX 256
+
+/** Requests queued at once by the asynchronous submission test */
+#define KAT_ASYNC_REQUESTS 4
+
+/* ************************************************************************** */
+/* Structures and Typedefs                                                    */
+/* ************************************************************************** */
+
+typedef sss_status_t (*kat_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    kat_fn_t fn;
+} kat_case_t;
+
+#if (__GNUC__ && !AX_EMBEDDED)
+/** What the worker of the asynchronous submission test did, in order */
+typedef struct
+{
+    smComAsync_Request_t req[KAT_ASYNC_REQUESTS];
+    size_t index[KAT_ASYNC_REQUESTS];
+    uint8_t events[2 * KAT_ASYNC_REQUESTS]; /* 2 * request for its function, + 1 for its callback */
+    size_t nEvents;
+    int doneInCallback; /* A callback saw its request marked done */
+} kat_async_ctx_t;
+#endif
+
+#if SSS_HAVE_SCP_SCP03_SSS
+typedef struct
+{
+    sss_session_t session;
+    sss_key_store_t ks;
+    /* [0] wraps through se05x_Transform_scp, [1] through the reference */
+    NXSCP03_DynCtx_t dyn[2];
+    struct Se05xSession se05x;
+    uint8_t cmd[KAT_SCP03_BUF_SIZE];
+    uint8_t tx[2][KAT_SCP03_BUF_SIZE];
+    uint8_t rspWire[KAT_SCP03_BUF_SIZE];
+    size_t rspWireLen;
+    uint8_t rsp[KAT_SCP03_BUF_SIZE];
+} kat_scp03_ctx_t;
+#endif
+
+#if KAT_ECKEY_REOPEN
+typedef struct
+{
+    sss_session_t hostSession;
+    sss_key_store_t hostKs;
+    /* Secure element side: the attestation key and the ECKA key read with it */
+    sss_object_t attestKey;
+    sss_object_t eckaKey;
+    uint8_t attestPub[KAT_ECKEY_PUB_LEN];
+    uint8_t eckaPub[KAT_ECKEY_PUB_LEN];
+    /* Base session of the tunnel, its fp_TXn is the stub secure element */
+    sss_se05x_session_t base;
+    sss_se05x_tunnel_context_t tunnel;
+    SE_Connect_Ctx_t connectCtx;
+    ex_SE05x_authCtx_t auth;
+    sss_se05x_session_t session;
+    /* Host ephemeral key of the last INTERNAL AUTHENTICATE */
+    uint8_t hostEphemeral[KAT_ECKEY_PUB_LEN];
+    uint32_t authenticates;
+} kat_eckey_ctx_t;
+#endif
+
+/* ************************************************************************** */
+/* Global Variables                                                           */
+/* ************************************************************************** */
+
+#if SSS_HAVE_SCP_SCP03_SSS
+static kat_scp03_ctx_t gScp03;
+
+/* clang-format off */
+static const uint8_t gKeyEnc[16]  = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                                      0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F };
+static const uint8_t gKeyMac[16]  = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+                                      0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F };
+static const uint8_t gKeyRmac[16] = { 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+                                      0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F };
+static const uint8_t gSessionId[8] = { 0xE5, 0x51, 0x0A, 0x55, 0x01, 0x02, 0x03, 0x04 };
+/* clang-format on */
+
+static const tlvHeader_t gCmdHdr = {{0x80, 0x01, 0x01, 0x00}};
+#endif
+
+#if KAT_ECKEY_REOPEN
+static kat_eckey_ctx_t gEcKey;
+
+static const uint8_t gEcKeySessionId[8] = { 0x5E, 0x55, 0x10, 0x4E, 0x00, 0x00, 0x00, 0x01 };
+#endif
+
+/* ************************************************************************** */
+/* Known answer tests                                                         */
+/* ************************************************************************** */
+
+static sss_status_t kat_hmac_drbg(void)
+{
+    return sss_se05x_drbg_self_test();
+}
+
+#if defined(T1oI2C)
+/* CRC-16/X.25 bit by bit, the reference for the table driven frame CRC */
+static uint16_t kat_crc16_x25(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (bit = 8; bit > 0; --bit) {
+            crc = (crc & 0x0001) ? (uint16_t)((crc >> 1) ^ 0x8408) : (uint16_t)(crc >> 1);
+        }
+    }
+    crc ^= 0xFFFF;
+#if defined(T1oI2C_UM11225)
+    /* Sent low byte first */
+    crc = (uint16_t)(((crc & 0xFF) << 8) | ((crc >> 8) & 0xFF));
+#endif
+    return crc;
+}
+
+/* Check value of CRC-16/X.25, then pseudo random frames of every length up
+ * to MAX_DATA_LEN and a CRC from an offset against the bitwise reference */
+static sss_status_t kat_t1oi2c_crc(void)
+{
+    static uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    static uint8_t frame[MAX_DATA_LEN];
+    sss_status_t status = kStatus_SSS_Fail;
+    uint32_t seed       = 0x12345678;
+    uint16_t crc        = 0;
+    size_t len;
+
+    crc = phNxpEseProto7816_ComputeCRC(check, 0, sizeof(check));
+#if defined(T1oI2C_UM11225)
+    ENSURE_OR_GO_EXIT(crc == 0x6E90);
+#else
+    ENSURE_OR_GO_EXIT(crc == 0x906E);
+#endif
+    ENSURE_OR_GO_EXIT(kat_crc16_x25(check, sizeof(check)) == crc);
+
+    for (len = 0; len < sizeof(frame); len++) {
+        seed       = seed * 1103515245u + 12345u;
+        frame[len] = (uint8_t)(seed >> 16);
+    }
+    for (len = 0; len <= sizeof(frame); len++) {
+        crc = phNxpEseProto7816_ComputeCRC(frame, 0, (uint32_t)len);
+        if (crc != kat_crc16_x25(frame, len)) {
+            LOG_E("CRC of %u bytes: 0x%04X, expected 0x%04X", (unsigned)len, crc, kat_crc16_x25(frame, len));
+            goto exit;
+        }
+    }
+    /* The end is an index into the buffer, not a length */
+    crc = phNxpEseProto7816_ComputeCRC(frame, PH_PROTO_7816_HEADER_LEN, sizeof(frame));
+    ENSURE_OR_GO_EXIT(crc == kat_crc16_x25(&frame[PH_PROTO_7816_HEADER_LEN], sizeof(frame) - PH_PROTO_7816_HEADER_LEN));
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+#endif
+
+#if (__GNUC__ && !AX_EMBEDDED)
+static kat_async_ctx_t gAsync;
+
+/* Queued work, as an SSS call would be. Request 2 fails. */
+static U32 kat_async_fn(void *fnCtx)
+{
+    size_t i = *(size_t *)fnCtx;
+
+    /* Let the submitting thread wait for the request meanwhile */
+    sm_usleep(1000);
+    if (gAsync.nEvents < sizeof(gAsync.events)) {
+        gAsync.events[gAsync.nEvents++] = (uint8_t)(2 * i);
+    }
+    return (i == 2) ? SMCOM_SND_FAILED : SMCOM_OK;
+}
+
+static void kat_async_callback(smComAsync_Request_t *pReq, void *userCtx)
+{
+    size_t i = *(size_t *)userCtx;
+
+    if (pReq->done) {
+        gAsync.doneInCallback = 1;
+    }
+    if (gAsync.nEvents < sizeof(gAsync.events)) {
+        gAsync.events[gAsync.nEvents++] = (uint8_t)(2 * i + 1);
+    }
+}
+
+/* Functions run on the worker in submission order, each callback runs right
+ * after its function and before smComAsync_Wait() returns for the request */
+static sss_status_t kat_smcom_async(void)
+{
+    sss_status_t status          = kStatus_SSS_Fail;
+    smComAsync_Worker_t *pWorker = NULL;
+    U32 ret;
+    size_t i;
+
+    memset(&gAsync, 0, sizeof(gAsync));
+    ENSURE_OR_GO_EXIT(smComAsync_Start(NULL, &pWorker) == SMCOM_OK);
+    for (i = 0; i < KAT_ASYNC_REQUESTS; i++) {
+        gAsync.index[i]        = i;
+        gAsync.req[i].fn       = &kat_async_fn;
+        gAsync.req[i].fnCtx    = &gAsync.index[i];
+        gAsync.req[i].callback = &kat_async_callback;
+        gAsync.req[i].userCtx  = &gAsync.index[i];
+        ENSURE_OR_GO_EXIT(smComAsync_Submit(pWorker, &gAsync.req[i]) == SMCOM_OK);
+    }
+    for (i = 0; i < KAT_ASYNC_REQUESTS; i++) {
+        ret = smComAsync_Wait(pWorker, &gAsync.req[i]);
+        ENSURE_OR_GO_EXIT(ret == ((i == 2) ? SMCOM_SND_FAILED : SMCOM_OK));
+        /* The callback of request i is the last event the waiter can rely on */
+        ENSURE_OR_GO_EXIT(gAsync.nEvents >= 2 * i + 2);
+        ENSURE_OR_GO_EXIT(gAsync.events[2 * i + 1] == 2 * i + 1);
+    }
+    for (i = 0; i < 2 * KAT_ASYNC_REQUESTS; i++) {
+        ENSURE_OR_GO_EXIT(gAsync.events[i] == i);
+    }
+    ENSURE_OR_GO_EXIT(gAsync.doneInCallback == 0);
+    status = kStatus_SSS_Success;
+exit:
+    smComAsync_Stop(pWorker);
+    return status;
+}
+#endif
+
+#if SSS_HAVE_SCP_SCP03_SSS
+static sss_status_t kat_scp03_key(kat_scp03_ctx_t *pCtx, sss_object_t *pObj, uint32_t keyId, const uint8_t *key)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+
+    status = sss_host_key_object_init(pObj, &pCtx->ks);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_object_allocate_handle(
+        pObj, keyId, kSSS_KeyPart_Default, kSSS_CipherType_AES, 16, kKeyObject_Mode_Transient);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_set_key(&pCtx->ks, pObj, key, 16, 16 * 8, NULL, 0);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+exit:
+    return status;
+}
+
+static sss_status_t kat_scp03_open(kat_scp03_ctx_t *pCtx)
+{
+    sss_status_t status      = kStatus_SSS_Fail;
+    sss_type_t hostsubsystem = kType_SSS_SubSystem_NONE;
+    uint32_t keyId           = 0x100;
+    size_t d;
+
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS
+    hostsubsystem = kType_SSS_mbedTLS;
+#elif SSS_HAVE_HOSTCRYPTO_OPENSSL
+    hostsubsystem = kType_SSS_OpenSSL;
+#endif
+
+    status = sss_host_session_open(&pCtx->session, hostsubsystem, 0, kSSS_ConnectionType_Plain, NULL);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_context_init(&pCtx->ks, &pCtx->session);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_allocate(&pCtx->ks, __LINE__);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    for (d = 0; d < 2; d++) {
+        status = kat_scp03_key(pCtx, &pCtx->dyn[d].Enc, keyId++, gKeyEnc);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        status = kat_scp03_key(pCtx, &pCtx->dyn[d].Mac, keyId++, gKeyMac);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        status = kat_scp03_key(pCtx, &pCtx->dyn[d].Rmac, keyId++, gKeyRmac);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        pCtx->dyn[d].authType = kSSS_AuthType_SCP03;
+    }
+    pCtx->se05x.pdynScp03Ctx = &pCtx->dyn[0];
+exit:
+    return status;
+}
+
+static void kat_scp03_close(kat_scp03_ctx_t *pCtx)
+{
+    size_t d;
+
+    for (d = 0; d < 2; d++) {
+        nxScp03_Free_HostContexts(&pCtx->dyn[d]);
+        if (pCtx->ks.session != NULL) {
+            sss_host_key_object_free(&pCtx->dyn[d].Enc);
+            sss_host_key_object_free(&pCtx->dyn[d].Mac);
+            sss_host_key_object_free(&pCtx->dyn[d].Rmac);
+        }
+    }
+    if (pCtx->ks.session != NULL) {
+        sss_host_key_store_context_free(&pCtx->ks);
+    }
+    if (pCtx->session.subsystem != kType_SSS_SubSystem_NONE) {
+        sss_host_session_close(&pCtx->session);
+    }
+}
+
+/* Reference wrapping: encrypt the command in place, then copy it behind the
+ * header, the way se05x_Transform_scp did before it encrypted straight into
+ * the Tx buffer. */
+static sss_status_t kat_scp03_wrap_copying(NXSCP03_DynCtx_t *pDyn,
+    bool hasSession,
+    uint8_t *cmd,
+    size_t cmdLen,
+    uint8_t hasle,
+    uint8_t *tx,
+    size_t *pTxLen)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    uint8_t mac[16]     = {0};
+    size_t macLen       = sizeof(mac);
+    size_t encLen       = cmdLen;
+    size_t lc           = 0;
+    size_t lcw          = 0;
+    size_t tag1Len      = 0;
+    size_t macStart     = 0;
+    size_t i            = 0;
+
+    status = nxSCP03_Encrypt_CommandAPDU(pDyn, cmd, &encLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    lc  = encLen + SCP_COMMAND_MAC_SIZE;
+    lcw = ((lc < 0xFF) && !hasle) ? 1 : 3;
+
+    if (hasSession) {
+        tag1Len = sizeof(gCmdHdr.hdr) + lcw + lc;
+        tx[i++] = kSE05x_TAG_SESSION_ID;
+        tx[i++] = sizeof(gSessionId);
+        memcpy(&tx[i], gSessionId, sizeof(gSessionId));
+        i += sizeof(gSessionId);
+        tx[i++] = kSE05x_TAG_1;
+        if (tag1Len <= 0x7F) {
+            tx[i++] = (uint8_t)tag1Len;
+        }
+        else if (tag1Len <= 0xFF) {
+            tx[i++] = 0x81;
+            tx[i++] = (uint8_t)tag1Len;
+        }
+        else {
+            tx[i++] = 0x82;
+            tx[i++] = (uint8_t)(tag1Len >> 8);
+            tx[i++] = (uint8_t)tag1Len;
+        }
+    }
+
+    macStart = i;
+    memcpy(&tx[i], gCmdHdr.hdr, sizeof(gCmdHdr.hdr));
+    tx[i] |= 0x04;
+    i += sizeof(gCmdHdr.hdr);
+    if (lcw == 1) {
+        tx[i++] = (uint8_t)lc;
+    }
+    else {
+        tx[i++] = 0x00;
+        tx[i++] = (uint8_t)(lc >> 8);
+        tx[i++] = (uint8_t)lc;
+    }
+    memcpy(&tx[i], cmd, encLen);
+    i += encLen;
+
+    status = nxpSCP03_CalculateMac_CommandAPDU(pDyn, &tx[macStart], i - macStart, mac, &macLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    memcpy(&tx[i], mac, SCP_COMMAND_MAC_SIZE);
+    i += SCP_COMMAND_MAC_SIZE;
+    if (!hasSession && hasle) {
+        tx[i++] = 0x00;
+        tx[i++] = 0x00;
+    }
+    *pTxLen = i;
+exit:
+    return status;
+}
+
+/* Wrap a response the way the SE does for the current counter and MCV:
+ * data padded and encrypted with the response ICV, followed by R-MAC and SW. */
+static sss_status_t kat_scp03_build_response(kat_scp03_ctx_t *pCtx, NXSCP03_DynCtx_t *pDyn, size_t dataLen)
+{
+    sss_status_t status  = kStatus_SSS_Fail;
+    sss_symmetric_t symm = {0};
+    sss_mac_t mac        = {0};
+    uint8_t ivZero[16]   = {0};
+    uint8_t block[16]    = {0};
+    uint8_t icv[16]      = {0};
+    uint8_t rmac[16]     = {0};
+    size_t rmacLen       = sizeof(rmac);
+    const uint8_t sw[2]  = {0x90, 0x00};
+    size_t paddedLen     = 0;
+    size_t i             = 0;
+
+    for (i = 0; i < dataLen; i++) {
+        pCtx->rspWire[i] = (uint8_t)(0xA5 ^ i);
+    }
+    if (dataLen > 0) {
+        paddedLen              = nxSCP03_Padded_Length(dataLen);
+        pCtx->rspWire[dataLen] = 0x80;
+        memset(&pCtx->rspWire[dataLen + 1], 0, paddedLen - dataLen - 1);
+
+        memcpy(block, pDyn->cCounter, sizeof(block));
+        block[0] = 0x80;
+        status   = sss_host_symmetric_context_init(
+            &symm, &pCtx->session, &pDyn->Enc, kAlgorithm_SSS_AES_CBC, kMode_SSS_Encrypt);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        status = sss_host_cipher_one_go(&symm, ivZero, sizeof(ivZero), block, icv, sizeof(block));
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        status = sss_host_cipher_one_go(&symm, icv, sizeof(icv), pCtx->rspWire, pCtx->rspWire, paddedLen);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    }
+
+    status = sss_host_mac_context_init(&mac, &pCtx->session, &pDyn->Rmac, kAlgorithm_SSS_CMAC_AES, kMode_SSS_Mac);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_init(&mac);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_update(&mac, pDyn->MCV, sizeof(pDyn->MCV));
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    if (paddedLen > 0) {
+        status = sss_host_mac_update(&mac, pCtx->rspWire, paddedLen);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    }
+    status = sss_host_mac_update(&mac, sw, sizeof(sw));
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_finish(&mac, rmac, &rmacLen);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    memcpy(&pCtx->rspWire[paddedLen], rmac, SCP_COMMAND_MAC_SIZE);
+    memcpy(&pCtx->rspWire[paddedLen + SCP_COMMAND_MAC_SIZE], sw, sizeof(sw));
+    pCtx->rspWireLen = paddedLen + SCP_COMMAND_MAC_SIZE + sizeof(sw);
+cleanup:
+    if (symm.session != NULL) {
+        sss_host_symmetric_context_free(&symm);
+    }
+    if (mac.session != NULL) {
+        sss_host_mac_context_free(&mac);
+    }
+    return status;
+}
+
+/* Unwrap the response on pDyn, expect the data of kat_scp03_build_response */
+static sss_status_t kat_scp03_unwrap(kat_scp03_ctx_t *pCtx, NXSCP03_DynCtx_t *pDyn, size_t cmdLen, size_t dataLen)
+{
+    size_t rspLen = pCtx->rspWireLen;
+    size_t i;
+
+    memcpy(pCtx->rsp, pCtx->rspWire, rspLen);
+    if (nxpSCP03_Decrypt_ResponseAPDU(pDyn, cmdLen, pCtx->rsp, &rspLen, 0) != SCP_OK) {
+        return kStatus_SSS_Fail;
+    }
+    if ((rspLen != dataLen + 2) || (pCtx->rsp[dataLen] != 0x90) || (pCtx->rsp[dataLen + 1] != 0x00)) {
+        return kStatus_SSS_Fail;
+    }
+    for (i = 0; i < dataLen; i++) {
+        if (pCtx->rsp[i] != (uint8_t)(0xA5 ^ i)) {
+            return kStatus_SSS_Fail;
+        }
+    }
+    return kStatus_SSS_Success;
+}
+
+/* One command / response of dataLen bytes on both contexts */
+static sss_status_t kat_scp03_one(kat_scp03_ctx_t *pCtx, bool hasSession, size_t dataLen, uint8_t hasle)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    smStatus_t ret;
+    tlvHeader_t outHdr  = {{0}};
+    size_t txLen[2]     = {sizeof(pCtx->tx[0]), sizeof(pCtx->tx[1])};
+    uint8_t counter[16] = {0};
+    size_t d, i;
+
+    /* Every length starts from the same, non trivial, state */
+    for (d = 0; d < 2; d++) {
+        memset(pCtx->dyn[d].MCV, 0x3C, sizeof(pCtx->dyn[d].MCV));
+        memset(pCtx->dyn[d].cCounter, 0, sizeof(pCtx->dyn[d].cCounter));
+        pCtx->dyn[d].cCounter[14] = 0x01;
+        pCtx->dyn[d].cCounter[15] = 0xFF;
+    }
+
+    for (i = 0; i < dataLen; i++) {
+        pCtx->cmd[i] = (uint8_t)(i * 7);
+    }
+    ret = se05x_Transform_scp(&pCtx->se05x, &gCmdHdr, pCtx->cmd, dataLen, &outHdr, pCtx->tx[0], &txLen[0], hasle);
+    ENSURE_OR_GO_EXIT(ret == SM_OK);
+
+    for (i = 0; i < dataLen; i++) {
+        pCtx->cmd[i] = (uint8_t)(i * 7);
+    }
+    status = kat_scp03_wrap_copying(&pCtx->dyn[1], hasSession, pCtx->cmd, dataLen, hasle, pCtx->tx[1], &txLen[1]);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(txLen[0] == txLen[1]);
+    ENSURE_OR_GO_EXIT(memcmp(pCtx->tx[0], pCtx->tx[1], txLen[0]) == 0);
+    ENSURE_OR_GO_EXIT(memcmp(pCtx->dyn[0].MCV, pCtx->dyn[1].MCV, sizeof(pCtx->dyn[0].MCV)) == 0);
+
+    /* Both contexts are in the same state, so is the response for them */
+    status = kat_scp03_build_response(pCtx, &pCtx->dyn[0], dataLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = kat_scp03_unwrap(pCtx, &pCtx->dyn[0], txLen[0], dataLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    /* A tampered R-MAC is rejected and leaves the counter alone. The
+     * response does not depend on Le, so once per length is enough. */
+    if (!hasle) {
+        memcpy(counter, pCtx->dyn[1].cCounter, sizeof(counter));
+        pCtx->rspWire[pCtx->rspWireLen - SCP_GP_SW_LEN - 1] ^= 0x01;
+        status = kat_scp03_unwrap(pCtx, &pCtx->dyn[1], txLen[1], dataLen);
+        pCtx->rspWire[pCtx->rspWireLen - SCP_GP_SW_LEN - 1] ^= 0x01;
+        ENSURE_OR_GO_EXIT(status != kStatus_SSS_Success);
+        status = kStatus_SSS_Fail;
+        ENSURE_OR_GO_EXIT(memcmp(counter, pCtx->dyn[1].cCounter, sizeof(counter)) == 0);
+    }
+    status = kat_scp03_unwrap(pCtx, &pCtx->dyn[1], txLen[1], dataLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(memcmp(pCtx->dyn[0].cCounter, pCtx->dyn[1].cCounter, sizeof(counter)) == 0);
+    status = kStatus_SSS_Success;
+exit:
+    if (status != kStatus_SSS_Success) {
+        LOG_E("SCP03 wrap mismatch: session=%d len=%d hasle=%d", hasSession, (int)dataLen, hasle);
+    }
+    return status;
+}
+
+/* se05x_Transform_scp and the response unwrapping, as built, against the
+ * wrapping that encrypts the command in place and copies it afterwards. */
+static sss_status_t kat_scp03_wrap(void)
+{
+    sss_status_t status   = kStatus_SSS_Fail;
+    kat_scp03_ctx_t *pCtx = &gScp03;
+    int hasSession        = 0;
+    int maxSession        = 0;
+    size_t dataLen;
+    uint8_t hasle;
+
+#if SSSFTR_SE05X_AuthECKey || SSSFTR_SE05X_AuthSession
+    maxSession = 1;
+#endif
+
+    memset(pCtx, 0, sizeof(*pCtx));
+    status = kat_scp03_open(pCtx);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    for (hasSession = 0; hasSession <= maxSession; hasSession++) {
+        pCtx->se05x.hasSession = (uint8_t)hasSession;
+        memcpy(pCtx->se05x.value, gSessionId, sizeof(pCtx->se05x.value));
+        for (dataLen = 0; dataLen <= KAT_SCP03_MAX_DATA; dataLen++) {
+            for (hasle = 0; hasle <= 1; hasle++) {
+                status = kat_scp03_one(pCtx, hasSession != 0, dataLen, hasle);
+                ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+            }
+        }
+    }
+cleanup:
+    kat_scp03_close(pCtx);
+    return status;
+}
+#endif /* SSS_HAVE_SCP_SCP03_SSS */
+
+#if KAT_ECKEY_REOPEN
+/* Value of the TLV at *pIndex, NULL if malformed */
+static uint8_t *kat_eckey_tlv_get(uint8_t *buf, size_t bufLen, size_t *pIndex, uint8_t *pTag, size_t *pLen)
+{
+    size_t i = *pIndex;
+    size_t len;
+
+    if (i + 2 > bufLen) {
+        return NULL;
+    }
+    *pTag = buf[i++];
+    len   = buf[i++];
+    if (len == 0x81) {
+        ENSURE_OR_RETURN_ON_ERROR(i + 1 <= bufLen, NULL);
+        len = buf[i++];
+    }
+    else if (len == 0x82) {
+        ENSURE_OR_RETURN_ON_ERROR(i + 2 <= bufLen, NULL);
+        len = ((size_t)buf[i] << 8) | buf[i + 1];
+        i += 2;
+    }
+    ENSURE_OR_RETURN_ON_ERROR(i + len <= bufLen, NULL);
+    *pIndex = i + len;
+    *pLen   = len;
+    return &buf[i];
+}
+
+/* TLV with a two byte length, the form the host rebuilds the attested data in */
+static void kat_eckey_tlv_put(uint8_t *buf, size_t *pIndex, uint8_t tag, const uint8_t *value, size_t len)
+{
+    size_t i = *pIndex;
+
+    buf[i++] = tag;
+    buf[i++] = 0x82;
+    buf[i++] = (uint8_t)(len >> 8);
+    buf[i++] = (uint8_t)len;
+    memcpy(&buf[i], value, len);
+    *pIndex = i + len;
+}
+
+static smStatus_t kat_eckey_sw(uint8_t *rsp, size_t *rspLen, size_t o, smStatus_t sw)
+{
+    rsp[o++] = (uint8_t)(sw >> 8);
+    rsp[o++] = (uint8_t)sw;
+    *rspLen  = o;
+    return SM_OK;
+}
+
+/* Sign SHA-256( SHA-256(command APDU) || attested TLVs ) with the attestation key */
+static sss_status_t kat_eckey_attest(kat_eckey_ctx_t *pCtx,
+    uint8_t *cmdApdu,
+    size_t cmdApduLen,
+    uint8_t *tlvs,
+    size_t tlvsLen,
+    uint8_t *sig,
+    size_t *pSigLen)
+{
+    sss_status_t status   = kStatus_SSS_Fail;
+    sss_digest_t md       = {0};
+    sss_asymmetric_t asym = {0};
+    uint8_t input[32 + KAT_ECKEY_RSP_MAX];
+    size_t inputLen = 32;
+    uint8_t digest[32];
+    size_t digestLen = sizeof(digest);
+
+    ENSURE_OR_GO_CLEANUP(tlvsLen <= KAT_ECKEY_RSP_MAX);
+    status = sss_host_digest_context_init(&md, &pCtx->hostSession, kAlgorithm_SSS_SHA256, kMode_SSS_Digest);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_digest_one_go(&md, cmdApdu, cmdApduLen, input, &inputLen);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    memcpy(&input[inputLen], tlvs, tlvsLen);
+    status = sss_host_digest_one_go(&md, input, inputLen + tlvsLen, digest, &digestLen);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    status = sss_host_asymmetric_context_init(
+        &asym, &pCtx->hostSession, &pCtx->attestKey, kAlgorithm_SSS_SHA256, kMode_SSS_Sign);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_asymmetric_sign_digest(&asym, digest, digestLen, sig, pSigLen);
+cleanup:
+    if (md.session != NULL) {
+        sss_host_digest_context_free(&md);
+    }
+    if (asym.session != NULL) {
+        sss_host_asymmetric_context_free(&asym);
+    }
+    return status;
+}
+
+/* ReadObject with attestation of the ECKA public key */
+static smStatus_t kat_eckey_read_attested(
+    kat_eckey_ctx_t *pCtx, const tlvHeader_t *hdr, uint8_t *cmdBuf, size_t cmdBufLen, uint8_t *rsp, size_t *rspLen)
+{
+    /* clang-format off */
+    const uint8_t chipId[SE050_MODULE_UNIQUE_ID_LEN] = { 0x04, 0x00, 0x50, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB,
+        0xCD, 0xEF, 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC };
+    const uint8_t attribute[] = { 0x7F, 0xFF, 0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    const uint8_t objectSize[] = { 0x00, 0x20 };
+    const uint8_t timeStamp[12] = { 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03 };
+    /* clang-format on */
+    uint8_t cmdApdu[7 + 100];
+    uint8_t sig[80];
+    size_t sigLen = sizeof(sig);
+    size_t o      = 0;
+
+    ENSURE_OR_RETURN_ON_ERROR((cmdBufLen > 0) && (cmdBufLen <= 100), SM_ERR_WRONG_LENGTH);
+    /* The command as the host keeps it, with an extended length Lc */
+    memcpy(cmdApdu, hdr->hdr, sizeof(hdr->hdr));
+    cmdApdu[4] = 0x00;
+    cmdApdu[5] = 0x00;
+    cmdApdu[6] = (uint8_t)cmdBufLen;
+    memcpy(&cmdApdu[7], cmdBuf, cmdBufLen);
+
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_1, pCtx->eckaPub, sizeof(pCtx->eckaPub));
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_2, chipId, sizeof(chipId));
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_3, attribute, sizeof(attribute));
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_4, objectSize, sizeof(objectSize));
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_TIMESTAMP, timeStamp, sizeof(timeStamp));
+    if (kat_eckey_attest(pCtx, cmdApdu, 7 + cmdBufLen, rsp, o, sig, &sigLen) != kStatus_SSS_Success) {
+        return kat_eckey_sw(rsp, rspLen, 0, SM_ERR_CONDITIONS_NOT_SATISFIED);
+    }
+    kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_SIGNATURE, sig, sigLen);
+    return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+}
+
+/* Session wrapped command. Only INTERNAL AUTHENTICATE is known: remember the
+ * host ephemeral key and answer with the SE random and a receipt. The stub
+ * does no secure messaging, a wrapped command of an open session is turned
+ * down as after an SE reset. */
+static smStatus_t kat_eckey_process(
+    kat_eckey_ctx_t *pCtx, uint8_t *cmdBuf, size_t cmdBufLen, uint8_t *rsp, size_t *rspLen)
+{
+    const uint8_t tagEpk[] = {0x7F, 0x49};
+    size_t index           = 0;
+    uint8_t tag            = 0;
+    size_t len             = 0;
+    uint8_t *pInner        = NULL;
+    uint8_t *pData         = NULL;
+    size_t dataLen         = 0;
+    size_t i               = 0;
+    size_t o               = 0;
+
+    pInner = kat_eckey_tlv_get(cmdBuf, cmdBufLen, &index, &tag, &len);
+    ENSURE_OR_RETURN_ON_ERROR((pInner != NULL) && (tag == kSE05x_TAG_SESSION_ID), SM_ERR_WRONG_DATA);
+    if ((len != sizeof(gEcKeySessionId)) || (memcmp(pInner, gEcKeySessionId, len) != 0)) {
+        return kat_eckey_sw(rsp, rspLen, 0, SM_ERR_CONDITIONS_NOT_SATISFIED);
+    }
+    pInner = kat_eckey_tlv_get(cmdBuf, cmdBufLen, &index, &tag, &len);
+    ENSURE_OR_RETURN_ON_ERROR((pInner != NULL) && (tag == kSE05x_TAG_1) && (len > 5), SM_ERR_WRONG_DATA);
+    if (pInner[1] != INS_GP_INTERNAL_AUTHENTICATE) {
+        return kat_eckey_sw(rsp, rspLen, 0, SM_ERR_CONDITIONS_NOT_SATISFIED);
+    }
+
+    /* Header, Lc, control reference template, 7F49 host ephemeral key, 5F37 signature */
+    pData   = &pInner[5];
+    dataLen = pInner[4];
+    ENSURE_OR_RETURN_ON_ERROR((dataLen > 2) && (5 + dataLen <= len), SM_ERR_WRONG_DATA);
+    i = 2 + (size_t)pData[1];
+    ENSURE_OR_RETURN_ON_ERROR(i + 3 <= dataLen, SM_ERR_WRONG_DATA);
+    ENSURE_OR_RETURN_ON_ERROR(memcmp(&pData[i], tagEpk, sizeof(tagEpk)) == 0, SM_ERR_WRONG_DATA);
+    /* 0x43 0x41 || 04 || X || Y, then the key parameter reference */
+    ENSURE_OR_RETURN_ON_ERROR(i + 5 + sizeof(pCtx->hostEphemeral) <= dataLen, SM_ERR_WRONG_DATA);
+    memcpy(pCtx->hostEphemeral, &pData[i + 5], sizeof(pCtx->hostEphemeral));
+    pCtx->authenticates++;
+
+    rsp[o++] = kSE05x_GP_TAG_DR_SE;
+    rsp[o++] = 16;
+    for (i = 0; i < 16; i++) {
+        rsp[o++] = (uint8_t)(0xD0 + i + pCtx->authenticates);
+    }
+    rsp[o++] = kSE05x_GP_TAG_RECEIPT;
+    rsp[o++] = 16;
+    for (i = 0; i < 16; i++) {
+        rsp[o++] = (uint8_t)(0xE0 + i);
+    }
+    return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+}
+
+/* The secure element behind the base session of the tunnel. Knows what an
+ * ECKey session open sends. */
+static smStatus_t kat_eckey_se_txn(struct Se05xSession *pSession,
+    const tlvHeader_t *hdr,
+    uint8_t *cmdBuf,
+    size_t cmdBufLen,
+    uint8_t *rsp,
+    size_t *rspLen,
+    uint8_t hasle)
+{
+    kat_eckey_ctx_t *pCtx = &gEcKey;
+    size_t o              = 0;
+
+    (void)pSession;
+    (void)hasle;
+
+    ENSURE_OR_RETURN_ON_ERROR(*rspLen >= KAT_ECKEY_RSP_MAX, SM_ERR_WRONG_LENGTH);
+
+    switch (hdr->hdr[1]) {
+    case kSE05x_INS_MGMT:
+        if (hdr->hdr[3] == kSE05x_P2_VERSION) {
+            const uint8_t version[] = {0x07, 0x02, 0x00, 0x3F, 0xFF, 0x01, 0x0B};
+            kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_1, version, sizeof(version));
+            return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+        }
+        if (hdr->hdr[3] == kSE05x_P2_EXIST) {
+            const uint8_t result = kSE05x_Result_SUCCESS;
+            kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_1, &result, sizeof(result));
+            return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+        }
+        if (hdr->hdr[3] == kSE05x_P2_SESSION_CREATE) {
+            kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_1, gEcKeySessionId, sizeof(gEcKeySessionId));
+            return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+        }
+        break;
+    case kSE05x_INS_READ:
+        /* The attestation key */
+        kat_eckey_tlv_put(rsp, &o, kSE05x_TAG_1, pCtx->attestPub, sizeof(pCtx->attestPub));
+        return kat_eckey_sw(rsp, rspLen, o, SM_OK);
+    case kSE05x_INS_READ_With_Attestation:
+        return kat_eckey_read_attested(pCtx, hdr, cmdBuf, cmdBufLen, rsp, rspLen);
+    case kSE05x_INS_PROCESS:
+        return kat_eckey_process(pCtx, cmdBuf, cmdBufLen, rsp, rspLen);
+    default:
+        break;
+    }
+    return kat_eckey_sw(rsp, rspLen, 0, SM_ERR_COMMAND_NOT_ALLOWED);
+}
+
+/* Key pair of the stub secure element, and its raw public key */
+static sss_status_t kat_eckey_se_key(kat_eckey_ctx_t *pCtx, sss_object_t *pObj, uint32_t keyId, uint8_t *pub)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    uint8_t der[KAT_ECKEY_DER_HEADER_LEN + KAT_ECKEY_PUB_LEN + 16];
+    size_t derLen = sizeof(der);
+    size_t derBits;
+
+    status = sss_host_key_object_init(pObj, &pCtx->hostKs);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_object_allocate_handle(
+        pObj, keyId, kSSS_KeyPart_Pair, kSSS_CipherType_EC_NIST_P, 256, kKeyObject_Mode_Transient);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_generate_key(&pCtx->hostKs, pObj, 256, NULL);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_get_key(&pCtx->hostKs, pObj, der, &derLen, &derBits);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(derLen == KAT_ECKEY_DER_HEADER_LEN + KAT_ECKEY_PUB_LEN);
+    memcpy(pub, &der[KAT_ECKEY_DER_HEADER_LEN], KAT_ECKEY_PUB_LEN);
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+
+/* One ECKey session open through the tunnel. The host ephemeral key must
+ * differ from the one of the previous open. */
+static sss_status_t kat_eckey_open(kat_eckey_ctx_t *pCtx)
+{
+    sss_status_t status                = kStatus_SSS_Fail;
+    NXECKey03_StaticCtx_t *pStatic_ctx = pCtx->connectCtx.auth.ctx.eckey.pStatic_ctx;
+    uint8_t previous[KAT_ECKEY_PUB_LEN];
+    uint32_t authenticates = pCtx->authenticates;
+
+    memcpy(previous, pCtx->hostEphemeral, sizeof(previous));
+    status = sss_se05x_session_open(&pCtx->session,
+        kType_SSS_SE_SE05x,
+        kEX_SSS_objID_ECKEY_Auth,
+        kSSS_ConnectionType_Encrypted,
+        &pCtx->connectCtx);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(pCtx->authenticates == authenticates + 1);
+    ENSURE_OR_GO_EXIT(memcmp(previous, pCtx->hostEphemeral, sizeof(previous)) != 0);
+    /* Used up */
+    ENSURE_OR_GO_EXIT(pStatic_ctx->HostEcKeypair.keyStore == NULL);
+    ENSURE_OR_GO_EXIT(pCtx->session.s_ctx.authType == kSSS_AuthType_ECKey);
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+
+static void kat_eckey_close(kat_eckey_ctx_t *pCtx)
+{
+    /* The stub turns the wrapped CloseSession down, as after an SE reset */
+    if (pCtx->session.subsystem != kType_SSS_SubSystem_NONE) {
+        sss_se05x_session_close(&pCtx->session);
+    }
+}
+
+/* ECKey session open, close and open again against a stub secure element.
+ * The host ephemeral key pair is freed after each authentication, the later
+ * opens must not depend on it. With the pool, the next key comes from there. */
+static sss_status_t kat_eckey_reopen(void)
+{
+    sss_status_t status        = kStatus_SSS_Fail;
+    kat_eckey_ctx_t *pCtx      = &gEcKey;
+    SE05x_AuthCtx_ECKey_t *pEC = NULL;
+#if (__GNUC__ && !AX_EMBEDDED)
+    NXECKey03_EphemeralPoolStats_t stats = {0};
+#endif
+
+    memset(pCtx, 0, sizeof(*pCtx));
+    status = ex_sss_se05x_prepare_host(
+        &pCtx->hostSession, &pCtx->hostKs, &pCtx->connectCtx, &pCtx->auth, kSSS_AuthType_ECKey);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    pEC    = &pCtx->connectCtx.auth.ctx.eckey;
+    status = kat_eckey_se_key(pCtx, &pCtx->attestKey, __LINE__, pCtx->attestPub);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = kat_eckey_se_key(pCtx, &pCtx->eckaKey, __LINE__, pCtx->eckaPub);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    pCtx->base.subsystem      = kType_SSS_SE_SE05x;
+    pCtx->base.s_ctx.authType = kSSS_AuthType_None;
+    pCtx->base.s_ctx.fp_TXn   = &kat_eckey_se_txn;
+    status                    = sss_se05x_tunnel_context_init(&pCtx->tunnel, &pCtx->base);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    pCtx->connectCtx.connType  = kType_SE_Conn_Type_Channel;
+    pCtx->connectCtx.tunnelCtx = (sss_tunnel_t *)&pCtx->tunnel;
+
+    /* With the key pair prepared by the example code */
+    status = kat_eckey_open(pCtx);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    kat_eckey_close(pCtx);
+
+    /* Generated at open */
+    status = kat_eckey_open(pCtx);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    kat_eckey_close(pCtx);
+
+#if (__GNUC__ && !AX_EMBEDDED)
+    /* Taken from the pool */
+    status = nxECKey_StartEphemeralPool(pEC->pStatic_ctx, 1);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = nxECKey_RefillEphemeralPool(pEC->pStatic_ctx);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = kat_eckey_open(pCtx);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = nxECKey_GetEphemeralPoolStats(pEC->pStatic_ctx, &stats);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_CLEANUP((stats.taken == 1) && (stats.misses == 0));
+    status = kStatus_SSS_Success;
+#endif
+cleanup:
+    kat_eckey_close(pCtx);
+    if (pEC != NULL) {
+#if (__GNUC__ && !AX_EMBEDDED)
+        nxECKey_StopEphemeralPool(pEC->pStatic_ctx);
+#endif
+        sss_host_key_object_free(&pEC->pStatic_ctx->HostEcdsaObj);
+        sss_host_key_object_free(&pEC->pStatic_ctx->HostEcKeypair);
+        sss_host_key_object_free(&pEC->pStatic_ctx->masterSec);
+        sss_host_key_object_free(&pEC->pStatic_ctx->SeEcPubKey);
+        sss_host_key_object_free(&pEC->pDyn_ctx->Enc);
+        sss_host_key_object_free(&pEC->pDyn_ctx->Mac);
+        sss_host_key_object_free(&pEC->pDyn_ctx->Rmac);
+    }
+    if (pCtx->tunnel.se05x_session != NULL) {
+        sss_se05x_tunnel_context_free(&pCtx->tunnel);
+    }
+    if (pCtx->hostKs.session != NULL) {
+        sss_host_key_object_free(&pCtx->attestKey);
+        sss_host_key_object_free(&pCtx->eckaKey);
+        sss_host_key_store_context_free(&pCtx->hostKs);
+    }
+    if (pCtx->hostSession.subsystem != kType_SSS_SubSystem_NONE) {
+        sss_host_session_close(&pCtx->hostSession);
+    }
+    return status;
+}
+#endif /* KAT_ECKEY_REOPEN */
+
+static const kat_case_t gCases[] = {
+    {"HMAC_DRBG SHA-256 (CAVP)", &kat_hmac_drbg},
+#if defined(T1oI2C)
+    {"T=1oI2C CRC-16/X.25", &kat_t1oi2c_crc},
+#endif
+#if (__GNUC__ && !AX_EMBEDDED)
+    {"smComAsync callback / wait order", &kat_smcom_async},
+#endif
+#if SSS_HAVE_SCP_SCP03_SSS
+    {"SCP03 wrap / unwrap, 0..880 bytes", &kat_scp03_wrap},
+#endif
+#if KAT_ECKEY_REOPEN
+    {"ECKey session open / close / re-open", &kat_eckey_reopen},
+#endif
+};
+
+/* ************************************************************************** */
+/* Public Functions                                                           */
+/* ************************************************************************** */
+
+int main(int argc, const char *argv[])
+{
+    int failures = 0;
+    size_t c;
+
+    (void)argc;
+    (void)argv;
+
+    for (c = 0; c < sizeof(gCases) / sizeof(gCases[0]); c++) {
+        if (gCases[c].fn() == kStatus_SSS_Success) {
+            LOG_I("%-40s pass", gCases[c].name);
+        }
+        else {
+            LOG_E("%-40s FAIL", gCases[c].name);
+            failures++;
+        }
+    }
+
+    if (failures == 0) {
+        LOG_I("ex_sss_kat Example Success !!!...");
+    }
+    else {
+        LOG_E("ex_sss_kat Example Failed !!!... (%d failures)", failures);
+    }
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,675 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/** @file
+ *
+ * ex_sss_scp03_bench.c:  Host side cost of the SE05x secure channel
+ *
+ * Runs the SCP03 command wrapping / response unwrapping and the session key
+ * derivation against the host crypto only, no secure element is needed.
+ * Reports time, host crypto allocations, bytes copied by the middleware and
+ * wire bytes per operation.
+ *
+ * Usage: ex_scp03_bench [min_ms_per_row]
+ *
+ * Returns non zero if any operation fails, so it can run as a CI check.
+ */
+
+/* ************************************************************************** */
+/* Includes                                                                   */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <fsl_sss_api.h>
+#include <fsl_sss_se05x_apis.h>
+#include <nxEnsure.h>
+#include <nxLog_App.h>
+#include <nxScp03_Apis.h>
+#include <se05x_tlv.h>
+
+#if SSS_HAVE_HOSTCRYPTO_OPENSSL
+#include <fsl_sss_openssl_apis.h>
+#include <openssl/crypto.h>
+#endif
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS
+#include <fsl_sss_mbedtls_apis.h>
+#endif
+
+#if SSS_HAVE_SCP_SCP03_SSS && (SSS_HAVE_HOSTCRYPTO_OPENSSL || SSS_HAVE_HOSTCRYPTO_MBEDTLS)
+
+/* ************************************************************************** */
+/* Local Defines                                                              */
+/* ************************************************************************** */
+
+/** Largest command / response payload */
+#define BENCH_MAX_PAYLOAD 1024
+
+/** Room for header, Lc, padding and MAC around the payload */
+#define BENCH_BUF_SIZE (BENCH_MAX_PAYLOAD + 64)
+
+/** Default wall clock time per result row */
+#ifndef BENCH_DEFAULT_MIN_MS
+#define BENCH_DEFAULT_MIN_MS 100
+#endif
+
+/** Fewer iterations are not reported */
+#define BENCH_MIN_ITERATIONS 16
+
+/** Set by the build when memcpy/memmove are linked to the counting wrappers */
+#ifndef BENCH_COUNT_COPIES
+#define BENCH_COUNT_COPIES 0
+#endif
+
+/* ************************************************************************** */
+/* Structures and Typedefs                                                    */
+/* ************************************************************************** */
+
+typedef struct
+{
+    sss_session_t session;
+    sss_key_store_t ks;
+    NXSCP03_DynCtx_t dyn;
+    sss_object_t masterSec;
+    struct Se05xSession se05x;
+    uint8_t cmd[BENCH_BUF_SIZE];
+    uint8_t tx[BENCH_BUF_SIZE];
+    uint8_t rsp[BENCH_BUF_SIZE];
+    size_t rspLen;
+    /* Response as received from the SE, restored before each unwrap */
+    uint8_t rspWire[BENCH_BUF_SIZE];
+    size_t rspWireLen;
+    uint8_t cCounter[16];
+    /* Accumulated over the timed sections of one row */
+    uint64_t ns;
+    uint64_t tStart;
+    size_t wireBytes;
+} bench_ctx_t;
+
+/** One operation. Only the part between bench_begin and bench_end counts. */
+typedef sss_status_t (*bench_op_t)(bench_ctx_t *pCtx, size_t payloadLen);
+
+typedef struct
+{
+    const char *name;
+    bench_op_t setup; //!< Once per row, may be NULL
+    bench_op_t op;
+    bool sized; //!< Run for every payload size, else only once
+} bench_case_t;
+
+/* ************************************************************************** */
+/* Global Variables                                                           */
+/* ************************************************************************** */
+
+static const size_t gPayloadSizes[] = {0, 16, 64, 256, 512, BENCH_MAX_PAYLOAD};
+
+/* Allocations of the host crypto, counted while an operation is timed */
+static volatile int gCounting;
+static size_t gAllocCount;
+static size_t gAllocBytes;
+
+/* Bytes copied with memcpy/memmove by the middleware (not the host crypto
+ * library), counted while an operation is timed */
+static size_t gCopyBytes;
+
+/* clang-format off */
+static const uint8_t gKeyEnc[16]  = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                                      0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F };
+static const uint8_t gKeyMac[16]  = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+                                      0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F };
+static const uint8_t gKeyRmac[16] = { 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+                                      0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F };
+/* clang-format on */
+
+static const tlvHeader_t gCmdHdr = {{0x80, 0x01, 0x01, 0x00}};
+
+/* ************************************************************************** */
+/* Static function declarations                                               */
+/* ************************************************************************** */
+
+static uint64_t bench_now_ns(void);
+static void bench_begin(bench_ctx_t *pCtx);
+static void bench_end(bench_ctx_t *pCtx);
+static sss_status_t bench_open(bench_ctx_t *pCtx);
+static void bench_close(bench_ctx_t *pCtx);
+static sss_status_t bench_build_response(bench_ctx_t *pCtx, size_t payloadLen);
+
+/* ************************************************************************** */
+/* Private Functions                                                          */
+/* ************************************************************************** */
+
+#if BENCH_COUNT_COPIES
+void *__real_memcpy(void *dest, const void *src, size_t n);
+void *__real_memmove(void *dest, const void *src, size_t n);
+
+void *__wrap_memcpy(void *dest, const void *src, size_t n)
+{
+    if (gCounting) {
+        gCopyBytes += n;
+    }
+    return __real_memcpy(dest, src, n);
+}
+
+void *__wrap_memmove(void *dest, const void *src, size_t n)
+{
+    if (gCounting) {
+        gCopyBytes += n;
+    }
+    return __real_memmove(dest, src, n);
+}
+#endif
+
+#if SSS_HAVE_HOSTCRYPTO_OPENSSL
+static void *bench_malloc(size_t num, const char *file, int line)
+{
+    (void)file;
+    (void)line;
+    if (gCounting) {
+        gAllocCount++;
+        gAllocBytes += num;
+    }
+    return malloc(num);
+}
+
+static void *bench_realloc(void *addr, size_t num, const char *file, int line)
+{
+    (void)file;
+    (void)line;
+    if (gCounting) {
+        gAllocCount++;
+        gAllocBytes += num;
+    }
+    return realloc(addr, num);
+}
+
+static void bench_free(void *addr, const char *file, int line)
+{
+    (void)file;
+    (void)line;
+    free(addr);
+}
+#endif
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_begin(bench_ctx_t *pCtx)
+{
+    gCounting    = 1;
+    pCtx->tStart = bench_now_ns();
+}
+
+static void bench_end(bench_ctx_t *pCtx)
+{
+    pCtx->ns += bench_now_ns() - pCtx->tStart;
+    gCounting = 0;
+}
+
+static sss_status_t bench_key_object(bench_ctx_t *pCtx, sss_object_t *pObj, uint32_t keyId, const uint8_t *key)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+
+    status = sss_host_key_object_init(pObj, &pCtx->ks);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_object_allocate_handle(
+        pObj, keyId, kSSS_KeyPart_Default, kSSS_CipherType_AES, 16, kKeyObject_Mode_Transient);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_set_key(&pCtx->ks, pObj, key, 16, 16 * 8, NULL, 0);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+exit:
+    return status;
+}
+
+static sss_status_t bench_open(bench_ctx_t *pCtx)
+{
+    sss_status_t status      = kStatus_SSS_Fail;
+    sss_type_t hostsubsystem = kType_SSS_SubSystem_NONE;
+
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS
+    hostsubsystem = kType_SSS_mbedTLS;
+#elif SSS_HAVE_HOSTCRYPTO_OPENSSL
+    hostsubsystem = kType_SSS_OpenSSL;
+#endif
+
+    status = sss_host_session_open(&pCtx->session, hostsubsystem, 0, kSSS_ConnectionType_Plain, NULL);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_context_init(&pCtx->ks, &pCtx->session);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_host_key_store_allocate(&pCtx->ks, __LINE__);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    status = bench_key_object(pCtx, &pCtx->dyn.Enc, __LINE__, gKeyEnc);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = bench_key_object(pCtx, &pCtx->dyn.Mac, __LINE__, gKeyMac);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = bench_key_object(pCtx, &pCtx->dyn.Rmac, __LINE__, gKeyRmac);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = bench_key_object(pCtx, &pCtx->masterSec, __LINE__, gKeyEnc);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+
+    pCtx->dyn.authType       = kSSS_AuthType_SCP03;
+    pCtx->dyn.cCounter[15]   = 1;
+    pCtx->se05x.pdynScp03Ctx = &pCtx->dyn;
+exit:
+    return status;
+}
+
+static void bench_close(bench_ctx_t *pCtx)
+{
+    nxScp03_Free_HostContexts(&pCtx->dyn);
+    if (pCtx->ks.session != NULL) {
+        sss_host_key_object_free(&pCtx->dyn.Enc);
+        sss_host_key_object_free(&pCtx->dyn.Mac);
+        sss_host_key_object_free(&pCtx->dyn.Rmac);
+        sss_host_key_object_free(&pCtx->masterSec);
+        sss_host_key_store_context_free(&pCtx->ks);
+    }
+    if (pCtx->session.subsystem != kType_SSS_SubSystem_NONE) {
+        sss_host_session_close(&pCtx->session);
+    }
+}
+
+/* Wrap a response the way the SE does for the current counter and MCV:
+ * data padded and encrypted with the response ICV, followed by R-MAC and SW. */
+static sss_status_t bench_build_response(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    sss_status_t status  = kStatus_SSS_Fail;
+    sss_symmetric_t symm = {0};
+    sss_mac_t mac        = {0};
+    uint8_t ivZero[16]   = {0};
+    uint8_t block[16]    = {0};
+    uint8_t icv[16]      = {0};
+    uint8_t rmac[16]     = {0};
+    size_t rmacLen       = sizeof(rmac);
+    const uint8_t sw[2]  = {0x90, 0x00};
+    size_t paddedLen     = 0;
+    size_t i             = 0;
+
+    for (i = 0; i < payloadLen; i++) {
+        pCtx->rspWire[i] = (uint8_t)(0xA5 ^ i);
+    }
+    if (payloadLen > 0) {
+        paddedLen                 = nxSCP03_Padded_Length(payloadLen);
+        pCtx->rspWire[payloadLen] = 0x80;
+        memset(&pCtx->rspWire[payloadLen + 1], 0, paddedLen - payloadLen - 1);
+
+        memcpy(block, pCtx->dyn.cCounter, sizeof(block));
+        block[0] = 0x80;
+        status   = sss_host_symmetric_context_init(
+            &symm, &pCtx->session, &pCtx->dyn.Enc, kAlgorithm_SSS_AES_CBC, kMode_SSS_Encrypt);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        status = sss_host_cipher_one_go(&symm, ivZero, sizeof(ivZero), block, icv, sizeof(block));
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        status = sss_host_cipher_one_go(&symm, icv, sizeof(icv), pCtx->rspWire, pCtx->rspWire, paddedLen);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    }
+
+    status = sss_host_mac_context_init(&mac, &pCtx->session, &pCtx->dyn.Rmac, kAlgorithm_SSS_CMAC_AES, kMode_SSS_Mac);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_init(&mac);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_update(&mac, pCtx->dyn.MCV, sizeof(pCtx->dyn.MCV));
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    if (paddedLen > 0) {
+        status = sss_host_mac_update(&mac, pCtx->rspWire, paddedLen);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    }
+    status = sss_host_mac_update(&mac, sw, sizeof(sw));
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_mac_finish(&mac, rmac, &rmacLen);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    memcpy(&pCtx->rspWire[paddedLen], rmac, 8);
+    memcpy(&pCtx->rspWire[paddedLen + 8], sw, sizeof(sw));
+    pCtx->rspWireLen = paddedLen + 8 + sizeof(sw);
+cleanup:
+    if (symm.session != NULL) {
+        sss_host_symmetric_context_free(&symm);
+    }
+    if (mac.session != NULL) {
+        sss_host_mac_context_free(&mac);
+    }
+    return status;
+}
+
+static void bench_fill_command(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    size_t i;
+    for (i = 0; i < payloadLen; i++) {
+        pCtx->cmd[i] = (uint8_t)(i * 7);
+    }
+}
+
+/* ************************************************************************** */
+/* Benchmarked operations                                                     */
+/* ************************************************************************** */
+
+static sss_status_t op_encrypt(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    size_t cmdLen       = payloadLen;
+
+    bench_fill_command(pCtx, payloadLen);
+    bench_begin(pCtx);
+    status = nxSCP03_Encrypt_CommandAPDU(&pCtx->dyn, pCtx->cmd, &cmdLen);
+    bench_end(pCtx);
+    pCtx->wireBytes += cmdLen;
+    return status;
+}
+
+static sss_status_t op_cmac(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    uint8_t mac[16]     = {0};
+    size_t macLen       = sizeof(mac);
+
+    /* Header, extended Lc and data, as MACed by se05x_Transform_scp */
+    memcpy(pCtx->cmd, gCmdHdr.hdr, sizeof(gCmdHdr.hdr));
+    pCtx->cmd[4] = 0x00;
+    pCtx->cmd[5] = (uint8_t)((payloadLen + 8) >> 8);
+    pCtx->cmd[6] = (uint8_t)(payloadLen + 8);
+    memset(&pCtx->cmd[7], 0x5A, payloadLen);
+
+    bench_begin(pCtx);
+    status = nxpSCP03_CalculateMac_CommandAPDU(&pCtx->dyn, pCtx->cmd, payloadLen + 7, mac, &macLen);
+    bench_end(pCtx);
+    pCtx->wireBytes += 8;
+    return status;
+}
+
+static sss_status_t setup_decrypt(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    memcpy(pCtx->cCounter, pCtx->dyn.cCounter, sizeof(pCtx->cCounter));
+    return bench_build_response(pCtx, payloadLen);
+}
+
+static sss_status_t op_decrypt(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    uint16_t scpStatus;
+
+    /* Unwrapping is in place and increments the counter, start over */
+    memcpy(pCtx->rsp, pCtx->rspWire, pCtx->rspWireLen);
+    pCtx->rspLen = pCtx->rspWireLen;
+    memcpy(pCtx->dyn.cCounter, pCtx->cCounter, sizeof(pCtx->cCounter));
+
+    bench_begin(pCtx);
+    scpStatus = nxpSCP03_Decrypt_ResponseAPDU(&pCtx->dyn, 1, pCtx->rsp, &pCtx->rspLen, 0);
+    bench_end(pCtx);
+    pCtx->wireBytes += pCtx->rspWireLen;
+    if ((scpStatus != SCP_OK) || (pCtx->rspLen != payloadLen + 2)) {
+        return kStatus_SSS_Fail;
+    }
+    return kStatus_SSS_Success;
+}
+
+static sss_status_t op_transform(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    smStatus_t ret;
+    tlvHeader_t outHdr = {{0}};
+    size_t txLen       = sizeof(pCtx->tx);
+
+    bench_fill_command(pCtx, payloadLen);
+    bench_begin(pCtx);
+    ret = se05x_Transform(&pCtx->se05x, &gCmdHdr, pCtx->cmd, payloadLen, &outHdr, pCtx->tx, &txLen, 0);
+    bench_end(pCtx);
+    pCtx->wireBytes += sizeof(outHdr.hdr) + txLen;
+    return (ret == SM_OK) ? kStatus_SSS_Success : kStatus_SSS_Fail;
+}
+
+static sss_status_t op_transform_scp(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    smStatus_t ret;
+    tlvHeader_t outHdr = {{0}};
+    size_t txLen       = sizeof(pCtx->tx);
+
+    bench_fill_command(pCtx, payloadLen);
+    bench_begin(pCtx);
+    ret = se05x_Transform_scp(&pCtx->se05x, &gCmdHdr, pCtx->cmd, payloadLen, &outHdr, pCtx->tx, &txLen, 0);
+    bench_end(pCtx);
+    pCtx->wireBytes += txLen;
+    return (ret == SM_OK) ? kStatus_SSS_Success : kStatus_SSS_Fail;
+}
+
+/* Host work on the critical path of one APDU: wrap the command, unwrap the
+ * response. What the SE would do in between is not timed. */
+static sss_status_t bench_roundtrip(bench_ctx_t *pCtx, size_t payloadLen, bool pipelined)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    smStatus_t ret;
+    uint16_t scpStatus;
+    tlvHeader_t outHdr = {{0}};
+    size_t txLen       = sizeof(pCtx->tx);
+
+    bench_fill_command(pCtx, payloadLen);
+    bench_begin(pCtx);
+    ret = se05x_Transform_scp(&pCtx->se05x, &gCmdHdr, pCtx->cmd, payloadLen, &outHdr, pCtx->tx, &txLen, 0);
+    bench_end(pCtx);
+    ENSURE_OR_GO_EXIT(ret == SM_OK);
+    pCtx->wireBytes += txLen;
+
+    /* The SE processes the command */
+    status = bench_build_response(pCtx, payloadLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    memcpy(pCtx->rsp, pCtx->rspWire, pCtx->rspWireLen);
+    pCtx->rspLen = pCtx->rspWireLen;
+#if NX_SCP03_PIPELINED_ICV
+    if (pipelined) {
+        /* As run by the T=1oI2C layer while it waits for the response */
+        nxScp03_Precompute_ICV(&pCtx->dyn);
+    }
+#else
+    (void)pipelined;
+#endif
+
+    bench_begin(pCtx);
+    scpStatus = nxpSCP03_Decrypt_ResponseAPDU(&pCtx->dyn, 1, pCtx->rsp, &pCtx->rspLen, 0);
+    bench_end(pCtx);
+    pCtx->wireBytes += pCtx->rspWireLen;
+    status = (scpStatus == SCP_OK) ? kStatus_SSS_Success : kStatus_SSS_Fail;
+exit:
+    return status;
+}
+
+static sss_status_t op_roundtrip(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    return bench_roundtrip(pCtx, payloadLen, false);
+}
+
+static sss_status_t op_roundtrip_pipelined(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    return bench_roundtrip(pCtx, payloadLen, true);
+}
+
+/* Host side of the ECKey session set up (fsl_sss_se05x_eckey.c): master
+ * secret from the ECDH shared secret, session keys and initial MCV. */
+static sss_status_t op_eckey_session_keys(bench_ctx_t *pCtx, size_t payloadLen)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    sss_digest_t md     = {0};
+    uint8_t derivationInput[4 + 32 + 16 + 4];
+    uint8_t masterSk[32];
+    size_t masterSkLen = sizeof(masterSk);
+    uint8_t ddA[128];
+    uint16_t ddALen;
+    uint8_t key[16];
+    uint32_t keyLen;
+    const uint8_t ddConstants[] = {
+        DATA_DERIVATION_SENC, DATA_DERIVATION_SMAC, DATA_DERIVATION_SRMAC, DATA_DERIVATION_INITIAL_MCV};
+    sss_object_t *keyObjs[] = {&pCtx->dyn.Enc, &pCtx->dyn.Mac, &pCtx->dyn.Rmac, NULL};
+    size_t i;
+
+    (void)payloadLen;
+    /* kdf counter, shared secret, random, SCP parameters */
+    memset(derivationInput, 0x3C, sizeof(derivationInput));
+
+    bench_begin(pCtx);
+    nxScp03_Free_HostContexts(&pCtx->dyn);
+    status = sss_host_digest_context_init(&md, &pCtx->session, kAlgorithm_SSS_SHA256, kMode_SSS_Digest);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_digest_one_go(&md, derivationInput, sizeof(derivationInput), masterSk, &masterSkLen);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_key_store_set_key(&pCtx->ks, &pCtx->masterSec, masterSk, 16, 16 * 8, NULL, 0);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+
+    for (i = 0; i < sizeof(ddConstants); i++) {
+        ddALen = sizeof(ddA);
+        keyLen = sizeof(key);
+        nxScp03_setDerivationData(
+            ddA, &ddALen, ddConstants[i], DATA_DERIVATION_L_128BIT, DATA_DERIVATION_KDF_CTR, NULL, 0);
+        status = nxScp03_Generate_SessionKey(&pCtx->masterSec, ddA, ddALen, key, &keyLen);
+        ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        if (keyObjs[i] != NULL) {
+            status = sss_host_key_store_set_key(&pCtx->ks, keyObjs[i], key, 16, 16 * 8, NULL, 0);
+            ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+        }
+        else {
+            memcpy(pCtx->dyn.MCV, key, sizeof(pCtx->dyn.MCV));
+        }
+    }
+cleanup:
+    if (md.session != NULL) {
+        sss_host_digest_context_free(&md);
+    }
+    bench_end(pCtx);
+    return status;
+}
+
+static const bench_case_t gCases[] = {
+    {"nxSCP03_Encrypt_CommandAPDU", NULL, &op_encrypt, true},
+    {"nxpSCP03_CalculateMac_Command", NULL, &op_cmac, true},
+    {"nxpSCP03_Decrypt_ResponseAPDU", &setup_decrypt, &op_decrypt, true},
+    {"se05x_Transform", NULL, &op_transform, true},
+    {"se05x_Transform_scp", NULL, &op_transform_scp, true},
+    {"apdu_roundtrip", NULL, &op_roundtrip, true},
+    {"apdu_roundtrip_pipelined", NULL, &op_roundtrip_pipelined, true},
+    {"eckey_session_keys", NULL, &op_eckey_session_keys, false},
+};
+
+static sss_status_t bench_row(bench_ctx_t *pCtx, const bench_case_t *pCase, size_t payloadLen, uint64_t minNs)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    uint64_t wallStart  = 0;
+    size_t iterations   = 0;
+    uint32_t hits       = 0;
+
+    pCtx->ns        = 0;
+    pCtx->wireBytes = 0;
+    gAllocCount     = 0;
+    gAllocBytes     = 0;
+    gCopyBytes      = 0;
+
+    if (pCase->setup != NULL) {
+        status = pCase->setup(pCtx, payloadLen);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    }
+    /* Once untimed, sets up the session contexts */
+    status = pCase->op(pCtx, payloadLen);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    pCtx->ns        = 0;
+    pCtx->wireBytes = 0;
+    gAllocCount     = 0;
+    gAllocBytes     = 0;
+    gCopyBytes      = 0;
+    hits            = pCtx->dyn.icvHits;
+
+    wallStart = bench_now_ns();
+    while ((iterations < BENCH_MIN_ITERATIONS) || ((bench_now_ns() - wallStart) < minNs)) {
+        status = pCase->op(pCtx, payloadLen);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        iterations++;
+    }
+
+    LOG_I("%-30s %5u B %10.1f ns/op %6.2f allocs/op %8.1f alloc B/op %6u copy B/op %6u wire B/op %5.2f ICV hits/op",
+        pCase->name,
+        (unsigned)payloadLen,
+        (double)pCtx->ns / (double)iterations,
+        (double)gAllocCount / (double)iterations,
+        (double)gAllocBytes / (double)iterations,
+        (unsigned)(gCopyBytes / iterations),
+        (unsigned)(pCtx->wireBytes / iterations),
+        (double)(pCtx->dyn.icvHits - hits) / (double)iterations);
+exit:
+    if (status != kStatus_SSS_Success) {
+        LOG_E("%s (%u B) failed", pCase->name, (unsigned)payloadLen);
+    }
+    return status;
+}
+
+/* ************************************************************************** */
+/* Public Functions                                                           */
+/* ************************************************************************** */
+
+int main(int argc, const char *argv[])
+{
+    static bench_ctx_t ctx;
+    sss_status_t status = kStatus_SSS_Fail;
+    int failures        = 0;
+    uint64_t minNs      = (uint64_t)BENCH_DEFAULT_MIN_MS * 1000000ull;
+    size_t c, s;
+
+    if (argc > 1) {
+        minNs = (uint64_t)strtoul(argv[1], NULL, 10) * 1000000ull;
+    }
+
+#if SSS_HAVE_HOSTCRYPTO_OPENSSL
+    /* Before the first allocation of OpenSSL */
+    if (CRYPTO_set_mem_functions(&bench_malloc, &bench_realloc, &bench_free) == 0) {
+        LOG_W("Allocations of OpenSSL can not be counted");
+    }
+#else
+    LOG_W("Allocations of the host crypto are not counted");
+#endif
+#if !BENCH_COUNT_COPIES
+    LOG_W("Bytes copied are not counted with this compiler");
+#endif
+
+    status = bench_open(&ctx);
+    if (status != kStatus_SSS_Success) {
+        LOG_E("Host crypto session could not be opened");
+        failures++;
+        goto exit;
+    }
+
+    for (c = 0; c < sizeof(gCases) / sizeof(gCases[0]); c++) {
+        for (s = 0; s < sizeof(gPayloadSizes) / sizeof(gPayloadSizes[0]); s++) {
+            if (bench_row(&ctx, &gCases[c], gPayloadSizes[s], minNs) != kStatus_SSS_Success) {
+                failures++;
+            }
+            if (!gCases[c].sized) {
+                break;
+            }
+        }
+    }
+
+exit:
+    bench_close(&ctx);
+    if (failures == 0) {
+        LOG_I("ex_scp03_bench Example Success !!!...");
+    }
+    else {
+        LOG_E("ex_scp03_bench Example Failed !!!... (%d failures)", failures);
+    }
+    return (failures == 0) ? 0 : 1;
+}
+
+#else
+
+int main(int argc, const char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    LOG_E("ex_scp03_bench needs PlatfSCP03 (SSS_HAVE_SCP_SCP03_SSS) and a host crypto");
+    return 1;
+}
+
+#endif /* SSS_HAVE_SCP_SCP03_SSS && (SSS_HAVE_HOSTCRYPTO_OPENSSL || SSS_HAVE_HOSTCRYPTO_MBEDTLS) */
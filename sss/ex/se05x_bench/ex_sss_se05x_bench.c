@@ -0,0 +1,935 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/** @file
+ *
+ * ex_sss_se05x_bench.c:  APDU cost of SE05x middleware sequences
+ *
+ * Runs the middleware against a simulated secure element, no hardware is
+ * needed. Each row reports the APDUs and wire bytes the middleware spends,
+ * and a throughput modelled from them (BENCH_LINK_US_PER_APDU,
+ * BENCH_LINK_NS_PER_BYTE) plus the measured host time. "before" rows replay
+ * the previous algorithm against the same simulator.
+ *
+ * The link model is an estimate. APDU and byte counts are exact.
+ *
+ * The T=1oI2C rows run the real T=1 stack over a simulated I2C bus (this
+ * file implements axI2CInit/axI2CRead/axI2CWrite instead of
+ * platform/linux/i2c_a7.c). The SE NACKs reads while it processes a command,
+ * like the real one, and the driver back off delay is the one of the Linux
+ * driver. The rows count the bus transactions and time every APDU with the
+ * fixed 1 ms polling and with the learned latency model.
+ *
+ * The CRC rows time the frame CRC of the T=1 stack (table driven, unless
+ * built with T1OI2C_CRC_BITWISE) against the bitwise CRC-16/X.25.
+ *
+ * Usage: ex_se05x_bench
+ *
+ * Returns non zero if any operation fails or returns wrong data, so it can
+ * run as a CI check.
+ */
+
+/* ************************************************************************** */
+/* Includes                                                                   */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <fsl_sss_api.h>
+#include <fsl_sss_se05x_apis.h>
+#include <i2c_a7.h>
+#include <nxEnsure.h>
+#include <nxLog_App.h>
+#include <phNxpEsePal_i2c.h>
+#include <phNxpEseProto7816_3.h>
+#include <se05x_APDU.h>
+#include <se05x_const.h>
+#include <se05x_tlv.h>
+#include <smCom.h>
+#include <smComT1oI2C.h>
+#include <unistd.h>
+
+/* ************************************************************************** */
+/* Local Defines                                                              */
+/* ************************************************************************** */
+
+/** Bytes streamed through sss_cipher_update() per row */
+#define BENCH_STREAM_SIZE (64 * 1024)
+
+/** Link model: fixed cost of one APDU (T=1 framing, polling, SE dispatch) */
+#ifndef BENCH_LINK_US_PER_APDU
+#define BENCH_LINK_US_PER_APDU 600
+#endif
+
+/** Link model: one byte on the wire, about 1 MHz I2C with T=1 framing */
+#ifndef BENCH_LINK_NS_PER_BYTE
+#define BENCH_LINK_NS_PER_BYTE 10000
+#endif
+
+/** Chunk size of the cipher update before coalescing (CIPHER_UPDATE_MAX_DATA) */
+#define BENCH_BEFORE_CIPHER_CHUNK 448
+
+/** The simulated SE XORs the data of a cipher update with this */
+#define BENCH_SIM_CIPHER_XOR 0x5A
+
+/** T=1oI2C rows: timed APDUs per command and polling mode */
+#define BENCH_I2C_ITERATIONS 20
+
+/** T=1oI2C rows: APDUs per command before timing, for the model to learn */
+#define BENCH_I2C_WARMUP 4
+
+/** Simulated SE: time to prepare a frame other than the response to a command */
+#define BENCH_I2C_FRAME_US 100
+
+/** Simulated SE: largest command and response APDU */
+#define BENCH_I2C_MAX_APDU 1024
+
+/** Simulated SE: largest INF of the I-frames it sends */
+#define BENCH_I2C_SE_IFS 254
+
+/** Simulated SE: NAD of the frames it sends */
+#define BENCH_I2C_SE_NAD 0xA5
+
+/** CRC rows: bytes run through each CRC per frame size */
+#define BENCH_CRC_BYTES (4 * 1024 * 1024)
+
+/* ************************************************************************** */
+/* Structures and Typedefs                                                    */
+/* ************************************************************************** */
+
+/** What the simulated SE saw */
+typedef struct
+{
+    size_t apdus;
+    size_t wireBytes;
+} bench_sim_t;
+
+typedef struct
+{
+    sss_se05x_session_t session;
+    sss_se05x_symmetric_t symm;
+    uint8_t in[BENCH_STREAM_SIZE];
+    uint8_t out[BENCH_STREAM_SIZE];
+} bench_ctx_t;
+
+/** A command the simulated SE on the I2C bus knows */
+typedef struct
+{
+    const char *name;
+    uint8_t hdr[4];  /* CLA INS P1 P2 */
+    size_t cmdLen;   /* Command data */
+    size_t rspLen;   /* Response data, without SW */
+    uint32_t seUs;   /* SE processing time, +/- 1/16 */
+} bench_i2c_cmd_t;
+
+/** What happened on the I2C bus */
+typedef struct
+{
+    size_t reads;    /* Read transactions */
+    size_t nacks;    /* Reads the SE NACKed, busy or nothing to send */
+    size_t writes;   /* Write transactions */
+    size_t frames;   /* Frames read completely by the host */
+    uint64_t seNs;   /* SE processing time of the commands */
+    uint64_t idleNs; /* Frames ready, but not yet read by the host */
+} bench_i2c_count_t;
+
+/** The simulated SE on the I2C bus */
+typedef struct
+{
+    uint8_t apdu[BENCH_I2C_MAX_APDU]; /* Command APDU received so far */
+    size_t apduLen;
+    uint8_t rsp[BENCH_I2C_MAX_APDU]; /* Response APDU */
+    size_t rspLen;
+    size_t rspOffset; /* Response bytes already sent in I-frames */
+    uint8_t seqNo;    /* N(S) of the next I-frame of the SE */
+    uint8_t frame[MAX_DATA_LEN]; /* Frame the host reads next */
+    size_t frameLen;
+    size_t frameOffset; /* Frame bytes already read, frame pending while < frameLen */
+    uint64_t readyNs;   /* Frame can be read from */
+    int backoffDelay;   /* Driver back off delay (ms), as platform/linux/i2c_a7.c */
+    uint32_t rng;
+    size_t errors; /* Malformed frames and transactions */
+    bench_i2c_count_t count;
+} bench_i2c_sim_t;
+
+/** One command in one polling mode */
+typedef struct
+{
+    size_t apdus;
+    uint64_t hostNs;
+    bench_i2c_count_t count;
+} bench_i2c_row_t;
+
+/** Streams srcLen bytes, like sss_se05x_cipher_update() */
+typedef sss_status_t (*bench_update_t)(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen);
+
+/* ************************************************************************** */
+/* Global Variables                                                           */
+/* ************************************************************************** */
+
+static const size_t gRecordSizes[] = {16, 64, 100, 250, 256, 500, 1000, 1500, 4096};
+
+static bench_sim_t gSim;
+
+static const bench_i2c_cmd_t gI2cCmds[] = {
+    {"GetVersion", {kSE05x_CLA, kSE05x_INS_MGMT, kSE05x_P1_DEFAULT, kSE05x_P2_VERSION}, 0, 7, 300},
+    {"ReadObject 400 B", {kSE05x_CLA, kSE05x_INS_READ, kSE05x_P1_DEFAULT, kSE05x_P2_DEFAULT}, 6, 400, 1500},
+    {"ECDSASign", {kSE05x_CLA, kSE05x_INS_CRYPTO, kSE05x_P1_SIGNATURE, kSE05x_P2_SIGN}, 40, 72, 12000},
+    {"WriteBinary 600 B", {kSE05x_CLA, kSE05x_INS_WRITE, kSE05x_P1_BINARY, kSE05x_P2_DEFAULT}, 600, 0, 4000},
+};
+
+/* ATR of the simulated SE: PVER, VID, DLLP (BWT, IFSC 254), PLID, PLP, HB */
+/* Frame sizes of the CRC rows: S-block, short APDU, one full INF, largest frame */
+static const size_t gCrcFrameSizes[] = {PH_PROTO_7816_HEADER_LEN, 64, 257, MAX_DATA_LEN};
+
+static const uint8_t gI2cAtr[] = {0x00, 0xA0, 0x00, 0x00, 0x03, 0x96, 0x04, 0x03, 0xE8, 0x00, 0xFE, 0x02, 0x0B,
+    0x03, 0xE8, 0x08, 0x01, 0x00, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x0A, 0x4A, 0x43, 0x4F, 0x50, 0x34, 0x20, 0x41,
+    0x54, 0x50, 0x4F};
+
+static bench_i2c_sim_t gI2cSim;
+
+/* ************************************************************************** */
+/* Static function declarations                                               */
+/* ************************************************************************** */
+
+static uint64_t bench_now_ns(void);
+static smStatus_t bench_sim_txn(struct Se05xSession *pSession,
+    const tlvHeader_t *hdr,
+    uint8_t *cmdBuf,
+    size_t cmdBufLen,
+    uint8_t *rsp,
+    size_t *rspLen,
+    uint8_t hasle);
+
+/* ************************************************************************** */
+/* Private Functions                                                          */
+/* ************************************************************************** */
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Value of the TLV at *pIndex, NULL if malformed */
+static uint8_t *bench_sim_tlv(uint8_t *buf, size_t bufLen, size_t *pIndex, uint8_t *pTag, size_t *pLen)
+{
+    size_t i = *pIndex;
+    size_t len;
+
+    if (i + 2 > bufLen) {
+        return NULL;
+    }
+    *pTag = buf[i++];
+    len   = buf[i++];
+    if (len == 0x81) {
+        ENSURE_OR_RETURN_ON_ERROR(i + 1 <= bufLen, NULL);
+        len = buf[i++];
+    }
+    else if (len == 0x82) {
+        ENSURE_OR_RETURN_ON_ERROR(i + 2 <= bufLen, NULL);
+        len = ((size_t)buf[i] << 8) | buf[i + 1];
+        i += 2;
+    }
+    ENSURE_OR_RETURN_ON_ERROR(i + len <= bufLen, NULL);
+    *pIndex = i + len;
+    *pLen   = len;
+    return &buf[i];
+}
+
+/* The secure element. Knows CipherUpdate: TAG_2 crypto object, TAG_3 data,
+ * answers TAG_1 with the data XORed with BENCH_SIM_CIPHER_XOR. */
+static smStatus_t bench_sim_txn(struct Se05xSession *pSession,
+    const tlvHeader_t *hdr,
+    uint8_t *cmdBuf,
+    size_t cmdBufLen,
+    uint8_t *rsp,
+    size_t *rspLen,
+    uint8_t hasle)
+{
+    size_t index   = 0;
+    uint8_t tag    = 0;
+    size_t dataLen = 0;
+    uint8_t *pData = NULL;
+    size_t i       = 0;
+    size_t o       = 0;
+
+    (void)pSession;
+
+    gSim.apdus++;
+    /* Header, Lc, data and Le */
+    gSim.wireBytes += sizeof(hdr->hdr) + ((cmdBufLen < 0xFF && !hasle) ? 1 : 3) + cmdBufLen + (hasle ? 2 : 0);
+
+    if ((hdr->hdr[1] != kSE05x_INS_CRYPTO) || (hdr->hdr[2] != kSE05x_P1_CIPHER) ||
+        (hdr->hdr[3] != kSE05x_P2_UPDATE)) {
+        return SM_ERR_COMMAND_NOT_ALLOWED;
+    }
+    pData = bench_sim_tlv(cmdBuf, cmdBufLen, &index, &tag, &dataLen);
+    ENSURE_OR_RETURN_ON_ERROR((pData != NULL) && (tag == kSE05x_TAG_2), SM_ERR_WRONG_DATA);
+    pData = bench_sim_tlv(cmdBuf, cmdBufLen, &index, &tag, &dataLen);
+    ENSURE_OR_RETURN_ON_ERROR((pData != NULL) && (tag == kSE05x_TAG_3), SM_ERR_WRONG_DATA);
+    ENSURE_OR_RETURN_ON_ERROR(*rspLen >= dataLen + 6, SM_ERR_WRONG_LENGTH);
+
+    rsp[o++] = kSE05x_TAG_1;
+    if (dataLen <= 0x7F) {
+        rsp[o++] = (uint8_t)dataLen;
+    }
+    else if (dataLen <= 0xFF) {
+        rsp[o++] = 0x81;
+        rsp[o++] = (uint8_t)dataLen;
+    }
+    else {
+        rsp[o++] = 0x82;
+        rsp[o++] = (uint8_t)(dataLen >> 8);
+        rsp[o++] = (uint8_t)dataLen;
+    }
+    for (i = 0; i < dataLen; i++) {
+        rsp[o++] = pData[i] ^ BENCH_SIM_CIPHER_XOR;
+    }
+    rsp[o++] = 0x90;
+    rsp[o++] = 0x00;
+    *rspLen  = o;
+    gSim.wireBytes += o;
+    return SM_OK;
+}
+
+/* sss_se05x_cipher_update() before the cached tail was coalesced: one APDU
+ * for the completed cached block, then chunks of BENCH_BEFORE_CIPHER_CHUNK. */
+static sss_status_t bench_cipher_update_before(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+    smStatus_t status    = SM_NOT_OK;
+    size_t src_offset    = 0;
+    size_t output_offset = 0;
+    size_t outBuffSize   = *destLen;
+    size_t inputData_len = 0;
+    size_t blockoutLen   = 0;
+
+    if ((context->cache_data_len + srcLen) < CIPHER_BLOCK_SIZE) {
+        memcpy((context->cache_data + context->cache_data_len), srcData, srcLen);
+        context->cache_data_len += srcLen;
+        *destLen = 0;
+        return kStatus_SSS_Success;
+    }
+
+    if (context->cache_data_len > 0) {
+        memcpy((context->cache_data + context->cache_data_len), srcData, (CIPHER_BLOCK_SIZE - context->cache_data_len));
+        blockoutLen = outBuffSize;
+        status      = Se05x_API_CipherUpdate(&context->session->s_ctx,
+            context->cryptoObjectId,
+            context->cache_data,
+            CIPHER_BLOCK_SIZE,
+            destData,
+            &blockoutLen);
+        ENSURE_OR_RETURN_ON_ERROR(status == SM_OK, kStatus_SSS_Fail);
+        src_offset = CIPHER_BLOCK_SIZE - context->cache_data_len;
+        outBuffSize -= blockoutLen;
+        output_offset += blockoutLen;
+        context->cache_data_len = 0;
+    }
+
+    while (srcLen - src_offset >= CIPHER_BLOCK_SIZE) {
+        size_t rem_srcData = srcLen - src_offset;
+
+        if (rem_srcData > BENCH_BEFORE_CIPHER_CHUNK) {
+            inputData_len = BENCH_BEFORE_CIPHER_CHUNK;
+        }
+        else {
+            inputData_len = rem_srcData - (rem_srcData % CIPHER_BLOCK_SIZE);
+        }
+        blockoutLen = outBuffSize;
+        status      = Se05x_API_CipherUpdate(&context->session->s_ctx,
+            context->cryptoObjectId,
+            (srcData + src_offset),
+            inputData_len,
+            (destData + output_offset),
+            &blockoutLen);
+        ENSURE_OR_RETURN_ON_ERROR(status == SM_OK, kStatus_SSS_Fail);
+        src_offset += inputData_len;
+        outBuffSize -= blockoutLen;
+        output_offset += blockoutLen;
+    }
+
+    *destLen = output_offset;
+    if ((srcLen - src_offset) > 0) {
+        memcpy(context->cache_data, (srcData + src_offset), (srcLen - src_offset));
+        context->cache_data_len = (srcLen - src_offset);
+    }
+    return kStatus_SSS_Success;
+}
+
+static sss_status_t bench_cipher_update_after(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+    return sss_se05x_cipher_update(context, srcData, srcLen, destData, destLen);
+}
+
+/* Stream BENCH_STREAM_SIZE bytes in records of recordLen, check the output */
+static sss_status_t bench_cipher_stream(
+    bench_ctx_t *pCtx, bench_update_t update, size_t recordLen, uint64_t *pNs, bench_sim_t *pSim)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    size_t offset       = 0;
+    size_t outOffset    = 0;
+    size_t chunk        = 0;
+    size_t outLen       = 0;
+    uint64_t start      = 0;
+    size_t i            = 0;
+
+    memset(&gSim, 0, sizeof(gSim));
+    pCtx->symm.cache_data_len = 0;
+
+    start = bench_now_ns();
+    while (offset < BENCH_STREAM_SIZE) {
+        chunk  = (BENCH_STREAM_SIZE - offset < recordLen) ? (BENCH_STREAM_SIZE - offset) : recordLen;
+        outLen = sizeof(pCtx->out) - outOffset;
+        status = update(&pCtx->symm, &pCtx->in[offset], chunk, &pCtx->out[outOffset], &outLen);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        offset += chunk;
+        outOffset += outLen;
+    }
+    *pNs  = bench_now_ns() - start;
+    *pSim = gSim;
+
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(outOffset + pCtx->symm.cache_data_len == BENCH_STREAM_SIZE);
+    for (i = 0; i < outOffset; i++) {
+        ENSURE_OR_GO_EXIT(pCtx->out[i] == (pCtx->in[i] ^ BENCH_SIM_CIPHER_XOR));
+    }
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+
+/* Modelled throughput of streaming BENCH_STREAM_SIZE bytes */
+static double bench_mb_per_s(uint64_t hostNs, const bench_sim_t *pSim)
+{
+    double ns = (double)hostNs + (double)pSim->apdus * BENCH_LINK_US_PER_APDU * 1000.0 +
+                (double)pSim->wireBytes * BENCH_LINK_NS_PER_BYTE;
+    return (double)BENCH_STREAM_SIZE * 1000.0 / ns;
+}
+
+/* CRC-16/X.25 of a T=1oI2C frame, in the byte order of the protocol */
+static void bench_i2c_crc(const uint8_t *frame, size_t len, uint8_t *pCrc)
+{
+    uint16_t crc = 0xFFFF;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= frame[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x0001) ? (uint16_t)((crc >> 1) ^ 0x8408) : (uint16_t)(crc >> 1);
+        }
+    }
+    crc ^= 0xFFFF;
+#if defined(T1oI2C_UM11225)
+    pCrc[0] = (uint8_t)crc;
+    pCrc[1] = (uint8_t)(crc >> 8);
+#elif defined(T1oI2C_GP1_0)
+    pCrc[0] = (uint8_t)(crc >> 8);
+    pCrc[1] = (uint8_t)crc;
+#endif
+}
+
+/* The SE has a frame for the host, readable after delayNs */
+static void bench_i2c_queue(uint8_t pcb, const uint8_t *pInf, size_t infLen, uint64_t delayNs)
+{
+    uint8_t *pFrame = gI2cSim.frame;
+    size_t o        = 0;
+
+    pFrame[o++] = BENCH_I2C_SE_NAD;
+    pFrame[o++] = pcb;
+#if defined(T1oI2C_GP1_0)
+    pFrame[o++] = (uint8_t)(infLen >> 8);
+#endif
+    pFrame[o++] = (uint8_t)infLen;
+    if (infLen > 0) {
+        memcpy(&pFrame[o], pInf, infLen);
+        o += infLen;
+    }
+    bench_i2c_crc(pFrame, o, &pFrame[o]);
+    o += PH_PROTO_7816_CRC_LEN;
+
+    gI2cSim.frameLen    = o;
+    gI2cSim.frameOffset = 0;
+    gI2cSim.readyNs     = bench_now_ns() + delayNs;
+}
+
+/* Next I-frame of the response, chained if it does not fit */
+static void bench_i2c_queue_response(uint64_t delayNs)
+{
+    size_t len  = gI2cSim.rspLen - gI2cSim.rspOffset;
+    uint8_t pcb = (uint8_t)(gI2cSim.seqNo << 6);
+
+    if (len > BENCH_I2C_SE_IFS) {
+        len = BENCH_I2C_SE_IFS;
+        pcb |= PH_PROTO_7816_CHAINING;
+    }
+    bench_i2c_queue(pcb, &gI2cSim.rsp[gI2cSim.rspOffset], len, delayNs);
+    gI2cSim.rspOffset += len;
+    gI2cSim.seqNo ^= 1;
+}
+
+/* The SE executes the received command APDU */
+static void bench_i2c_process(void)
+{
+    const bench_i2c_cmd_t *pCmd = NULL;
+    uint64_t seNs               = (uint64_t)BENCH_I2C_FRAME_US * 1000;
+    size_t i;
+
+    for (i = 0; i < sizeof(gI2cCmds) / sizeof(gI2cCmds[0]); i++) {
+        if ((gI2cSim.apduLen >= sizeof(gI2cCmds[i].hdr)) &&
+            (memcmp(gI2cSim.apdu, gI2cCmds[i].hdr, sizeof(gI2cCmds[i].hdr)) == 0)) {
+            pCmd = &gI2cCmds[i];
+            break;
+        }
+    }
+
+    gI2cSim.rspLen = 0;
+    if (pCmd != NULL) {
+        for (i = 0; i < pCmd->rspLen; i++) {
+            gI2cSim.rsp[gI2cSim.rspLen++] = (uint8_t)(i ^ pCmd->hdr[1]);
+        }
+        gI2cSim.rsp[gI2cSim.rspLen++] = 0x90;
+        gI2cSim.rsp[gI2cSim.rspLen++] = 0x00;
+        gI2cSim.rng = gI2cSim.rng * 1103515245u + 12345u;
+        seNs        = (uint64_t)pCmd->seUs * 1000;
+        seNs        = seNs - (seNs / 16) + ((gI2cSim.rng >> 8) % (seNs / 8 + 1));
+    }
+    else {
+        gI2cSim.rsp[gI2cSim.rspLen++] = 0x6D;
+        gI2cSim.rsp[gI2cSim.rspLen++] = 0x00;
+    }
+    gI2cSim.count.seNs += seNs;
+    gI2cSim.apduLen   = 0;
+    gI2cSim.rspOffset = 0;
+    bench_i2c_queue_response(seNs);
+}
+
+/* One command over the T=1oI2C stack, checks the response */
+static sss_status_t bench_i2c_apdu(void *conn_ctx, const bench_i2c_cmd_t *pCmd, bench_i2c_row_t *pRow)
+{
+    static uint8_t cmd[BENCH_I2C_MAX_APDU];
+    static uint8_t rsp[BENCH_I2C_MAX_APDU];
+    sss_status_t status           = kStatus_SSS_Fail;
+    bench_i2c_count_t before      = gI2cSim.count;
+    const bench_i2c_count_t *pNow = &gI2cSim.count;
+    U32 rspLen                    = sizeof(rsp);
+    size_t cmdLen                 = 0;
+    uint64_t start                = 0;
+    U32 ret                       = SMCOM_COM_FAILED;
+    size_t i;
+
+    memcpy(cmd, pCmd->hdr, sizeof(pCmd->hdr));
+    cmdLen = sizeof(pCmd->hdr);
+    cmd[cmdLen++] = 0x00; /* Extended length */
+    if (pCmd->cmdLen > 0) {
+        cmd[cmdLen++] = (uint8_t)(pCmd->cmdLen >> 8);
+        cmd[cmdLen++] = (uint8_t)pCmd->cmdLen;
+        memset(&cmd[cmdLen], 0x3C, pCmd->cmdLen);
+        cmdLen += pCmd->cmdLen;
+    }
+    cmd[cmdLen++] = 0x00; /* Le */
+    cmd[cmdLen++] = 0x00;
+
+    start = bench_now_ns();
+    ret   = smCom_TransceiveRaw(conn_ctx, cmd, (U16)cmdLen, rsp, &rspLen);
+    pRow->hostNs += bench_now_ns() - start;
+    ENSURE_OR_GO_EXIT(ret == SMCOM_OK);
+    ENSURE_OR_GO_EXIT(rspLen == pCmd->rspLen + 2);
+    ENSURE_OR_GO_EXIT((rsp[rspLen - 2] == 0x90) && (rsp[rspLen - 1] == 0x00));
+    for (i = 0; i < pCmd->rspLen; i++) {
+        ENSURE_OR_GO_EXIT(rsp[i] == (uint8_t)(i ^ pCmd->hdr[1]));
+    }
+
+    pRow->apdus++;
+    pRow->count.reads += pNow->reads - before.reads;
+    pRow->count.nacks += pNow->nacks - before.nacks;
+    pRow->count.writes += pNow->writes - before.writes;
+    pRow->count.frames += pNow->frames - before.frames;
+    pRow->count.seNs += pNow->seNs - before.seNs;
+    pRow->count.idleNs += pNow->idleNs - before.idleNs;
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+
+/* Fixed polling: the model predicts nothing until it has learned again */
+static void bench_i2c_forget(void *conn_ctx)
+{
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+    phNxpEse_resetPollModel(conn_ctx);
+#else
+    (void)conn_ctx;
+#endif
+}
+
+/* ************************************************************************** */
+/* Benchmarks                                                                 */
+/* ************************************************************************** */
+
+/* sss_cipher_update() of a stream in records of unaligned sizes */
+static sss_status_t bench_cipher_update(bench_ctx_t *pCtx)
+{
+    sss_status_t status = kStatus_SSS_Success;
+    bench_sim_t before  = {0};
+    bench_sim_t after   = {0};
+    uint64_t beforeNs   = 0;
+    uint64_t afterNs    = 0;
+    size_t r;
+
+    LOG_I("sss_cipher_update, %u B in records of N B. Model: %u us/APDU, %u ns/B",
+        (unsigned)BENCH_STREAM_SIZE,
+        (unsigned)BENCH_LINK_US_PER_APDU,
+        (unsigned)BENCH_LINK_NS_PER_BYTE);
+    for (r = 0; r < sizeof(gRecordSizes) / sizeof(gRecordSizes[0]); r++) {
+        if ((bench_cipher_stream(pCtx, &bench_cipher_update_before, gRecordSizes[r], &beforeNs, &before) !=
+                kStatus_SSS_Success) ||
+            (bench_cipher_stream(pCtx, &bench_cipher_update_after, gRecordSizes[r], &afterNs, &after) !=
+                kStatus_SSS_Success)) {
+            LOG_E("sss_cipher_update, records of %u B failed", (unsigned)gRecordSizes[r]);
+            status = kStatus_SSS_Fail;
+            continue;
+        }
+        LOG_I("N=%4u B  before: %5u APDUs %7u wire B %6.3f MB/s  after: %5u APDUs %7u wire B %6.3f MB/s",
+            (unsigned)gRecordSizes[r],
+            (unsigned)before.apdus,
+            (unsigned)before.wireBytes,
+            bench_mb_per_s(beforeNs, &before),
+            (unsigned)after.apdus,
+            (unsigned)after.wireBytes,
+            bench_mb_per_s(afterNs, &after));
+    }
+    return status;
+}
+
+/* Frame CRC of the T=1 stack against the bitwise CRC, in MB/s */
+static sss_status_t bench_t1oi2c_crc(void)
+{
+    static uint8_t frame[MAX_DATA_LEN];
+    sss_status_t status                    = kStatus_SSS_Success;
+    uint8_t bitwise[PH_PROTO_7816_CRC_LEN] = {0};
+    uint16_t crc                           = 0;
+    uint64_t t0                            = 0;
+    uint64_t tabNs                         = 0;
+    uint64_t bitNs                         = 0;
+    size_t rounds;
+    size_t i;
+    size_t r;
+
+    for (i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(i * 13 + (i >> 3));
+    }
+    LOG_I("T=1oI2C frame CRC-16/X.25, %u B per frame size", (unsigned)BENCH_CRC_BYTES);
+    for (r = 0; r < sizeof(gCrcFrameSizes) / sizeof(gCrcFrameSizes[0]); r++) {
+        rounds = BENCH_CRC_BYTES / gCrcFrameSizes[r];
+
+        t0 = bench_now_ns();
+        for (i = 0; i < rounds; i++) {
+            /* Feed the result back, so that no round can be left out */
+            frame[0] ^= (uint8_t)crc;
+            crc = phNxpEseProto7816_ComputeCRC(frame, 0, (uint32_t)gCrcFrameSizes[r]);
+        }
+        tabNs = bench_now_ns() - t0;
+
+        t0 = bench_now_ns();
+        for (i = 0; i < rounds; i++) {
+            frame[0] ^= bitwise[0];
+            bench_i2c_crc(frame, gCrcFrameSizes[r], bitwise);
+        }
+        bitNs = bench_now_ns() - t0;
+
+        crc = phNxpEseProto7816_ComputeCRC(frame, 0, (uint32_t)gCrcFrameSizes[r]);
+        bench_i2c_crc(frame, gCrcFrameSizes[r], bitwise);
+        if ((bitwise[0] != (uint8_t)(crc >> 8)) || (bitwise[1] != (uint8_t)crc)) {
+            LOG_E("CRC of %u B frames differs", (unsigned)gCrcFrameSizes[r]);
+            status = kStatus_SSS_Fail;
+        }
+        LOG_I("  frame %4u B  stack: %8.1f MB/s  bitwise: %8.1f MB/s  x%.1f",
+            (unsigned)gCrcFrameSizes[r],
+            (double)(rounds * gCrcFrameSizes[r]) * 1000.0 / (double)tabNs,
+            (double)(rounds * gCrcFrameSizes[r]) * 1000.0 / (double)bitNs,
+            (double)bitNs / (double)tabNs);
+    }
+    return status;
+}
+
+/* APDUs over the T=1oI2C stack, with fixed 1 ms polling and the latency model */
+static sss_status_t bench_t1oi2c_polling(void)
+{
+    static bench_i2c_row_t rows[2][sizeof(gI2cCmds) / sizeof(gI2cCmds[0])];
+    sss_status_t status = kStatus_SSS_Fail;
+    bench_i2c_row_t warmup;
+    void *conn_ctx = NULL;
+    uint8_t atr[64];
+    U16 atrLen = sizeof(atr);
+    size_t mode;
+    size_t n;
+    size_t c;
+
+    memset(&gI2cSim, 0, sizeof(gI2cSim));
+    memset(rows, 0, sizeof(rows));
+    gI2cSim.rng = 1;
+    ENSURE_OR_GO_EXIT(smComT1oI2C_Init(&conn_ctx, "sim") == SMCOM_OK);
+    ENSURE_OR_GO_EXIT(smComT1oI2C_Open(conn_ctx, 0, 0, atr, &atrLen) == SMCOM_OK);
+
+    /* mode 0: fixed polling (before), mode 1: latency model (after) */
+    for (mode = 0; mode < 2; mode++) {
+        bench_i2c_forget(conn_ctx);
+        for (n = 0; n < BENCH_I2C_WARMUP + BENCH_I2C_ITERATIONS; n++) {
+            for (c = 0; c < sizeof(gI2cCmds) / sizeof(gI2cCmds[0]); c++) {
+                if (mode == 0) {
+                    bench_i2c_forget(conn_ctx);
+                }
+                memset(&warmup, 0, sizeof(warmup));
+                ENSURE_OR_GO_EXIT(bench_i2c_apdu(conn_ctx,
+                                      &gI2cCmds[c],
+                                      (n < BENCH_I2C_WARMUP) ? &warmup : &rows[mode][c]) == kStatus_SSS_Success);
+            }
+        }
+    }
+    ENSURE_OR_GO_EXIT(gI2cSim.errors == 0);
+
+    LOG_I("T=1oI2C polling, %u APDUs per command. fixed: poll every %u ms (before), model: latency model (after)",
+        (unsigned)BENCH_I2C_ITERATIONS,
+        (unsigned)ESE_POLL_DELAY_MS);
+    LOG_I("  per APDU           SE us |  fixed: APDU us  idle us reads NACKs |  model: APDU us  idle us reads NACKs");
+    for (c = 0; c < sizeof(gI2cCmds) / sizeof(gI2cCmds[0]); c++) {
+        const bench_i2c_row_t *pFixed = &rows[0][c];
+        const bench_i2c_row_t *pModel = &rows[1][c];
+        LOG_I("  %-17s %6u | %15u %8u %5.1f %5.1f | %15u %8u %5.1f %5.1f",
+            gI2cCmds[c].name,
+            (unsigned)(pModel->count.seNs / pModel->apdus / 1000),
+            (unsigned)(pFixed->hostNs / pFixed->apdus / 1000),
+            (unsigned)(pFixed->count.idleNs / pFixed->apdus / 1000),
+            (double)pFixed->count.reads / pFixed->apdus,
+            (double)pFixed->count.nacks / pFixed->apdus,
+            (unsigned)(pModel->hostNs / pModel->apdus / 1000),
+            (unsigned)(pModel->count.idleNs / pModel->apdus / 1000),
+            (double)pModel->count.reads / pModel->apdus,
+            (double)pModel->count.nacks / pModel->apdus);
+    }
+#if defined(T1OI2C_ADAPTIVE_POLLING)
+    smComT1oI2C_DumpPollStats(conn_ctx);
+#endif
+
+    /* Before, every frame took 3 reads (NAD/PCB, LEN, INF + CRC) after the polls */
+    LOG_I("T=1oI2C I2C transactions, model rows. before: 3 reads per frame, after: first read of header + CRC");
+    LOG_I("  per APDU          frames writes NACKs | before: reads | after: reads");
+    for (c = 0; c < sizeof(gI2cCmds) / sizeof(gI2cCmds[0]); c++) {
+        const bench_i2c_row_t *pModel = &rows[1][c];
+        LOG_I("  %-17s %6.1f %6.1f %5.1f | %13.1f | %12.1f",
+            gI2cCmds[c].name,
+            (double)pModel->count.frames / pModel->apdus,
+            (double)pModel->count.writes / pModel->apdus,
+            (double)pModel->count.nacks / pModel->apdus,
+            (double)(pModel->count.nacks + 3 * pModel->count.frames) / pModel->apdus,
+            (double)pModel->count.reads / pModel->apdus);
+    }
+    status = kStatus_SSS_Success;
+exit:
+    if (status != kStatus_SSS_Success) {
+        LOG_E("T=1oI2C polling failed (%u malformed frames)", (unsigned)gI2cSim.errors);
+    }
+    if (conn_ctx != NULL) {
+        smComT1oI2C_Close(conn_ctx, 0);
+    }
+    return status;
+}
+
+/* ************************************************************************** */
+/* Public Functions                                                           */
+/* ************************************************************************** */
+
+/* Simulated I2C bus, replaces platform/linux/i2c_a7.c */
+
+i2c_error_t axI2CInit(void **conn_ctx, const char *pDevName)
+{
+    (void)pDevName;
+    if (conn_ctx != NULL) {
+        *conn_ctx = &gI2cSim;
+    }
+    return I2C_OK;
+}
+
+void axI2CTerm(void *conn_ctx, int mode)
+{
+    (void)conn_ctx;
+    (void)mode;
+}
+
+/* Host frame to the SE: I-block (command APDU), R-block or S-block */
+i2c_error_t axI2CWrite(void *conn_ctx, unsigned char bus, unsigned char addr, unsigned char *pTx, unsigned short txLen)
+{
+    uint8_t crc[PH_PROTO_7816_CRC_LEN];
+    const uint8_t *pInf = NULL;
+    size_t infLen       = 0;
+    uint8_t pcb         = 0;
+
+    (void)conn_ctx;
+    (void)bus;
+    (void)addr;
+
+    gI2cSim.count.writes++;
+    ENSURE_OR_GO_EXIT(pTx != NULL);
+    ENSURE_OR_GO_EXIT(txLen >= PH_PROTO_7816_HEADER_LEN + PH_PROTO_7816_CRC_LEN);
+    ENSURE_OR_GO_EXIT(pTx[0] == SEND_PACKET_SOF);
+#if defined(T1oI2C_UM11225)
+    infLen = pTx[2];
+#elif defined(T1oI2C_GP1_0)
+    infLen = ((size_t)pTx[2] << 8) | pTx[3];
+#endif
+    ENSURE_OR_GO_EXIT(txLen == PH_PROTO_7816_HEADER_LEN + infLen + PH_PROTO_7816_CRC_LEN);
+    bench_i2c_crc(pTx, txLen - PH_PROTO_7816_CRC_LEN, crc);
+    ENSURE_OR_GO_EXIT(memcmp(crc, &pTx[txLen - PH_PROTO_7816_CRC_LEN], sizeof(crc)) == 0);
+    pcb  = pTx[1];
+    pInf = &pTx[PH_PROTO_7816_HEADER_LEN];
+
+    if (!(pcb & 0x80)) {
+        /* I-block: acknowledge a chained one, execute the command after the last one */
+        ENSURE_OR_GO_EXIT(gI2cSim.apduLen + infLen <= sizeof(gI2cSim.apdu));
+        memcpy(&gI2cSim.apdu[gI2cSim.apduLen], pInf, infLen);
+        gI2cSim.apduLen += infLen;
+        if (pcb & PH_PROTO_7816_CHAINING) {
+            bench_i2c_queue(
+                (uint8_t)(0x80 | ((((pcb >> 6) & 0x01) ^ 0x01) << 4)), NULL, 0, (uint64_t)BENCH_I2C_FRAME_US * 1000);
+        }
+        else {
+            bench_i2c_process();
+        }
+    }
+    else if (!(pcb & 0x40)) {
+        /* R-block: next part of a chained response, or resend after an error */
+        if (((pcb & 0x03) == 0) && (gI2cSim.rspOffset < gI2cSim.rspLen)) {
+            bench_i2c_queue_response((uint64_t)BENCH_I2C_FRAME_US * 1000);
+        }
+        else {
+            gI2cSim.frameOffset = 0;
+            gI2cSim.readyNs     = bench_now_ns() + (uint64_t)BENCH_I2C_FRAME_US * 1000;
+        }
+    }
+    else {
+        /* S-block request */
+        uint8_t type = pcb & 0x1F;
+        if ((type == RESYNCH_REQ) || (type == INTF_RESET_REQ)) {
+            gI2cSim.seqNo     = 0;
+            gI2cSim.apduLen   = 0;
+            gI2cSim.rspLen    = 0;
+            gI2cSim.rspOffset = 0;
+        }
+#if defined(T1oI2C_UM11225)
+        if ((type == ATR_REQ) || (type == INTF_RESET_REQ)) {
+            bench_i2c_queue(pcb | 0x20, gI2cAtr, sizeof(gI2cAtr), (uint64_t)BENCH_I2C_FRAME_US * 1000);
+            return I2C_OK;
+        }
+#endif
+        bench_i2c_queue(pcb | 0x20, NULL, 0, (uint64_t)BENCH_I2C_FRAME_US * 1000);
+    }
+    return I2C_OK;
+exit:
+    gI2cSim.errors++;
+    return I2C_FAILED;
+}
+
+/* The SE NACKs reads while it has nothing to send */
+static i2c_error_t bench_i2c_read(unsigned char *pRx, unsigned short rxLen, int backoff)
+{
+    uint64_t now = bench_now_ns();
+    size_t len   = 0;
+
+    gI2cSim.count.reads++;
+    if ((pRx == NULL) || (rxLen > MAX_DATA_LEN)) {
+        gI2cSim.errors++;
+        return I2C_FAILED;
+    }
+    if ((gI2cSim.frameOffset >= gI2cSim.frameLen) || (now < gI2cSim.readyNs)) {
+        gI2cSim.count.nacks++;
+        if (backoff) {
+            if (gI2cSim.backoffDelay < 200) {
+                gI2cSim.backoffDelay += 1;
+            }
+            usleep(gI2cSim.backoffDelay * 1000);
+        }
+        return I2C_FAILED;
+    }
+    gI2cSim.backoffDelay = 0;
+
+    if (gI2cSim.frameOffset == 0) {
+        gI2cSim.count.idleNs += now - gI2cSim.readyNs;
+    }
+    len = gI2cSim.frameLen - gI2cSim.frameOffset;
+    if (len > rxLen) {
+        len = rxLen;
+    }
+    memcpy(pRx, &gI2cSim.frame[gI2cSim.frameOffset], len);
+    memset(&pRx[len], 0, rxLen - len);
+    gI2cSim.frameOffset += len;
+    if (gI2cSim.frameOffset >= gI2cSim.frameLen) {
+        gI2cSim.count.frames++;
+    }
+    return I2C_OK;
+}
+
+i2c_error_t axI2CRead(void *conn_ctx, unsigned char bus, unsigned char addr, unsigned char *pRx, unsigned short rxLen)
+{
+    (void)conn_ctx;
+    (void)bus;
+    (void)addr;
+    return bench_i2c_read(pRx, rxLen, 1);
+}
+
+i2c_error_t axI2CReadNoBackoff(
+    void *conn_ctx, unsigned char bus, unsigned char addr, unsigned char *pRx, unsigned short rxLen)
+{
+    (void)conn_ctx;
+    (void)bus;
+    (void)addr;
+    return bench_i2c_read(pRx, rxLen, 0);
+}
+
+int main(int argc, const char *argv[])
+{
+    static bench_ctx_t ctx;
+    int failures = 0;
+    size_t i;
+
+    (void)argc;
+    (void)argv;
+
+    ctx.session.subsystem    = kType_SSS_SE_SE05x;
+    ctx.session.s_ctx.fp_TXn = &bench_sim_txn;
+    ctx.symm.session         = &ctx.session;
+    ctx.symm.algorithm       = kAlgorithm_SSS_AES_CBC;
+    ctx.symm.mode            = kMode_SSS_Encrypt;
+    ctx.symm.cryptoObjectId  = kSE05x_CryptoObject_AES_CBC_NOPAD;
+    for (i = 0; i < sizeof(ctx.in); i++) {
+        ctx.in[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+
+    if (bench_cipher_update(&ctx) != kStatus_SSS_Success) {
+        failures++;
+    }
+    if (bench_t1oi2c_polling() != kStatus_SSS_Success) {
+        failures++;
+    }
+    if (bench_t1oi2c_crc() != kStatus_SSS_Success) {
+        failures++;
+    }
+
+    if (failures == 0) {
+        LOG_I("ex_se05x_bench Example Success !!!...");
+    }
+    else {
+        LOG_E("ex_se05x_bench Example Failed !!!... (%d failures)", failures);
+    }
+    return (failures == 0) ? 0 : 1;
+}
@@ -42,6 +42,10 @@ extern "C" {
 #endif
 #if SSS_HAVE_APPLET_SE05X_IOT
 #include "se05x_APDU.h"
+#include "fsl_sss_se05x_apis.h"
+#if SSSFTR_SE05X_AuthECKey
+#include "fsl_sss_se05x_scp03.h"
+#endif
 #endif
 
 /* *****************************************************************************************************************
@@ -99,6 +103,9 @@ sss_status_t ex_sss_boot_factory_reset(ex_sss_boot_ctx_t *pCtx)
     smStatus_t st;
     sss_se05x_session_t *pSession = (sss_se05x_session_t *)&pCtx->session;
     st                            = Se05x_API_DeleteAll_Iterative(&pSession->s_ctx);
+    /* Objects, crypto objects and curves went away behind the cache. Also
+     * after a failure, some of them may be gone. */
+    sss_se05x_session_flush_object_cache(pSession);
     if (st == SW_OK) {
         status = kStatus_SSS_Success;
     }
@@ -153,6 +160,9 @@ static void free_auth_objects(SE_Connect_Ctx_t *pConnectCtx)
 
     if (pConnectCtx->auth.authType == kSSS_AuthType_ECKey) {
         SE05x_AuthCtx_ECKey_t *pEC = &pConnectCtx->auth.ctx.eckey;
+#if SSSFTR_SE05X_AuthECKey && (__GNUC__ && !AX_EMBEDDED)
+        nxECKey_StopEphemeralPool(pEC->pStatic_ctx);
+#endif
         sss_host_key_object_free(&pEC->pStatic_ctx->HostEcdsaObj);
         sss_host_key_object_free(&pEC->pStatic_ctx->HostEcKeypair);
         sss_host_key_object_free(&pEC->pStatic_ctx->masterSec);
@@ -214,6 +224,9 @@ void ex_sss_session_close(ex_sss_boot_ctx_t *pCtx)
 #elif (SSS_HAVE_SE05X_AUTH_ECKEY)
     {
         ex_SE05x_authCtx_t *pauth = &pCtx->ex_se05x_auth;
+#if SSSFTR_SE05X_AuthECKey && (__GNUC__ && !AX_EMBEDDED)
+        nxECKey_StopEphemeralPool(&pauth->eckey.ex_static);
+#endif
         sss_host_key_object_free(&pauth->eckey.ex_static.HostEcdsaObj);
         sss_host_key_object_free(&pauth->eckey.ex_static.HostEcKeypair);
         sss_host_key_object_free(&pauth->eckey.ex_static.masterSec);
@@ -0,0 +1,682 @@
+/*
+ *
+ * Copyright 2025 NXP
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/** @file
+ *
+ * ex_sss_pool.c:  Pool of SE05x devices with load balanced dispatch
+ */
+
+/* *****************************************************************************************************************
+ * Includes
+ * ***************************************************************************************************************** */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(SSS_USE_FTR_FILE)
+#include "fsl_sss_ftr.h"
+#else
+#include "fsl_sss_ftr_default.h"
+#endif
+
+#include "ex_sss_pool.h"
+
+#include <string.h>
+
+#include "nxEnsure.h"
+#include "nxLog_App.h"
+#if SSS_HAVE_APPLET_SE05X_IOT
+#include "fsl_sss_se05x_apis.h"
+#endif
+
+/* *****************************************************************************************************************
+ * Internal Definitions
+ * ***************************************************************************************************************** */
+
+#if (__GNUC__ && !AX_EMBEDDED)
+#define POOL_LOCK(pPool) pthread_mutex_lock(&(pPool)->lock)
+#define POOL_UNLOCK(pPool) pthread_mutex_unlock(&(pPool)->lock)
+#define DEVICE_LOCK(pDevice) pthread_mutex_lock(&(pDevice)->lock)
+#define DEVICE_TRYLOCK(pDevice) (pthread_mutex_trylock(&(pDevice)->lock) == 0)
+#define DEVICE_UNLOCK(pDevice) pthread_mutex_unlock(&(pDevice)->lock)
+#else
+#define POOL_LOCK(pPool)
+#define POOL_UNLOCK(pPool)
+#define DEVICE_LOCK(pDevice)
+#define DEVICE_TRYLOCK(pDevice) (1)
+#define DEVICE_UNLOCK(pDevice)
+#endif
+
+/* Random bytes requested to check that a device responds */
+#define POOL_PROBE_LEN 8
+
+/* *****************************************************************************************************************
+ * Type Definitions
+ * ***************************************************************************************************************** */
+
+typedef struct
+{
+    sss_algorithm_t algorithm;
+    uint8_t *digest;
+    size_t digestLen;
+    uint8_t *signature;
+    size_t *pSignatureLen;
+} pool_sign_args_t;
+
+typedef struct
+{
+    sss_object_t *otherPartyKeyObject;
+    sss_object_t *derivedKeyObject;
+} pool_dh_args_t;
+
+typedef struct
+{
+    uint8_t *data;
+    size_t dataLen;
+} pool_rng_args_t;
+
+/* *****************************************************************************************************************
+ * Private Functions Prototypes
+ * ***************************************************************************************************************** */
+
+static sss_status_t pool_open_device(ex_sss_pool_device_t *pDevice);
+static void pool_resolve_key(ex_sss_pool_t *pPool, size_t deviceIdx, ex_sss_pool_key_t *pKey);
+static void pool_resolve_keys(ex_sss_pool_t *pPool, size_t deviceIdx);
+static void pool_drop_keys(ex_sss_pool_t *pPool, size_t deviceIdx);
+static sss_status_t pool_recover_device(ex_sss_pool_t *pPool, size_t deviceIdx);
+static ex_sss_pool_key_t *pool_find_key(ex_sss_pool_t *pPool, uint32_t keyId);
+static sss_status_t pool_run(
+    ex_sss_pool_t *pPool, uint32_t keyId, ex_sss_pool_fn_t fn, void *arg, bool failureIsDeviceError);
+static sss_status_t pool_sign_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg);
+static sss_status_t pool_verify_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg);
+static sss_status_t pool_dh_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg);
+static sss_status_t pool_rng_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg);
+
+/* *****************************************************************************************************************
+ * Public Functions
+ * ***************************************************************************************************************** */
+
+sss_status_t ex_sss_pool_open(ex_sss_pool_t *pPool, const char *portNames[], size_t count)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+    size_t i;
+    size_t opened = 0;
+
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+    ENSURE_OR_GO_EXIT(portNames != NULL);
+    ENSURE_OR_GO_EXIT((count > 0) && (count <= EX_SSS_POOL_MAX_DEVICES));
+
+#if ((SSS_HAVE_SE05X_AUTH_USERID_PLATFSCP03) || (SSS_HAVE_SE05X_AUTH_AESKEY_PLATFSCP03) || \
+     (SSS_HAVE_SE05X_AUTH_ECKEY_PLATFSCP03))
+    if (count > 1) {
+        /* ex_sss_boot_se05x_open() keeps the platform SCP tunnel in a single global context */
+        LOG_E("Only one device supported with platform SCP tunnel");
+        goto exit;
+    }
+#endif
+
+    memset(pPool, 0, sizeof(*pPool));
+#if (__GNUC__ && !AX_EMBEDDED)
+    ENSURE_OR_GO_EXIT(pthread_mutex_init(&pPool->lock, NULL) == 0);
+#endif
+
+    for (i = 0; i < count; i++) {
+        ex_sss_pool_device_t *pDevice = &pPool->device[i];
+        pDevice->portName             = portNames[i];
+#if (__GNUC__ && !AX_EMBEDDED)
+        ENSURE_OR_GO_EXIT(pthread_mutex_init(&pDevice->lock, NULL) == 0);
+#endif
+        pPool->deviceCount++;
+        if (pool_open_device(pDevice) == kStatus_SSS_Success) {
+            pDevice->healthy = true;
+            opened++;
+        }
+        else {
+            LOG_W("Device %u (%s) kept out of rotation", (unsigned)i, (portNames[i] != NULL) ? portNames[i] : "default");
+        }
+    }
+
+    if (opened > 0) {
+        status = kStatus_SSS_Success;
+    }
+    else {
+        LOG_E("No device of the pool could be opened");
+    }
+
+exit:
+    return status;
+}
+
+void ex_sss_pool_close(ex_sss_pool_t *pPool)
+{
+    size_t i;
+    size_t j;
+
+    if (pPool == NULL) {
+        return;
+    }
+
+    for (j = 0; j < pPool->keyCount; j++) {
+        for (i = 0; i < pPool->deviceCount; i++) {
+            if (pPool->key[j].replicaMask & (1u << i)) {
+                sss_key_object_free(&pPool->key[j].object[i]);
+            }
+        }
+    }
+
+    for (i = 0; i < pPool->deviceCount; i++) {
+        ex_sss_pool_device_t *pDevice = &pPool->device[i];
+        if (pDevice->boot.session.subsystem != kType_SSS_SubSystem_NONE) {
+            ex_sss_session_close(&pDevice->boot);
+        }
+#if (__GNUC__ && !AX_EMBEDDED)
+        pthread_mutex_destroy(&pDevice->lock);
+#endif
+    }
+
+#if (__GNUC__ && !AX_EMBEDDED)
+    pthread_mutex_destroy(&pPool->lock);
+#endif
+    memset(pPool, 0, sizeof(*pPool));
+}
+
+sss_status_t ex_sss_pool_add_key(ex_sss_pool_t *pPool, uint32_t keyId)
+{
+    sss_status_t status    = kStatus_SSS_Fail;
+    ex_sss_pool_key_t *pKey = NULL;
+    size_t i;
+
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+    ENSURE_OR_GO_EXIT(keyId != EX_SSS_POOL_ANY_KEY);
+
+    POOL_LOCK(pPool);
+    pKey = pool_find_key(pPool, keyId);
+    if (pKey == NULL && pPool->keyCount < EX_SSS_POOL_MAX_KEYS) {
+        pKey        = &pPool->key[pPool->keyCount++];
+        pKey->keyId = keyId;
+    }
+    POOL_UNLOCK(pPool);
+    if (pKey == NULL) {
+        LOG_E("Too many keys in pool (max %d)", EX_SSS_POOL_MAX_KEYS);
+        goto exit;
+    }
+
+    for (i = 0; i < pPool->deviceCount; i++) {
+        ex_sss_pool_device_t *pDevice = &pPool->device[i];
+        bool inRotation;
+
+        /* Devices being recovered resolve all keys when they come back */
+        POOL_LOCK(pPool);
+        inRotation = pDevice->healthy;
+        if (inRotation) {
+            pDevice->inFlight++;
+        }
+        POOL_UNLOCK(pPool);
+        if (!inRotation) {
+            continue;
+        }
+        DEVICE_LOCK(pDevice);
+        pool_resolve_key(pPool, i, pKey);
+        DEVICE_UNLOCK(pDevice);
+        POOL_LOCK(pPool);
+        pDevice->inFlight--;
+        POOL_UNLOCK(pPool);
+    }
+
+    if (pKey->replicaMask != 0) {
+        status = kStatus_SSS_Success;
+    }
+    else {
+        LOG_E("Key 0x%08X not found on any device", keyId);
+    }
+
+exit:
+    return status;
+}
+
+sss_status_t ex_sss_pool_dispatch(ex_sss_pool_t *pPool, uint32_t keyId, ex_sss_pool_fn_t fn, void *arg)
+{
+    return pool_run(pPool, keyId, fn, arg, true);
+}
+
+sss_status_t ex_sss_pool_asymmetric_sign_digest(ex_sss_pool_t *pPool,
+    uint32_t keyId,
+    sss_algorithm_t algorithm,
+    uint8_t *digest,
+    size_t digestLen,
+    uint8_t *signature,
+    size_t *signatureLen)
+{
+    pool_sign_args_t args;
+
+    args.algorithm     = algorithm;
+    args.digest        = digest;
+    args.digestLen     = digestLen;
+    args.signature     = signature;
+    args.pSignatureLen = signatureLen;
+    return pool_run(pPool, keyId, &pool_sign_fn, &args, true);
+}
+
+sss_status_t ex_sss_pool_asymmetric_verify_digest(ex_sss_pool_t *pPool,
+    uint32_t keyId,
+    sss_algorithm_t algorithm,
+    uint8_t *digest,
+    size_t digestLen,
+    uint8_t *signature,
+    size_t signatureLen)
+{
+    pool_sign_args_t args;
+
+    args.algorithm     = algorithm;
+    args.digest        = digest;
+    args.digestLen     = digestLen;
+    args.signature     = signature;
+    args.pSignatureLen = &signatureLen;
+    /* A wrong signature is no reason to take the device out of rotation */
+    return pool_run(pPool, keyId, &pool_verify_fn, &args, false);
+}
+
+sss_status_t ex_sss_pool_derive_key_dh(
+    ex_sss_pool_t *pPool, uint32_t keyId, sss_object_t *otherPartyKeyObject, sss_object_t *derivedKeyObject)
+{
+    pool_dh_args_t args;
+
+    args.otherPartyKeyObject = otherPartyKeyObject;
+    args.derivedKeyObject    = derivedKeyObject;
+    return pool_run(pPool, keyId, &pool_dh_fn, &args, true);
+}
+
+sss_status_t ex_sss_pool_rng_get_random(ex_sss_pool_t *pPool, uint8_t *random_data, size_t dataLen)
+{
+    pool_rng_args_t args;
+
+    args.data    = random_data;
+    args.dataLen = dataLen;
+    return pool_run(pPool, EX_SSS_POOL_ANY_KEY, &pool_rng_fn, &args, true);
+}
+
+size_t ex_sss_pool_health_check(ex_sss_pool_t *pPool)
+{
+    size_t healthyCount = 0;
+    size_t i;
+    uint8_t probe[POOL_PROBE_LEN];
+    pool_rng_args_t args;
+
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+
+    args.data    = probe;
+    args.dataLen = sizeof(probe);
+
+    for (i = 0; i < pPool->deviceCount; i++) {
+        ex_sss_pool_device_t *pDevice = &pPool->device[i];
+        sss_status_t status           = kStatus_SSS_Fail;
+        bool recover                  = false;
+
+        POOL_LOCK(pPool);
+        if (pDevice->inFlight > 0 || pDevice->recovering) {
+            /* In use, so it answers. Checked on next round. */
+            if (pDevice->healthy) {
+                healthyCount++;
+            }
+            POOL_UNLOCK(pPool);
+            continue;
+        }
+        if (pDevice->healthy) {
+            pDevice->inFlight++;
+        }
+        else {
+            /* Out of rotation and idle: nobody else can pick it up */
+            pDevice->recovering = true;
+            recover             = true;
+        }
+        POOL_UNLOCK(pPool);
+
+        if (!recover) {
+            if (!DEVICE_TRYLOCK(pDevice)) {
+                POOL_LOCK(pPool);
+                pDevice->inFlight--;
+                healthyCount++;
+                POOL_UNLOCK(pPool);
+                continue;
+            }
+            status = pool_rng_fn(&pDevice->boot, NULL, &args);
+            DEVICE_UNLOCK(pDevice);
+
+            POOL_LOCK(pPool);
+            pDevice->inFlight--;
+            if (status == kStatus_SSS_Success) {
+                pDevice->consecutiveFailures = 0;
+                healthyCount++;
+            }
+            else {
+                LOG_W("Device %u taken out of rotation", (unsigned)i);
+                pDevice->healthy = false;
+                if (pDevice->inFlight == 0) {
+                    pDevice->recovering = true;
+                    recover             = true;
+                }
+            }
+            POOL_UNLOCK(pPool);
+        }
+
+        if (recover) {
+            status = pool_recover_device(pPool, i);
+            POOL_LOCK(pPool);
+            pDevice->recovering = false;
+            if (status == kStatus_SSS_Success) {
+                LOG_I("Device %u back in rotation", (unsigned)i);
+                pDevice->healthy             = true;
+                pDevice->consecutiveFailures = 0;
+                healthyCount++;
+            }
+            POOL_UNLOCK(pPool);
+        }
+    }
+
+exit:
+    return healthyCount;
+}
+
+void ex_sss_pool_dump_stats(ex_sss_pool_t *pPool)
+{
+    size_t i;
+
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+
+    POOL_LOCK(pPool);
+    LOG_I("dev healthy inFlight      ops   failed  port");
+    for (i = 0; i < pPool->deviceCount; i++) {
+        ex_sss_pool_device_t *pDevice = &pPool->device[i];
+        LOG_I("%3u %7s %8u %8u %8u  %s",
+            (unsigned)i,
+            pDevice->healthy ? "yes" : "no",
+            pDevice->inFlight,
+            pDevice->opCount,
+            pDevice->failCount,
+            (pDevice->portName != NULL) ? pDevice->portName : "default");
+    }
+    POOL_UNLOCK(pPool);
+
+exit:
+    return;
+}
+
+/* *****************************************************************************************************************
+ * Private Functions
+ * ***************************************************************************************************************** */
+
+static sss_status_t pool_open_device(ex_sss_pool_device_t *pDevice)
+{
+    sss_status_t status;
+
+    memset(&pDevice->boot, 0, sizeof(pDevice->boot));
+    status = ex_sss_boot_open(&pDevice->boot, pDevice->portName);
+    if (status == kStatus_SSS_Success) {
+        status = ex_sss_key_store_and_object_init(&pDevice->boot);
+    }
+    if (status != kStatus_SSS_Success) {
+        LOG_E("Failed to open device %s", (pDevice->portName != NULL) ? pDevice->portName : "default");
+        ex_sss_session_close(&pDevice->boot);
+        memset(&pDevice->boot, 0, sizeof(pDevice->boot));
+    }
+    return status;
+}
+
+/* Probe a device taken out of rotation, reopen it if it does not answer.
+ * Called with the device idle and marked recovering, so without its lock. */
+static sss_status_t pool_recover_device(ex_sss_pool_t *pPool, size_t deviceIdx)
+{
+    ex_sss_pool_device_t *pDevice = &pPool->device[deviceIdx];
+    sss_status_t status           = kStatus_SSS_Fail;
+    uint8_t probe[POOL_PROBE_LEN];
+    pool_rng_args_t args;
+
+    args.data    = probe;
+    args.dataLen = sizeof(probe);
+
+    if (pDevice->boot.session.subsystem != kType_SSS_SubSystem_NONE) {
+        status = pool_rng_fn(&pDevice->boot, NULL, &args);
+        if (status != kStatus_SSS_Success) {
+            pool_drop_keys(pPool, deviceIdx);
+            ex_sss_session_close(&pDevice->boot);
+            memset(&pDevice->boot, 0, sizeof(pDevice->boot));
+        }
+    }
+    if (status != kStatus_SSS_Success) {
+        status = pool_open_device(pDevice);
+    }
+    if (status == kStatus_SSS_Success) {
+        pool_resolve_keys(pPool, deviceIdx);
+    }
+    return status;
+}
+
+/* Look up one key on one device. Called with the device locked or recovering. */
+static void pool_resolve_key(ex_sss_pool_t *pPool, size_t deviceIdx, ex_sss_pool_key_t *pKey)
+{
+    ex_sss_pool_device_t *pDevice = &pPool->device[deviceIdx];
+    sss_object_t object           = {0};
+    sss_status_t status;
+    bool known;
+
+    status = sss_key_object_init(&object, &pDevice->boot.ks);
+    if (status == kStatus_SSS_Success) {
+        status = sss_key_object_get_handle(&object, pKey->keyId);
+    }
+
+    POOL_LOCK(pPool);
+    known = (pKey->replicaMask & (1u << deviceIdx)) != 0;
+    if (known) {
+        sss_key_object_free(&pKey->object[deviceIdx]);
+    }
+    if (status == kStatus_SSS_Success) {
+        pKey->object[deviceIdx] = object;
+        pKey->replicaMask |= (1u << deviceIdx);
+    }
+    else {
+        pKey->replicaMask &= ~(1u << deviceIdx);
+    }
+    POOL_UNLOCK(pPool);
+
+    if (status != kStatus_SSS_Success) {
+        sss_key_object_free(&object);
+    }
+}
+
+/* Look up all registered keys on one device */
+static void pool_resolve_keys(ex_sss_pool_t *pPool, size_t deviceIdx)
+{
+    size_t j;
+
+    for (j = 0; j < pPool->keyCount; j++) {
+        pool_resolve_key(pPool, deviceIdx, &pPool->key[j]);
+    }
+}
+
+/* Release the key objects of one device before its session is closed */
+static void pool_drop_keys(ex_sss_pool_t *pPool, size_t deviceIdx)
+{
+    size_t j;
+
+    POOL_LOCK(pPool);
+    for (j = 0; j < pPool->keyCount; j++) {
+        ex_sss_pool_key_t *pKey = &pPool->key[j];
+        if (pKey->replicaMask & (1u << deviceIdx)) {
+            sss_key_object_free(&pKey->object[deviceIdx]);
+            pKey->replicaMask &= ~(1u << deviceIdx);
+        }
+    }
+    POOL_UNLOCK(pPool);
+}
+
+/* Called with the pool locked */
+static ex_sss_pool_key_t *pool_find_key(ex_sss_pool_t *pPool, uint32_t keyId)
+{
+    size_t j;
+
+    for (j = 0; j < pPool->keyCount; j++) {
+        if (pPool->key[j].keyId == keyId) {
+            return &pPool->key[j];
+        }
+    }
+    return NULL;
+}
+
+static sss_status_t pool_run(
+    ex_sss_pool_t *pPool, uint32_t keyId, ex_sss_pool_fn_t fn, void *arg, bool failureIsDeviceError)
+{
+    sss_status_t status     = kStatus_SSS_Fail;
+    uint32_t triedMask      = 0;
+    bool retry              = false;
+
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+    ENSURE_OR_GO_EXIT(fn != NULL);
+
+    do {
+        ex_sss_pool_device_t *pDevice = NULL;
+        ex_sss_pool_key_t *pKey       = NULL;
+        sss_object_t *pKeyObject      = NULL;
+        uint32_t candidates           = 0;
+        size_t selected               = 0;
+        size_t i;
+
+        retry = false;
+
+        /* Select the least loaded healthy replica */
+        POOL_LOCK(pPool);
+        if (keyId == EX_SSS_POOL_ANY_KEY) {
+            candidates = (pPool->deviceCount >= 32) ? 0xFFFFFFFFu : ((1u << pPool->deviceCount) - 1u);
+        }
+        else {
+            pKey = pool_find_key(pPool, keyId);
+            if (pKey != NULL) {
+                candidates = pKey->replicaMask;
+            }
+        }
+        candidates &= ~triedMask;
+        for (i = 0; i < pPool->deviceCount; i++) {
+            ex_sss_pool_device_t *pCandidate = &pPool->device[i];
+            if (!(candidates & (1u << i)) || !pCandidate->healthy) {
+                continue;
+            }
+            if ((pDevice == NULL) || (pCandidate->inFlight < pDevice->inFlight) ||
+                ((pCandidate->inFlight == pDevice->inFlight) && (pCandidate->opCount < pDevice->opCount))) {
+                pDevice  = pCandidate;
+                selected = i;
+            }
+        }
+        if (pDevice != NULL) {
+            pDevice->inFlight++;
+            if (pKey != NULL) {
+                pKeyObject = &pKey->object[selected];
+            }
+        }
+        POOL_UNLOCK(pPool);
+
+        if (pDevice == NULL) {
+            if (triedMask == 0) {
+                LOG_E("No healthy device holds key 0x%08X", keyId);
+            }
+            goto exit;
+        }
+        triedMask |= (1u << selected);
+
+        DEVICE_LOCK(pDevice);
+        status = fn(&pDevice->boot, pKeyObject, arg);
+        DEVICE_UNLOCK(pDevice);
+
+        POOL_LOCK(pPool);
+        pDevice->inFlight--;
+        pDevice->opCount++;
+        if (status == kStatus_SSS_Success) {
+            pDevice->consecutiveFailures = 0;
+        }
+        else if (failureIsDeviceError) {
+            pDevice->failCount++;
+            pDevice->consecutiveFailures++;
+            if (pDevice->healthy && pDevice->consecutiveFailures >= EX_SSS_POOL_FAIL_THRESHOLD) {
+                LOG_W("Device %u taken out of rotation after %u failures",
+                    (unsigned)selected,
+                    pDevice->consecutiveFailures);
+                pDevice->healthy = false;
+                /* Give the operation a chance on another replica */
+                retry = true;
+            }
+        }
+        POOL_UNLOCK(pPool);
+    } while (retry);
+
+exit:
+    return status;
+}
+
+static sss_status_t pool_sign_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg)
+{
+    sss_status_t status     = kStatus_SSS_Fail;
+    pool_sign_args_t *pArgs = (pool_sign_args_t *)arg;
+    sss_asymmetric_t asymm  = {0};
+
+    status = sss_asymmetric_context_init(&asymm, &pCtx->session, pKeyObject, pArgs->algorithm, kMode_SSS_Sign);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_asymmetric_sign_digest(&asymm, pArgs->digest, pArgs->digestLen, pArgs->signature, pArgs->pSignatureLen);
+    sss_asymmetric_context_free(&asymm);
+
+exit:
+    return status;
+}
+
+static sss_status_t pool_verify_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg)
+{
+    sss_status_t status     = kStatus_SSS_Fail;
+    pool_sign_args_t *pArgs = (pool_sign_args_t *)arg;
+    sss_asymmetric_t asymm  = {0};
+
+    status = sss_asymmetric_context_init(&asymm, &pCtx->session, pKeyObject, pArgs->algorithm, kMode_SSS_Verify);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_asymmetric_verify_digest(
+        &asymm, pArgs->digest, pArgs->digestLen, pArgs->signature, *pArgs->pSignatureLen);
+    sss_asymmetric_context_free(&asymm);
+
+exit:
+    return status;
+}
+
+static sss_status_t pool_dh_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg)
+{
+    sss_status_t status    = kStatus_SSS_Fail;
+    pool_dh_args_t *pArgs  = (pool_dh_args_t *)arg;
+    sss_derive_key_t derive = {0};
+
+    status = sss_derive_key_context_init(
+        &derive, &pCtx->session, pKeyObject, kAlgorithm_SSS_ECDH, kMode_SSS_ComputeSharedSecret);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_derive_key_dh(&derive, pArgs->otherPartyKeyObject, pArgs->derivedKeyObject);
+    sss_derive_key_context_free(&derive);
+
+exit:
+    return status;
+}
+
+static sss_status_t pool_rng_fn(ex_sss_boot_ctx_t *pCtx, sss_object_t *pKeyObject, void *arg)
+{
+    sss_status_t status    = kStatus_SSS_Fail;
+    pool_rng_args_t *pArgs = (pool_rng_args_t *)arg;
+    sss_rng_context_t rng  = {0};
+
+    AX_UNUSED_ARG(pKeyObject);
+    status = sss_rng_context_init(&rng, &pCtx->session);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+    status = sss_rng_get_random(&rng, pArgs->data, pArgs->dataLen);
+    sss_rng_context_free(&rng);
+
+exit:
+    return status;
+}
+
+#ifdef __cplusplus
+}
+#endif
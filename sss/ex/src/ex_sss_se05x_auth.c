@@ -27,6 +27,9 @@
 #include "ex_sss_boot_int.h"
 #include "nxLog_App.h"
 #include "nxScp03_Types.h"
+#if SSSFTR_SE05X_AuthECKey
+#include "fsl_sss_se05x_scp03.h"
+#endif
 #if defined(SECURE_WORLD)
 #include "fsl_sss_lpc55s_apis.h"
 #endif
@@ -36,6 +39,12 @@
 
 #define AUTH_KEY_SIZE 16
 #define SCP03_MAX_AUTH_KEY_SIZE 52
+
+/* 1: generate host ephemeral key pairs for ECKey session opens ahead of
+ * time, see nxECKey_StartEphemeralPool() */
+#ifndef EX_SSS_ECKEY_EPHEMERAL_POOL
+#define EX_SSS_ECKEY_EPHEMERAL_POOL 0
+#endif
 /* *****************************************************************************************************************
 * Type Definitions
 * ***************************************************************************************************************** */
@@ -606,6 +615,13 @@ static sss_status_t ex_sss_se05x_prepare_host_eckey(SE05x_AuthCtx_ECKey_t *pAuth
         return status;
     }
 
+#if EX_SSS_ECKEY_EPHEMERAL_POOL && (__GNUC__ && !AX_EMBEDDED)
+    /* Key pairs for the session opens after the first one */
+    if (nxECKey_StartEphemeralPool(pStatic_ctx, 0) != kStatus_SSS_Success) {
+        LOG_W("No ephemeral key pool, key pairs are generated at session open");
+    }
+#endif
+
     /* Init allocate SE ECKA Public Key */
     status = Alloc_ECKeykey_toSE05xAuthctx(&pStatic_ctx->SeEcPubKey, pKs, MAKE_TEST_ID(__LINE__), kSSS_KeyPart_Public);
     if (status != kStatus_SSS_Success) {
@@ -693,6 +693,32 @@ typedef struct
         uint8_t data[SSS_ASYMMETRIC_MAX_CONTEXT_SIZE];
     } extension;
 } sss_asymmetric_t;
+
+/** Where public key operations of secure element keys are run,
+ * see ::sss_hybrid_set_policy */
+typedef enum
+{
+    /** On the secure element holding the key */
+    kSSS_HybridPolicy_SE = 0,
+    /** Verify and public key encrypt with keys registered by
+     * ::sss_hybrid_add_key on the host crypto backend, with the public key
+     * read once from the secure element */
+    kSSS_HybridPolicy_PublicOnHost = 1,
+} sss_hybrid_policy_t;
+
+/** Counters of the hybrid dispatch, see ::sss_hybrid_get_stats */
+typedef struct
+{
+    /** Operations run on the host */
+    uint32_t offloaded;
+    /** Public key operations that went to the secure element, including
+     * operations the host could not do */
+    uint32_t onSecureElement;
+    /** Public keys read from the secure element */
+    uint32_t keyReads;
+    /** Public keys that could not be read or imported on the host */
+    uint32_t keyReadFailures;
+} sss_hybrid_stats_t;
 /** @} */
 
 /** Header for a IS716 APDU */
@@ -1699,12 +1725,118 @@ sss_status_t sss_asymmetric_sign_digest(
 sss_status_t sss_asymmetric_verify_digest(
     sss_asymmetric_t *context, uint8_t *digest, size_t digestLen, uint8_t *signature, size_t signatureLen);
 
+/** @brief Asymmetric signature of several message digests with one SE05x key
+ *  Same as calling ::sss_asymmetric_sign_digest for each digest, with the
+ *  SE05x reserved for SSS_SE05X_BATCH_ATOMIC_MAX digests at a time. Host
+ *  crypto contexts are not supported, call ::sss_asymmetric_sign_digest
+ *  for them.
+ *
+ * @param context Pointer to asymmetric context.
+ * @param digests Input buffers containing the message digests
+ * @param digestLen Length of each digest in bytes
+ * @param count Number of digests
+ * @param signatures Output buffers for the signatures
+ * @param[in,out] signatureLens Size of each signature buffer, length of each signature
+ *
+ * @returns Status of the operation
+ * @retval #kStatus_SSS_Success All digests have been signed.
+ * @retval #kStatus_SSS_Fail Signing has failed. Digests before the failing one are signed.
+ * @retval #kStatus_SSS_InvalidArgument One of the arguments is invalid for the function to execute,
+ *         or context is not an SE05x context.
+ */
+sss_status_t sss_asymmetric_sign_digest_batch(sss_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[]);
+
+/** @brief Asymmetric verify of several message digests with one SE05x key
+ *  Same as calling ::sss_asymmetric_verify_digest for each digest, with the
+ *  SE05x reserved for SSS_SE05X_BATCH_ATOMIC_MAX digests at a time. All
+ *  signatures are verified, also after a failing one. Keys registered with
+ *  ::sss_hybrid_add_key are verified on the host as selected by
+ *  ::sss_hybrid_set_policy. Host crypto contexts are not supported, call
+ *  ::sss_asymmetric_verify_digest for them.
+ *
+ * @param context Pointer to asymmetric context.
+ * @param digests Input buffers containing the message digests
+ * @param digestLen Length of each digest in bytes
+ * @param count Number of digests
+ * @param signatures Input buffers containing the signatures to verify
+ * @param signatureLens Length of each signature in bytes
+ * @param[out] results Status of each verification, may be NULL
+ *
+ * @returns Status of the operation
+ * @retval #kStatus_SSS_Success All signatures are valid.
+ * @retval #kStatus_SSS_Fail At least one verification has failed, see results.
+ * @retval #kStatus_SSS_InvalidArgument One of the arguments is invalid for the function to execute,
+ *         or context is not an SE05x context.
+ */
+sss_status_t sss_asymmetric_verify_digest_batch(sss_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[],
+    sss_status_t results[]);
+
 /** @brief Asymmetric context release.
  *  The function frees asymmetric context.
  *
  * @param context Pointer to asymmetric context.
  */
 void sss_asymmetric_context_free(sss_asymmetric_t *context);
+
+/** @brief Select where public key operations of secure element keys run.
+ *
+ * With #kSSS_HybridPolicy_PublicOnHost, ::sss_asymmetric_verify_digest and
+ * RSA ::sss_asymmetric_encrypt on an SE05x key registered with
+ * ::sss_hybrid_add_key read the public key once, keep it in a host crypto
+ * session and run on the host CPU. Other keys, keys whose public part cannot
+ * be read and operations the host cannot do keep going to the secure element.
+ *
+ * Default is SSS_HYBRID_POLICY_DEFAULT (#kSSS_HybridPolicy_SE unless set
+ * in the build).
+ *
+ * @param policy One of @ref sss_hybrid_policy_t
+ *
+ * @retval #kStatus_SSS_Success The policy is set.
+ * @retval #kStatus_SSS_InvalidArgument The build has no SE05x or no host crypto.
+ */
+sss_status_t sss_hybrid_set_policy(sss_hybrid_policy_t policy);
+
+/** @brief Current policy, see ::sss_hybrid_set_policy */
+sss_hybrid_policy_t sss_hybrid_get_policy(void);
+
+/** @brief Allow host side public key operations with an SE05x key.
+ *
+ * Only register keys that do not change while registered, e.g. provisioned
+ * root or attestation keys. Changes made through ::sss_key_store_set_key,
+ * ::sss_key_store_generate_key and ::sss_key_store_erase_key of the same
+ * session are seen. Changes through another session, the sss_se05x_* or
+ * Se05x_API_* functions or another host are not: call
+ * ::sss_hybrid_remove_key or ::sss_hybrid_flush in that case.
+ *
+ * @param keyObject SE05x key object
+ *
+ * @retval #kStatus_SSS_Success The key is registered.
+ * @retval #kStatus_SSS_Fail All SSS_HYBRID_PUBKEY_CACHE_ENTRIES entries are in use.
+ * @retval #kStatus_SSS_InvalidArgument Not an SE05x key, or not supported by the build.
+ */
+sss_status_t sss_hybrid_add_key(sss_object_t *keyObject);
+
+/** @brief Run the operations of a key on the secure element again and drop its host copy. */
+void sss_hybrid_remove_key(sss_object_t *keyObject);
+
+/** @brief Read the counters of the hybrid dispatch.
+ *
+ * @param[out] pStats Counters since start or the last ::sss_hybrid_flush
+ */
+void sss_hybrid_get_stats(sss_hybrid_stats_t *pStats);
+
+/** @brief Unregister all keys, drop their host copies and reset the counters. */
+void sss_hybrid_flush(void);
 /**
  *@}
  */ /* end of sss_crypto_asymmetric */
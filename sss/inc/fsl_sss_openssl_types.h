@@ -140,6 +140,13 @@ typedef struct _sss_openssl_symmetric
     EVP_CIPHER_CTX *cipher_ctx;
     uint8_t cache_data[16];
     size_t cache_data_len;
+    /*! Cipher, direction and key cipher_ctx is set up with. An init with the
+     * same ones only sets the IV, the key is not expanded again. Only keys
+     * of up to 16 bytes are remembered, e.g. the SCP03 session keys. */
+    const EVP_CIPHER *keyed_cipher;
+    uint8_t keyed_key[16];
+    uint8_t keyed_key_len;
+    uint8_t keyed_enc;
 } sss_openssl_symmetric_t;
 
 typedef struct
@@ -155,6 +162,9 @@ typedef struct
     CMAC_CTX *cmac_ctx;
     HMAC_CTX *hmac_ctx;
 #endif
+    /*! Key the MAC context is set up with, see sss_openssl_symmetric_t::keyed_key */
+    uint8_t keyed_key[16];
+    uint8_t keyed_key_len;
 } sss_openssl_mac_t;
 
 typedef struct _sss_openssl_aead
@@ -336,6 +336,27 @@ sss_status_t sss_se05x_asymmetric_verify_digest(sss_se05x_asymmetric_t *context,
     const uint8_t *signature,
     size_t signatureLen);
 
+/** @copydoc sss_asymmetric_sign_digest_batch
+ *
+ */
+sss_status_t sss_se05x_asymmetric_sign_digest_batch(sss_se05x_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[]);
+
+/** @copydoc sss_asymmetric_verify_digest_batch
+ *
+ */
+sss_status_t sss_se05x_asymmetric_verify_digest_batch(sss_se05x_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[],
+    sss_status_t results[]);
+
 /** @copydoc sss_asymmetric_context_free
  *
  */
@@ -410,6 +431,22 @@ sss_status_t sss_se05x_cipher_crypt_ctr(sss_se05x_symmetric_t *context,
  */
 void sss_se05x_symmetric_context_free(sss_se05x_symmetric_t *context);
 
+/** Let sss_se05x_cipher_init() / update / finish hold back the input on the
+ * host, and encrypt or decrypt it with one CipherOneShot APDU at finish as
+ * long as it stays small. Larger input falls back to streaming.
+ *
+ * Call after sss_se05x_symmetric_context_init(). In lazy mode output is
+ * delayed: update returns no data while input is held back, and finish (or
+ * the update that overflows the buffer) returns the output of all input held
+ * back so far. Size the output buffers accordingly.
+ *
+ * Not available for kAlgorithm_SSS_AES_CTR_INT_IV, which always streams.
+ *
+ * @param context Symmetric context
+ * @param enable  1 to enable, 0 to stream (default)
+ */
+sss_status_t sss_se05x_symmetric_context_set_lazy(sss_se05x_symmetric_t *context, uint8_t enable);
+
 /*! @} */ /* end of : sss_se05x_symm */
 
 /**
@@ -513,6 +550,17 @@ sss_status_t sss_se05x_mac_finish(sss_se05x_mac_t *context, uint8_t *mac, size_t
  */
 void sss_se05x_mac_context_free(sss_se05x_mac_t *context);
 
+/** Let sss_se05x_mac_init() / update / finish hold back the input on the
+ * host and send it with one MACOneShot APDU at finish as long as it stays
+ * small, see sss_se05x_symmetric_context_set_lazy().
+ *
+ * Key and policy errors are then reported by finish instead of init.
+ *
+ * @param context MAC context
+ * @param enable  1 to enable, 0 to stream (default)
+ */
+sss_status_t sss_se05x_mac_context_set_lazy(sss_se05x_mac_t *context, uint8_t enable);
+
 /*! @} */ /* end of : sss_se05x_mac */
 
 /**
@@ -536,6 +584,15 @@ sss_status_t sss_se05x_digest_one_go(
  */
 sss_status_t sss_se05x_digest_init(sss_se05x_digest_t *context);
 
+/** Let sss_se05x_digest_init() / update / finish hold back the input on the
+ * host and send it with one SHAOneShot APDU at finish as long as it stays
+ * small, see sss_se05x_symmetric_context_set_lazy().
+ *
+ * @param context Digest context
+ * @param enable  1 to enable, 0 to stream (default)
+ */
+sss_status_t sss_se05x_digest_context_set_lazy(sss_se05x_digest_t *context, uint8_t enable);
+
 /** @copydoc sss_digest_update
  *
  */
@@ -572,6 +629,71 @@ sss_status_t sss_se05x_rng_get_random(sss_se05x_rng_context_t *context, uint8_t
  */
 sss_status_t sss_se05x_rng_context_free(sss_se05x_rng_context_t *context);
 
+/** Serve sss_se05x_rng_get_random() of this session from a host HMAC_DRBG
+ * (NIST SP 800-90A, SHA-256), instantiated from SE entropy.
+ *
+ * The DRBG is reseeded from the SE as set in pConfig. Without a DRBG every
+ * random byte is read from the SE. Needs host crypto (OpenSSL or mbedTLS).
+ * Enabled at session open when built with SSS_SE05X_RNG_DRBG=1.
+ *
+ * @param session SE05x session
+ * @param pConfig Reseed policy, NULL for the build defaults
+ *                (SSS_SE05X_DRBG_RESEED_BYTES, SSS_SE05X_DRBG_RESEED_MS)
+ */
+sss_status_t sss_se05x_session_enable_drbg(sss_se05x_session_t *session, const sss_se05x_drbg_config_t *pConfig);
+
+/** Stop using the host DRBG and wipe its state.
+ *
+ * Later requests read from the SE. A request in progress completes on the
+ * DRBG, which is wiped and freed when that request returns. On RTOS builds
+ * the session's DRBG is not reference counted under a lock: disable it only
+ * while no other task uses the session.
+ */
+void sss_se05x_session_disable_drbg(sss_se05x_session_t *session);
+
+/** Known answer test of the host DRBG with a NIST CAVP HMAC_DRBG SHA-256
+ * vector. Runs on the host crypto only, no SE is needed.
+ *
+ * @retval #kStatus_SSS_Success The output matches.
+ * @retval #kStatus_SSS_InvalidArgument Built without host crypto.
+ */
+sss_status_t sss_se05x_drbg_self_test(void);
+
+/** Reseed the host DRBG of the session from SE entropy now, e.g. before
+ * generating long term keys (prediction resistance on demand).
+ * Nothing to do if the session has no DRBG.
+ */
+sss_status_t sss_se05x_rng_reseed(sss_se05x_rng_context_t *context);
+
+/** Start a background thread that reads random bytes from the SE ahead of
+ * use, with the largest GetRandom response per APDU and at low bus priority.
+ *
+ * sss_se05x_rng_get_random() of this session then takes bytes from the ring
+ * and only reads from the SE itself when the ring runs dry. A host DRBG,
+ * if enabled, takes precedence.
+ *
+ * On sessions with a secure channel (SCP03, ECKey or tunnel) the random
+ * bytes are read through that channel, between the commands of the
+ * application threads. Available on POSIX hosts.
+ *
+ * @param session  SE05x session
+ * @param ringSize Ring size in bytes, a power of 2.
+ *                 0 for SSS_SE05X_RNG_RING_SIZE
+ */
+sss_status_t sss_se05x_session_start_rng_prefetch(sss_se05x_session_t *session, size_t ringSize);
+
+/** Stop the prefetch thread and wipe the ring.
+ * No other thread may use the session's RNG during this call. */
+void sss_se05x_session_stop_rng_prefetch(sss_se05x_session_t *session);
+
+/** Read the counters of the random number prefetch, to size the ring
+ * against the consumption of the application.
+ *
+ * @return kStatus_SSS_Fail if no prefetch thread is running
+ */
+sss_status_t sss_se05x_session_get_rng_prefetch_stats(
+    sss_se05x_session_t *session, sss_se05x_rng_prefetch_stats_t *pStats);
+
 /*! @} */ /* end of : sss_se05x_rng */
 
 /**
@@ -595,6 +717,49 @@ void sss_se05x_tunnel_context_free(sss_se05x_tunnel_context_t *context);
 */
 sss_status_t sss_se05x_refresh_session(sss_se05x_session_t *session, void *connectionData);
 
+/** Forget all cached object metadata of the session.
+ *
+ * Existence, type, size and curve of secure objects are cached per session
+ * and kept up to date by this session's own set/generate/erase calls.
+ * Call this when objects may have been changed through another session or
+ * by another host.
+ */
+void sss_se05x_session_flush_object_cache(sss_se05x_session_t *session);
+
+#if SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
+/** Create all EC curves enabled in this build (NIST, Brainpool, Koblitz)
+ * that are not yet on the SE, then verify them with one curve list read.
+ *
+ * Afterwards EC key operations of this session need no curve APDUs.
+ * Called from sss_se05x_session_open() when built with
+ * SSS_SE05X_CURVE_WARMUP=1.
+ *
+ * @return kStatus_SSS_Success if all curves are present on the SE
+ */
+sss_status_t sss_se05x_session_provision_curves(sss_se05x_session_t *session);
+#endif
+
+/** Hash the message of sss_se05x_asymmetric_sign() and
+ * sss_se05x_asymmetric_verify() on the host and send only the digest to
+ * the SE05x.
+ *
+ * Applies to RSA and ECDSA keys with SHA-256, SHA-384 or SHA-512. The
+ * message then no longer has to be transferred to the SE, so its size does
+ * not affect the signing time. EdDSA always hashes on the SE.
+ *
+ * Default is SSS_SE05X_HOST_HASH (0 unless set in the build).
+ *
+ * Enabling opens a host crypto session that is reused for every hash and
+ * closed by sss_se05x_session_close().
+ *
+ * @param session SE05x session
+ * @param enable  1 to hash on the host, 0 to hash on the SE
+ *
+ * @return kStatus_SSS_InvalidArgument if enabled in a build without host crypto,
+ *         kStatus_SSS_Fail if the host session could not be opened
+ */
+sss_status_t sss_se05x_session_set_host_hash(sss_se05x_session_t *session, uint8_t enable);
+
 /**
  * @addtogroup sss_se05x_tunnel
  * @{
@@ -728,6 +893,10 @@ sss_status_t sss_se05x_key_store_create_curve(Se05xSession_t *pSession, uint32_t
             sss_se05x_asymmetric_sign_digest(((sss_se05x_asymmetric_t * ) context),(digest),(digestLen),(signature),(signatureLen))
 #       define sss_asymmetric_verify_digest(context,digest,digestLen,signature,signatureLen) \
             sss_se05x_asymmetric_verify_digest(((sss_se05x_asymmetric_t * ) context),(digest),(digestLen),(signature),(signatureLen))
+#       define sss_asymmetric_sign_digest_batch(context,digests,digestLen,count,signatures,signatureLens) \
+            sss_se05x_asymmetric_sign_digest_batch(((sss_se05x_asymmetric_t * ) context),(digests),(digestLen),(count),(signatures),(signatureLens))
+#       define sss_asymmetric_verify_digest_batch(context,digests,digestLen,count,signatures,signatureLens,results) \
+            sss_se05x_asymmetric_verify_digest_batch(((sss_se05x_asymmetric_t * ) context),(digests),(digestLen),(count),(signatures),(signatureLens),(results))
 #       define sss_asymmetric_context_free(context) \
             sss_se05x_asymmetric_context_free(((sss_se05x_asymmetric_t * ) context))
         /* Direct Call : symm */
@@ -10,6 +10,15 @@
 /* ************************************************************************** */
 /* Defines                                                                    */
 /* ************************************************************************** */
+
+/** Host ephemeral key pairs kept ready by ::nxECKey_StartEphemeralPool by default */
+#ifndef NX_ECKEY_EPHEMERAL_POOL_DEPTH
+#define NX_ECKEY_EPHEMERAL_POOL_DEPTH 2
+#endif
+
+/** Upper limit of the pool depth */
+#define NX_ECKEY_EPHEMERAL_POOL_MAX 8
+
 /* ************************************************************************** */
 /* Includes                                                                   */
 /* ************************************************************************** */
@@ -32,6 +41,21 @@ extern "C" {
 /* Structrues and Typedefs                                                    */
 /* ************************************************************************** */
 
+/** Counters of the ephemeral key pool, see ::nxECKey_GetEphemeralPoolStats */
+typedef struct
+{
+    /** Key pairs kept ready */
+    size_t depth;
+    /** Key pairs ready right now */
+    size_t available;
+    /** Key pairs generated for the pool */
+    uint32_t generated;
+    /** Key pairs taken by session opens */
+    uint32_t taken;
+    /** Session opens that found the pool empty and generated a key pair */
+    uint32_t misses;
+} NXECKey03_EphemeralPoolStats_t;
+
 /* ************************************************************************** */
 /* Global Variables                                                           */
 /* ************************************************************************** */
@@ -50,6 +74,46 @@ sss_status_t nxScp03_AuthenticateChannel(pSe05xSession_t se05xSession, NXSCP03_A
 sss_status_t nxECKey_AuthenticateChannel(
     pSe05xSession_t se05xSession, SE05x_AuthCtx_ECKey_t *pAuthFScp, uint8_t *pSePubkey, size_t *sePubkeyLen);
 
+#if (__GNUC__ && !AX_EMBEDDED)
+/**
+* To generate host ephemeral key pairs ahead of ECKey session open.
+*
+* Each session open (::nxECKey_AuthenticateChannel) uses a new host ephemeral
+* key pair. The one prepared with the static keys serves the first open,
+* later opens (e.g. after an SE reset) take one from the pool, so host key
+* generation is not on their critical path. Each key pair is used once.
+*
+* With OpenSSL a background thread refills the pool. With other host crypto
+* the pool is filled here, refill it with ::nxECKey_RefillEphemeralPool when
+* the host is idle.
+*
+* HostEcdsaObj of pStatic_ctx must be set up, pEphemeralPool must be NULL
+* or a running pool. Stop the pool before the static keys are freed.
+*
+* @param pStatic_ctx Static keys of the ECKey authentication
+* @param depth       Key pairs to keep ready, 0 for NX_ECKEY_EPHEMERAL_POOL_DEPTH
+*/
+sss_status_t nxECKey_StartEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx, size_t depth);
+
+/**
+* To generate key pairs until the pool is full, in the calling thread.
+*/
+sss_status_t nxECKey_RefillEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx);
+
+/**
+* To stop the refill thread and free the key pairs of the pool.
+* No session open may use pStatic_ctx during this call.
+*/
+void nxECKey_StopEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx);
+
+/**
+* To read the counters of the pool, to size it against the session opens.
+*
+* @return kStatus_SSS_Fail if no pool is running
+*/
+sss_status_t nxECKey_GetEphemeralPoolStats(NXECKey03_StaticCtx_t *pStatic_ctx, NXECKey03_EphemeralPoolStats_t *pStats);
+#endif // (__GNUC__ && !AX_EMBEDDED)
+
 #ifdef __cplusplus
 } /* extern "c"*/
 #endif
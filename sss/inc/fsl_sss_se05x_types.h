@@ -123,8 +123,56 @@ typedef struct _sss_se05x_session
     /** In case connection is tunneled, context to the tunnel */
 
     sss_se05x_tunnel_context_t *ptun_ctx;
+
+    /** Metadata of secure objects used through this session.
+     * NULL if the cache is disabled, see ::sss_se05x_session_flush_object_cache */
+    struct _sss_se05x_obj_cache *pObjCache;
+
+    /** Hash messages of sss_se05x_asymmetric_sign() / _verify() on the host,
+     * see ::sss_se05x_session_set_host_hash */
+    uint8_t hostHash;
+
+    /** Host crypto session doing that hashing, opened together with
+     * ::sss_se05x_session_set_host_hash and kept until the session closes */
+    sss_session_t *pHostHashSession;
+
+    /** Host DRBG serving sss_se05x_rng_get_random(), NULL to read every
+     * byte from the SE, see ::sss_se05x_session_enable_drbg */
+    struct _sss_se05x_drbg *pDrbg;
+
+    /** Random bytes read ahead from the SE by a background thread,
+     * see ::sss_se05x_session_start_rng_prefetch */
+    struct _sss_se05x_rng_prefetch *pRngPrefetch;
 } sss_se05x_session_t;
 
+/** Reseed policy of the host DRBG, see ::sss_se05x_session_enable_drbg */
+typedef struct
+{
+    /** Reseed from SE entropy after this many output bytes, 0: never */
+    uint32_t reseedIntervalBytes;
+    /** Reseed from SE entropy after this many milliseconds, 0: never */
+    uint32_t reseedIntervalMs;
+    /** 1: reseed before every request (prediction resistance) */
+    uint8_t predictionResistance;
+} sss_se05x_drbg_config_t;
+
+/** Counters of the random number prefetch, see ::sss_se05x_session_get_rng_prefetch_stats */
+typedef struct
+{
+    /** Size of the ring in bytes */
+    size_t capacity;
+    /** Bytes in the ring right now */
+    size_t fillLevel;
+    /** Bytes read from the SE by the prefetch thread */
+    uint64_t produced;
+    /** Bytes served from the ring */
+    uint64_t consumed;
+    /** Requests that found too few bytes in the ring and read from the SE */
+    uint32_t misses;
+    /** Read rate of the prefetch thread while it talks to the SE */
+    uint32_t refillBytesPerSec;
+} sss_se05x_rng_prefetch_stats_t;
+
 struct _sss_se05x_object;
 
 /** @copydoc sss_key_store_t */
@@ -208,6 +256,10 @@ typedef struct
     uint8_t cache_data[16];
     /** Length of bytes cached on host */
     size_t cache_data_len;
+    /** Lazy mode requested, see ::sss_se05x_symmetric_context_set_lazy */
+    uint8_t lazy;
+    /** Input held back on host until finish, NULL when streaming */
+    struct _sss_se05x_lazy *pLazy;
 } sss_se05x_symmetric_t;
 
 /** @copydoc sss_mac_t */
@@ -226,6 +278,10 @@ typedef struct
 
     /** Used crypto object ID for this operation */
     SE05x_CryptoObjectID_t cryptoObjectId;
+    /** Lazy mode requested, see ::sss_se05x_mac_context_set_lazy */
+    uint8_t lazy;
+    /** Input held back on host until finish, NULL when streaming */
+    struct _sss_se05x_lazy *pLazy;
 } sss_se05x_mac_t;
 
 /** @copydoc sss_aead_t */
@@ -263,6 +319,10 @@ typedef struct
     /** Implementation specific part */
 
     SE05x_CryptoObjectID_t cryptoObjectId;
+    /** Lazy mode requested, see ::sss_se05x_digest_context_set_lazy */
+    uint8_t lazy;
+    /** Input held back on host until finish, NULL when streaming */
+    struct _sss_se05x_lazy *pLazy;
 } sss_se05x_digest_t;
 
 /** @copydoc sss_rng_context_t */
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include <fsl_sss_api.h>
+#include <string.h>
 
 #if defined(SSS_USE_FTR_FILE)
 #include "fsl_sss_ftr.h"
@@ -34,6 +35,449 @@
 
 #if (SSS_HAVE_SSS > 1)
 
+/* ************************************************************************** */
+/* Hybrid dispatch: public key operations of SE05x keys on the host          */
+/* ************************************************************************** */
+
+#if SSS_HAVE_APPLET_SE05X_IOT && (SSS_HAVE_HOSTCRYPTO_MBEDTLS || SSS_HAVE_HOSTCRYPTO_OPENSSL)
+#define SSS_HYBRID_SUPPORTED 1
+#else
+#define SSS_HYBRID_SUPPORTED 0
+#endif
+
+#ifndef SSS_HYBRID_POLICY_DEFAULT
+#define SSS_HYBRID_POLICY_DEFAULT kSSS_HybridPolicy_SE
+#endif
+
+/* Number of SE05x public keys that can be registered for the host */
+#ifndef SSS_HYBRID_PUBKEY_CACHE_ENTRIES
+#define SSS_HYBRID_PUBKEY_CACHE_ENTRIES 8
+#endif
+
+/* Largest public key read from the SE05x, DER encoded RSA 4096 */
+#define SSS_HYBRID_PUBKEY_MAX_LEN 600
+
+#if (__GNUC__ && !AX_EMBEDDED)
+#include <pthread.h>
+/* Only held to look up, pin and unpin keys, never across an operation */
+static pthread_mutex_t gSssHybridLock = PTHREAD_MUTEX_INITIALIZER;
+#define HYBRID_LOCK() (void)pthread_mutex_lock(&gSssHybridLock)
+#define HYBRID_UNLOCK() (void)pthread_mutex_unlock(&gSssHybridLock)
+#else
+#define HYBRID_LOCK()
+#define HYBRID_UNLOCK()
+#endif
+
+static sss_hybrid_policy_t gSssHybridPolicy = SSS_HYBRID_POLICY_DEFAULT;
+static sss_hybrid_stats_t gSssHybridStats;
+
+#if SSS_HYBRID_SUPPORTED
+typedef enum
+{
+    kSSS_HybridKey_NotLoaded = 0,
+    kSSS_HybridKey_Loading, /* Read from the SE by one thread, without the lock */
+    kSSS_HybridKey_OnHost,
+    kSSS_HybridKey_NotReadable,
+} sss_hybrid_key_state_t;
+
+/* A key registered with sss_hybrid_add_key(). The entry is free when it is
+ * not registered, not loaded and not in use. */
+typedef struct
+{
+    const sss_session_t *seSession; /* Session the key is read through */
+    uint32_t keyId;
+    uint8_t registered;
+    uint8_t stale; /* Changed while in use, unloaded by the last user */
+    uint32_t users; /* Operations running with hostKey */
+    sss_hybrid_key_state_t state;
+    sss_object_t hostKey;
+} sss_hybrid_key_t;
+
+static struct
+{
+    sss_session_t hostSession;
+    sss_key_store_t hostKs;
+    uint8_t hostOpen;
+    sss_hybrid_key_t key[SSS_HYBRID_PUBKEY_CACHE_ENTRIES];
+} gSssHybrid;
+
+/* Called with the lock held */
+static void sss_hybrid_unload_locked(sss_hybrid_key_t *pKey)
+{
+    if ((pKey->users > 0) || (pKey->state == kSSS_HybridKey_Loading)) {
+        pKey->stale = 1;
+        return;
+    }
+    if (pKey->state == kSSS_HybridKey_OnHost) {
+        sss_key_object_free(&pKey->hostKey);
+    }
+    pKey->state = kSSS_HybridKey_NotLoaded;
+    pKey->stale = 0;
+    if (!pKey->registered) {
+        memset(pKey, 0, sizeof(*pKey));
+    }
+}
+
+/* Called with the lock held */
+static sss_hybrid_key_t *sss_hybrid_find_locked(const sss_session_t *session, uint32_t keyId)
+{
+    size_t i;
+    for (i = 0; i < SSS_HYBRID_PUBKEY_CACHE_ENTRIES; i++) {
+        sss_hybrid_key_t *pKey = &gSssHybrid.key[i];
+        if (pKey->registered && (pKey->seSession == session) && (pKey->keyId == keyId)) {
+            return pKey;
+        }
+    }
+    return NULL;
+}
+
+/* The key was changed on the SE through this API, read it again on next use */
+static void sss_hybrid_invalidate(const sss_session_t *session, uint32_t keyId)
+{
+    sss_hybrid_key_t *pKey = NULL;
+
+    HYBRID_LOCK();
+    pKey = sss_hybrid_find_locked(session, keyId);
+    if (pKey != NULL) {
+        sss_hybrid_unload_locked(pKey);
+    }
+    HYBRID_UNLOCK();
+}
+
+/* Unregister the keys of session (NULL: all sessions) */
+static void sss_hybrid_forget_locked(const sss_session_t *session)
+{
+    size_t i;
+    for (i = 0; i < SSS_HYBRID_PUBKEY_CACHE_ENTRIES; i++) {
+        sss_hybrid_key_t *pKey = &gSssHybrid.key[i];
+        if ((session != NULL) && (pKey->seSession != session)) {
+            continue;
+        }
+        pKey->registered = 0;
+        sss_hybrid_unload_locked(pKey);
+    }
+}
+
+static void sss_hybrid_forget(const sss_session_t *session)
+{
+    HYBRID_LOCK();
+    sss_hybrid_forget_locked(session);
+    HYBRID_UNLOCK();
+}
+
+static sss_status_t sss_hybrid_open_host_locked(void)
+{
+    sss_status_t status;
+
+    if (gSssHybrid.hostOpen) {
+        return kStatus_SSS_Success;
+    }
+    status = sss_session_open(&gSssHybrid.hostSession, kType_SSS_Software, 0, kSSS_ConnectionType_Plain, NULL);
+    if (status != kStatus_SSS_Success) {
+        LOG_E("Hybrid: host session could not be opened");
+        return status;
+    }
+    status = sss_key_store_context_init(&gSssHybrid.hostKs, &gSssHybrid.hostSession);
+    if (status == kStatus_SSS_Success) {
+        status = sss_key_store_allocate(&gSssHybrid.hostKs, __LINE__);
+        if (status != kStatus_SSS_Success) {
+            sss_key_store_context_free(&gSssHybrid.hostKs);
+        }
+    }
+    if (status != kStatus_SSS_Success) {
+        LOG_E("Hybrid: host key store could not be allocated");
+        sss_session_close(&gSssHybrid.hostSession);
+        return status;
+    }
+    gSssHybrid.hostOpen = 1;
+    return kStatus_SSS_Success;
+}
+
+/* Closed once no key is registered or in use */
+static void sss_hybrid_close_host_locked(void)
+{
+    size_t i;
+
+    if (!gSssHybrid.hostOpen) {
+        return;
+    }
+    for (i = 0; i < SSS_HYBRID_PUBKEY_CACHE_ENTRIES; i++) {
+        if (gSssHybrid.key[i].registered || (gSssHybrid.key[i].state != kSSS_HybridKey_NotLoaded)) {
+            return;
+        }
+    }
+    sss_key_store_context_free(&gSssHybrid.hostKs);
+    sss_session_close(&gSssHybrid.hostSession);
+    gSssHybrid.hostOpen = 0;
+}
+
+/* Read the public key of keyObject and import it into the host key store.
+ * Called without the lock, only the loading thread touches pKey->hostKey. */
+static sss_hybrid_key_state_t sss_hybrid_load(sss_hybrid_key_t *pKey, sss_object_t *keyObject)
+{
+    uint8_t pubKey[SSS_HYBRID_PUBKEY_MAX_LEN];
+    size_t pubKeyLen           = sizeof(pubKey);
+    size_t pubKeyBitLen        = 0;
+    sss_cipher_type_t hostType = (sss_cipher_type_t)keyObject->cipherType;
+    sss_status_t status;
+
+    status = sss_key_store_get_key(keyObject->keyStore, keyObject, pubKey, &pubKeyLen, &pubKeyBitLen);
+    if (status != kStatus_SSS_Success) {
+        LOG_D("Hybrid: public key of 0x%X not readable, using SE", keyObject->keyId);
+        return kSSS_HybridKey_NotReadable;
+    }
+    if (hostType == kSSS_CipherType_RSA_CRT) {
+        hostType = kSSS_CipherType_RSA;
+    }
+
+    status = sss_key_object_init(&pKey->hostKey, &gSssHybrid.hostKs);
+    if (status != kStatus_SSS_Success) {
+        return kSSS_HybridKey_NotReadable;
+    }
+    status = sss_key_object_allocate_handle(
+        &pKey->hostKey, keyObject->keyId, kSSS_KeyPart_Public, hostType, pubKeyLen, kKeyObject_Mode_Transient);
+    if (status == kStatus_SSS_Success) {
+        status = sss_key_store_set_key(&gSssHybrid.hostKs, &pKey->hostKey, pubKey, pubKeyLen, pubKeyBitLen, NULL, 0);
+    }
+    if (status != kStatus_SSS_Success) {
+        LOG_W("Hybrid: public key of 0x%X could not be imported on host", keyObject->keyId);
+        sss_key_object_free(&pKey->hostKey);
+        return kSSS_HybridKey_NotReadable;
+    }
+    return kSSS_HybridKey_OnHost;
+}
+
+/* Host copy of the key of an SE05x public key operation, pinned until
+ * sss_hybrid_release(). NULL if the operation has to run on the SE. */
+static sss_hybrid_key_t *sss_hybrid_acquire(sss_asymmetric_t *context)
+{
+    sss_hybrid_key_t *pKey = NULL;
+    sss_hybrid_key_state_t loaded;
+
+    if (gSssHybridPolicy != kSSS_HybridPolicy_PublicOnHost) {
+        return NULL;
+    }
+    switch (context->keyObject->cipherType) {
+    case kSSS_CipherType_RSA:
+    case kSSS_CipherType_RSA_CRT:
+        if ((context->mode != kMode_SSS_Verify) && (context->mode != kMode_SSS_Encrypt)) {
+            return NULL;
+        }
+        break;
+    case kSSS_CipherType_EC_NIST_P:
+    case kSSS_CipherType_EC_NIST_K:
+    case kSSS_CipherType_EC_BRAINPOOL:
+        if (context->mode != kMode_SSS_Verify) {
+            return NULL;
+        }
+        break;
+    default:
+        return NULL;
+    }
+
+    HYBRID_LOCK();
+    pKey = sss_hybrid_find_locked(context->session, context->keyObject->keyId);
+    if ((pKey == NULL) || pKey->stale) {
+        goto on_se;
+    }
+    if (pKey->state == kSSS_HybridKey_OnHost) {
+        pKey->users++;
+        HYBRID_UNLOCK();
+        return pKey;
+    }
+    if (pKey->state != kSSS_HybridKey_NotLoaded) {
+        /* Not readable, or being read by another thread */
+        goto on_se;
+    }
+
+    /* Read the key without the lock, other threads use the SE meanwhile */
+    pKey->state = kSSS_HybridKey_Loading;
+    gSssHybridStats.keyReads++;
+    HYBRID_UNLOCK();
+    loaded = sss_hybrid_load(pKey, context->keyObject);
+    HYBRID_LOCK();
+    if (loaded != kSSS_HybridKey_OnHost) {
+        gSssHybridStats.keyReadFailures++;
+    }
+    pKey->state = loaded;
+    if (pKey->stale) {
+        /* Changed or unregistered while it was read */
+        sss_hybrid_unload_locked(pKey);
+        goto on_se;
+    }
+    if (loaded == kSSS_HybridKey_OnHost) {
+        pKey->users++;
+        HYBRID_UNLOCK();
+        return pKey;
+    }
+
+on_se:
+    gSssHybridStats.onSecureElement++;
+    HYBRID_UNLOCK();
+    return NULL;
+}
+
+/* Counterpart of sss_hybrid_acquire(). On failure the caller retries on the SE. */
+static void sss_hybrid_release(sss_hybrid_key_t *pKey, sss_status_t status)
+{
+    HYBRID_LOCK();
+    if (status == kStatus_SSS_Success) {
+        gSssHybridStats.offloaded++;
+    }
+    else {
+        gSssHybridStats.onSecureElement++;
+    }
+    pKey->users--;
+    if ((pKey->users == 0) && pKey->stale) {
+        sss_hybrid_unload_locked(pKey);
+    }
+    HYBRID_UNLOCK();
+}
+
+/* Verify a batch with the host copy of the key. Signatures the host does not
+ * accept are verified again by the SE, one at a time. */
+static sss_status_t sss_hybrid_verify_digest_batch(sss_asymmetric_t *context,
+    sss_hybrid_key_t *pKey,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[],
+    sss_status_t results[])
+{
+    sss_se05x_asymmetric_t *se05x_context = (sss_se05x_asymmetric_t *)context;
+    sss_asymmetric_t hostCtx;
+    sss_status_t retval = kStatus_SSS_Success;
+    sss_status_t status;
+    size_t i;
+
+    status = sss_asymmetric_context_init(
+        &hostCtx, &gSssHybrid.hostSession, &pKey->hostKey, context->algorithm, context->mode);
+    if (status != kStatus_SSS_Success) {
+        return sss_se05x_asymmetric_verify_digest_batch(
+            se05x_context, digests, digestLen, count, signatures, signatureLens, results);
+    }
+    for (i = 0; i < count; i++) {
+        status = sss_asymmetric_verify_digest(&hostCtx, digests[i], digestLen, signatures[i], signatureLens[i]);
+        if (status != kStatus_SSS_Success) {
+            status = sss_se05x_asymmetric_verify_digest(
+                se05x_context, digests[i], digestLen, signatures[i], signatureLens[i]);
+        }
+        if (results != NULL) {
+            results[i] = status;
+        }
+        if ((status != kStatus_SSS_Success) && (retval == kStatus_SSS_Success)) {
+            retval = status;
+        }
+    }
+    sss_asymmetric_context_free(&hostCtx);
+    return retval;
+}
+#endif // SSS_HYBRID_SUPPORTED
+
+sss_status_t sss_hybrid_set_policy(sss_hybrid_policy_t policy)
+{
+    if (policy == kSSS_HybridPolicy_SE) {
+        gSssHybridPolicy = policy;
+        return kStatus_SSS_Success;
+    }
+#if SSS_HYBRID_SUPPORTED
+    if (policy == kSSS_HybridPolicy_PublicOnHost) {
+        gSssHybridPolicy = policy;
+        return kStatus_SSS_Success;
+    }
+#endif
+    return kStatus_SSS_InvalidArgument;
+}
+
+sss_hybrid_policy_t sss_hybrid_get_policy(void)
+{
+    return gSssHybridPolicy;
+}
+
+sss_status_t sss_hybrid_add_key(sss_object_t *keyObject)
+{
+#if SSS_HYBRID_SUPPORTED
+    sss_status_t retval    = kStatus_SSS_Fail;
+    sss_hybrid_key_t *pKey = NULL;
+    size_t i;
+
+    if ((keyObject == NULL) || (keyObject->keyStore == NULL) || !SSS_OBJECT_TYPE_IS_SE05X(keyObject)) {
+        return kStatus_SSS_InvalidArgument;
+    }
+    HYBRID_LOCK();
+    if (sss_hybrid_find_locked(keyObject->keyStore->session, keyObject->keyId) != NULL) {
+        retval = kStatus_SSS_Success;
+        goto exit;
+    }
+    for (i = 0; i < SSS_HYBRID_PUBKEY_CACHE_ENTRIES; i++) {
+        if (!gSssHybrid.key[i].registered && (gSssHybrid.key[i].state == kSSS_HybridKey_NotLoaded)) {
+            pKey = &gSssHybrid.key[i];
+            break;
+        }
+    }
+    if (pKey == NULL) {
+        LOG_W("Hybrid: no room for key 0x%X, see SSS_HYBRID_PUBKEY_CACHE_ENTRIES", keyObject->keyId);
+        goto exit;
+    }
+    if (sss_hybrid_open_host_locked() != kStatus_SSS_Success) {
+        goto exit;
+    }
+    memset(pKey, 0, sizeof(*pKey));
+    pKey->seSession  = keyObject->keyStore->session;
+    pKey->keyId      = keyObject->keyId;
+    pKey->registered = 1;
+    retval           = kStatus_SSS_Success;
+exit:
+    HYBRID_UNLOCK();
+    return retval;
+#else
+    AX_UNUSED_ARG(keyObject);
+    return kStatus_SSS_InvalidArgument;
+#endif
+}
+
+void sss_hybrid_remove_key(sss_object_t *keyObject)
+{
+#if SSS_HYBRID_SUPPORTED
+    sss_hybrid_key_t *pKey = NULL;
+
+    if ((keyObject == NULL) || (keyObject->keyStore == NULL)) {
+        return;
+    }
+    HYBRID_LOCK();
+    pKey = sss_hybrid_find_locked(keyObject->keyStore->session, keyObject->keyId);
+    if (pKey != NULL) {
+        pKey->registered = 0;
+        sss_hybrid_unload_locked(pKey);
+    }
+    HYBRID_UNLOCK();
+#else
+    AX_UNUSED_ARG(keyObject);
+#endif
+}
+
+void sss_hybrid_get_stats(sss_hybrid_stats_t *pStats)
+{
+    if (pStats == NULL) {
+        return;
+    }
+    HYBRID_LOCK();
+    *pStats = gSssHybridStats;
+    HYBRID_UNLOCK();
+}
+
+void sss_hybrid_flush(void)
+{
+    HYBRID_LOCK();
+#if SSS_HYBRID_SUPPORTED
+    sss_hybrid_forget_locked(NULL);
+    sss_hybrid_close_host_locked();
+#endif
+    memset(&gSssHybridStats, 0, sizeof(gSssHybridStats));
+    HYBRID_UNLOCK();
+}
+
 sss_status_t sss_session_create(sss_session_t *session,
     sss_type_t subsystem,
     uint32_t application_id,
@@ -209,6 +653,9 @@ void sss_session_close(sss_session_t *session)
 #if SSS_HAVE_APPLET_SE05X_IOT
     if (SSS_SESSION_TYPE_IS_SE05X(session)) {
         sss_se05x_session_t *se05x_session = (sss_se05x_session_t *)session;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_forget(session);
+#endif
         sss_se05x_session_close(se05x_session);
     }
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -1068,6 +1515,9 @@ sss_status_t sss_key_store_set_key(sss_key_store_t *keyStore,
     if (SSS_KEY_STORE_TYPE_IS_SE05X(keyStore)) {
         sss_se05x_key_store_t *se05x_keyStore = (sss_se05x_key_store_t *)keyStore;
         sss_se05x_object_t *se05x_keyObject   = (sss_se05x_object_t *)keyObject;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_invalidate(keyStore->session, keyObject->keyId);
+#endif
         return sss_se05x_key_store_set_key(
             se05x_keyStore, se05x_keyObject, data, dataLen, keyBitLen, options, optionsLen);
     }
@@ -1117,6 +1567,9 @@ sss_status_t sss_key_store_generate_key(
     if (SSS_KEY_STORE_TYPE_IS_SE05X(keyStore)) {
         sss_se05x_key_store_t *se05x_keyStore = (sss_se05x_key_store_t *)keyStore;
         sss_se05x_object_t *se05x_keyObject   = (sss_se05x_object_t *)keyObject;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_invalidate(keyStore->session, keyObject->keyId);
+#endif
         return sss_se05x_key_store_generate_key(se05x_keyStore, se05x_keyObject, keyBitLen, options);
     }
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -1257,6 +1710,9 @@ sss_status_t sss_key_store_erase_key(sss_key_store_t *keyStore, sss_object_t *ke
     if (SSS_KEY_STORE_TYPE_IS_SE05X(keyStore)) {
         sss_se05x_key_store_t *se05x_keyStore = (sss_se05x_key_store_t *)keyStore;
         sss_se05x_object_t *se05x_keyObject   = (sss_se05x_object_t *)keyObject;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_invalidate(keyStore->session, keyObject->keyId);
+#endif
         return sss_se05x_key_store_erase_key(se05x_keyStore, se05x_keyObject);
     }
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -1372,6 +1828,23 @@ sss_status_t sss_asymmetric_encrypt(
 #if SSS_HAVE_APPLET_SE05X_IOT
     if (SSS_ASYMMETRIC_TYPE_IS_SE05X(context)) {
         sss_se05x_asymmetric_t *se05x_context = (sss_se05x_asymmetric_t *)context;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_key_t *pHostKey = sss_hybrid_acquire(context);
+        if (pHostKey != NULL) {
+            sss_asymmetric_t hostCtx;
+            sss_status_t status = sss_asymmetric_context_init(
+                &hostCtx, &gSssHybrid.hostSession, &pHostKey->hostKey, context->algorithm, context->mode);
+            if (status == kStatus_SSS_Success) {
+                status = sss_asymmetric_encrypt(&hostCtx, srcData, srcLen, destData, destLen);
+                sss_asymmetric_context_free(&hostCtx);
+            }
+            sss_hybrid_release(pHostKey, status);
+            if (status == kStatus_SSS_Success) {
+                return status;
+            }
+            /* Not done by the host (e.g. algorithm not supported there), the SE decides */
+        }
+#endif
         return sss_se05x_asymmetric_encrypt(se05x_context, srcData, srcLen, destData, destLen);
     }
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -1462,6 +1935,23 @@ sss_status_t sss_asymmetric_verify_digest(
 #if SSS_HAVE_APPLET_SE05X_IOT
     if (SSS_ASYMMETRIC_TYPE_IS_SE05X(context)) {
         sss_se05x_asymmetric_t *se05x_context = (sss_se05x_asymmetric_t *)context;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_key_t *pHostKey = sss_hybrid_acquire(context);
+        if (pHostKey != NULL) {
+            sss_asymmetric_t hostCtx;
+            sss_status_t status = sss_asymmetric_context_init(
+                &hostCtx, &gSssHybrid.hostSession, &pHostKey->hostKey, context->algorithm, context->mode);
+            if (status == kStatus_SSS_Success) {
+                status = sss_asymmetric_verify_digest(&hostCtx, digest, digestLen, signature, signatureLen);
+                sss_asymmetric_context_free(&hostCtx);
+            }
+            sss_hybrid_release(pHostKey, status);
+            if (status == kStatus_SSS_Success) {
+                return status;
+            }
+            /* Not done by the host (e.g. algorithm not supported there), the SE decides */
+        }
+#endif
         return sss_se05x_asymmetric_verify_digest(se05x_context, digest, digestLen, signature, signatureLen);
     }
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -1480,6 +1970,53 @@ sss_status_t sss_asymmetric_verify_digest(
     return kStatus_SSS_InvalidArgument;
 }
 
+sss_status_t sss_asymmetric_sign_digest_batch(sss_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[])
+{
+#if SSS_HAVE_APPLET_SE05X_IOT
+    if (SSS_ASYMMETRIC_TYPE_IS_SE05X(context)) {
+        sss_se05x_asymmetric_t *se05x_context = (sss_se05x_asymmetric_t *)context;
+        return sss_se05x_asymmetric_sign_digest_batch(
+            se05x_context, digests, digestLen, count, signatures, signatureLens);
+    }
+#endif /* SSS_HAVE_APPLET_SE05X_IOT */
+    return kStatus_SSS_InvalidArgument;
+}
+
+sss_status_t sss_asymmetric_verify_digest_batch(sss_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[],
+    sss_status_t results[])
+{
+#if SSS_HAVE_APPLET_SE05X_IOT
+    if (SSS_ASYMMETRIC_TYPE_IS_SE05X(context)) {
+        sss_se05x_asymmetric_t *se05x_context = (sss_se05x_asymmetric_t *)context;
+#if SSS_HYBRID_SUPPORTED
+        sss_hybrid_key_t *pHostKey = NULL;
+        if ((count > 0) && (digests != NULL) && (signatures != NULL) && (signatureLens != NULL)) {
+            pHostKey = sss_hybrid_acquire(context);
+        }
+        if (pHostKey != NULL) {
+            sss_status_t status = sss_hybrid_verify_digest_batch(
+                context, pHostKey, digests, digestLen, count, signatures, signatureLens, results);
+            sss_hybrid_release(pHostKey, status);
+            return status;
+        }
+#endif
+        return sss_se05x_asymmetric_verify_digest_batch(
+            se05x_context, digests, digestLen, count, signatures, signatureLens, results);
+    }
+#endif /* SSS_HAVE_APPLET_SE05X_IOT */
+    return kStatus_SSS_InvalidArgument;
+}
+
 void sss_asymmetric_context_free(sss_asymmetric_t *context)
 {
 #if SSS_HAVE_SSCP
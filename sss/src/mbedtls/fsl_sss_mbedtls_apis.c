@@ -2576,6 +2576,8 @@ sss_status_t sss_mbedtls_mac_one_go(
 
         cipher_info = mbedtls_cipher_info_from_type(cipher_type);
         if (cipher_info != NULL) {
+            /* Release the setup of an earlier operation of this context */
+            mbedtls_cipher_free(context->cipher_ctx);
             mbedtls_cipher_init(context->cipher_ctx);
             ret = mbedtls_cipher_setup(context->cipher_ctx, cipher_info);
             if (ret == 0) {
@@ -2733,6 +2735,8 @@ sss_status_t sss_mbedtls_mac_init(sss_mbedtls_mac_t *context)
         }
 
         if (cipher_info != NULL) {
+            /* Release the setup of an earlier operation of this context */
+            mbedtls_cipher_free(context->cipher_ctx);
             mbedtls_cipher_init(context->cipher_ctx);
             ret = mbedtls_cipher_setup(context->cipher_ctx, cipher_info);
             if (ret == 0) {
@@ -2754,6 +2758,7 @@ sss_status_t sss_mbedtls_mac_init(sss_mbedtls_mac_t *context)
         const mbedtls_md_info_t *md_info = NULL;
         mbedtls_md_context_t *hmac_ctx;
         hmac_ctx = context->HmacCtx;
+        mbedtls_md_free(hmac_ctx);
         mbedtls_md_init(hmac_ctx);
 
         switch (context->algorithm) {
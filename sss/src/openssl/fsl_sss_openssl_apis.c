@@ -126,6 +126,10 @@ static sss_status_t sss_openssl_aead_ccm_Decryptfinal(sss_openssl_aead_t *contex
 static sss_status_t sss_openssl_aead_ccm_Encryptfinal(sss_openssl_aead_t *context, uint8_t *destData, size_t *destLen);
 
 static sss_status_t sss_openssl_aead_ccm_update(sss_openssl_aead_t *context, const uint8_t *srcData, size_t srcLen);
+
+static bool sss_openssl_is_keyed(const uint8_t *keyed, size_t keyedLen, const sss_openssl_object_t *keyObject);
+static void sss_openssl_set_keyed(
+    uint8_t *keyed, size_t keyedSize, uint8_t *pKeyedLen, const sss_openssl_object_t *keyObject);
 /* ************************************************************************** */
 /* Functions : sss_openssl_session                                            */
 /* ************************************************************************** */
@@ -1161,6 +1165,29 @@ void sss_openssl_key_store_context_free(sss_openssl_key_store_t *keyStore)
     memset(keyStore, 0, sizeof(*keyStore));
 }
 
+/* True if a context was last set up with the current contents of keyObject */
+static bool sss_openssl_is_keyed(const uint8_t *keyed, size_t keyedLen, const sss_openssl_object_t *keyObject)
+{
+    if ((keyedLen == 0) || (keyObject->contents == NULL) || (keyedLen != keyObject->contents_size)) {
+        return false;
+    }
+    return (CRYPTO_memcmp(keyed, keyObject->contents, keyedLen) == 0);
+}
+
+/* Remember the key a context is set up with. Longer keys are not remembered
+ * and set up on every init. */
+static void sss_openssl_set_keyed(
+    uint8_t *keyed, size_t keyedSize, uint8_t *pKeyedLen, const sss_openssl_object_t *keyObject)
+{
+    if ((keyObject->contents != NULL) && (keyObject->contents_size <= keyedSize)) {
+        memcpy(keyed, keyObject->contents, keyObject->contents_size);
+        *pKeyedLen = (uint8_t)keyObject->contents_size;
+    }
+    else {
+        *pKeyedLen = 0;
+    }
+}
+
 static int openssl_get_padding(sss_algorithm_t algorithm)
 {
     int padding = 0;
@@ -1768,6 +1795,8 @@ sss_status_t sss_openssl_symmetric_context_init(sss_openssl_symmetric_t *context
     context->mode           = mode;
     context->cache_data_len = 0;
     context->cipher_ctx     = NULL;
+    context->keyed_cipher   = NULL;
+    context->keyed_key_len  = 0;
 
     return retval;
 }
@@ -2101,6 +2130,8 @@ sss_status_t sss_openssl_cipher_init(sss_openssl_symmetric_t *context, uint8_t *
 {
     sss_status_t retval           = kStatus_SSS_Success;
     const EVP_CIPHER *cipher_info = NULL;
+    int enc                       = 0;
+    int ret                       = 0;
 
     ENSURE_OR_GO_EXIT(context != NULL);
     if (ivLen > 0) {
@@ -2178,8 +2209,11 @@ sss_status_t sss_openssl_cipher_init(sss_openssl_symmetric_t *context, uint8_t *
         cipher_info = EVP_des_ede3_cbc();
     }
 
-    /* Create and initialise the context */
-    context->cipher_ctx = EVP_CIPHER_CTX_new();
+    /* Create and initialise the context, or re-initialise the one of an
+     * earlier operation of this symmetric context */
+    if (context->cipher_ctx == NULL) {
+        context->cipher_ctx = EVP_CIPHER_CTX_new();
+    }
     if (!(context->cipher_ctx)) {
         retval = kStatus_SSS_InvalidArgument;
         LOG_E(" Cipher initialization failed ");
@@ -2187,34 +2221,43 @@ sss_status_t sss_openssl_cipher_init(sss_openssl_symmetric_t *context, uint8_t *
     }
 
     if (context->mode == kMode_SSS_Encrypt) {
-        /* Initialise the encryption operation. IMPORTANT - ensure you use a key
-        * and IV size appropriate for your cipher
-        */
-        if (1 != EVP_CipherInit(context->cipher_ctx, cipher_info, context->keyObject->contents, iv, 1)) {
-            retval = kStatus_SSS_InvalidArgument;
-            LOG_E("EncryptionCipher initialization failed !!!");
-
-            goto exit;
-        }
-
-        EVP_CIPHER_CTX_set_padding(context->cipher_ctx, 0);
+        enc = 1;
     }
     else if (context->mode == kMode_SSS_Decrypt) {
-        /* Initialise the encryption operation. IMPORTANT - ensure you use a key
-        * and IV size appropriate for your cipher
-        */
-        if (1 != EVP_CipherInit(context->cipher_ctx, cipher_info, context->keyObject->contents, iv, 0)) {
-            retval = kStatus_SSS_InvalidArgument;
-            LOG_E(" DecryptionCipher initialization failed");
-            goto exit;
-        }
-
-        EVP_CIPHER_CTX_set_padding(context->cipher_ctx, 0);
+        enc = 0;
     }
     else {
         retval = kStatus_SSS_InvalidArgument;
+        goto exit;
     }
 
+    /* Initialise the operation. IMPORTANT - ensure you use a key
+    * and IV size appropriate for your cipher
+    */
+    if ((cipher_info == context->keyed_cipher) && (enc == context->keyed_enc) &&
+        sss_openssl_is_keyed(context->keyed_key, context->keyed_key_len, context->keyObject)) {
+        /* Same key as the earlier operation: only reset the IV */
+        ret = EVP_CipherInit_ex(context->cipher_ctx, NULL, NULL, NULL, iv, enc);
+    }
+    else {
+        context->keyed_key_len = 0;
+        ret = EVP_CipherInit(context->cipher_ctx, cipher_info, context->keyObject->contents, iv, enc);
+        if (ret == 1) {
+            context->keyed_cipher = cipher_info;
+            context->keyed_enc    = (uint8_t)enc;
+            sss_openssl_set_keyed(
+                context->keyed_key, sizeof(context->keyed_key), &context->keyed_key_len, context->keyObject);
+        }
+    }
+    if (1 != ret) {
+        context->keyed_key_len = 0;
+        retval                 = kStatus_SSS_InvalidArgument;
+        LOG_E("%s Cipher initialization failed", (enc == 1) ? "Encryption" : "Decryption");
+        goto exit;
+    }
+
+    EVP_CIPHER_CTX_set_padding(context->cipher_ctx, 0);
+
 exit:
     return retval;
 }
@@ -3149,6 +3192,23 @@ void sss_openssl_aead_context_free(sss_openssl_aead_t *context)
 /* ************************************************************************** */
 
 #if (OPENSSL_VERSION_NUMBER >= 0x30000000)
+/* EVP_MAC_init(), without setting up the key again if it did not change */
+static int sss_openssl_mac_key(sss_openssl_mac_t *context, const OSSL_PARAM *params)
+{
+    int ret = 0;
+
+    if (sss_openssl_is_keyed(context->keyed_key, context->keyed_key_len, context->keyObject)) {
+        return EVP_MAC_init(context->mac_ctx, NULL, 0, NULL);
+    }
+    context->keyed_key_len = 0;
+    ret = EVP_MAC_init(context->mac_ctx, context->keyObject->contents, context->keyObject->contents_size, params);
+    if (ret == 1) {
+        sss_openssl_set_keyed(
+            context->keyed_key, sizeof(context->keyed_key), &context->keyed_key_len, context->keyObject);
+    }
+    return ret;
+}
+
 sss_status_t sss_openssl_mac_context_init(sss_openssl_mac_t *context,
     sss_openssl_session_t *session,
     sss_openssl_object_t *keyObject,
@@ -3178,12 +3238,13 @@ sss_status_t sss_openssl_mac_context_init(sss_openssl_mac_t *context,
         context->mac_ctx = EVP_MAC_CTX_new(mac);
         ENSURE_OR_GO_CLEANUP(context->mac_ctx != NULL);
 
-        context->session   = session;
-        context->keyObject = keyObject;
-        context->mode      = mode;
-        context->algorithm = algorithm;
-        context->lib_ctx   = library_context;
-        retval             = kStatus_SSS_Success;
+        context->session       = session;
+        context->keyObject     = keyObject;
+        context->mode          = mode;
+        context->algorithm     = algorithm;
+        context->lib_ctx       = library_context;
+        context->keyed_key_len = 0;
+        retval                 = kStatus_SSS_Success;
     }
 cleanup:
     if (mac != NULL) {
@@ -3192,6 +3253,24 @@ cleanup:
     return retval;
 }
 #else
+/* CMAC_Init(), without setting up the key again if it did not change */
+static int sss_openssl_cmac_key(sss_openssl_mac_t *context, const EVP_CIPHER *cipher_info)
+{
+    int ret = 0;
+
+    if (sss_openssl_is_keyed(context->keyed_key, context->keyed_key_len, context->keyObject)) {
+        return CMAC_Init(context->cmac_ctx, NULL, 0, NULL, NULL);
+    }
+    context->keyed_key_len = 0;
+    ret = CMAC_Init(
+        context->cmac_ctx, context->keyObject->contents, context->keyObject->contents_size, cipher_info, NULL);
+    if (ret == 1) {
+        sss_openssl_set_keyed(
+            context->keyed_key, sizeof(context->keyed_key), &context->keyed_key_len, context->keyObject);
+    }
+    return ret;
+}
+
 sss_status_t sss_openssl_mac_context_init(sss_openssl_mac_t *context,
     sss_openssl_session_t *session,
     sss_openssl_object_t *keyObject,
@@ -3221,6 +3300,7 @@ sss_status_t sss_openssl_mac_context_init(sss_openssl_mac_t *context,
         context->keyObject = keyObject;
         context->mode = mode;
         context->algorithm = algorithm;
+        context->keyed_key_len = 0;
         retval = kStatus_SSS_Success;
     }
 
@@ -3280,7 +3360,7 @@ sss_status_t sss_openssl_mac_one_go(
     params[1] = OSSL_PARAM_construct_end();
 
     if (context->mode == kMode_SSS_Mac) {
-        ret = EVP_MAC_init(context->mac_ctx, context->keyObject->contents, context->keyObject->contents_size, params);
+        ret = sss_openssl_mac_key(context, params);
         ENSURE_OR_GO_CLEANUP(ret == 1);
 
         ret = EVP_MAC_update(context->mac_ctx, message, messageLen);
@@ -3296,7 +3376,7 @@ sss_status_t sss_openssl_mac_one_go(
         };
         size_t macLocalLen = sizeof(macLocal);
 
-        ret = EVP_MAC_init(context->mac_ctx, context->keyObject->contents, context->keyObject->contents_size, params);
+        ret = sss_openssl_mac_key(context, params);
         ENSURE_OR_GO_CLEANUP(ret == 1);
 
         ret = EVP_MAC_update(context->mac_ctx, message, messageLen);
@@ -3376,8 +3456,7 @@ sss_status_t sss_openssl_mac_one_go(
                 goto cleanup;
             }
 
-            ret = CMAC_Init(
-                context->cmac_ctx, context->keyObject->contents, context->keyObject->contents_size, cipher_info, NULL);
+            ret = sss_openssl_cmac_key(context, cipher_info);
             if (ret == 1) {
                 ret = CMAC_Update(context->cmac_ctx, message, messageLen);
                 if (ret == 1) {
@@ -3533,7 +3612,7 @@ sss_status_t sss_openssl_mac_init(sss_openssl_mac_t *context)
 
     params[1] = OSSL_PARAM_construct_end();
 
-    ret = EVP_MAC_init(context->mac_ctx, context->keyObject->contents, context->keyObject->contents_size, params);
+    ret = sss_openssl_mac_key(context, params);
     ENSURE_OR_GO_CLEANUP(ret == 1);
 
     retval = kStatus_SSS_Success;
@@ -3581,8 +3660,7 @@ sss_status_t sss_openssl_mac_init(sss_openssl_mac_t *context)
         }
 
         if (context->cmac_ctx) {
-            ret = CMAC_Init(
-                context->cmac_ctx, context->keyObject->contents, context->keyObject->contents_size, cipher_info, NULL);
+            ret = sss_openssl_cmac_key(context, cipher_info);
             if (ret == 1) {
                 retval = kStatus_SSS_Success;
             }
@@ -31,9 +31,7 @@ extern "C" {
 #include "se05x_APDU.h"
 #include "se05x_tlv.h"
 #include "smCom.h"
-#if defined(SMCOM_JRCP_V1_AM)
 #include "sm_timer.h"
-#endif
 #if defined(USE_THREADX_RTOS)
 #include "tx_api.h"
 #endif
@@ -101,7 +99,61 @@ extern "C" {
 #define USE_LOCK 0
 #endif
 
+/* Number of secure objects whose metadata is cached per session.
+ * 0 disables the cache, see sss_se05x_session_flush_object_cache() */
+#ifndef SSS_SE05X_OBJ_CACHE_ENTRIES
+#define SSS_SE05X_OBJ_CACHE_ENTRIES 16
+#endif
+
+/* Items of a sign / verify batch sent while the device is reserved. The
+ * reservation is then dropped and taken again, so that other threads get
+ * their turn during long batches. */
+#ifndef SSS_SE05X_BATCH_ATOMIC_MAX
+#define SSS_SE05X_BATCH_ATOMIC_MAX 8
+#endif
+
+/* Largest input of a cipher/MAC/digest init-update-finish sequence that is
+ * held back on the host and sent as one one-shot APDU at finish.
+ * 0 always streams. */
+#ifndef SSS_SE05X_LAZY_ONESHOT_MAX
+#define SSS_SE05X_LAZY_ONESHOT_MAX CIPHER_UPDATE_MAX_DATA
+#endif
+
+/* 1: create all EC curves enabled in this build at session open,
+ * see sss_se05x_session_provision_curves() */
+#ifndef SSS_SE05X_CURVE_WARMUP
+#define SSS_SE05X_CURVE_WARMUP 0
+#endif
+
+/* 1: hash messages of asymmetric sign/verify on the host by default,
+ * see sss_se05x_session_set_host_hash() */
+#ifndef SSS_SE05X_HOST_HASH
+#define SSS_SE05X_HOST_HASH 0
+#endif
+
+/* 1: serve random numbers from a host DRBG seeded by the SE,
+ * see sss_se05x_session_enable_drbg() */
+#ifndef SSS_SE05X_RNG_DRBG
+#define SSS_SE05X_RNG_DRBG 0
+#endif
+
+/* Default reseed interval of the host DRBG, in output bytes and in ms */
+#ifndef SSS_SE05X_DRBG_RESEED_BYTES
+#define SSS_SE05X_DRBG_RESEED_BYTES (1024 * 1024)
+#endif
+#ifndef SSS_SE05X_DRBG_RESEED_MS
+#define SSS_SE05X_DRBG_RESEED_MS (60 * 1000)
+#endif
+
+/* Default size of the random prefetch ring in bytes, a power of 2 */
+#ifndef SSS_SE05X_RNG_RING_SIZE
+#define SSS_SE05X_RNG_RING_SIZE 4096
+#endif
+
 smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t curve_id);
+#if SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
+static smStatus_t sss_se05x_create_curve(sss_se05x_session_t *session, Se05xSession_t *pSession, uint32_t curve_id);
+#endif
 void add_ecc_header(uint8_t *key, size_t *keylen, uint8_t **key_buf, size_t *key_buflen, uint32_t curve_id);
 
 static SE05x_ECSignatureAlgo_t se05x_get_ec_sign_hash_mode(sss_algorithm_t algorithm);
@@ -109,6 +161,19 @@ static SE05x_ECSignatureAlgo_t se05x_get_ec_sign_hash_mode(sss_algorithm_t algor
 /* Used during testing as well */
 void get_ecc_raw_data(uint8_t *key, size_t keylen, uint8_t **key_buf, size_t *key_buflen, uint32_t curve_id);
 
+static sss_status_t sss_se05x_begin_atomic(sss_se05x_session_t *session);
+static void sss_se05x_end_atomic(sss_se05x_session_t *session);
+
+static void sss_se05x_objcache_open(sss_se05x_session_t *session);
+static void sss_se05x_objcache_close(sss_se05x_session_t *session);
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+static void sss_se05x_host_hash_session_close(sss_se05x_session_t *session);
+#endif
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+static void sss_se05x_cryptoobj_open(sss_se05x_session_t *session);
+static void sss_se05x_cryptoobj_close(sss_se05x_session_t *session);
+#endif
+
 #if SSSFTR_SE05X_AuthSession
 static smStatus_t se05x_CreateVerifyUserIDSession(
     pSe05xSession_t se05xSession, const uint32_t auth_id, SE05x_AuthCtx_ID_t *pin, pSe05xPolicy_t policy);
@@ -145,7 +210,7 @@ static SE05x_RSASignatureAlgo_t se05x_get_rsa_sign_hash_mode(sss_algorithm_t alg
 static SE05x_CipherMode_t se05x_get_cipher_mode(sss_algorithm_t algorithm);
 static SE05x_MACAlgo_t se05x_get_mac_algo(sss_algorithm_t algorithm);
 #if SSSFTR_SE05X_KEY_SET || SSSFTR_SE05X_KEY_GET
-static uint8_t CheckIfKeyIdExists(uint32_t keyId, pSe05xSession_t session_ctx, smStatus_t *apduStatus);
+static uint8_t CheckIfKeyIdExists(uint32_t keyId, sss_se05x_session_t *session, smStatus_t *apduStatus);
 #endif
 static smStatus_t sss_se05x_channel_txn(void *conn_ctx,
     struct _sss_se05x_tunnel_context *pChannelCtx,
@@ -666,7 +731,28 @@ sss_status_t sss_se05x_session_open(sss_se05x_session_t *session,
 
     if (status == SM_OK) {
         session->subsystem = subsystem;
-        retval             = kStatus_SSS_Success;
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+        session->hostHash         = 0;
+        session->pHostHashSession = NULL;
+        if (sss_se05x_session_set_host_hash(session, SSS_SE05X_HOST_HASH) != kStatus_SSS_Success) {
+            LOG_W("Host hashing not available, hashing on the SE");
+        }
+#endif
+        sss_se05x_objcache_open(session);
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+        sss_se05x_cryptoobj_open(session);
+#endif
+#if SSS_SE05X_CURVE_WARMUP && SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
+        if (sss_se05x_session_provision_curves(session) != kStatus_SSS_Success) {
+            LOG_W("Not all EC curves could be provisioned");
+        }
+#endif
+#if SSS_SE05X_RNG_DRBG
+        if (sss_se05x_session_enable_drbg(session, NULL) != kStatus_SSS_Success) {
+            LOG_W("No host DRBG, random numbers are read from the SE");
+        }
+#endif
+        retval = kStatus_SSS_Success;
     }
     else {
         /* Retain the APDU throughput error. Any other error, pass generic kStatus_SSS_Fail */
@@ -989,6 +1075,9 @@ void sss_se05x_session_close(sss_se05x_session_t *session)
 {
     smStatus_t sm_status = SM_NOT_OK;
 
+    /* Before the session goes, the thread sends APDUs */
+    sss_se05x_session_stop_rng_prefetch(session);
+
 #ifdef SSS_USE_SCP03_THREAD_SAFETY
 #if SSS_HAVE_SCP_SCP03_SSS
 #if defined(USE_RTOS) && (USE_RTOS == 1)
@@ -1009,6 +1098,9 @@ void sss_se05x_session_close(sss_se05x_session_t *session)
 #endif //#if SSS_HAVE_SCP_SCP03_SSS
 #endif //#ifdef SSS_USE_SCP03_THREAD_SAFETY
 
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    sss_se05x_cryptoobj_close(session);
+#endif
     sm_status = Se05x_API_CloseSession(&session->s_ctx);
     if (sm_status == SM_ERR_APDU_THROUGHPUT) {
         LOG_E("6a66 Error");
@@ -1016,6 +1108,17 @@ void sss_se05x_session_close(sss_se05x_session_t *session)
     if (session->s_ctx.pChannelCtx == NULL) {
         SM_Close(session->s_ctx.conn_ctx, 0);
     }
+#if SSS_HAVE_SCP_SCP03_SSS
+    /* Close session above was the last wrapped APDU */
+    if (session->s_ctx.pdynScp03Ctx != NULL) {
+        nxScp03_Free_HostContexts(session->s_ctx.pdynScp03Ctx);
+    }
+#endif
+    sss_se05x_session_disable_drbg(session);
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+    sss_se05x_host_hash_session_close(session);
+#endif
+    sss_se05x_objcache_close(session);
     memset(session, 0, sizeof(*session));
 }
 
@@ -1027,905 +1130,1623 @@ void sss_se05x_session_delete(sss_se05x_session_t *session)
 /* End: se05x_session */
 
 /* ************************************************************************** */
-/* Functions : sss_se05x_keyobj                                               */
+/* Functions : sss_se05x_objcache                                             */
 /* ************************************************************************** */
 
-sss_status_t sss_se05x_key_object_init(sss_se05x_object_t *keyObject, sss_se05x_key_store_t *keyStore)
+/* Existence, type, size and curve of a secure object hardly ever change, but
+ * looking them up costs one APDU each. Cache them per session, keyed by
+ * object id. Facts are filled in as they are read from the SE and dropped
+ * when this session writes or erases the object. */
+
+typedef struct
 {
-    sss_status_t retval = kStatus_SSS_Success;
-    if (keyObject == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    memset(keyObject, 0, sizeof(*keyObject));
-    keyObject->keyStore = keyStore;
+    uint32_t keyId;
+    SE05x_SecureObjectType_t objType;
+    SE05x_ECCurve_t curveId;
+    uint16_t size;
+    uint8_t transient;
+    uint8_t inUse : 1; /* Entry is valid, exists is known */
+    uint8_t exists : 1;
+    uint8_t hasType : 1; /* objType and transient */
+    uint8_t hasSize : 1;
+    uint8_t hasCurve : 1;
+} sss_se05x_obj_meta_t;
 
-    return retval;
+#if SSS_SE05X_OBJ_CACHE_ENTRIES > 0
+
+struct _sss_se05x_obj_cache
+{
+#if defined(USE_THREADX_RTOS)
+    TX_MUTEX lock;
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    SemaphoreHandle_t lock;
+#elif (__GNUC__ && !AX_EMBEDDED)
+    pthread_mutex_t lock;
+#endif
+    sss_se05x_obj_meta_t entry[SSS_SE05X_OBJ_CACHE_ENTRIES];
+    size_t next; /* Entry replaced next when the cache is full */
+    /* Crypto object registry, bit n stands for crypto object id n */
+    uint32_t cryptoObjPresent; /* On the SE, valid if cryptoObjValid */
+    uint32_t cryptoObjUsed;    /* Used by this session, deleted at session close */
+    uint8_t cryptoObjValid;
+    /* EC curves on the SE, bit n stands for curve id n */
+    uint32_t curvePresent[(kSE05x_ECCurve_ECC_MONT_DH_448 / 32) + 1];
+    uint8_t curveListValid; /* Weierstrass curves not in curvePresent are absent */
+};
+
+#if USE_LOCK
+#define OBJCACHE_LOCK(pCache) LOCK_TXN((pCache)->lock)
+#define OBJCACHE_UNLOCK(pCache) UNLOCK_TXN((pCache)->lock)
+#else
+#define OBJCACHE_LOCK(pCache)
+#define OBJCACHE_UNLOCK(pCache)
+#endif
+
+static void sss_se05x_objcache_open(sss_se05x_session_t *session)
+{
+    struct _sss_se05x_obj_cache *pCache = NULL;
+
+    session->pObjCache = NULL;
+    pCache             = (struct _sss_se05x_obj_cache *)SSS_MALLOC(sizeof(*pCache));
+    if (pCache == NULL) {
+        LOG_W("No memory for object cache, metadata is read from the SE each time");
+        return;
+    }
+    memset(pCache, 0, sizeof(*pCache));
+#if defined(USE_THREADX_RTOS)
+    if (tx_mutex_create(&pCache->lock, "objcache", TX_NO_INHERIT) != TX_SUCCESS) {
+        LOG_E("tx_mutex_create failed");
+        SSS_FREE(pCache);
+        return;
+    }
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    pCache->lock = xSemaphoreCreateMutex();
+    if (pCache->lock == NULL) {
+        LOG_E("xSemaphoreCreateMutex failed");
+        SSS_FREE(pCache);
+        return;
+    }
+#elif (__GNUC__ && !AX_EMBEDDED)
+    if (pthread_mutex_init(&pCache->lock, NULL) != 0) {
+        LOG_E("mutex init has failed");
+        SSS_FREE(pCache);
+        return;
+    }
+#endif
+    session->pObjCache = pCache;
 }
 
-sss_status_t sss_se05x_key_object_allocate_handle(sss_se05x_object_t *keyObject,
-    uint32_t keyId,
-    sss_key_part_t keyPart,
-    sss_cipher_type_t cipherType,
-    size_t keyByteLenMax,
-    uint32_t options)
+static void sss_se05x_objcache_close(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Success;
-    smStatus_t status;
-    SE05x_Result_t exists = kSE05x_Result_NA;
-    keyObject->objectType = keyPart;
-    keyObject->cipherType = cipherType;
-    keyObject->keyId      = keyId;
-    if (options == kKeyObject_Mode_Persistent) {
-        keyObject->isPersistant = 1;
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+
+    if (pCache == NULL) {
+        return;
+    }
+#if defined(USE_THREADX_RTOS)
+    tx_mutex_delete(&pCache->lock);
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    vSemaphoreDelete(pCache->lock);
+#elif (__GNUC__ && !AX_EMBEDDED)
+    if (pthread_mutex_destroy(&pCache->lock) != 0) {
+        LOG_E("pthread_mutex_destroy failed");
     }
+#endif
+    SSS_FREE(pCache);
+    session->pObjCache = NULL;
+}
 
-    AX_UNUSED_ARG(keyByteLenMax);
+/* Call with the lock held. Returns NULL if keyId is not cached and create is 0 */
+static sss_se05x_obj_meta_t *sss_se05x_objcache_entry(
+    struct _sss_se05x_obj_cache *pCache, uint32_t keyId, uint8_t create)
+{
+    sss_se05x_obj_meta_t *pMeta = NULL;
+    size_t i;
 
-    status = Se05x_API_CheckObjectExists(&keyObject->keyStore->session->s_ctx, keyId, &exists);
-    if (status == SM_OK) {
-        if (exists == kSE05x_Result_SUCCESS) {
-            LOG_W("Object id 0x%X exists", keyId);
+    for (i = 0; i < SSS_SE05X_OBJ_CACHE_ENTRIES; i++) {
+        if (pCache->entry[i].inUse && (pCache->entry[i].keyId == keyId)) {
+            return &pCache->entry[i];
+        }
+        if ((pMeta == NULL) && !pCache->entry[i].inUse) {
+            pMeta = &pCache->entry[i];
         }
     }
-    else {
-        LOG_E("Couldn't check if object id 0x%X exists", keyId);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
+    if (!create) {
+        return NULL;
+    }
+    if (pMeta == NULL) {
+        pMeta        = &pCache->entry[pCache->next];
+        pCache->next = (pCache->next + 1) % SSS_SE05X_OBJ_CACHE_ENTRIES;
+    }
+    memset(pMeta, 0, sizeof(*pMeta));
+    pMeta->keyId = keyId;
+    pMeta->inUse = 1;
+    return pMeta;
+}
+
+/* Copy of the cached facts of keyId. Returns 0 if nothing is cached */
+static uint8_t sss_se05x_objcache_get(sss_se05x_session_t *session, uint32_t keyId, sss_se05x_obj_meta_t *pMeta)
+{
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    sss_se05x_obj_meta_t *pEntry        = NULL;
+    uint8_t found                       = 0;
+
+    if (pCache == NULL) {
+        return 0;
+    }
+    OBJCACHE_LOCK(pCache);
+    pEntry = sss_se05x_objcache_entry(pCache, keyId, 0);
+    if (pEntry != NULL) {
+        *pMeta = *pEntry;
+        found  = 1;
+    }
+    OBJCACHE_UNLOCK(pCache);
+    return found;
+}
+
+/* Record facts read from the SE. Only the facts flagged in pMeta are taken */
+static void sss_se05x_objcache_put(sss_se05x_session_t *session, const sss_se05x_obj_meta_t *pMeta)
+{
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    sss_se05x_obj_meta_t *pEntry        = NULL;
+
+    if (pCache == NULL) {
+        return;
+    }
+    OBJCACHE_LOCK(pCache);
+    pEntry         = sss_se05x_objcache_entry(pCache, pMeta->keyId, 1);
+    pEntry->exists = pMeta->exists;
+    if (!pMeta->exists) {
+        pEntry->hasType  = 0;
+        pEntry->hasSize  = 0;
+        pEntry->hasCurve = 0;
+    }
+    if (pMeta->hasType) {
+        pEntry->objType   = pMeta->objType;
+        pEntry->transient = pMeta->transient;
+        pEntry->hasType   = 1;
+    }
+    if (pMeta->hasSize) {
+        pEntry->size    = pMeta->size;
+        pEntry->hasSize = 1;
+    }
+    if (pMeta->hasCurve) {
+        pEntry->curveId  = pMeta->curveId;
+        pEntry->hasCurve = 1;
+    }
+    OBJCACHE_UNLOCK(pCache);
+}
+
+/* Forget which curves are on the SE. Called with the cache locked. */
+static void sss_se05x_curvecache_invalidate(struct _sss_se05x_obj_cache *pCache)
+{
+    pCache->curveListValid = 0;
+    memset(pCache->curvePresent, 0, sizeof(pCache->curvePresent));
+}
+
+/* This session changed keyId. exists: 1 written, 0 erased, -1 unknown (failed) */
+static void sss_se05x_objcache_changed(sss_se05x_session_t *session, uint32_t keyId, int exists)
+{
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    sss_se05x_obj_meta_t *pEntry        = NULL;
+
+    if (pCache == NULL) {
+        return;
+    }
+    OBJCACHE_LOCK(pCache);
+    if (exists < 0) {
+        pEntry = sss_se05x_objcache_entry(pCache, keyId, 0);
+        if (pEntry != NULL) {
+            memset(pEntry, 0, sizeof(*pEntry));
         }
-        return kStatus_SSS_Fail;
+        /* The write may have failed for a curve deleted behind the cache */
+        sss_se05x_curvecache_invalidate(pCache);
     }
+    else {
+        pEntry         = sss_se05x_objcache_entry(pCache, keyId, 1);
+        pEntry->exists = (exists != 0);
+        /* Type, size and curve may have changed with the new contents */
+        pEntry->hasType  = 0;
+        pEntry->hasSize  = 0;
+        pEntry->hasCurve = 0;
+    }
+    OBJCACHE_UNLOCK(pCache);
+}
 
-    return retval;
+void sss_se05x_session_flush_object_cache(sss_se05x_session_t *session)
+{
+    struct _sss_se05x_obj_cache *pCache = NULL;
+
+    if ((session == NULL) || (session->pObjCache == NULL)) {
+        return;
+    }
+    pCache = session->pObjCache;
+    OBJCACHE_LOCK(pCache);
+    memset(pCache->entry, 0, sizeof(pCache->entry));
+    pCache->next           = 0;
+    pCache->cryptoObjValid = 0;
+    sss_se05x_curvecache_invalidate(pCache);
+    OBJCACHE_UNLOCK(pCache);
 }
 
-//static sss_status_t sss_se05x_key_object_get_handle_binary(
-//    sss_se05x_object_t *keyObject) {
-//    sss_status_t retval = kStatus_SSS_Success;
-//    keyObject->objectType = kSSS_KeyPart_Default;
-//    keyObject->cipherType = kSSS_CipherType_Binary;
-//    return retval;
-//}
-sss_status_t sss_se05x_key_object_get_handle(sss_se05x_object_t *keyObject, uint32_t keyId)
+#if SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
+
+#define CURVECACHE_WORD(ID) ((uint32_t)(ID) / 32u)
+#define CURVECACHE_BIT(ID) (1u << ((uint32_t)(ID) % 32u))
+
+/* Is curve_id on the SE? -1 if the cache cannot tell */
+static int sss_se05x_curvecache_known(sss_se05x_session_t *session, uint32_t curve_id)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-#if SSSFTR_SE05X_KEY_GET
-    SE05x_SecObjTyp_t retObjectType;
-    uint8_t retTransientType;
-    SE05x_ECCurve_t retCurveId;
-    const SE05x_AttestationType_t attestationType = kSE05x_AttestationType_None;
-    smStatus_t apiRetval                          = SM_NOT_OK;
-    smStatus_t apduRetValue                       = SM_NOT_OK;
+    struct _sss_se05x_obj_cache *pCache = NULL;
+    int known                           = -1;
 
-    if (0 == CheckIfKeyIdExists(keyId, &keyObject->keyStore->session->s_ctx, &apduRetValue)) {
-        /* Object does not exist  */
-        LOG_D("keyId does not exist");
-        LOG_U32_D(keyId);
-        if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
+    if ((session == NULL) || (session->pObjCache == NULL) ||
+        (CURVECACHE_WORD(curve_id) >= ARRAY_SIZE(pCache->curvePresent))) {
+        return -1;
+    }
+    pCache = session->pObjCache;
+    OBJCACHE_LOCK(pCache);
+    if (pCache->curvePresent[CURVECACHE_WORD(curve_id)] & CURVECACHE_BIT(curve_id)) {
+        known = 1;
+    }
+    else if (pCache->curveListValid && (curve_id <= kSE05x_ECCurve_Total_Weierstrass_Curves)) {
+        known = 0;
+    }
+    OBJCACHE_UNLOCK(pCache);
+    return known;
+}
+
+/* Take the curve list as read with Se05x_API_ReadECCurveList */
+static void sss_se05x_curvecache_load(sss_se05x_session_t *session, const uint8_t *curveList, size_t curveListLen)
+{
+    struct _sss_se05x_obj_cache *pCache = NULL;
+    size_t i;
+
+    if ((session == NULL) || (session->pObjCache == NULL)) {
+        return;
+    }
+    pCache = session->pObjCache;
+    OBJCACHE_LOCK(pCache);
+    for (i = 0; (i < curveListLen) && (i < kSE05x_ECCurve_Total_Weierstrass_Curves); i++) {
+        /* Index i is curve id i + 1 */
+        if (curveList[i] == kSE05x_SetIndicator_SET) {
+            pCache->curvePresent[CURVECACHE_WORD(i + 1)] |= CURVECACHE_BIT(i + 1);
         }
         else {
-            return retval;
+            pCache->curvePresent[CURVECACHE_WORD(i + 1)] &= ~CURVECACHE_BIT(i + 1);
         }
     }
+    pCache->curveListValid = 1;
+    OBJCACHE_UNLOCK(pCache);
+}
 
-    keyObject->keyId = keyId;
+/* curve_id was created on the SE, or found to be there */
+static void sss_se05x_curvecache_set(sss_se05x_session_t *session, uint32_t curve_id)
+{
+    struct _sss_se05x_obj_cache *pCache = NULL;
 
-    apiRetval = Se05x_API_ReadType(
-        &keyObject->keyStore->session->s_ctx, keyId, &retObjectType, &retTransientType, attestationType);
-    if (apiRetval == SM_OK) {
-        keyObject->isPersistant = retTransientType;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-        if (retObjectType >= kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P192 &&
-            retObjectType <= kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_448)
-#else
-        if (retObjectType >= kSE05x_SecObjTyp_EC_KEY_PAIR && retObjectType <= kSE05x_SecObjTyp_EC_PUB_KEY)
-#endif
-        {
-            apiRetval = Se05x_API_EC_CurveGetId(&keyObject->keyStore->session->s_ctx, keyId, &retCurveId);
-            if (apiRetval == SM_OK) {
-                keyObject->curve_id = retCurveId;
-                if ((retCurveId == kSE05x_ECCurve_NIST_P256)
-#if SSS_HAVE_EC_NIST_192
-                    || (retCurveId == kSE05x_ECCurve_NIST_P192)
-#endif
-#if SSS_HAVE_EC_NIST_224
-                    || (retCurveId == kSE05x_ECCurve_NIST_P224)
-#endif
-#if SSS_HAVE_EC_NIST_521
-                    || (retCurveId == kSE05x_ECCurve_NIST_P521)
-#endif
-                    || (retCurveId == kSE05x_ECCurve_NIST_P384)) {
-                    keyObject->cipherType = kSSS_CipherType_EC_NIST_P;
-                }
-#if SSS_HAVE_EC_BP
-                else if ((retCurveId >= kSE05x_ECCurve_Brainpool160) && (retCurveId <= kSE05x_ECCurve_Brainpool512)) {
-                    keyObject->cipherType = kSSS_CipherType_EC_BRAINPOOL;
-                }
-#endif
-#if SSS_HAVE_EC_NIST_K
-                else if ((retCurveId >= kSE05x_ECCurve_Secp160k1) && (retCurveId <= kSE05x_ECCurve_Secp256k1)) {
-                    keyObject->cipherType = kSSS_CipherType_EC_NIST_K;
-                }
-#endif
-#if SSS_HAVE_EC_ED
-                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_ED_25519) {
-                    keyObject->cipherType = kSSS_CipherType_EC_TWISTED_ED;
-                }
-#endif
-#if SSS_HAVE_EC_MONT
-                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_MONT_DH_25519) {
-                    keyObject->cipherType = kSSS_CipherType_EC_MONTGOMERY;
-                }
-#endif
-#if SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
-                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_MONT_DH_448) {
-                    keyObject->cipherType = kSSS_CipherType_EC_MONTGOMERY;
-                }
-#endif
-                else {
-                    return kStatus_SSS_Fail;
-                }
-            }
-            else {
-                LOG_E("error in Se05x_API_GetECCurveId");
-                if (apiRetval == SM_ERR_APDU_THROUGHPUT) {
-                    return kStatus_SSS_ApduThroughputError;
-                }
-                return kStatus_SSS_Fail;
-            }
-        }
-#if SSSFTR_RSA && SSS_HAVE_RSA
-        else if (retObjectType == kSE05x_SecObjTyp_RSA_KEY_PAIR_CRT) {
-            keyObject->cipherType = kSSS_CipherType_RSA_CRT;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_RSA_PRIV_KEY_CRT) {
-            keyObject->cipherType = kSSS_CipherType_RSA_CRT;
-        }
-        else if (retObjectType >= kSE05x_SecObjTyp_RSA_KEY_PAIR && retObjectType <= kSE05x_SecObjTyp_RSA_PUB_KEY) {
-            keyObject->cipherType = kSSS_CipherType_RSA;
-        }
-#endif
-        else if (retObjectType == kSE05x_SecObjTyp_AES_KEY) {
-            keyObject->cipherType = kSSS_CipherType_AES;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_DES_KEY) {
-            keyObject->cipherType = kSSS_CipherType_DES;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_BINARY_FILE) {
-            keyObject->cipherType = kSSS_CipherType_Binary;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_UserID) {
-            keyObject->cipherType = kSSS_CipherType_UserID;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_COUNTER) {
-            keyObject->cipherType = kSSS_CipherType_Count;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_PCR) {
-            keyObject->cipherType = kSSS_CipherType_PCR;
-        }
-        else if (retObjectType == kSE05x_SecObjTyp_HMAC_KEY) {
-            keyObject->cipherType = kSSS_CipherType_HMAC;
-        }
-        else {
-            return kStatus_SSS_Fail;
-        }
+    if ((session == NULL) || (session->pObjCache == NULL) ||
+        (CURVECACHE_WORD(curve_id) >= ARRAY_SIZE(pCache->curvePresent))) {
+        return;
+    }
+    pCache = session->pObjCache;
+    OBJCACHE_LOCK(pCache);
+    pCache->curvePresent[CURVECACHE_WORD(curve_id)] |= CURVECACHE_BIT(curve_id);
+    OBJCACHE_UNLOCK(pCache);
+}
 
-        switch (retObjectType) {
-        case kSE05x_SecObjTyp_EC_KEY_PAIR:
-#if SSS_HAVE_RSA
-        case kSE05x_SecObjTyp_RSA_KEY_PAIR:
-        case kSE05x_SecObjTyp_RSA_KEY_PAIR_CRT:
-#endif
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P192:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P224:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P256:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P384:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P521:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool160:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool192:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool224:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool256:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool320:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool384:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool512:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp160k1:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp192k1:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp224k1:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp256k1:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_BN_P256:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_ED25519:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_MONT_DH_25519:
-        case kSE05x_SecObjTyp_EC_KEY_PAIR_MONT_DH_448:
-#endif
-            keyObject->objectType = kSSS_KeyPart_Pair;
-            break;
+#endif /* SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET */
 
-        case kSE05x_SecObjTyp_EC_PUB_KEY:
-        case kSE05x_SecObjTyp_RSA_PUB_KEY:
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P192:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P224:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P256:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P384:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P521:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool160:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool192:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool224:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool256:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool320:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool384:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool512:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp160k1:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp192k1:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp224k1:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp256k1:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_BN_P256:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_ED25519:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_25519:
-        case kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_448:
-#endif
-            keyObject->objectType = kSSS_KeyPart_Public;
-            break;
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
 
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P192:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P224:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P256:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P384:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P521:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool160:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool192:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool224:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool256:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool320:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool384:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool512:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp160k1:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp192k1:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp224k1:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp256k1:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_BN_P256:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_ED25519:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_MONT_DH_25519:
-        case kSE05x_SecObjTyp_EC_PRIV_KEY_MONT_DH_448:
-            keyObject->objectType = kSSS_KeyPart_Private;
-            break;
-#endif
+#define CRYPTOOBJ_BIT(ID) (((uint32_t)(ID) < 32u) ? (1u << (uint32_t)(ID)) : 0u)
 
-        case kSE05x_SecObjTyp_BINARY_FILE:
-        case kSE05x_SecObjTyp_PCR:
-        case kSE05x_SecObjTyp_AES_KEY:
-        case kSE05x_SecObjTyp_DES_KEY:
-        case kSE05x_SecObjTyp_HMAC_KEY:
-        case kSE05x_SecObjTyp_COUNTER:
-        case kSE05x_SecObjTyp_UserID:
-            keyObject->objectType = kSSS_KeyPart_Default;
-            break;
-        default:
-            return kStatus_SSS_Fail;
-        }
+/* Is cryptoObjectId on the SE? -1 if the registry cannot tell */
+static int sss_se05x_cryptoobj_known(sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId)
+{
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    uint32_t bit                        = CRYPTOOBJ_BIT(cryptoObjectId);
+    int known                           = -1;
+
+    if ((pCache == NULL) || (bit == 0)) {
+        return -1;
     }
-    else {
-        LOG_W("Error in Se05x_API_ReadType. Further use of object may fail");
-        if (apiRetval == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-        }
-        else {
-            retval = kStatus_SSS_Success;
-        }
-        return retval;
+    OBJCACHE_LOCK(pCache);
+    if (pCache->cryptoObjValid) {
+        known = (pCache->cryptoObjPresent & bit) ? 1 : 0;
     }
-
-    retval = kStatus_SSS_Success;
-#endif // SSSFTR_SE05X_KEY_GET
-    return retval;
+    OBJCACHE_UNLOCK(pCache);
+    return known;
 }
 
-// LCOV_EXCL_START
-sss_status_t sss_se05x_key_object_set_user(sss_se05x_object_t *keyObject, uint32_t user, uint32_t options)
+/* Take the crypto object list as read from the SE */
+static void sss_se05x_cryptoobj_load(sss_se05x_session_t *session, const uint8_t *list, size_t listlen)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(user);
-    AX_UNUSED_ARG(options);
-    /* Purpose / Policy is set during creation time and hence can not
-     * enforced in SE050 later on */
-    LOG_W("Not supported in SE05X");
-    return retval;
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    uint32_t present                    = 0;
+    size_t i;
+
+    if (pCache == NULL) {
+        return;
+    }
+    for (i = 0; (i + 1) < listlen; i += 4) {
+        present |= CRYPTOOBJ_BIT(list[i + 1] | (list[i + 0] << 8));
+    }
+    OBJCACHE_LOCK(pCache);
+    pCache->cryptoObjPresent = present;
+    pCache->cryptoObjValid   = 1;
+    OBJCACHE_UNLOCK(pCache);
 }
 
-sss_status_t sss_se05x_key_object_set_purpose(sss_se05x_object_t *keyObject, sss_mode_t purpose, uint32_t options)
+/* cryptoObjectId exists (1) and is used by this session, or was deleted (0) */
+static void sss_se05x_cryptoobj_record(
+    sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId, uint8_t present)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(purpose);
-    AX_UNUSED_ARG(options);
-    /* Purpose / Policy is set during creation time and hence can not
-     * enforced in SE050 later on */
-    LOG_W("Not supported in SE05X");
-    return retval;
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    uint32_t bit                        = CRYPTOOBJ_BIT(cryptoObjectId);
+
+    if (pCache == NULL) {
+        return;
+    }
+    OBJCACHE_LOCK(pCache);
+    if (present) {
+        pCache->cryptoObjPresent |= bit;
+        pCache->cryptoObjUsed |= bit;
+    }
+    else {
+        pCache->cryptoObjPresent &= ~bit;
+        pCache->cryptoObjUsed &= ~bit;
+    }
+    OBJCACHE_UNLOCK(pCache);
 }
 
-sss_status_t sss_se05x_key_object_set_access(sss_se05x_object_t *keyObject, uint32_t access, uint32_t options)
+/* Crypto objects used by this session. The registry is emptied */
+static uint32_t sss_se05x_cryptoobj_take_used(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(access);
-    AX_UNUSED_ARG(options);
-    LOG_W("Not supported in SE05X");
-    return retval;
+    struct _sss_se05x_obj_cache *pCache = session->pObjCache;
+    uint32_t used                       = 0;
+
+    if (pCache == NULL) {
+        return 0;
+    }
+    OBJCACHE_LOCK(pCache);
+    used                     = pCache->cryptoObjUsed;
+    pCache->cryptoObjUsed    = 0;
+    pCache->cryptoObjPresent = 0;
+    pCache->cryptoObjValid   = 0;
+    OBJCACHE_UNLOCK(pCache);
+    return used;
 }
 
-sss_status_t sss_se05x_key_object_set_eccgfp_group(sss_se05x_object_t *keyObject, sss_eccgfp_group_t *group)
+#endif /* SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ */
+
+#else /* SSS_SE05X_OBJ_CACHE_ENTRIES > 0 */
+
+static void sss_se05x_objcache_open(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(group);
-    LOG_W("Not supported in SE05X");
-    return retval;
+    session->pObjCache = NULL;
 }
 
-sss_status_t sss_se05x_key_object_get_user(sss_se05x_object_t *keyObject, uint32_t *user)
+static void sss_se05x_objcache_close(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(user);
-    LOG_W("Not supported in SE05X");
-    return retval;
+    AX_UNUSED_ARG(session);
 }
 
-sss_status_t sss_se05x_key_object_get_purpose(sss_se05x_object_t *keyObject, sss_mode_t *purpose)
+static uint8_t sss_se05x_objcache_get(sss_se05x_session_t *session, uint32_t keyId, sss_se05x_obj_meta_t *pMeta)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(purpose);
-    LOG_W("Not supported in SE05X");
-    return retval;
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(keyId);
+    AX_UNUSED_ARG(pMeta);
+    return 0;
 }
 
-sss_status_t sss_se05x_key_object_get_access(sss_se05x_object_t *keyObject, uint32_t *access)
+static void sss_se05x_objcache_put(sss_se05x_session_t *session, const sss_se05x_obj_meta_t *pMeta)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyObject);
-    AX_UNUSED_ARG(access);
-    LOG_W("Not supported in SE05X");
-    return retval;
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(pMeta);
 }
-// LCOV_EXCL_STOP
 
-void sss_se05x_key_object_free(sss_se05x_object_t *keyObject)
+static void sss_se05x_objcache_changed(sss_se05x_session_t *session, uint32_t keyId, int exists)
 {
-    memset(keyObject, 0, sizeof(*keyObject));
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(keyId);
+    AX_UNUSED_ARG(exists);
 }
 
-/* End: se05x_keyobj */
+void sss_se05x_session_flush_object_cache(sss_se05x_session_t *session)
+{
+    AX_UNUSED_ARG(session);
+}
 
-/* ************************************************************************** */
-/* Functions : sss_se05x_keyderive                                            */
-/* ************************************************************************** */
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
 
-sss_status_t sss_se05x_derive_key_context_init(sss_se05x_derive_key_t *context,
-    sss_se05x_session_t *session,
-    sss_se05x_object_t *keyObject,
-    sss_algorithm_t algorithm,
-    sss_mode_t mode)
+static int sss_se05x_cryptoobj_known(sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId)
 {
-    sss_status_t retval = kStatus_SSS_Success;
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(cryptoObjectId);
+    return -1;
+}
 
-    if (context == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    context->session   = session;
-    context->keyObject = keyObject;
-    context->algorithm = algorithm;
-    context->mode      = mode;
+static void sss_se05x_cryptoobj_load(sss_se05x_session_t *session, const uint8_t *list, size_t listlen)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(list);
+    AX_UNUSED_ARG(listlen);
+}
 
-    return retval;
+static void sss_se05x_cryptoobj_record(
+    sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId, uint8_t present)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(cryptoObjectId);
+    AX_UNUSED_ARG(present);
 }
 
-sss_status_t sss_se05x_derive_key_go(sss_se05x_derive_key_t *context,
-    const uint8_t *saltData,
-    size_t saltLen,
-    const uint8_t *info,
-    size_t infoLen,
-    sss_se05x_object_t *derivedKeyObject,
-    uint16_t deriveDataLen,
-    uint8_t *hkdfOutput,
-    size_t *hkdfOutputLen)
+static uint32_t sss_se05x_cryptoobj_take_used(sss_se05x_session_t *session)
 {
-    sss_status_t retval                     = kStatus_SSS_Fail;
-    smStatus_t status                       = SM_NOT_OK;
-    uint8_t hkdfKey[SE05X_MAX_BUF_SIZE_CMD] = {
-        0,
-    };
-    size_t hkdfKeyLen                   = sizeof(hkdfKey);
-    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
-    SE05x_DigestMode_t digestMode;
+    AX_UNUSED_ARG(session);
+    return 0;
+}
 
-    AX_UNUSED_ARG(hkdfOutput);
-    AX_UNUSED_ARG(hkdfOutputLen);
+#endif /* SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ */
 
-    ENSURE_OR_GO_EXIT(context);
-    ENSURE_OR_GO_EXIT(info);
-    ENSURE_OR_GO_EXIT(derivedKeyObject);
-    if (saltLen) {
-        ENSURE_OR_GO_EXIT(saltData);
-    }
+#if SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
 
-    digestMode = se05x_get_sha_algo(context->algorithm);
-    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+static int sss_se05x_curvecache_known(sss_se05x_session_t *session, uint32_t curve_id)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(curve_id);
+    return -1;
+}
 
-    status = Se05x_API_HKDF(&context->session->s_ctx,
-        context->keyObject->keyId,
-        digestMode,
-        saltData,
-        saltLen,
-        info,
-        infoLen,
-        deriveDataLen,
-        hkdfKey,
-        &hkdfKeyLen);
-    ENSURE_OR_GO_EXIT(status == SM_OK);
+static void sss_se05x_curvecache_load(sss_se05x_session_t *session, const uint8_t *curveList, size_t curveListLen)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(curveList);
+    AX_UNUSED_ARG(curveListLen);
+}
 
-    retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
-        sss_derived_keyObject,
-        hkdfKey,
-        hkdfKeyLen,
-        hkdfKeyLen * 8,
-        NULL,
-        0);
-    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+static void sss_se05x_curvecache_set(sss_se05x_session_t *session, uint32_t curve_id)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(curve_id);
+}
 
-    retval = kStatus_SSS_Success;
-exit:
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+#endif /* SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET */
+
+#endif /* SSS_SE05X_OBJ_CACHE_ENTRIES > 0 */
+
+/* Se05x_API_CheckObjectExists, answered from the cache when possible */
+static smStatus_t sss_se05x_cached_exists(sss_se05x_session_t *session, uint32_t keyId, SE05x_Result_t *pExists)
+{
+    smStatus_t status         = SM_NOT_OK;
+    sss_se05x_obj_meta_t meta = {0};
+
+    if (sss_se05x_objcache_get(session, keyId, &meta)) {
+        *pExists = meta.exists ? kSE05x_Result_SUCCESS : kSE05x_Result_FAILURE;
+        return SM_OK;
     }
-    return retval;
+    status = Se05x_API_CheckObjectExists(&session->s_ctx, keyId, pExists);
+    if (status == SM_OK) {
+        meta.keyId  = keyId;
+        meta.exists = (*pExists == kSE05x_Result_SUCCESS);
+        sss_se05x_objcache_put(session, &meta);
+    }
+    return status;
 }
 
-sss_status_t sss_se05x_derive_key_one_go(sss_se05x_derive_key_t *context,
-    const uint8_t *saltData,
-    size_t saltLen,
-    const uint8_t *info,
-    size_t infoLen,
-    sss_se05x_object_t *derivedKeyObject,
-    uint16_t deriveDataLen)
+/* Se05x_API_ReadType, answered from the cache when possible */
+static smStatus_t sss_se05x_cached_read_type(
+    sss_se05x_session_t *session, uint32_t keyId, SE05x_SecureObjectType_t *pType, uint8_t *pTransient)
 {
-    sss_status_t retval   = kStatus_SSS_Fail;
-    smStatus_t status     = SM_NOT_OK;
-    uint8_t hkdfKey[1024] = {
-        0,
-    };
-    size_t hkdfKeyLen                   = sizeof(hkdfKey);
-    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
-    SE05x_DigestMode_t digestMode       = se05x_get_sha_algo(context->algorithm);
-    uint32_t derivedKeyID               = (derivedKeyObject == NULL ? 0 : derivedKeyObject->keyId);
-    uint8_t *pHkdfKey                   = hkdfKey;
-    SE05x_HkdfMode_t hkdfMode =
-        (context->mode == kMode_SSS_HKDF_ExpandOnly ? kSE05x_HkdfMode_ExpandOnly : kSE05x_HkdfMode_ExtractExpand);
+    smStatus_t status         = SM_NOT_OK;
+    sss_se05x_obj_meta_t meta = {0};
 
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    if (derivedKeyObject != NULL) {
-        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
-        if (context->keyObject->keyStore->session->subsystem == derivedKeyObject->keyStore->session->subsystem) {
-            pHkdfKey = NULL;
-        }
+    if (sss_se05x_objcache_get(session, keyId, &meta) && meta.exists && meta.hasType) {
+        *pType      = meta.objType;
+        *pTransient = meta.transient;
+        return SM_OK;
     }
-#endif
-
-    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+    status = Se05x_API_ReadType(&session->s_ctx, keyId, pType, pTransient, kSE05x_AttestationType_None);
+    if (status == SM_OK) {
+        memset(&meta, 0, sizeof(meta));
+        meta.keyId     = keyId;
+        meta.exists    = 1;
+        meta.objType   = *pType;
+        meta.transient = *pTransient;
+        meta.hasType   = 1;
+        sss_se05x_objcache_put(session, &meta);
+    }
+    return status;
+}
 
-    status = Se05x_API_HKDF_Extended(&context->session->s_ctx,
-        context->keyObject->keyId,
-        digestMode,
-        hkdfMode,
-        saltData,
-        saltLen,
-        0,
-        info,
-        infoLen,
-        derivedKeyID,
-        deriveDataLen,
-        pHkdfKey,
-        &hkdfKeyLen);
-    ENSURE_OR_GO_EXIT(status == SM_OK);
+/* Se05x_API_EC_CurveGetId, answered from the cache when possible */
+static smStatus_t sss_se05x_cached_curve_id(sss_se05x_session_t *session, uint32_t keyId, SE05x_ECCurve_t *pCurveId)
+{
+    smStatus_t status         = SM_NOT_OK;
+    sss_se05x_obj_meta_t meta = {0};
 
-    if (pHkdfKey != NULL) {
-        if (derivedKeyObject != NULL) {
-            retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
-                sss_derived_keyObject,
-                hkdfKey,
-                hkdfKeyLen,
-                hkdfKeyLen * 8,
-                NULL,
-                0);
-            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
-        }
+    if (sss_se05x_objcache_get(session, keyId, &meta) && meta.exists && meta.hasCurve) {
+        *pCurveId = meta.curveId;
+        return SM_OK;
     }
-
-    retval = kStatus_SSS_Success;
-exit:
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+    status = Se05x_API_EC_CurveGetId(&session->s_ctx, keyId, pCurveId);
+    if (status == SM_OK) {
+        memset(&meta, 0, sizeof(meta));
+        meta.keyId    = keyId;
+        meta.exists   = 1;
+        meta.curveId  = *pCurveId;
+        meta.hasCurve = 1;
+        sss_se05x_objcache_put(session, &meta);
     }
-    return retval;
+    return status;
 }
 
-sss_status_t sss_se05x_derive_key_sobj_one_go(sss_se05x_derive_key_t *context,
-    sss_se05x_object_t *saltKeyObject,
-    const uint8_t *info,
-    size_t infoLen,
-    sss_se05x_object_t *derivedKeyObject,
-    uint16_t deriveDataLen)
+/* Se05x_API_ReadSize, answered from the cache when possible */
+static smStatus_t sss_se05x_cached_read_size(sss_se05x_session_t *session, uint32_t keyId, uint16_t *pSize)
 {
-    sss_status_t retval   = kStatus_SSS_Fail;
-    smStatus_t status     = SM_NOT_OK;
-    uint8_t hkdfKey[1024] = {
-        0,
-    };
-    size_t hkdfKeyLen                   = sizeof(hkdfKey);
-    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
-    SE05x_DigestMode_t digestMode       = se05x_get_sha_algo(context->algorithm);
-    uint32_t saltID                     = (saltKeyObject == NULL ? 0 : saltKeyObject->keyId);
-    uint32_t derivedKeyID               = (derivedKeyObject == NULL ? 0 : derivedKeyObject->keyId);
-    uint8_t *pHkdfKey                   = hkdfKey;
-    SE05x_HkdfMode_t hkdfMode =
-        (context->mode == kMode_SSS_HKDF_ExpandOnly ? kSE05x_HkdfMode_ExpandOnly : kSE05x_HkdfMode_ExtractExpand);
+    smStatus_t status         = SM_NOT_OK;
+    sss_se05x_obj_meta_t meta = {0};
 
-    if (saltKeyObject != NULL) {
-        // Enforce that Salt is stored (securely) in the same keystore as the HMAC key.
-        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
-        if (context->keyObject->keyStore != saltKeyObject->keyStore) {
-            retval = kStatus_SSS_InvalidArgument;
-            goto exit;
-        }
+    if (sss_se05x_objcache_get(session, keyId, &meta) && meta.exists && meta.hasSize) {
+        *pSize = meta.size;
+        return SM_OK;
     }
-
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    if (derivedKeyObject != NULL) {
-        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
-        if (context->keyObject->keyStore == derivedKeyObject->keyStore) {
-            pHkdfKey = NULL;
-        }
+    status = Se05x_API_ReadSize(&session->s_ctx, keyId, pSize);
+    if (status == SM_OK) {
+        memset(&meta, 0, sizeof(meta));
+        meta.keyId   = keyId;
+        meta.exists  = 1;
+        meta.size    = *pSize;
+        meta.hasSize = 1;
+        sss_se05x_objcache_put(session, &meta);
     }
-#endif
+    return status;
+}
 
-    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
 
-    status = Se05x_API_HKDF_Extended(&context->session->s_ctx,
-        context->keyObject->keyId,
-        digestMode,
-        hkdfMode,
-        NULL,
+/* Crypto objects (the SE side of cipher, AEAD, MAC and digest contexts) are
+ * looked up with one APDU listing all of them. The list is read once at
+ * session open and the registry is kept up to date on create and delete, so
+ * an init goes straight to the Init APDU. Crypto objects used through this
+ * session are no longer deleted by context_free but kept for the next init,
+ * and deleted when the session is closed.
+ * Without object cache, the list is read each time as before. */
+
+/* Read the crypto object list, tell whether cryptoObjectId is on it */
+static smStatus_t sss_se05x_cryptoobj_read(
+    sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId, uint8_t *pPresent)
+{
+    smStatus_t status  = SM_NOT_OK;
+    uint8_t list[1024] = {
         0,
-        saltID,
-        info,
-        infoLen,
-        derivedKeyID,
-        deriveDataLen,
-        pHkdfKey,
-        &hkdfKeyLen);
-    ENSURE_OR_GO_EXIT(status == SM_OK);
+    };
+    size_t listlen = sizeof(list);
+    size_t i;
 
-    if (pHkdfKey != NULL) {
-        if (derivedKeyObject != NULL) {
-            retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
-                sss_derived_keyObject,
-                hkdfKey,
-                hkdfKeyLen,
-                hkdfKeyLen * 8,
-                NULL,
-                0);
-            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    *pPresent = 0;
+    status    = Se05x_API_ReadCryptoObjectList(&session->s_ctx, list, &listlen);
+    if (status != SM_OK) {
+        return status;
+    }
+    for (i = 0; (i + 1) < listlen; i += 4) {
+        uint16_t id = list[i + 1] | (list[i + 0] << 8);
+        if (id == cryptoObjectId) {
+            *pPresent = 1;
         }
     }
+    sss_se05x_cryptoobj_load(session, list, listlen);
+    return status;
+}
 
-    retval = kStatus_SSS_Success;
-exit:
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+static void sss_se05x_cryptoobj_open(sss_se05x_session_t *session)
+{
+    uint8_t present = 0;
+
+    if (session->pObjCache == NULL) {
+        return;
+    }
+    /* On failure the registry stays empty and is filled on first use */
+    if (SM_OK != sss_se05x_cryptoobj_read(session, kSE05x_CryptoObject_NA, &present)) {
+        LOG_D("Could not read crypto object list");
     }
-    return retval;
 }
 
-sss_status_t sss_se05x_derive_key_dh(
-    sss_se05x_derive_key_t *context, sss_se05x_object_t *otherPartyKeyObject, sss_se05x_object_t *derivedKeyObject)
+static void sss_se05x_cryptoobj_close(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-    uint8_t pubkey[256] = {0};
-    size_t pubkeylen    = sizeof(pubkey);
-    uint8_t sharedsecret[256];
-    size_t sharedsecretLen  = sizeof(sharedsecret);
-    size_t pbKeyBitLen      = 0;
-    uint8_t *pPublicKey     = NULL;
-    size_t publicKeyLen     = 0;
-    uint16_t publicKeyIndex = 0;
-#if SSS_HAVE_EC_MONT
-    uint8_t swapByte = 0;
-#endif
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    uint8_t invertEndiannes = 0x00;
-#endif
-
-    sss_object_t *sss_other_keyObject   = NULL;
-    sss_object_t *sss_derived_keyObject = NULL;
-    ENSURE_OR_GO_EXIT(context);
-    ENSURE_OR_GO_EXIT(otherPartyKeyObject);
-    ENSURE_OR_GO_EXIT(derivedKeyObject);
-    sss_other_keyObject   = (sss_object_t *)otherPartyKeyObject;
-    sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
-    retval                = sss_key_store_get_key(
-        (sss_key_store_t *)sss_other_keyObject->keyStore, sss_other_keyObject, pubkey, &pubkeylen, &pbKeyBitLen);
-    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    uint32_t used = sss_se05x_cryptoobj_take_used(session);
+    uint32_t id;
 
-    retval =
-        sss_util_pkcs8_asn1_get_ec_public_key_index((const uint8_t *)pubkey, pubkeylen, &publicKeyIndex, &publicKeyLen);
-    if (retval != kStatus_SSS_Success) {
-        LOG_W("error in sss_util_pkcs8_asn1_get_ec_public_key_index");
-        goto exit;
+    for (id = 0; used != 0; id++, used >>= 1) {
+        if ((used & 1u) && (SM_OK != Se05x_API_DeleteCryptoObject(&session->s_ctx, (SE05x_CryptoObjectID_t)id))) {
+            LOG_D("Could not delete crypto object 0x%04X", id);
+        }
     }
+}
 
-#if SSS_HAVE_EC_MONT
-    // Change Endianness Public Key in case of Montgomery Curve
-    {
-        if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
-            for (size_t keyValueIdx = 0; keyValueIdx < (publicKeyLen >> 1); keyValueIdx++) {
-                ENSURE_OR_GO_EXIT((SIZE_MAX - publicKeyIndex) >= keyValueIdx);
-                swapByte                             = pubkey[publicKeyIndex + keyValueIdx];
-                pubkey[publicKeyIndex + keyValueIdx] = pubkey[publicKeyIndex + publicKeyLen - 1 - keyValueIdx];
-                ENSURE_OR_GO_EXIT((SIZE_MAX - publicKeyIndex) >= publicKeyLen);
-                pubkey[publicKeyIndex + publicKeyLen - 1 - keyValueIdx] = swapByte;
-            }
+/* Create cryptoObjectId unless it is on the SE. With refresh, the list is
+ * read from the SE even if the registry knows the object.
+ * *pCreated is set if the object had to be created. */
+static smStatus_t sss_se05x_cryptoobj_ensure(sss_se05x_session_t *session,
+    SE05x_CryptoObjectID_t cryptoObjectId,
+    SE05x_CryptoContext_t cryptoContext,
+    SE05x_CryptoModeSubType_t subtype,
+    uint8_t refresh,
+    uint8_t *pCreated)
+{
+    smStatus_t status = SM_NOT_OK;
+    uint8_t present   = 0;
+    int known         = refresh ? -1 : sss_se05x_cryptoobj_known(session, cryptoObjectId);
+
+    *pCreated = 0;
+    if (known < 0) {
+        status = sss_se05x_cryptoobj_read(session, cryptoObjectId, &present);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            return status;
         }
     }
-#endif
-    if (pubkeylen > publicKeyIndex) {
-        pPublicKey = &pubkey[publicKeyIndex];
-    }
     else {
-        goto exit;
-    }
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-#if SSS_HAVE_EC_MONT
-    if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
-        // In case of Montgomery curves we want to store the
-        // shared secret using Little Endian Convention
-        invertEndiannes = 0x01;
+        present = (uint8_t)known;
     }
-#endif
 
-    if (context->keyObject->keyStore->session->subsystem == derivedKeyObject->keyStore->session->subsystem) {
-        status = Se05x_API_ECDHGenerateSharedSecret_InObject(&context->session->s_ctx,
-            context->keyObject->keyId,
-            pPublicKey,
-            publicKeyLen,
-            derivedKeyObject->keyId,
-            invertEndiannes);
+    if (!present) {
+        status = Se05x_API_CreateCryptoObject(&session->s_ctx, cryptoObjectId, cryptoContext, subtype);
         if (status != SM_OK) {
-            LOG_W("error in Se05x_API_ECDHGenerateSharedSecret_InObject");
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-            }
-            else {
-                retval = kStatus_SSS_Fail;
-            }
-            goto exit;
+            return status;
         }
+        *pCreated = 1;
     }
-    else {
-#endif
-        status = Se05x_API_ECGenSharedSecret(&context->session->s_ctx,
-            context->keyObject->keyId,
-            pPublicKey,
-            publicKeyLen,
-            sharedsecret,
-            &sharedsecretLen);
-        if (status != SM_OK) {
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-            }
-            else {
-                retval = kStatus_SSS_Fail;
-            }
-            goto exit;
-        }
+    sss_se05x_cryptoobj_record(session, cryptoObjectId, 1);
+    return SM_OK;
+}
 
-#if SSS_HAVE_EC_MONT
-        // Change Endianness Shared Secret in case of Montgomery Curve
-        {
-            if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
-                for (size_t keyValueIdx = 0; keyValueIdx < (publicKeyLen >> 1); keyValueIdx++) {
-                    swapByte                                     = sharedsecret[keyValueIdx];
-                    sharedsecret[keyValueIdx]                    = sharedsecret[publicKeyLen - 1 - keyValueIdx];
-                    sharedsecret[publicKeyLen - 1 - keyValueIdx] = swapByte;
-                }
-            }
-        }
-#endif
+/* Init of cryptoObjectId failed with initStatus. If the registry claimed the
+ * object exists, another session may have deleted it meanwhile. Read the list
+ * again and re-create it. Returns 1 if the init is worth a retry. */
+static uint8_t sss_se05x_cryptoobj_recover(sss_se05x_session_t *session,
+    SE05x_CryptoObjectID_t cryptoObjectId,
+    SE05x_CryptoContext_t cryptoContext,
+    SE05x_CryptoModeSubType_t subtype,
+    smStatus_t initStatus)
+{
+    uint8_t created = 0;
 
-        retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
-            sss_derived_keyObject,
-            sharedsecret,
-            sharedsecretLen,
-            sharedsecretLen * 8,
-            NULL,
-            0);
-        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
-#if SSS_HAVE_SE05X_VER_GTE_07_02
+    if ((initStatus == SM_OK) || (initStatus == SM_ERR_APDU_THROUGHPUT)) {
+        return 0;
     }
-#endif
-
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
+    if (sss_se05x_cryptoobj_known(session, cryptoObjectId) != 1) {
+        return 0;
+    }
+    if (SM_OK != sss_se05x_cryptoobj_ensure(session, cryptoObjectId, cryptoContext, subtype, 1, &created)) {
+        return 0;
+    }
+    if (created) {
+        LOG_D("Crypto object 0x%04X was gone, re-created", cryptoObjectId);
+    }
+    return created;
 }
 
-void sss_se05x_derive_key_context_free(sss_se05x_derive_key_t *context)
+/* Context of cryptoObjectId is freed. Returns 1 if the object stays on the SE
+ * for reuse, 0 if the caller deletes it. */
+static uint8_t sss_se05x_cryptoobj_keep(sss_se05x_session_t *session, SE05x_CryptoObjectID_t cryptoObjectId)
 {
-    AX_UNUSED_ARG(context);
+    return (sss_se05x_cryptoobj_known(session, cryptoObjectId) == 1) ? 1 : 0;
 }
 
-/* End: se05x_keyderive */
+#endif /* SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ */
+
+/* End: se05x_objcache */
 
 /* ************************************************************************** */
-/* Functions : sss_se05x_keystore                                             */
+/* Functions : sss_se05x_keyobj                                               */
 /* ************************************************************************** */
 
-sss_status_t sss_se05x_key_store_context_init(sss_se05x_key_store_t *keyStore, sss_se05x_session_t *session)
+sss_status_t sss_se05x_key_object_init(sss_se05x_object_t *keyObject, sss_se05x_key_store_t *keyStore)
 {
     sss_status_t retval = kStatus_SSS_Success;
-    if (keyStore == NULL) {
+    if (keyObject == NULL) {
         return kStatus_SSS_Fail;
     }
-    memset(keyStore, 0, sizeof(*keyStore));
-    keyStore->session = session;
-    return retval;
-}
-
-sss_status_t sss_se05x_key_store_allocate(sss_se05x_key_store_t *keyStore, uint32_t keyStoreId)
-{
-    AX_UNUSED_ARG(keyStore);
-    AX_UNUSED_ARG(keyStoreId);
-    return kStatus_SSS_Success;
-}
-
-sss_status_t sss_se05x_key_store_save(sss_se05x_key_store_t *keyStore)
-{
-    AX_UNUSED_ARG(keyStore);
-    return kStatus_SSS_Success;
-}
+    memset(keyObject, 0, sizeof(*keyObject));
+    keyObject->keyStore = keyStore;
 
-sss_status_t sss_se05x_key_store_load(sss_se05x_key_store_t *keyStore)
-{
-    AX_UNUSED_ARG(keyStore);
-    return kStatus_SSS_Success;
+    return retval;
 }
 
-#if SSSFTR_SE05X_RSA && SSSFTR_SE05X_KEY_SET && SSS_HAVE_RSA
-static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keyStore,
-    sss_se05x_object_t *keyObject,
-    const uint8_t *key,
-    size_t keyLen,
-    size_t keyBitLen,
-    void *policy_buff,
-    size_t policy_buff_len)
+sss_status_t sss_se05x_key_object_allocate_handle(sss_se05x_object_t *keyObject,
+    uint32_t keyId,
+    sss_key_part_t keyPart,
+    sss_cipher_type_t cipherType,
+    size_t keyByteLenMax,
+    uint32_t options)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-    //int ret;
-    uint32_t key_type = keyObject->objectType;
-    Se05xPolicy_t se05x_policy;
-    //SE05x_KeyPart_t key_part;
-    uint8_t *rsaN = NULL, *rsaE = NULL, *rsaD = NULL;
-    uint8_t *rsaP = NULL, *rsaQ = NULL, *rsaDP = NULL, *rsaDQ = NULL, *rsaQINV = NULL;
-    size_t rsaNlen, rsaElen, rsaDlen;
-    size_t rsaPlen, rsaQlen, rsaDPlen, rsaDQlen, rsaQINVlen;
-    SE05x_INS_t transient_type;
-    SE05x_RSAKeyFormat_t rsa_format;
-    uint8_t IdExists          = 0;
-    size_t keyBitLength       = 0;
-    SE05x_Result_t obj_exists = kSE05x_Result_NA;
-
-    se05x_policy.value     = (uint8_t *)policy_buff;
-    se05x_policy.value_len = policy_buff_len;
-
-    /* Assign proper instruction type based on keyObject->isPersistant  */
-    (keyObject->isPersistant) ? (transient_type = kSE05x_INS_NA) : (transient_type = kSE05x_INS_TRANSIENT);
-
-    if (keyObject->cipherType == kSSS_CipherType_RSA) {
-        rsa_format = kSE05x_RSAKeyFormat_RAW;
-    }
-    else if (keyObject->cipherType == kSSS_CipherType_RSA_CRT) {
-        rsa_format = kSE05x_RSAKeyFormat_CRT;
-    }
-    else {
-        retval = kStatus_SSS_Fail;
-        goto exit;
+    sss_status_t retval = kStatus_SSS_Success;
+    smStatus_t status;
+    SE05x_Result_t exists = kSE05x_Result_NA;
+    keyObject->objectType = keyPart;
+    keyObject->cipherType = cipherType;
+    keyObject->keyId      = keyId;
+    if (options == kKeyObject_Mode_Persistent) {
+        keyObject->isPersistant = 1;
     }
 
-#if 0
-    if (key_type == kSSS_KeyPart_Public) {
-        key_part = SE05x_KeyPart_Public;
-    }
-    else if (key_type == kSSS_KeyPart_Private) {
-        key_part = kSE05x_KeyPart_Private;
-    }
-    else if (key_type == kSSS_KeyPart_Pair) {
-        key_part = kSE05x_KeyPart_Pair;
+    AX_UNUSED_ARG(keyByteLenMax);
+
+    status = sss_se05x_cached_exists(keyObject->keyStore->session, keyId, &exists);
+    if (status == SM_OK) {
+        if (exists == kSE05x_Result_SUCCESS) {
+            LOG_W("Object id 0x%X exists", keyId);
+        }
     }
     else {
-        retval = kStatus_SSS_Fail;
-        goto exit;
+        LOG_E("Couldn't check if object id 0x%X exists", keyId);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            return kStatus_SSS_ApduThroughputError;
+        }
+        return kStatus_SSS_Fail;
     }
 
-    /* Set the kye parameters */
-    status = Se05x_API_WriteRSAKey(&keyStore->session->s_ctx,
-        &se05x_policy,
-        keyObject->keyId,
-        (U16)keyBitLen,
-        SE05X_RSA_NO_p,
-        SE05X_RSA_NO_q,
-        SE05X_RSA_NO_dp,
-        SE05X_RSA_NO_dq,
-        SE05X_RSA_NO_qInv,
-        SE05X_RSA_NO_pubExp,
-        SE05X_RSA_NO_priv,
-        SE05X_RSA_NO_pubMod,
-        transient_type,
-        key_part,
-        rsa_format);
-
-    if (status != SM_OK) {
-        retval = kStatus_SSS_Fail;
-        goto exit;
-    }
-#endif
+    return retval;
+}
 
-    if (key_type == kSSS_KeyPart_Public) {
-        smStatus_t apduRetValue = SM_NOT_OK;
-        retval                  = sss_util_asn1_rsa_parse_public(key, keyLen, &rsaN, &rsaNlen, &rsaE, &rsaElen);
-        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+//static sss_status_t sss_se05x_key_object_get_handle_binary(
+//    sss_se05x_object_t *keyObject) {
+//    sss_status_t retval = kStatus_SSS_Success;
+//    keyObject->objectType = kSSS_KeyPart_Default;
+//    keyObject->cipherType = kSSS_CipherType_Binary;
+//    return retval;
+//}
+sss_status_t sss_se05x_key_object_get_handle(sss_se05x_object_t *keyObject, uint32_t keyId)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSSFTR_SE05X_KEY_GET
+    SE05x_SecObjTyp_t retObjectType;
+    uint8_t retTransientType;
+    SE05x_ECCurve_t retCurveId;
+    smStatus_t apiRetval    = SM_NOT_OK;
+    smStatus_t apduRetValue = SM_NOT_OK;
 
-        IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+    if (0 == CheckIfKeyIdExists(keyId, keyObject->keyStore->session, &apduRetValue)) {
+        /* Object does not exist  */
+        LOG_D("keyId does not exist");
+        LOG_U32_D(keyId);
         if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
+            return kStatus_SSS_ApduThroughputError;
         }
-        keyBitLength = (IdExists == 1) ? 0 : keyBitLen;
-        obj_exists   = (IdExists == 1) ? kSE05x_Result_SUCCESS : kSE05x_Result_FAILURE;
-
-        /* Set the Public Exponent */
-        if (keyBitLength > UINT16_MAX) {
-            retval = kStatus_SSS_Fail;
-            goto exit;
+        else {
+            return retval;
         }
-        status = sss_se05x_LL_set_RSA_key(&keyStore->session->s_ctx,
-            &se05x_policy,
-            keyObject->keyId,
-            (U16)keyBitLength,
-            SE05X_RSA_NO_p,
-            SE05X_RSA_NO_q,
-            SE05X_RSA_NO_dp,
-            SE05X_RSA_NO_dq,
-            SE05X_RSA_NO_qInv,
-            rsaE,
-            rsaElen,
-            SE05X_RSA_NO_priv,
-            SE05X_RSA_NO_pubMod,
-            transient_type,
-            kSE05x_KeyPart_Public,
-            rsa_format,
-            obj_exists);
-        if (status != SM_OK) {
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-            }
-            else {
-                retval = kStatus_SSS_Fail;
-            }
+    }
+
+    keyObject->keyId = keyId;
+
+    apiRetval =
+        sss_se05x_cached_read_type(keyObject->keyStore->session, keyId, &retObjectType, &retTransientType);
+    if (apiRetval == SM_OK) {
+        keyObject->isPersistant = retTransientType;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+        if (retObjectType >= kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P192 &&
+            retObjectType <= kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_448)
+#else
+        if (retObjectType >= kSE05x_SecObjTyp_EC_KEY_PAIR && retObjectType <= kSE05x_SecObjTyp_EC_PUB_KEY)
+#endif
+        {
+            apiRetval = sss_se05x_cached_curve_id(keyObject->keyStore->session, keyId, &retCurveId);
+            if (apiRetval == SM_OK) {
+                keyObject->curve_id = retCurveId;
+                if ((retCurveId == kSE05x_ECCurve_NIST_P256)
+#if SSS_HAVE_EC_NIST_192
+                    || (retCurveId == kSE05x_ECCurve_NIST_P192)
+#endif
+#if SSS_HAVE_EC_NIST_224
+                    || (retCurveId == kSE05x_ECCurve_NIST_P224)
+#endif
+#if SSS_HAVE_EC_NIST_521
+                    || (retCurveId == kSE05x_ECCurve_NIST_P521)
+#endif
+                    || (retCurveId == kSE05x_ECCurve_NIST_P384)) {
+                    keyObject->cipherType = kSSS_CipherType_EC_NIST_P;
+                }
+#if SSS_HAVE_EC_BP
+                else if ((retCurveId >= kSE05x_ECCurve_Brainpool160) && (retCurveId <= kSE05x_ECCurve_Brainpool512)) {
+                    keyObject->cipherType = kSSS_CipherType_EC_BRAINPOOL;
+                }
+#endif
+#if SSS_HAVE_EC_NIST_K
+                else if ((retCurveId >= kSE05x_ECCurve_Secp160k1) && (retCurveId <= kSE05x_ECCurve_Secp256k1)) {
+                    keyObject->cipherType = kSSS_CipherType_EC_NIST_K;
+                }
+#endif
+#if SSS_HAVE_EC_ED
+                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_ED_25519) {
+                    keyObject->cipherType = kSSS_CipherType_EC_TWISTED_ED;
+                }
+#endif
+#if SSS_HAVE_EC_MONT
+                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_MONT_DH_25519) {
+                    keyObject->cipherType = kSSS_CipherType_EC_MONTGOMERY;
+                }
+#endif
+#if SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
+                else if (retCurveId == kSE05x_ECCurve_RESERVED_ID_ECC_MONT_DH_448) {
+                    keyObject->cipherType = kSSS_CipherType_EC_MONTGOMERY;
+                }
+#endif
+                else {
+                    return kStatus_SSS_Fail;
+                }
+            }
+            else {
+                LOG_E("error in Se05x_API_GetECCurveId");
+                if (apiRetval == SM_ERR_APDU_THROUGHPUT) {
+                    return kStatus_SSS_ApduThroughputError;
+                }
+                return kStatus_SSS_Fail;
+            }
+        }
+#if SSSFTR_RSA && SSS_HAVE_RSA
+        else if (retObjectType == kSE05x_SecObjTyp_RSA_KEY_PAIR_CRT) {
+            keyObject->cipherType = kSSS_CipherType_RSA_CRT;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_RSA_PRIV_KEY_CRT) {
+            keyObject->cipherType = kSSS_CipherType_RSA_CRT;
+        }
+        else if (retObjectType >= kSE05x_SecObjTyp_RSA_KEY_PAIR && retObjectType <= kSE05x_SecObjTyp_RSA_PUB_KEY) {
+            keyObject->cipherType = kSSS_CipherType_RSA;
+        }
+#endif
+        else if (retObjectType == kSE05x_SecObjTyp_AES_KEY) {
+            keyObject->cipherType = kSSS_CipherType_AES;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_DES_KEY) {
+            keyObject->cipherType = kSSS_CipherType_DES;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_BINARY_FILE) {
+            keyObject->cipherType = kSSS_CipherType_Binary;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_UserID) {
+            keyObject->cipherType = kSSS_CipherType_UserID;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_COUNTER) {
+            keyObject->cipherType = kSSS_CipherType_Count;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_PCR) {
+            keyObject->cipherType = kSSS_CipherType_PCR;
+        }
+        else if (retObjectType == kSE05x_SecObjTyp_HMAC_KEY) {
+            keyObject->cipherType = kSSS_CipherType_HMAC;
+        }
+        else {
+            return kStatus_SSS_Fail;
+        }
+
+        switch (retObjectType) {
+        case kSE05x_SecObjTyp_EC_KEY_PAIR:
+#if SSS_HAVE_RSA
+        case kSE05x_SecObjTyp_RSA_KEY_PAIR:
+        case kSE05x_SecObjTyp_RSA_KEY_PAIR_CRT:
+#endif
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P192:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P224:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P256:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P384:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_NIST_P521:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool160:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool192:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool224:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool256:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool320:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool384:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Brainpool512:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp160k1:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp192k1:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp224k1:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_Secp256k1:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_BN_P256:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_ED25519:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_MONT_DH_25519:
+        case kSE05x_SecObjTyp_EC_KEY_PAIR_MONT_DH_448:
+#endif
+            keyObject->objectType = kSSS_KeyPart_Pair;
+            break;
+
+        case kSE05x_SecObjTyp_EC_PUB_KEY:
+        case kSE05x_SecObjTyp_RSA_PUB_KEY:
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P192:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P224:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P256:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P384:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_NIST_P521:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool160:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool192:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool224:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool256:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool320:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool384:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Brainpool512:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp160k1:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp192k1:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp224k1:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_Secp256k1:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_BN_P256:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_ED25519:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_25519:
+        case kSE05x_SecObjTyp_EC_PUB_KEY_MONT_DH_448:
+#endif
+            keyObject->objectType = kSSS_KeyPart_Public;
+            break;
+
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P192:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P224:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P256:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P384:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_NIST_P521:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool160:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool192:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool224:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool256:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool320:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool384:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Brainpool512:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp160k1:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp192k1:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp224k1:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_Secp256k1:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_BN_P256:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_ED25519:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_MONT_DH_25519:
+        case kSE05x_SecObjTyp_EC_PRIV_KEY_MONT_DH_448:
+            keyObject->objectType = kSSS_KeyPart_Private;
+            break;
+#endif
+
+        case kSE05x_SecObjTyp_BINARY_FILE:
+        case kSE05x_SecObjTyp_PCR:
+        case kSE05x_SecObjTyp_AES_KEY:
+        case kSE05x_SecObjTyp_DES_KEY:
+        case kSE05x_SecObjTyp_HMAC_KEY:
+        case kSE05x_SecObjTyp_COUNTER:
+        case kSE05x_SecObjTyp_UserID:
+            keyObject->objectType = kSSS_KeyPart_Default;
+            break;
+        default:
+            return kStatus_SSS_Fail;
+        }
+    }
+    else {
+        LOG_W("Error in Se05x_API_ReadType. Further use of object may fail");
+        if (apiRetval == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+        }
+        else {
+            retval = kStatus_SSS_Success;
+        }
+        return retval;
+    }
+
+    retval = kStatus_SSS_Success;
+#endif // SSSFTR_SE05X_KEY_GET
+    return retval;
+}
+
+// LCOV_EXCL_START
+sss_status_t sss_se05x_key_object_set_user(sss_se05x_object_t *keyObject, uint32_t user, uint32_t options)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(user);
+    AX_UNUSED_ARG(options);
+    /* Purpose / Policy is set during creation time and hence can not
+     * enforced in SE050 later on */
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_set_purpose(sss_se05x_object_t *keyObject, sss_mode_t purpose, uint32_t options)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(purpose);
+    AX_UNUSED_ARG(options);
+    /* Purpose / Policy is set during creation time and hence can not
+     * enforced in SE050 later on */
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_set_access(sss_se05x_object_t *keyObject, uint32_t access, uint32_t options)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(access);
+    AX_UNUSED_ARG(options);
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_set_eccgfp_group(sss_se05x_object_t *keyObject, sss_eccgfp_group_t *group)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(group);
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_get_user(sss_se05x_object_t *keyObject, uint32_t *user)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(user);
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_get_purpose(sss_se05x_object_t *keyObject, sss_mode_t *purpose)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(purpose);
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+
+sss_status_t sss_se05x_key_object_get_access(sss_se05x_object_t *keyObject, uint32_t *access)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyObject);
+    AX_UNUSED_ARG(access);
+    LOG_W("Not supported in SE05X");
+    return retval;
+}
+// LCOV_EXCL_STOP
+
+void sss_se05x_key_object_free(sss_se05x_object_t *keyObject)
+{
+    memset(keyObject, 0, sizeof(*keyObject));
+}
+
+/* End: se05x_keyobj */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_keyderive                                            */
+/* ************************************************************************** */
+
+sss_status_t sss_se05x_derive_key_context_init(sss_se05x_derive_key_t *context,
+    sss_se05x_session_t *session,
+    sss_se05x_object_t *keyObject,
+    sss_algorithm_t algorithm,
+    sss_mode_t mode)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+    context->session   = session;
+    context->keyObject = keyObject;
+    context->algorithm = algorithm;
+    context->mode      = mode;
+
+    return retval;
+}
+
+sss_status_t sss_se05x_derive_key_go(sss_se05x_derive_key_t *context,
+    const uint8_t *saltData,
+    size_t saltLen,
+    const uint8_t *info,
+    size_t infoLen,
+    sss_se05x_object_t *derivedKeyObject,
+    uint16_t deriveDataLen,
+    uint8_t *hkdfOutput,
+    size_t *hkdfOutputLen)
+{
+    sss_status_t retval                     = kStatus_SSS_Fail;
+    smStatus_t status                       = SM_NOT_OK;
+    uint8_t hkdfKey[SE05X_MAX_BUF_SIZE_CMD] = {
+        0,
+    };
+    size_t hkdfKeyLen                   = sizeof(hkdfKey);
+    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
+    SE05x_DigestMode_t digestMode;
+
+    AX_UNUSED_ARG(hkdfOutput);
+    AX_UNUSED_ARG(hkdfOutputLen);
+
+    ENSURE_OR_GO_EXIT(context);
+    ENSURE_OR_GO_EXIT(info);
+    ENSURE_OR_GO_EXIT(derivedKeyObject);
+    if (saltLen) {
+        ENSURE_OR_GO_EXIT(saltData);
+    }
+
+    digestMode = se05x_get_sha_algo(context->algorithm);
+    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+
+    status = Se05x_API_HKDF(&context->session->s_ctx,
+        context->keyObject->keyId,
+        digestMode,
+        saltData,
+        saltLen,
+        info,
+        infoLen,
+        deriveDataLen,
+        hkdfKey,
+        &hkdfKeyLen);
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+
+    retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
+        sss_derived_keyObject,
+        hkdfKey,
+        hkdfKeyLen,
+        hkdfKeyLen * 8,
+        NULL,
+        0);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+    }
+    return retval;
+}
+
+sss_status_t sss_se05x_derive_key_one_go(sss_se05x_derive_key_t *context,
+    const uint8_t *saltData,
+    size_t saltLen,
+    const uint8_t *info,
+    size_t infoLen,
+    sss_se05x_object_t *derivedKeyObject,
+    uint16_t deriveDataLen)
+{
+    sss_status_t retval   = kStatus_SSS_Fail;
+    smStatus_t status     = SM_NOT_OK;
+    uint8_t hkdfKey[1024] = {
+        0,
+    };
+    size_t hkdfKeyLen                   = sizeof(hkdfKey);
+    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
+    SE05x_DigestMode_t digestMode       = se05x_get_sha_algo(context->algorithm);
+    uint32_t derivedKeyID               = (derivedKeyObject == NULL ? 0 : derivedKeyObject->keyId);
+    uint8_t *pHkdfKey                   = hkdfKey;
+    SE05x_HkdfMode_t hkdfMode =
+        (context->mode == kMode_SSS_HKDF_ExpandOnly ? kSE05x_HkdfMode_ExpandOnly : kSE05x_HkdfMode_ExtractExpand);
+
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    if (derivedKeyObject != NULL) {
+        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
+        if (context->keyObject->keyStore->session->subsystem == derivedKeyObject->keyStore->session->subsystem) {
+            pHkdfKey = NULL;
+        }
+    }
+#endif
+
+    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+
+    status = Se05x_API_HKDF_Extended(&context->session->s_ctx,
+        context->keyObject->keyId,
+        digestMode,
+        hkdfMode,
+        saltData,
+        saltLen,
+        0,
+        info,
+        infoLen,
+        derivedKeyID,
+        deriveDataLen,
+        pHkdfKey,
+        &hkdfKeyLen);
+    if ((pHkdfKey == NULL) && (derivedKeyObject != NULL)) {
+        /* Output went straight into the derived key object */
+        sss_se05x_objcache_changed(derivedKeyObject->keyStore->session, derivedKeyID, (status == SM_OK) ? 1 : -1);
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+
+    if (pHkdfKey != NULL) {
+        if (derivedKeyObject != NULL) {
+            retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
+                sss_derived_keyObject,
+                hkdfKey,
+                hkdfKeyLen,
+                hkdfKeyLen * 8,
+                NULL,
+                0);
+            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        }
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+    }
+    return retval;
+}
+
+sss_status_t sss_se05x_derive_key_sobj_one_go(sss_se05x_derive_key_t *context,
+    sss_se05x_object_t *saltKeyObject,
+    const uint8_t *info,
+    size_t infoLen,
+    sss_se05x_object_t *derivedKeyObject,
+    uint16_t deriveDataLen)
+{
+    sss_status_t retval   = kStatus_SSS_Fail;
+    smStatus_t status     = SM_NOT_OK;
+    uint8_t hkdfKey[1024] = {
+        0,
+    };
+    size_t hkdfKeyLen                   = sizeof(hkdfKey);
+    sss_object_t *sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
+    SE05x_DigestMode_t digestMode       = se05x_get_sha_algo(context->algorithm);
+    uint32_t saltID                     = (saltKeyObject == NULL ? 0 : saltKeyObject->keyId);
+    uint32_t derivedKeyID               = (derivedKeyObject == NULL ? 0 : derivedKeyObject->keyId);
+    uint8_t *pHkdfKey                   = hkdfKey;
+    SE05x_HkdfMode_t hkdfMode =
+        (context->mode == kMode_SSS_HKDF_ExpandOnly ? kSE05x_HkdfMode_ExpandOnly : kSE05x_HkdfMode_ExtractExpand);
+
+    if (saltKeyObject != NULL) {
+        // Enforce that Salt is stored (securely) in the same keystore as the HMAC key.
+        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
+        if (context->keyObject->keyStore != saltKeyObject->keyStore) {
+            retval = kStatus_SSS_InvalidArgument;
+            goto exit;
+        }
+    }
+
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    if (derivedKeyObject != NULL) {
+        ENSURE_OR_GO_EXIT(context->keyObject != NULL);
+        if (context->keyObject->keyStore == derivedKeyObject->keyStore) {
+            pHkdfKey = NULL;
+        }
+    }
+#endif
+
+    ENSURE_OR_GO_EXIT(digestMode != kSE05x_DigestMode_NA);
+
+    status = Se05x_API_HKDF_Extended(&context->session->s_ctx,
+        context->keyObject->keyId,
+        digestMode,
+        hkdfMode,
+        NULL,
+        0,
+        saltID,
+        info,
+        infoLen,
+        derivedKeyID,
+        deriveDataLen,
+        pHkdfKey,
+        &hkdfKeyLen);
+    if ((pHkdfKey == NULL) && (derivedKeyObject != NULL)) {
+        /* Output went straight into the derived key object */
+        sss_se05x_objcache_changed(derivedKeyObject->keyStore->session, derivedKeyID, (status == SM_OK) ? 1 : -1);
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+
+    if (pHkdfKey != NULL) {
+        if (derivedKeyObject != NULL) {
+            retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
+                sss_derived_keyObject,
+                hkdfKey,
+                hkdfKeyLen,
+                hkdfKeyLen * 8,
+                NULL,
+                0);
+            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        }
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+    }
+    return retval;
+}
+
+sss_status_t sss_se05x_derive_key_dh(
+    sss_se05x_derive_key_t *context, sss_se05x_object_t *otherPartyKeyObject, sss_se05x_object_t *derivedKeyObject)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    uint8_t pubkey[256] = {0};
+    size_t pubkeylen    = sizeof(pubkey);
+    uint8_t sharedsecret[256];
+    size_t sharedsecretLen  = sizeof(sharedsecret);
+    size_t pbKeyBitLen      = 0;
+    uint8_t *pPublicKey     = NULL;
+    size_t publicKeyLen     = 0;
+    uint16_t publicKeyIndex = 0;
+#if SSS_HAVE_EC_MONT
+    uint8_t swapByte = 0;
+#endif
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    uint8_t invertEndiannes = 0x00;
+#endif
+
+    sss_object_t *sss_other_keyObject   = NULL;
+    sss_object_t *sss_derived_keyObject = NULL;
+    ENSURE_OR_GO_EXIT(context);
+    ENSURE_OR_GO_EXIT(otherPartyKeyObject);
+    ENSURE_OR_GO_EXIT(derivedKeyObject);
+    sss_other_keyObject   = (sss_object_t *)otherPartyKeyObject;
+    sss_derived_keyObject = (sss_object_t *)derivedKeyObject;
+    retval                = sss_key_store_get_key(
+        (sss_key_store_t *)sss_other_keyObject->keyStore, sss_other_keyObject, pubkey, &pubkeylen, &pbKeyBitLen);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+
+    retval =
+        sss_util_pkcs8_asn1_get_ec_public_key_index((const uint8_t *)pubkey, pubkeylen, &publicKeyIndex, &publicKeyLen);
+    if (retval != kStatus_SSS_Success) {
+        LOG_W("error in sss_util_pkcs8_asn1_get_ec_public_key_index");
+        goto exit;
+    }
+
+#if SSS_HAVE_EC_MONT
+    // Change Endianness Public Key in case of Montgomery Curve
+    {
+        if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
+            for (size_t keyValueIdx = 0; keyValueIdx < (publicKeyLen >> 1); keyValueIdx++) {
+                ENSURE_OR_GO_EXIT((SIZE_MAX - publicKeyIndex) >= keyValueIdx);
+                swapByte                             = pubkey[publicKeyIndex + keyValueIdx];
+                pubkey[publicKeyIndex + keyValueIdx] = pubkey[publicKeyIndex + publicKeyLen - 1 - keyValueIdx];
+                ENSURE_OR_GO_EXIT((SIZE_MAX - publicKeyIndex) >= publicKeyLen);
+                pubkey[publicKeyIndex + publicKeyLen - 1 - keyValueIdx] = swapByte;
+            }
+        }
+    }
+#endif
+    if (pubkeylen > publicKeyIndex) {
+        pPublicKey = &pubkey[publicKeyIndex];
+    }
+    else {
+        goto exit;
+    }
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+#if SSS_HAVE_EC_MONT
+    if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
+        // In case of Montgomery curves we want to store the
+        // shared secret using Little Endian Convention
+        invertEndiannes = 0x01;
+    }
+#endif
+
+    if (context->keyObject->keyStore->session->subsystem == derivedKeyObject->keyStore->session->subsystem) {
+        status = Se05x_API_ECDHGenerateSharedSecret_InObject(&context->session->s_ctx,
+            context->keyObject->keyId,
+            pPublicKey,
+            publicKeyLen,
+            derivedKeyObject->keyId,
+            invertEndiannes);
+        sss_se05x_objcache_changed(
+            derivedKeyObject->keyStore->session, derivedKeyObject->keyId, (status == SM_OK) ? 1 : -1);
+        if (status != SM_OK) {
+            LOG_W("error in Se05x_API_ECDHGenerateSharedSecret_InObject");
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+            else {
+                retval = kStatus_SSS_Fail;
+            }
+            goto exit;
+        }
+    }
+    else {
+#endif
+        status = Se05x_API_ECGenSharedSecret(&context->session->s_ctx,
+            context->keyObject->keyId,
+            pPublicKey,
+            publicKeyLen,
+            sharedsecret,
+            &sharedsecretLen);
+        if (status != SM_OK) {
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+            else {
+                retval = kStatus_SSS_Fail;
+            }
+            goto exit;
+        }
+
+#if SSS_HAVE_EC_MONT
+        // Change Endianness Shared Secret in case of Montgomery Curve
+        {
+            if (otherPartyKeyObject->cipherType == kSSS_CipherType_EC_MONTGOMERY) {
+                for (size_t keyValueIdx = 0; keyValueIdx < (publicKeyLen >> 1); keyValueIdx++) {
+                    swapByte                                     = sharedsecret[keyValueIdx];
+                    sharedsecret[keyValueIdx]                    = sharedsecret[publicKeyLen - 1 - keyValueIdx];
+                    sharedsecret[publicKeyLen - 1 - keyValueIdx] = swapByte;
+                }
+            }
+        }
+#endif
+
+        retval = sss_key_store_set_key((sss_key_store_t *)derivedKeyObject->keyStore,
+            sss_derived_keyObject,
+            sharedsecret,
+            sharedsecretLen,
+            sharedsecretLen * 8,
+            NULL,
+            0);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    }
+#endif
+
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+void sss_se05x_derive_key_context_free(sss_se05x_derive_key_t *context)
+{
+    AX_UNUSED_ARG(context);
+}
+
+/* End: se05x_keyderive */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_keystore                                             */
+/* ************************************************************************** */
+
+sss_status_t sss_se05x_key_store_context_init(sss_se05x_key_store_t *keyStore, sss_se05x_session_t *session)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    if (keyStore == NULL) {
+        return kStatus_SSS_Fail;
+    }
+    memset(keyStore, 0, sizeof(*keyStore));
+    keyStore->session = session;
+    return retval;
+}
+
+sss_status_t sss_se05x_key_store_allocate(sss_se05x_key_store_t *keyStore, uint32_t keyStoreId)
+{
+    AX_UNUSED_ARG(keyStore);
+    AX_UNUSED_ARG(keyStoreId);
+    return kStatus_SSS_Success;
+}
+
+sss_status_t sss_se05x_key_store_save(sss_se05x_key_store_t *keyStore)
+{
+    AX_UNUSED_ARG(keyStore);
+    return kStatus_SSS_Success;
+}
+
+sss_status_t sss_se05x_key_store_load(sss_se05x_key_store_t *keyStore)
+{
+    AX_UNUSED_ARG(keyStore);
+    return kStatus_SSS_Success;
+}
+
+#if SSSFTR_SE05X_RSA && SSSFTR_SE05X_KEY_SET && SSS_HAVE_RSA
+static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keyStore,
+    sss_se05x_object_t *keyObject,
+    const uint8_t *key,
+    size_t keyLen,
+    size_t keyBitLen,
+    void *policy_buff,
+    size_t policy_buff_len)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    //int ret;
+    uint32_t key_type = keyObject->objectType;
+    Se05xPolicy_t se05x_policy;
+    //SE05x_KeyPart_t key_part;
+    uint8_t *rsaN = NULL, *rsaE = NULL, *rsaD = NULL;
+    uint8_t *rsaP = NULL, *rsaQ = NULL, *rsaDP = NULL, *rsaDQ = NULL, *rsaQINV = NULL;
+    size_t rsaNlen, rsaElen, rsaDlen;
+    size_t rsaPlen, rsaQlen, rsaDPlen, rsaDQlen, rsaQINVlen;
+    SE05x_INS_t transient_type;
+    SE05x_RSAKeyFormat_t rsa_format;
+    uint8_t IdExists          = 0;
+    size_t keyBitLength       = 0;
+    SE05x_Result_t obj_exists = kSE05x_Result_NA;
+
+    se05x_policy.value     = (uint8_t *)policy_buff;
+    se05x_policy.value_len = policy_buff_len;
+
+    /* Assign proper instruction type based on keyObject->isPersistant  */
+    (keyObject->isPersistant) ? (transient_type = kSE05x_INS_NA) : (transient_type = kSE05x_INS_TRANSIENT);
+
+    if (keyObject->cipherType == kSSS_CipherType_RSA) {
+        rsa_format = kSE05x_RSAKeyFormat_RAW;
+    }
+    else if (keyObject->cipherType == kSSS_CipherType_RSA_CRT) {
+        rsa_format = kSE05x_RSAKeyFormat_CRT;
+    }
+    else {
+        retval = kStatus_SSS_Fail;
+        goto exit;
+    }
+
+#if 0
+    if (key_type == kSSS_KeyPart_Public) {
+        key_part = SE05x_KeyPart_Public;
+    }
+    else if (key_type == kSSS_KeyPart_Private) {
+        key_part = kSE05x_KeyPart_Private;
+    }
+    else if (key_type == kSSS_KeyPart_Pair) {
+        key_part = kSE05x_KeyPart_Pair;
+    }
+    else {
+        retval = kStatus_SSS_Fail;
+        goto exit;
+    }
+
+    /* Set the kye parameters */
+    status = Se05x_API_WriteRSAKey(&keyStore->session->s_ctx,
+        &se05x_policy,
+        keyObject->keyId,
+        (U16)keyBitLen,
+        SE05X_RSA_NO_p,
+        SE05X_RSA_NO_q,
+        SE05X_RSA_NO_dp,
+        SE05X_RSA_NO_dq,
+        SE05X_RSA_NO_qInv,
+        SE05X_RSA_NO_pubExp,
+        SE05X_RSA_NO_priv,
+        SE05X_RSA_NO_pubMod,
+        transient_type,
+        key_part,
+        rsa_format);
+
+    if (status != SM_OK) {
+        retval = kStatus_SSS_Fail;
+        goto exit;
+    }
+#endif
+
+    if (key_type == kSSS_KeyPart_Public) {
+        smStatus_t apduRetValue = SM_NOT_OK;
+        retval                  = sss_util_asn1_rsa_parse_public(key, keyLen, &rsaN, &rsaNlen, &rsaE, &rsaElen);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+
+        IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
+        if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        keyBitLength = (IdExists == 1) ? 0 : keyBitLen;
+        obj_exists   = (IdExists == 1) ? kSE05x_Result_SUCCESS : kSE05x_Result_FAILURE;
+
+        /* Set the Public Exponent */
+        if (keyBitLength > UINT16_MAX) {
+            retval = kStatus_SSS_Fail;
+            goto exit;
+        }
+        status = sss_se05x_LL_set_RSA_key(&keyStore->session->s_ctx,
+            &se05x_policy,
+            keyObject->keyId,
+            (U16)keyBitLength,
+            SE05X_RSA_NO_p,
+            SE05X_RSA_NO_q,
+            SE05X_RSA_NO_dp,
+            SE05X_RSA_NO_dq,
+            SE05X_RSA_NO_qInv,
+            rsaE,
+            rsaElen,
+            SE05X_RSA_NO_priv,
+            SE05X_RSA_NO_pubMod,
+            transient_type,
+            kSE05x_KeyPart_Public,
+            rsa_format,
+            obj_exists);
+        if (status != SM_OK) {
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+            else {
+                retval = kStatus_SSS_Fail;
+            }
             goto exit;
         }
 
@@ -1988,7 +2809,7 @@ static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keySt
                 goto exit;
             }
 
-            IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+            IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
             if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
                 retval = kStatus_SSS_ApduThroughputError;
                 goto exit;
@@ -2082,7 +2903,7 @@ static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keySt
                 goto exit;
             }
 
-            IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+            IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
             if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
                 retval = kStatus_SSS_ApduThroughputError;
                 goto exit;
@@ -2263,7 +3084,7 @@ static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keySt
             ENSURE_OR_EXIT_WITH_STATUS_ON_ERROR(
                 !((rsaD == NULL) || (rsaE == NULL) || (rsaN == NULL)), retval, kStatus_SSS_Fail);
 
-            IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+            IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
             if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
                 retval = kStatus_SSS_ApduThroughputError;
                 goto exit;
@@ -2387,7 +3208,7 @@ static sss_status_t sss_se05x_key_store_set_rsa_key(sss_se05x_key_store_t *keySt
                 goto exit;
             }
 
-            IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+            IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
             if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
                 retval = kStatus_SSS_ApduThroughputError;
                 goto exit;
@@ -2758,6 +3579,14 @@ static sss_status_t getEccPrivPubKeyLen(uint32_t curve_id, size_t *pubKeyLen, si
 #if SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
 /* sss_se05x_create_curve_if_needed for internal to this file and for tests */
 smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t curve_id)
+{
+    return sss_se05x_create_curve(NULL, pSession, curve_id);
+}
+
+/* Create curve_id unless it is on the SE. With session, what is known about
+ * the curves is taken from / kept in the session's cache, so the curve list
+ * is read at most once per session. */
+static smStatus_t sss_se05x_create_curve(sss_se05x_session_t *session, Se05xSession_t *pSession, uint32_t curve_id)
 {
     smStatus_t status = SM_NOT_OK;
     //uint32_t existing_curve_id = 0;
@@ -2765,8 +3594,13 @@ smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t c
         0,
     };
     size_t curveListLen = sizeof(curveList);
+    int known           = sss_se05x_curvecache_known(session, curve_id);
     //int i = 0;
 
+    if (known == 1) {
+        return SM_OK;
+    }
+
 #if SSS_HAVE_EC_ED
     if (curve_id == kSE05x_ECCurve_RESERVED_ID_ECC_ED_25519) {
         /* ECC_ED_25519 is always preset */
@@ -2787,6 +3621,7 @@ smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t c
         }
         else {
             /* If curve is already created, Se05x_API_CreateECCurve fails. Ignore this error */
+            sss_se05x_curvecache_set(session, curve_id);
             return SM_OK;
         }
 
@@ -2797,21 +3632,24 @@ smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t c
     }
 #endif // SSS_HAVE_EC_MONT
 
-    status = Se05x_API_ReadECCurveList(pSession, curveList, &curveListLen);
-    if (status == SM_OK) {
-        if (curve_id == 0) {
-            return SM_NOT_OK;
-        }
-        if ((curve_id - 1) >= curveListLen) {
-            return SM_NOT_OK;
+    if (known < 0) {
+        status = Se05x_API_ReadECCurveList(pSession, curveList, &curveListLen);
+        if (status == SM_OK) {
+            sss_se05x_curvecache_load(session, curveList, curveListLen);
+            if (curve_id == 0) {
+                return SM_NOT_OK;
+            }
+            if ((curve_id - 1) >= curveListLen) {
+                return SM_NOT_OK;
+            }
+            if (curveList[curve_id - 1] == kSE05x_SetIndicator_SET) {
+                return SM_OK;
+            }
         }
-        if (curveList[curve_id - 1] == kSE05x_SetIndicator_SET) {
-            return SM_OK;
+        else {
+            return status;
         }
     }
-    else {
-        return status;
-    }
 
     status = SM_NOT_OK;
 
@@ -2882,18 +3720,92 @@ smStatus_t sss_se05x_create_curve_if_needed(Se05xSession_t *pSession, uint32_t c
     if (status == SM_ERR_CONDITIONS_NOT_SATISFIED) {
         LOG_W("Allowing SM_ERR_CONDITIONS_NOT_SATISFIED for CreateCurve");
     }
+    if ((status == SM_OK) || (status == SM_ERR_CONDITIONS_NOT_SATISFIED)) {
+        sss_se05x_curvecache_set(session, curve_id);
+    }
 exit:
     return status;
 }
+
+sss_status_t sss_se05x_session_provision_curves(sss_se05x_session_t *session)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    uint8_t curveList[kSE05x_ECCurve_Total_Weierstrass_Curves] = {
+        0,
+    };
+    size_t curveListLen = sizeof(curveList);
+    size_t i;
+    const uint32_t curves[] = {
+#if SSS_HAVE_EC_NIST_192
+        kSE05x_ECCurve_NIST_P192,
+#endif
+#if SSS_HAVE_EC_NIST_224
+        kSE05x_ECCurve_NIST_P224,
+#endif
+        kSE05x_ECCurve_NIST_P256,
+        kSE05x_ECCurve_NIST_P384,
+#if SSS_HAVE_EC_NIST_521
+        kSE05x_ECCurve_NIST_P521,
+#endif
+#if SSS_HAVE_EC_BP
+        kSE05x_ECCurve_Brainpool160,
+        kSE05x_ECCurve_Brainpool192,
+        kSE05x_ECCurve_Brainpool224,
+        kSE05x_ECCurve_Brainpool256,
+        kSE05x_ECCurve_Brainpool320,
+        kSE05x_ECCurve_Brainpool384,
+        kSE05x_ECCurve_Brainpool512,
+#endif
+#if SSS_HAVE_EC_NIST_K
+        kSE05x_ECCurve_Secp160k1,
+        kSE05x_ECCurve_Secp192k1,
+        kSE05x_ECCurve_Secp224k1,
+        kSE05x_ECCurve_Secp256k1,
+#endif
+    };
+
+    ENSURE_OR_GO_EXIT(session != NULL);
+
+    for (i = 0; i < ARRAY_SIZE(curves); i++) {
+        status = sss_se05x_create_curve(session, &session->s_ctx, curves[i]);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        if ((status != SM_OK) && (status != SM_ERR_CONDITIONS_NOT_SATISFIED)) {
+            LOG_W("Could not create curve 0x%02X", curves[i]);
+        }
+    }
+
+    /* Verify, and leave the cache with the state as seen by the SE */
+    status = Se05x_API_ReadECCurveList(&session->s_ctx, curveList, &curveListLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+    sss_se05x_curvecache_load(session, curveList, curveListLen);
+
+    retval = kStatus_SSS_Success;
+    for (i = 0; i < ARRAY_SIZE(curves); i++) {
+        if ((curves[i] > curveListLen) || (curveList[curves[i] - 1] != kSE05x_SetIndicator_SET)) {
+            LOG_W("Curve 0x%02X is not on the SE", curves[i]);
+            retval = kStatus_SSS_Fail;
+        }
+    }
+exit:
+    return retval;
+}
 #endif // SSSFTR_SE05X_ECC && SSSFTR_SE05X_KEY_SET
 
 #if SSSFTR_SE05X_KEY_SET || SSSFTR_SE05X_KEY_GET
-static uint8_t CheckIfKeyIdExists(uint32_t keyId, pSe05xSession_t session_ctx, smStatus_t *apduStatus)
+static uint8_t CheckIfKeyIdExists(uint32_t keyId, sss_se05x_session_t *session, smStatus_t *apduStatus)
 {
     smStatus_t retStatus    = SM_NOT_OK;
     SE05x_Result_t IdExists = kSE05x_Result_NA;
 
-    retStatus = Se05x_API_CheckObjectExists(session_ctx, keyId, &IdExists);
+    retStatus = sss_se05x_cached_exists(session, keyId, &IdExists);
     if (apduStatus != NULL) {
         *apduStatus = retStatus;
     }
@@ -2958,7 +3870,8 @@ static sss_status_t sss_se05x_key_store_set_ecc_public_key(sss_se05x_key_store_t
         goto exit;
     }
 
-    status = sss_se05x_create_curve_if_needed(&keyObject->keyStore->session->s_ctx, keyObject->curve_id);
+    status = sss_se05x_create_curve(
+        keyObject->keyStore->session, &keyObject->keyStore->session->s_ctx, keyObject->curve_id);
     if (status == SM_NOT_OK) {
         goto exit;
     }
@@ -2970,7 +3883,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_public_key(sss_se05x_key_store_t
         LOG_W("Allowing SM_ERR_CONDITIONS_NOT_SATISFIED for CreateCurve");
     }
 
-    status = Se05x_API_CheckObjectExists(&keyStore->session->s_ctx, keyObject->keyId, &exists);
+    status = sss_se05x_cached_exists(keyStore->session, keyObject->keyId, &exists);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -2979,7 +3892,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_public_key(sss_se05x_key_store_t
 
     if (exists == kSE05x_Result_SUCCESS) {
         /* Check if object is of same curve id */
-        status = Se05x_API_EC_CurveGetId(&keyObject->keyStore->session->s_ctx, keyObject->keyId, &retCurveId);
+        status = sss_se05x_cached_curve_id(keyObject->keyStore->session, keyObject->keyId, &retCurveId);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -3145,7 +4058,8 @@ static sss_status_t sss_se05x_key_store_set_ecc_keypair(sss_se05x_key_store_t *k
         goto exit;
     }
 
-    status = sss_se05x_create_curve_if_needed(&keyObject->keyStore->session->s_ctx, keyObject->curve_id);
+    status = sss_se05x_create_curve(
+        keyObject->keyStore->session, &keyObject->keyStore->session->s_ctx, keyObject->curve_id);
 
     if (status == SM_NOT_OK) {
         goto exit;
@@ -3153,7 +4067,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_keypair(sss_se05x_key_store_t *k
     else if (status == SM_ERR_CONDITIONS_NOT_SATISFIED) {
         LOG_W("Allowing SM_ERR_CONDITIONS_NOT_SATISFIED for CreateCurve");
     }
-    status = Se05x_API_CheckObjectExists(&keyStore->session->s_ctx, keyObject->keyId, &exists);
+    status = sss_se05x_cached_exists(keyStore->session, keyObject->keyId, &exists);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -3162,7 +4076,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_keypair(sss_se05x_key_store_t *k
 
     if (exists == kSE05x_Result_SUCCESS) {
         /* Check if object is of same curve id */
-        status = Se05x_API_EC_CurveGetId(&keyObject->keyStore->session->s_ctx, keyObject->keyId, &retCurveId);
+        status = sss_se05x_cached_curve_id(keyObject->keyStore->session, keyObject->keyId, &retCurveId);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -3343,7 +4257,8 @@ static sss_status_t sss_se05x_key_store_set_ecc_private_key(sss_se05x_key_store_
         goto exit;
     }
 
-    status = sss_se05x_create_curve_if_needed(&keyObject->keyStore->session->s_ctx, keyObject->curve_id);
+    status = sss_se05x_create_curve(
+        keyObject->keyStore->session, &keyObject->keyStore->session->s_ctx, keyObject->curve_id);
 
     if (status == SM_NOT_OK) {
         goto exit;
@@ -3351,7 +4266,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_private_key(sss_se05x_key_store_
     else if (status == SM_ERR_CONDITIONS_NOT_SATISFIED) {
         LOG_W("Allowing SM_ERR_CONDITIONS_NOT_SATISFIED for CreateCurve");
     }
-    status = Se05x_API_CheckObjectExists(&keyStore->session->s_ctx, keyObject->keyId, &exists);
+    status = sss_se05x_cached_exists(keyStore->session, keyObject->keyId, &exists);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -3360,7 +4275,7 @@ static sss_status_t sss_se05x_key_store_set_ecc_private_key(sss_se05x_key_store_
 
     if (exists == kSE05x_Result_SUCCESS) {
         /* Check if object is of same curve id */
-        status = Se05x_API_EC_CurveGetId(&keyObject->keyStore->session->s_ctx, keyObject->keyId, &retCurveId);
+        status = sss_se05x_cached_curve_id(keyObject->keyStore->session, keyObject->keyId, &retCurveId);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -3509,7 +4424,7 @@ static sss_status_t sss_se05x_key_store_set_aes_key(sss_se05x_key_store_t *keySt
     /* Assign proper instruction type based on keyObject->isPersistant  */
     (keyObject->isPersistant) ? (transient_type = kSE05x_INS_NA) : (transient_type = kSE05x_INS_TRANSIENT);
 
-    IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+    IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
     if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -3580,7 +4495,7 @@ static sss_status_t sss_se05x_key_store_set_des_key(sss_se05x_key_store_t *keySt
 
     /* Assign proper instruction type based on keyObject->isPersistant  */
     (keyObject->isPersistant) ? (transient_type = kSE05x_INS_NA) : (transient_type = kSE05x_INS_TRANSIENT);
-    IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+    IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
     if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -3688,7 +4603,7 @@ static sss_status_t sss_se05x_key_store_set_cert(sss_se05x_key_store_t *keyStore
 
     ENSURE_OR_GO_EXIT(keyLen < 0xFFFFu);
 
-    IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+    IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
     if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -3924,6 +4839,9 @@ sss_status_t sss_se05x_key_store_set_key(sss_se05x_key_store_t *keyStore,
     }
     retval = kStatus_SSS_Success;
 exit:
+    if ((keyStore != NULL) && (keyObject != NULL)) {
+        sss_se05x_objcache_changed(keyStore->session, keyObject->keyId, (retval == kStatus_SSS_Success) ? 1 : -1);
+    }
 #endif /* SSSFTR_SE05X_KEY_SET */
     return retval;
 }
@@ -3991,9 +4909,10 @@ sss_status_t sss_se05x_key_store_generate_key(
             goto exit;
         }
 
-        status = sss_se05x_create_curve_if_needed(&keyObject->keyStore->session->s_ctx, keyObject->curve_id);
+        status = sss_se05x_create_curve(
+            keyObject->keyStore->session, &keyObject->keyStore->session->s_ctx, keyObject->curve_id);
 
-        IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+        IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
         if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -4038,7 +4957,7 @@ sss_status_t sss_se05x_key_store_generate_key(
             goto exit;
         }
 
-        IdExists = CheckIfKeyIdExists(keyObject->keyId, &keyStore->session->s_ctx, &apduRetValue);
+        IdExists = CheckIfKeyIdExists(keyObject->keyId, keyStore->session, &apduRetValue);
         if (apduRetValue == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -4076,6 +4995,9 @@ sss_status_t sss_se05x_key_store_generate_key(
 
     retval = kStatus_SSS_Success;
 exit:
+    if ((keyStore != NULL) && (keyObject != NULL)) {
+        sss_se05x_objcache_changed(keyStore->session, keyObject->keyId, (retval == kStatus_SSS_Success) ? 1 : -1);
+    }
 #endif // SSSFTR_SE05X_KEY_SET
     return retval;
 }
@@ -4441,11 +5363,16 @@ sss_status_t sss_se05x_key_store_get_key(
     sss_cipher_type_t cipher_type = kSSS_CipherType_NONE;
     smStatus_t status             = SM_NOT_OK;
     uint16_t size                 = 0;
+    bool atomic                   = false;
     ENSURE_OR_GO_EXIT(keyObject);
     ENSURE_OR_GO_EXIT(key);
     ENSURE_OR_GO_EXIT(keylen);
     ENSURE_OR_GO_EXIT(pKeyBitLen);
 
+    /* Size and all chunks of the object are read without other commands in between */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(keyStore->session) == kStatus_SSS_Success);
+    atomic = true;
+
     cipher_type = (sss_cipher_type_t)keyObject->cipherType;
 
     switch (cipher_type) {
@@ -4538,7 +5465,7 @@ sss_status_t sss_se05x_key_store_get_key(
         uint16_t rem_data = 0;
         uint16_t offset   = 0;
         size_t max_buffer = 0;
-        status            = Se05x_API_ReadSize(&keyStore->session->s_ctx, keyObject->keyId, &size);
+        status            = sss_se05x_cached_read_size(keyStore->session, keyObject->keyId, &size);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -4610,6 +5537,9 @@ sss_status_t sss_se05x_key_store_get_key(
 
     retval = kStatus_SSS_Success;
 exit:
+    if (atomic) {
+        sss_se05x_end_atomic(keyStore->session);
+    }
     return retval;
 }
 
@@ -4772,7 +5702,7 @@ sss_status_t sss_se05x_key_store_get_key_attst(sss_se05x_key_store_t *keyStore,
 
         if (attestAlgo == kSE05x_AttestationAlgo_RSA_SHA_512_PKCS1 ||
             attestAlgo == kSE05x_AttestationAlgo_RSA_SHA512_PKCS1_PSS) {
-            status = Se05x_API_ReadSize(&keyStore->session->s_ctx, keyObject_attst->keyId, &key_size_bytes);
+            status = sss_se05x_cached_read_size(keyStore->session, keyObject_attst->keyId, &key_size_bytes);
             if (status == SM_ERR_APDU_THROUGHPUT) {
                 return kStatus_SSS_ApduThroughputError;
             }
@@ -4954,7 +5884,7 @@ sss_status_t sss_se05x_key_store_get_key_attst(sss_se05x_key_store_t *keyStore,
         uint16_t offset   = 0;
         size_t dataLen    = 0;
         // size_t signatureLen = 0;
-        status = Se05x_API_ReadSize(&keyStore->session->s_ctx, keyObject->keyId, &size);
+        status = sss_se05x_cached_read_size(keyStore->session, keyObject->keyId, &size);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
@@ -5288,255 +6218,680 @@ sss_status_t sss_se05x_key_store_get_key_fromoffset(sss_se05x_key_store_t *keySt
         goto exit;
     }
 
-    retval = kStatus_SSS_Success;
-exit:
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+#endif
+sss_status_t sss_se05x_key_store_open_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+
+    if (NULL == keyObject) {
+        keyStore->kekKey = NULL;
+        retval           = kStatus_SSS_Success;
+    }
+    else if (keyObject->keyStore == keyStore) {
+        keyStore->kekKey = keyObject;
+        retval           = kStatus_SSS_Success;
+    }
+    else {
+        LOG_W("KeyObject must be of same KeyStore.");
+    }
+
+    return retval;
+}
+
+sss_status_t sss_se05x_key_store_freeze_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    AX_UNUSED_ARG(keyStore);
+    AX_UNUSED_ARG(keyObject);
+    /* Purpose / Policy is set during creation time and hence can not
+     * enforced in SE050 later on */
+    return retval;
+}
+
+sss_status_t sss_se05x_key_store_erase_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    ENSURE_OR_GO_EXIT(keyStore);
+    ENSURE_OR_GO_EXIT(keyObject);
+
+    status = Se05x_API_DeleteSecureObject(&keyStore->session->s_ctx, keyObject->keyId);
+    sss_se05x_objcache_changed(keyStore->session, keyObject->keyId, (SM_OK == status) ? 0 : -1);
+    if (SM_OK == status) {
+        LOG_D("Erased Key id %X", keyObject->keyId);
+        retval = kStatus_SSS_Success;
+    }
+    else {
+        LOG_W("Could not delete Key id %X", keyObject->keyId);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+    }
+exit:
+    return retval;
+}
+
+void sss_se05x_key_store_context_free(sss_se05x_key_store_t *keyStore)
+{
+    memset(keyStore, 0, sizeof(*keyStore));
+}
+
+sss_status_t sss_se05x_key_store_export_key(
+    sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject, uint8_t *key, size_t *keylen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    sss_cipher_type_t cipher_type = (sss_cipher_type_t)keyObject->cipherType;
+    smStatus_t status             = SM_NOT_OK;
+
+    switch (cipher_type) {
+    case kSSS_CipherType_EC_NIST_P:
+#if SSS_HAVE_EC_NIST_K
+    case kSSS_CipherType_EC_NIST_K:
+#endif
+#if SSS_HAVE_EC_BP
+    case kSSS_CipherType_EC_BRAINPOOL:
+#endif
+#if SSS_HAVE_EC_MONT
+    case kSSS_CipherType_EC_MONTGOMERY:
+#endif
+#if SSS_HAVE_EC_ED
+    case kSSS_CipherType_EC_TWISTED_ED:
+#endif
+    case kSSS_CipherType_AES:
+    case kSSS_CipherType_DES: {
+        status =
+            Se05x_API_ExportObject(&keyStore->session->s_ctx, keyObject->keyId, kSE05x_RSAKeyComponent_NA, key, keylen);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        if (status != SM_OK) {
+            goto exit;
+        }
+
+        break;
+    }
+
+    default:
+        goto exit;
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+sss_status_t sss_se05x_key_store_import_key(
+    sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject, uint8_t *key, size_t keylen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    sss_cipher_type_t cipher_type = (sss_cipher_type_t)keyObject->cipherType;
+    smStatus_t status             = SM_NOT_OK;
+
+    switch (cipher_type) {
+    case kSSS_CipherType_EC_NIST_P:
+#if SSS_HAVE_EC_NIST_K
+    case kSSS_CipherType_EC_NIST_K:
+#endif
+#if SSS_HAVE_EC_BP
+    case kSSS_CipherType_EC_BRAINPOOL:
+#endif
+#if SSS_HAVE_EC_MONT
+    case kSSS_CipherType_EC_MONTGOMERY:
+#endif
+#if SSS_HAVE_EC_ED
+    case kSSS_CipherType_EC_TWISTED_ED:
+#endif
+    case kSSS_CipherType_AES:
+    case kSSS_CipherType_DES: {
+        status =
+            Se05x_API_ImportObject(&keyStore->session->s_ctx, keyObject->keyId, kSE05x_RSAKeyComponent_NA, key, keylen);
+        sss_se05x_objcache_changed(keyStore->session, keyObject->keyId, (status == SM_OK) ? 1 : -1);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        if (status != SM_OK) {
+            goto exit;
+        }
+
+        break;
+    }
+
+    default:
+        goto exit;
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+/* End: se05x_keystore */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_asym                                                 */
+/* ************************************************************************** */
+
+sss_status_t sss_se05x_asymmetric_context_init(sss_se05x_asymmetric_t *context,
+    sss_se05x_session_t *session,
+    sss_se05x_object_t *keyObject,
+    sss_algorithm_t algorithm,
+    sss_mode_t mode)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+    context->session   = session;
+    context->keyObject = keyObject;
+    context->algorithm = algorithm;
+    context->mode      = mode;
+
     return retval;
 }
-#endif
-sss_status_t sss_se05x_key_store_open_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+
+sss_status_t sss_se05x_asymmetric_encrypt(
+    sss_se05x_asymmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-
-    if (NULL == keyObject) {
-        keyStore->kekKey = NULL;
-        retval           = kStatus_SSS_Success;
+#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA
+    smStatus_t status                           = SM_NOT_OK;
+    SE05x_RSAEncryptionAlgo_t rsaEncryptionAlgo = se05x_get_rsa_encrypt_mode(context->algorithm);
+    if (context->keyObject == NULL) {
+        return kStatus_SSS_Fail;
     }
-    else if (keyObject->keyStore == keyStore) {
-        keyStore->kekKey = keyObject;
-        retval           = kStatus_SSS_Success;
+    status = Se05x_API_RSAEncrypt(
+        &context->session->s_ctx, context->keyObject->keyId, rsaEncryptionAlgo, srcData, srcLen, destData, destLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
     }
-    else {
-        LOG_W("KeyObject must be of same KeyStore.");
+    else if (status == SM_OK) {
+        retval = kStatus_SSS_Success;
     }
-
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(srcData);
+    AX_UNUSED_ARG(srcLen);
+    AX_UNUSED_ARG(destData);
+    AX_UNUSED_ARG(destLen);
+#endif
     return retval;
 }
 
-sss_status_t sss_se05x_key_store_freeze_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+sss_status_t sss_se05x_asymmetric_decrypt(
+    sss_se05x_asymmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-    AX_UNUSED_ARG(keyStore);
-    AX_UNUSED_ARG(keyObject);
-    /* Purpose / Policy is set during creation time and hence can not
-     * enforced in SE050 later on */
+#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA
+    smStatus_t status = SM_NOT_OK;
+
+    SE05x_RSAEncryptionAlgo_t rsaEncryptionAlgo = se05x_get_rsa_encrypt_mode(context->algorithm);
+    if (context->keyObject == NULL) {
+        return retval;
+    }
+    status = Se05x_API_RSADecrypt(
+        &context->session->s_ctx, context->keyObject->keyId, rsaEncryptionAlgo, srcData, srcLen, destData, destLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+    }
+    else if (status == SM_OK) {
+        retval = kStatus_SSS_Success;
+    }
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(srcData);
+    AX_UNUSED_ARG(srcLen);
+    AX_UNUSED_ARG(destData);
+    AX_UNUSED_ARG(destLen);
+#endif
     return retval;
 }
 
-sss_status_t sss_se05x_key_store_erase_key(sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject)
+sss_status_t sss_se05x_asymmetric_sign_digest(
+    sss_se05x_asymmetric_t *context, const uint8_t *digest, size_t digestLen, uint8_t *signature, size_t *signatureLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
     smStatus_t status   = SM_NOT_OK;
-    ENSURE_OR_GO_EXIT(keyStore);
-    ENSURE_OR_GO_EXIT(keyObject);
 
-    status = Se05x_API_DeleteSecureObject(&keyStore->session->s_ctx, keyObject->keyId);
-    if (SM_OK == status) {
-        LOG_D("Erased Key id %X", keyObject->keyId);
+#if SSSFTR_SE05X_ECC
+    SE05x_ECSignatureAlgo_t ecSignAlgo = kSE05x_ECSignatureAlgo_NA;
+#endif
+
+#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
+    if (kStatus_SSS_Success != se05x_check_input_len(digestLen, context->algorithm)) {
+        LOG_E("Algorithm and digest length do not match");
+        return kStatus_SSS_Fail;
+    }
+#endif
+
+    switch (context->keyObject->cipherType) {
+#if SSSFTR_SE05X_ECC
+    case kSSS_CipherType_EC_NIST_P:
+#if SSS_HAVE_EC_NIST_K
+    case kSSS_CipherType_EC_NIST_K:
+#endif
+#if SSS_HAVE_EC_BP
+    case kSSS_CipherType_EC_BRAINPOOL:
+#endif
+    {
+        ecSignAlgo = se05x_get_ec_sign_hash_mode(context->algorithm);
+        status     = Se05x_API_ECDSASign(&context->session->s_ctx,
+            context->keyObject->keyId,
+            ecSignAlgo,
+            digest,
+            digestLen,
+            signature,
+            signatureLen);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+        }
+    } break;
+#if SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
+    case kSSS_CipherType_EC_MONTGOMERY: {
+        LOG_W(
+            "Sign operation is not supported for "
+            "kSSS_CipherType_EC_MONTGOMERY curve");
+        return kStatus_SSS_Fail;
+    } break;
+#endif // SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
+#endif //SSSFTR_SE05X_ECC
+#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
+    case kSSS_CipherType_RSA:
+    case kSSS_CipherType_RSA_CRT: {
+        if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) &&
+            (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA1)) {
+            /* Perform EMSA encoding on input data and and RSA decrypt on emsa data --> RSA sign without hash */
+            /* clang-format off */
+            uint8_t emsa_data[512] = {0,}; /* MAX - SHA512*/
+            size_t emsa_len = sizeof(emsa_data);
+            smStatus_t encode_ret = SM_OK;
+            /* clang-format on */
+
+            encode_ret = emsa_encode(context, digest, digestLen, emsa_data, &emsa_len);
+            if (SM_OK != encode_ret) {
+                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
+                    return kStatus_SSS_ApduThroughputError;
+                }
+                else {
+                    return kStatus_SSS_Fail;
+                }
+            }
+            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+                context->keyObject->keyId,
+                kSE05x_RSAEncryptionAlgo_NO_PAD,
+                emsa_data,
+                emsa_len,
+                signature,
+                signatureLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+        }
+        else if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512) &&
+                 (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA1)) {
+            smStatus_t encode_ret = SM_OK;
+            /* Perform PKCS1-v15 encoding on input data and and RSA decrypt on PKCS1-v15 data --> RSA sign without hash */
+            /* clang-format off */
+            uint8_t pkcs1v15_encode_data[512] = {0,}; /* MAX - SHA512*/
+            size_t encode_data_len = sizeof(pkcs1v15_encode_data);
+            /* clang-format on */
+
+            encode_ret = pkcs1_v15_encode(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
+            if (SM_OK != encode_ret) {
+                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
+                    return kStatus_SSS_ApduThroughputError;
+                }
+                else {
+                    return kStatus_SSS_Fail;
+                }
+            }
+            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+                context->keyObject->keyId,
+                kSE05x_RSAEncryptionAlgo_NO_PAD,
+                pkcs1v15_encode_data,
+                encode_data_len,
+                signature,
+                signatureLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+        }
+        else if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_NO_HASH) {
+            smStatus_t encode_ret = SM_OK;
+            /* Perform PKCS1-v15 encoding on input data and and RSA decrypt on PKCS1-v15 data --> RSA sign without hash */
+            /* clang-format off */
+            uint8_t pkcs1v15_encode_data[512] = {0,}; /* MAX - SHA512*/
+            size_t encode_data_len = sizeof(pkcs1v15_encode_data);
+            /* clang-format on */
+
+            encode_ret = pkcs1_v15_encode_no_hash(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
+            if (SM_OK != encode_ret) {
+                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
+                    return kStatus_SSS_ApduThroughputError;
+                }
+                else {
+                    return kStatus_SSS_Fail;
+                }
+            }
+            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+                context->keyObject->keyId,
+                kSE05x_RSAEncryptionAlgo_NO_PAD,
+                pkcs1v15_encode_data,
+                encode_data_len,
+                signature,
+                signatureLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+        }
+        else if (context->algorithm == kAlgorithm_SSS_RSASSA_NO_PADDING) {
+            uint8_t padded_data[512] = {0};
+            size_t padded_len        = sizeof(padded_data);
+
+            size_t parsedKeyByteLen      = 0;
+            uint16_t u16parsedKeyByteLen = 0;
+            status = sss_se05x_cached_read_size(context->session, context->keyObject->keyId, &u16parsedKeyByteLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                return kStatus_SSS_ApduThroughputError;
+            }
+            parsedKeyByteLen = u16parsedKeyByteLen;
+            if (status != SM_OK) {
+                return kStatus_SSS_Fail;
+            }
+
+            if (digestLen <= parsedKeyByteLen && digestLen > 0) {
+                memset(padded_data, 0x00, padded_len);
+                memcpy(&padded_data[parsedKeyByteLen - digestLen], &digest[0], digestLen);
+                padded_len = parsedKeyByteLen;
+            }
+            else {
+                return kStatus_SSS_Fail;
+            }
+            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+                context->keyObject->keyId,
+                kSE05x_RSAEncryptionAlgo_NO_PAD,
+                padded_data,
+                padded_len,
+                signature,
+                signatureLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+        }
+        else {
+            LOG_E("Selected padding is not supported for RSA Sign in SE050");
+            return kStatus_SSS_Fail;
+        }
+    } break;
+#endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
+    default:
+        break;
+    }
+
+    if (status == SM_OK) {
         retval = kStatus_SSS_Success;
     }
-    else {
-        LOG_W("Could not delete Key id %X", keyObject->keyId);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
-        }
-    }
-exit:
-    return retval;
-}
 
-void sss_se05x_key_store_context_free(sss_se05x_key_store_t *keyStore)
-{
-    memset(keyStore, 0, sizeof(*keyStore));
+    return retval;
 }
 
-sss_status_t sss_se05x_key_store_export_key(
-    sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject, uint8_t *key, size_t *keylen)
+sss_status_t sss_se05x_session_set_host_hash(sss_se05x_session_t *session, uint8_t enable)
 {
-    sss_status_t retval           = kStatus_SSS_Fail;
-    sss_cipher_type_t cipher_type = (sss_cipher_type_t)keyObject->cipherType;
-    smStatus_t status             = SM_NOT_OK;
-
-    switch (cipher_type) {
-    case kSSS_CipherType_EC_NIST_P:
-#if SSS_HAVE_EC_NIST_K
-    case kSSS_CipherType_EC_NIST_K:
-#endif
-#if SSS_HAVE_EC_BP
-    case kSSS_CipherType_EC_BRAINPOOL:
-#endif
-#if SSS_HAVE_EC_MONT
-    case kSSS_CipherType_EC_MONTGOMERY:
-#endif
-#if SSS_HAVE_EC_ED
-    case kSSS_CipherType_EC_TWISTED_ED:
+    if (session == NULL) {
+        return kStatus_SSS_Fail;
+    }
+#if SSS_HAVE_HOSTCRYPTO_NONE
+    if (enable) {
+        LOG_E("Host hashing needs host crypto");
+        return kStatus_SSS_InvalidArgument;
+    }
+#else
+    if (enable && session->pHostHashSession == NULL) {
+        sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS
+        const sss_type_t host_crypto = kType_SSS_mbedTLS;
+#elif SSS_HAVE_HOSTCRYPTO_OPENSSL
+        const sss_type_t host_crypto = kType_SSS_OpenSSL;
+#else
+        const sss_type_t host_crypto = kType_SSS_SubSystem_NONE;
 #endif
-    case kSSS_CipherType_AES:
-    case kSSS_CipherType_DES: {
-        status =
-            Se05x_API_ExportObject(&keyStore->session->s_ctx, keyObject->keyId, kSE05x_RSAKeyComponent_NA, key, keylen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
+        sss_session_t *pHostSession = (sss_session_t *)SSS_MALLOC(sizeof(*pHostSession));
+        if (pHostSession == NULL) {
+            LOG_E("malloc failed");
+            return kStatus_SSS_Fail;
         }
-        if (status != SM_OK) {
-            goto exit;
+        memset(pHostSession, 0, sizeof(*pHostSession));
+        retval = sss_host_session_open(pHostSession, host_crypto, 0, kSSS_ConnectionType_Plain, NULL);
+        if (retval != kStatus_SSS_Success) {
+            LOG_E("Could not open host session for hashing");
+            SSS_FREE(pHostSession);
+            return retval;
         }
-
-        break;
+        session->pHostHashSession = pHostSession;
     }
+    /* Disabling keeps the host session, it is closed with the SE session */
+    session->hostHash = enable ? 1 : 0;
+#endif
+    return kStatus_SSS_Success;
+}
 
-    default:
-        goto exit;
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+static void sss_se05x_host_hash_session_close(sss_se05x_session_t *session)
+{
+    if (session->pHostHashSession != NULL) {
+        sss_host_session_close(session->pHostHashSession);
+        SSS_FREE(session->pHostHashSession);
+        session->pHostHashSession = NULL;
     }
-
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
+    session->hostHash = 0;
 }
 
-sss_status_t sss_se05x_key_store_import_key(
-    sss_se05x_key_store_t *keyStore, sss_se05x_object_t *keyObject, uint8_t *key, size_t keylen)
+/* Digest algorithm of a signature scheme that can be hashed on the host,
+ * kAlgorithm_None if the message has to go to the SE */
+static sss_algorithm_t sss_se05x_host_hash_algorithm(sss_se05x_asymmetric_t *context)
 {
-    sss_status_t retval           = kStatus_SSS_Fail;
-    sss_cipher_type_t cipher_type = (sss_cipher_type_t)keyObject->cipherType;
-    smStatus_t status             = SM_NOT_OK;
-
-    switch (cipher_type) {
+    switch (context->keyObject->cipherType) {
+    case kSSS_CipherType_RSA:
+    case kSSS_CipherType_RSA_CRT:
     case kSSS_CipherType_EC_NIST_P:
-#if SSS_HAVE_EC_NIST_K
     case kSSS_CipherType_EC_NIST_K:
-#endif
-#if SSS_HAVE_EC_BP
     case kSSS_CipherType_EC_BRAINPOOL:
-#endif
-#if SSS_HAVE_EC_MONT
-    case kSSS_CipherType_EC_MONTGOMERY:
-#endif
-#if SSS_HAVE_EC_ED
-    case kSSS_CipherType_EC_TWISTED_ED:
-#endif
-    case kSSS_CipherType_AES:
-    case kSSS_CipherType_DES: {
-        status =
-            Se05x_API_ImportObject(&keyStore->session->s_ctx, keyObject->keyId, kSE05x_RSAKeyComponent_NA, key, keylen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
-        }
-        if (status != SM_OK) {
-            goto exit;
-        }
-
         break;
+    default:
+        return kAlgorithm_None;
     }
 
+    switch (context->algorithm) {
+    case kAlgorithm_SSS_ECDSA_SHA256:
+    case kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA256:
+    case kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA256:
+        return kAlgorithm_SSS_SHA256;
+    case kAlgorithm_SSS_ECDSA_SHA384:
+    case kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA384:
+    case kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA384:
+        return kAlgorithm_SSS_SHA384;
+    case kAlgorithm_SSS_ECDSA_SHA512:
+    case kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512:
+    case kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512:
+        return kAlgorithm_SSS_SHA512;
     default:
-        goto exit;
+        return kAlgorithm_None;
     }
-
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
 }
 
-/* End: se05x_keystore */
-
-/* ************************************************************************** */
-/* Functions : sss_se05x_asym                                                 */
-/* ************************************************************************** */
-
-sss_status_t sss_se05x_asymmetric_context_init(sss_se05x_asymmetric_t *context,
-    sss_se05x_session_t *session,
-    sss_se05x_object_t *keyObject,
+static sss_status_t sss_se05x_host_hash(sss_se05x_session_t *session,
     sss_algorithm_t algorithm,
-    sss_mode_t mode)
+    const uint8_t *srcData,
+    size_t srcLen,
+    uint8_t *digest,
+    size_t *digestLen)
 {
-    sss_status_t retval = kStatus_SSS_Success;
-    if (context == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    context->session   = session;
-    context->keyObject = keyObject;
-    context->algorithm = algorithm;
-    context->mode      = mode;
+    sss_status_t retval      = kStatus_SSS_Fail;
+    sss_digest_t host_digest = {0};
 
+    ENSURE_OR_GO_EXIT(session->pHostHashSession != NULL);
+
+    retval = sss_digest_context_init(&host_digest, session->pHostHashSession, algorithm, kMode_SSS_Digest);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_digest_one_go(&host_digest, srcData, srcLen, digest, digestLen);
+    sss_digest_context_free(&host_digest);
+exit:
     return retval;
 }
+#endif // !SSS_HAVE_HOSTCRYPTO_NONE
 
-sss_status_t sss_se05x_asymmetric_encrypt(
+sss_status_t sss_se05x_asymmetric_sign(
     sss_se05x_asymmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA
-    smStatus_t status                           = SM_NOT_OK;
-    SE05x_RSAEncryptionAlgo_t rsaEncryptionAlgo = se05x_get_rsa_encrypt_mode(context->algorithm);
-    if (context->keyObject == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    status = Se05x_API_RSAEncrypt(
-        &context->session->s_ctx, context->keyObject->keyId, rsaEncryptionAlgo, srcData, srcLen, destData, destLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-    }
-    else if (status == SM_OK) {
-        retval = kStatus_SSS_Success;
+#if (SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED)
+    smStatus_t status = SM_NOT_OK;
+#endif
+#if SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
+    size_t offset = 0;
+#endif
+
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+    if (context->session->hostHash) {
+        sss_algorithm_t hashAlgo = sss_se05x_host_hash_algorithm(context);
+        if (hashAlgo != kAlgorithm_None) {
+            uint8_t digest[64] = {0};
+            size_t digestLen   = sizeof(digest);
+            retval =
+                sss_se05x_host_hash(context->session, hashAlgo, srcData, srcLen, digest, &digestLen);
+            if (retval != kStatus_SSS_Success) {
+                LOG_E("Host hashing failed");
+                return retval;
+            }
+            return sss_se05x_asymmetric_sign_digest(context, digest, digestLen, destData, destLen);
+        }
     }
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(srcData);
-    AX_UNUSED_ARG(srcLen);
-    AX_UNUSED_ARG(destData);
-    AX_UNUSED_ARG(destLen);
 #endif
-    return retval;
-}
 
-sss_status_t sss_se05x_asymmetric_decrypt(
-    sss_se05x_asymmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
-{
-    sss_status_t retval = kStatus_SSS_Fail;
+    switch (context->keyObject->cipherType) {
 #if SSSFTR_SE05X_RSA && SSS_HAVE_RSA
-    smStatus_t status = SM_NOT_OK;
+    case kSSS_CipherType_RSA:
+    case kSSS_CipherType_RSA_CRT: {
+        SE05x_RSASignatureAlgo_t rsaSigningAlgo = se05x_get_rsa_sign_hash_mode(context->algorithm);
+        uint16_t key_size_bytes                 = 0;
+
+        if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512 ||
+            context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) {
+            status = sss_se05x_cached_read_size(context->session, context->keyObject->keyId, &key_size_bytes);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                return kStatus_SSS_ApduThroughputError;
+            }
+            if (status != SM_OK) {
+                return kStatus_SSS_Fail;
+            }
+
+            if ((key_size_bytes * 8) == 512) {
+                return kStatus_SSS_Fail;
+            }
+        }
+
+        status = Se05x_API_RSASign(
+            &context->session->s_ctx, context->keyObject->keyId, rsaSigningAlgo, srcData, srcLen, destData, destLen);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+        }
+    } break;
+#endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA
+#if SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
+    case kSSS_CipherType_EC_TWISTED_ED: {
+        if (context->algorithm == kAlgorithm_SSS_SHA512) {
+            SE05x_EDSignatureAlgo_t ecSignAlgo = kSE05x_EDSignatureAlgo_ED25519PURE_SHA_512;
+            status                             = Se05x_API_EdDSASign(
+                &context->session->s_ctx, context->keyObject->keyId, ecSignAlgo, srcData, srcLen, destData, destLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+            }
+        }
+
+#ifdef TMP_ENDIAN_VERBOSE_SIGN
+        {
+            printf("Signature before Reverse:\n");
+            for (size_t z = 0; z < *destLen; z++) {
+                printf("%02X.", destData[z]);
+            }
+            printf("\n");
+        }
+#endif
+
+        // Revert Endianness
+        offset = 0;
+
+        for (size_t keyValueIdx = 0; keyValueIdx < (*destLen >> 2); keyValueIdx++) {
+            uint8_t swapByte               = destData[keyValueIdx];
+            destData[offset + keyValueIdx] = destData[offset + (*destLen >> 1) - 1 - keyValueIdx];
+            if (offset + (*destLen >> 1) - 1 - keyValueIdx < *destLen) {
+                destData[offset + (*destLen >> 1) - 1 - keyValueIdx] = swapByte;
+            }
+            else {
+                return kStatus_SSS_Fail;
+            }
+        }
+
+        offset = *destLen >> 1;
+
+        for (size_t keyValueIdx = 0; keyValueIdx < (*destLen >> 2); keyValueIdx++) {
+            uint8_t swapByte = destData[offset + keyValueIdx];
+            if ((SIZE_MAX - offset) < keyValueIdx) {
+                return kStatus_SSS_Fail;
+            }
+            destData[offset + keyValueIdx]                       = destData[offset + (*destLen >> 1) - 1 - keyValueIdx];
+            destData[offset + (*destLen >> 1) - 1 - keyValueIdx] = swapByte;
+        }
+
+#ifdef TMP_ENDIAN_VERBOSE_SIGN
+        {
+            printf("Signature after Reverse:\n");
+            for (size_t z = 0; z < *destLen; z++) {
+                printf("%02X.", destData[z]);
+            }
+            printf("\n");
+        }
+#endif
 
-    SE05x_RSAEncryptionAlgo_t rsaEncryptionAlgo = se05x_get_rsa_encrypt_mode(context->algorithm);
-    if (context->keyObject == NULL) {
-        return retval;
-    }
-    status = Se05x_API_RSADecrypt(
-        &context->session->s_ctx, context->keyObject->keyId, rsaEncryptionAlgo, srcData, srcLen, destData, destLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+    } break;
+#endif // SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
+    default:
+        break;
     }
-    else if (status == SM_OK) {
+
+#if (SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED)
+    // status is set only in case of RSA or ED.
+    if (status == SM_OK) {
         retval = kStatus_SSS_Success;
     }
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(srcData);
-    AX_UNUSED_ARG(srcLen);
-    AX_UNUSED_ARG(destData);
-    AX_UNUSED_ARG(destLen);
 #endif
+
     return retval;
 }
 
-sss_status_t sss_se05x_asymmetric_sign_digest(
-    sss_se05x_asymmetric_t *context, const uint8_t *digest, size_t digestLen, uint8_t *signature, size_t *signatureLen)
+sss_status_t sss_se05x_asymmetric_verify_digest(sss_se05x_asymmetric_t *context,
+    const uint8_t *digest,
+    size_t digestLen,
+    const uint8_t *signature,
+    size_t signatureLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-
-#if SSSFTR_SE05X_ECC
-    SE05x_ECSignatureAlgo_t ecSignAlgo = kSE05x_ECSignatureAlgo_NA;
-#endif
+#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
+    smStatus_t status     = SM_NOT_OK;
+    SE05x_Result_t result = kSE05x_Result_FAILURE;
+#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
 
 #if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
     if (kStatus_SSS_Success != se05x_check_input_len(digestLen, context->algorithm)) {
         LOG_E("Algorithm and digest length do not match");
         return kStatus_SSS_Fail;
     }
-#endif
 
     switch (context->keyObject->cipherType) {
 #if SSSFTR_SE05X_ECC
@@ -5548,176 +6903,205 @@ sss_status_t sss_se05x_asymmetric_sign_digest(
     case kSSS_CipherType_EC_BRAINPOOL:
 #endif
     {
-        ecSignAlgo = se05x_get_ec_sign_hash_mode(context->algorithm);
-        status     = Se05x_API_ECDSASign(&context->session->s_ctx,
+        SE05x_ECSignatureAlgo_t ecSignAlgo = se05x_get_ec_sign_hash_mode(context->algorithm);
+        status                             = Se05x_API_ECDSAVerify(&context->session->s_ctx,
             context->keyObject->keyId,
             ecSignAlgo,
             digest,
             digestLen,
             signature,
-            signatureLen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-        }
+            signatureLen,
+            &result);
     } break;
 #if SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
     case kSSS_CipherType_EC_MONTGOMERY: {
         LOG_W(
-            "Sign operation is not supported for "
+            "Verify operation is not supported for "
             "kSSS_CipherType_EC_MONTGOMERY curve");
         return kStatus_SSS_Fail;
     } break;
 #endif // SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
-#endif //SSSFTR_SE05X_ECC
+#endif // SSSFTR_SE05X_ECC
 #if SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
     case kSSS_CipherType_RSA:
     case kSSS_CipherType_RSA_CRT: {
         if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) &&
             (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA1)) {
-            /* Perform EMSA encoding on input data and and RSA decrypt on emsa data --> RSA sign without hash */
             /* clang-format off */
-            uint8_t emsa_data[512] = {0,}; /* MAX - SHA512*/
-            size_t emsa_len = sizeof(emsa_data);
-            smStatus_t encode_ret = SM_OK;
+            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
+            size_t dec_len = sizeof(dec_data);
             /* clang-format on */
 
-            encode_ret = emsa_encode(context, digest, digestLen, emsa_data, &emsa_len);
-            if (SM_OK != encode_ret) {
-                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
-                    return kStatus_SSS_ApduThroughputError;
-                }
-                else {
-                    return kStatus_SSS_Fail;
-                }
-            }
-            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
                 context->keyObject->keyId,
                 kSE05x_RSAEncryptionAlgo_NO_PAD,
-                emsa_data,
-                emsa_len,
                 signature,
-                signatureLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
+                signatureLen,
+                dec_data,
+                &dec_len);
+            if (status == SM_OK) {
+                if (SM_OK == emsa_decode_and_compare(context, dec_data, dec_len, digest, digestLen)) {
+                    result = kSE05x_Result_SUCCESS;
+                }
             }
         }
         else if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512) &&
                  (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA1)) {
-            smStatus_t encode_ret = SM_OK;
-            /* Perform PKCS1-v15 encoding on input data and and RSA decrypt on PKCS1-v15 data --> RSA sign without hash */
             /* clang-format off */
-            uint8_t pkcs1v15_encode_data[512] = {0,}; /* MAX - SHA512*/
+            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
+            size_t dec_len = sizeof(dec_data);
+            uint8_t pkcs1v15_encode_data[512] = { 0, }; /* MAX - SHA512*/
             size_t encode_data_len = sizeof(pkcs1v15_encode_data);
             /* clang-format on */
 
-            encode_ret = pkcs1_v15_encode(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
-            if (SM_OK != encode_ret) {
-                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
-                    return kStatus_SSS_ApduThroughputError;
-                }
-                else {
-                    return kStatus_SSS_Fail;
-                }
-            }
-            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
                 context->keyObject->keyId,
                 kSE05x_RSAEncryptionAlgo_NO_PAD,
-                pkcs1v15_encode_data,
-                encode_data_len,
                 signature,
-                signatureLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
+                signatureLen,
+                dec_data,
+                &dec_len);
+            if (status == SM_OK) {
+                smStatus_t encode_ret = SM_OK;
+                encode_ret = pkcs1_v15_encode(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
+                if (SM_OK != encode_ret) {
+                    if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
+                        return kStatus_SSS_ApduThroughputError;
+                    }
+                    else {
+                        return kStatus_SSS_Fail;
+                    }
+                }
+
+                if (memcmp(dec_data, pkcs1v15_encode_data, encode_data_len) == 0) {
+                    result = kSE05x_Result_SUCCESS;
+                }
             }
         }
         else if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_NO_HASH) {
-            smStatus_t encode_ret = SM_OK;
-            /* Perform PKCS1-v15 encoding on input data and and RSA decrypt on PKCS1-v15 data --> RSA sign without hash */
             /* clang-format off */
-            uint8_t pkcs1v15_encode_data[512] = {0,}; /* MAX - SHA512*/
+            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
+            size_t dec_len = sizeof(dec_data);
+            uint8_t pkcs1v15_encode_data[512] = { 0, }; /* MAX - SHA512*/
             size_t encode_data_len = sizeof(pkcs1v15_encode_data);
             /* clang-format on */
 
-            encode_ret = pkcs1_v15_encode_no_hash(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
-            if (SM_OK != encode_ret) {
-                if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
-                    return kStatus_SSS_ApduThroughputError;
-                }
-                else {
-                    return kStatus_SSS_Fail;
-                }
-            }
-            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
                 context->keyObject->keyId,
                 kSE05x_RSAEncryptionAlgo_NO_PAD,
-                pkcs1v15_encode_data,
-                encode_data_len,
                 signature,
-                signatureLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
+                signatureLen,
+                dec_data,
+                &dec_len);
+            if (status == SM_OK) {
+                smStatus_t encode_ret = SM_OK;
+                encode_ret =
+                    pkcs1_v15_encode_no_hash(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
+                if (SM_OK != encode_ret) {
+                    if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
+                        return kStatus_SSS_ApduThroughputError;
+                    }
+                    else {
+                        return kStatus_SSS_Fail;
+                    }
+                }
+
+                if (memcmp(dec_data, pkcs1v15_encode_data, encode_data_len) == 0) {
+                    result = kSE05x_Result_SUCCESS;
+                }
             }
         }
         else if (context->algorithm == kAlgorithm_SSS_RSASSA_NO_PADDING) {
-            uint8_t padded_data[512] = {0};
-            size_t padded_len        = sizeof(padded_data);
-
+            uint8_t dec_data[512] = {
+                0,
+            }; /*MAX - RSA4096*/
+            uint8_t padded_data[512]     = {0};
+            size_t dec_len               = sizeof(dec_data);
+            size_t padded_len            = sizeof(padded_data);
             size_t parsedKeyByteLen      = 0;
             uint16_t u16parsedKeyByteLen = 0;
-            status = Se05x_API_ReadSize(&context->session->s_ctx, context->keyObject->keyId, &u16parsedKeyByteLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                return kStatus_SSS_ApduThroughputError;
-            }
-            parsedKeyByteLen = u16parsedKeyByteLen;
-            if (status != SM_OK) {
-                return kStatus_SSS_Fail;
-            }
 
-            if (digestLen <= parsedKeyByteLen && digestLen > 0) {
-                memset(padded_data, 0x00, padded_len);
-                memcpy(&padded_data[parsedKeyByteLen - digestLen], &digest[0], digestLen);
-                padded_len = parsedKeyByteLen;
-            }
-            else {
-                return kStatus_SSS_Fail;
-            }
-            status = Se05x_API_RSADecrypt(&context->session->s_ctx,
+            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
                 context->keyObject->keyId,
                 kSE05x_RSAEncryptionAlgo_NO_PAD,
-                padded_data,
-                padded_len,
                 signature,
-                signatureLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
+                signatureLen,
+                dec_data,
+                &dec_len);
+            if (status == SM_OK) {
+                status = sss_se05x_cached_read_size(context->session, context->keyObject->keyId, &u16parsedKeyByteLen);
+                if (status == SM_OK) {
+                    parsedKeyByteLen = u16parsedKeyByteLen;
+
+                    if (digestLen <= parsedKeyByteLen && digestLen > 0) {
+                        memset(padded_data, 0x00, padded_len);
+                        memcpy(&padded_data[parsedKeyByteLen - digestLen], &digest[0], digestLen);
+                        padded_len = parsedKeyByteLen;
+                    }
+
+                    else {
+                        return kStatus_SSS_Fail;
+                    }
+
+                    if (memcmp(&dec_data[0], &padded_data[0], padded_len) == 0) {
+                        result = kSE05x_Result_SUCCESS;
+                    }
+                }
             }
         }
         else {
             LOG_E("Selected padding is not supported for RSA Sign in SE050");
             return kStatus_SSS_Fail;
         }
+
     } break;
 #endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
     default:
         break;
     }
+#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
 
+#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
     if (status == SM_OK) {
-        retval = kStatus_SSS_Success;
+        if (result == kSE05x_Result_SUCCESS) {
+            retval = kStatus_SSS_Success;
+        }
+    }
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
     }
+#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
 
     return retval;
 }
 
-sss_status_t sss_se05x_asymmetric_sign(
-    sss_se05x_asymmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+sss_status_t sss_se05x_asymmetric_verify(sss_se05x_asymmetric_t *context,
+    const uint8_t *srcData,
+    size_t srcLen,
+    const uint8_t *signature,
+    size_t signatureLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
 #if (SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED)
-    smStatus_t status = SM_NOT_OK;
+    smStatus_t status     = SM_NOT_OK;
+    SE05x_Result_t result = kSE05x_Result_FAILURE;
 #endif
-#if SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
-    size_t offset = 0;
+
+#if !SSS_HAVE_HOSTCRYPTO_NONE
+    if (context->session->hostHash) {
+        sss_algorithm_t hashAlgo = sss_se05x_host_hash_algorithm(context);
+        if (hashAlgo != kAlgorithm_None) {
+            uint8_t digest[64] = {0};
+            size_t digestLen   = sizeof(digest);
+            retval =
+                sss_se05x_host_hash(context->session, hashAlgo, srcData, srcLen, digest, &digestLen);
+            if (retval != kStatus_SSS_Success) {
+                LOG_E("Host hashing failed");
+                return retval;
+            }
+            return sss_se05x_asymmetric_verify_digest(context, digest, digestLen, signature, signatureLen);
+        }
+    }
 #endif
 
     switch (context->keyObject->cipherType) {
@@ -5729,7 +7113,7 @@ sss_status_t sss_se05x_asymmetric_sign(
 
         if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512 ||
             context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) {
-            status = Se05x_API_ReadSize(&context->session->s_ctx, context->keyObject->keyId, &key_size_bytes);
+            status = sss_se05x_cached_read_size(context->session, context->keyObject->keyId, &key_size_bytes);
             if (status == SM_ERR_APDU_THROUGHPUT) {
                 return kStatus_SSS_ApduThroughputError;
             }
@@ -5738,485 +7122,948 @@ sss_status_t sss_se05x_asymmetric_sign(
             }
 
             if ((key_size_bytes * 8) == 512) {
-                return kStatus_SSS_Fail;
-            }
-        }
-
-        status = Se05x_API_RSASign(
-            &context->session->s_ctx, context->keyObject->keyId, rsaSigningAlgo, srcData, srcLen, destData, destLen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
+                return kStatus_SSS_Fail;
+            }
         }
+
+        status = Se05x_API_RSAVerify(&context->session->s_ctx,
+            context->keyObject->keyId,
+            rsaSigningAlgo,
+            srcData,
+            srcLen,
+            signature,
+            signatureLen,
+            &result);
     } break;
 #endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA
 #if SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
     case kSSS_CipherType_EC_TWISTED_ED: {
-        if (context->algorithm == kAlgorithm_SSS_SHA512) {
-            SE05x_EDSignatureAlgo_t ecSignAlgo = kSE05x_EDSignatureAlgo_ED25519PURE_SHA_512;
-            status                             = Se05x_API_EdDSASign(
-                &context->session->s_ctx, context->keyObject->keyId, ecSignAlgo, srcData, srcLen, destData, destLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-            }
-        }
-
-#ifdef TMP_ENDIAN_VERBOSE_SIGN
+#ifdef TMP_ENDIAN_VERBOSE
         {
             printf("Signature before Reverse:\n");
-            for (size_t z = 0; z < *destLen; z++) {
-                printf("%02X.", destData[z]);
+            for (size_t z = 0; z < signatureLen; z++) {
+                printf("%02X.", signature[z]);
             }
             printf("\n");
         }
 #endif
 
         // Revert Endianness
-        offset = 0;
+        uint8_t signature_temp[64] = {0};
+        size_t offset              = 0;
 
-        for (size_t keyValueIdx = 0; keyValueIdx < (*destLen >> 2); keyValueIdx++) {
-            uint8_t swapByte               = destData[keyValueIdx];
-            destData[offset + keyValueIdx] = destData[offset + (*destLen >> 1) - 1 - keyValueIdx];
-            if (offset + (*destLen >> 1) - 1 - keyValueIdx < *destLen) {
-                destData[offset + (*destLen >> 1) - 1 - keyValueIdx] = swapByte;
+        if (signatureLen <= sizeof(signature_temp)) {
+            memcpy(signature_temp, &signature[0], signatureLen);
+        }
+        else {
+            return kStatus_SSS_Fail;
+        }
+
+        for (size_t keyValueIdx = 0; keyValueIdx < (signatureLen >> 2); keyValueIdx++) {
+            uint8_t swapByte = signature_temp[keyValueIdx];
+            if (offset + (signatureLen >> 1) - 1 - keyValueIdx < signatureLen) {
+                signature_temp[offset + keyValueIdx] = signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx];
+                signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx] = swapByte;
             }
             else {
                 return kStatus_SSS_Fail;
             }
         }
 
-        offset = *destLen >> 1;
+        offset = signatureLen >> 1;
 
-        for (size_t keyValueIdx = 0; keyValueIdx < (*destLen >> 2); keyValueIdx++) {
-            uint8_t swapByte = destData[offset + keyValueIdx];
+        for (size_t keyValueIdx = 0; keyValueIdx < (signatureLen >> 2); keyValueIdx++) {
+            uint8_t swapByte = signature_temp[offset + keyValueIdx];
             if ((SIZE_MAX - offset) < keyValueIdx) {
                 return kStatus_SSS_Fail;
             }
-            destData[offset + keyValueIdx]                       = destData[offset + (*destLen >> 1) - 1 - keyValueIdx];
-            destData[offset + (*destLen >> 1) - 1 - keyValueIdx] = swapByte;
+            signature_temp[offset + keyValueIdx] = signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx];
+            if (offset + (signatureLen >> 1) - 1 - keyValueIdx < signatureLen) {
+                signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx] = swapByte;
+            }
+            else {
+                return kStatus_SSS_Fail;
+            }
         }
 
-#ifdef TMP_ENDIAN_VERBOSE_SIGN
+#ifdef TMP_ENDIAN_VERBOSE
         {
             printf("Signature after Reverse:\n");
-            for (size_t z = 0; z < *destLen; z++) {
-                printf("%02X.", destData[z]);
+            for (size_t z = 0; z < signatureLen; z++) {
+                printf("%02X.", signature_temp[z]);
             }
             printf("\n");
         }
 #endif
 
-    } break;
-#endif // SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
-    default:
-        break;
+        if (context->algorithm == kAlgorithm_SSS_SHA512) {
+            SE05x_EDSignatureAlgo_t ecSignAlgo = kSE05x_EDSignatureAlgo_ED25519PURE_SHA_512;
+            status                             = Se05x_API_EdDSAVerify(&context->session->s_ctx,
+                context->keyObject->keyId,
+                ecSignAlgo,
+                srcData,
+                srcLen,
+                signature_temp,
+                signatureLen,
+                &result);
+        }
+    } break;
+#endif // SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
+    default:
+        break;
+    }
+
+#if ((SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED))
+    // status is set only in case of RSA or ED.
+    if (status == SM_OK) {
+        if (result == kSE05x_Result_SUCCESS) {
+            retval = kStatus_SSS_Success;
+        }
+    }
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+    }
+#endif
+
+    return retval;
+}
+
+sss_status_t sss_se05x_asymmetric_sign_digest_batch(sss_se05x_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[])
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    size_t i;
+
+    ENSURE_OR_GO_EXIT(context != NULL);
+    ENSURE_OR_GO_EXIT((count == 0) || ((digests != NULL) && (signatures != NULL) && (signatureLens != NULL)));
+
+    /* The device is reserved for SSS_SE05X_BATCH_ATOMIC_MAX digests at a
+     * time: no interleaving within a run, no starving of other threads */
+    retval = kStatus_SSS_Success;
+    for (i = 0; i < count; i++) {
+        if ((i % SSS_SE05X_BATCH_ATOMIC_MAX) == 0) {
+            if (i > 0) {
+                sss_se05x_end_atomic(context->session);
+            }
+            retval = sss_se05x_begin_atomic(context->session);
+            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        }
+        retval =
+            sss_se05x_asymmetric_sign_digest(context, digests[i], digestLen, signatures[i], &signatureLens[i]);
+        if (retval != kStatus_SSS_Success) {
+            LOG_E("Batch signing failed at digest %u", (unsigned int)i);
+            break;
+        }
+    }
+    if (count > 0) {
+        sss_se05x_end_atomic(context->session);
+    }
+exit:
+    return retval;
+}
+
+sss_status_t sss_se05x_asymmetric_verify_digest_batch(sss_se05x_asymmetric_t *context,
+    uint8_t *digests[],
+    size_t digestLen,
+    size_t count,
+    uint8_t *signatures[],
+    size_t signatureLens[],
+    sss_status_t results[])
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    sss_status_t status = kStatus_SSS_Fail;
+    size_t i;
+
+    ENSURE_OR_GO_EXIT(context != NULL);
+    ENSURE_OR_GO_EXIT((count == 0) || ((digests != NULL) && (signatures != NULL) && (signatureLens != NULL)));
+
+    retval = kStatus_SSS_Success;
+    for (i = 0; i < count; i++) {
+        if ((i % SSS_SE05X_BATCH_ATOMIC_MAX) == 0) {
+            if (i > 0) {
+                sss_se05x_end_atomic(context->session);
+            }
+            status = sss_se05x_begin_atomic(context->session);
+            if (status != kStatus_SSS_Success) {
+                retval = status;
+                goto exit;
+            }
+        }
+        status =
+            sss_se05x_asymmetric_verify_digest(context, digests[i], digestLen, signatures[i], signatureLens[i]);
+        if (results != NULL) {
+            results[i] = status;
+        }
+        if ((status != kStatus_SSS_Success) && (retval == kStatus_SSS_Success)) {
+            retval = status;
+        }
+    }
+    if (count > 0) {
+        sss_se05x_end_atomic(context->session);
+    }
+exit:
+    return retval;
+}
+
+void sss_se05x_asymmetric_context_free(sss_se05x_asymmetric_t *context)
+{
+    memset(context, 0, sizeof(*context));
+}
+
+/* End: se05x_asym */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_lazy                                                 */
+/* ************************************************************************** */
+
+/* Most init/update/finish sequences process a few hundred bytes at most.
+ * Instead of an Init, Update and Final APDU, the input is held back on the
+ * host and sent with one one-shot APDU at finish. Once it grows beyond
+ * SSS_SE05X_LAZY_ONESHOT_MAX, the sequence is started on the SE and
+ * continues streaming. */
+
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+
+struct _sss_se05x_lazy
+{
+    uint8_t iv[CIPHER_BLOCK_SIZE];
+    size_t ivLen;
+    size_t len;
+    /* Room to pad the last block */
+    uint8_t data[SSS_SE05X_LAZY_ONESHOT_MAX + CIPHER_BLOCK_SIZE];
+};
+
+static struct _sss_se05x_lazy *sss_se05x_lazy_alloc(void)
+{
+    struct _sss_se05x_lazy *pLazy = (struct _sss_se05x_lazy *)SSS_MALLOC(sizeof(*pLazy));
+
+    if (pLazy != NULL) {
+        pLazy->ivLen = 0;
+        pLazy->len   = 0;
+    }
+    return pLazy;
+}
+
+static void sss_se05x_lazy_free(struct _sss_se05x_lazy **ppLazy)
+{
+    if (*ppLazy != NULL) {
+        /* May hold plain text */
+        memset(*ppLazy, 0, sizeof(**ppLazy));
+        SSS_FREE(*ppLazy);
+        *ppLazy = NULL;
+    }
+}
+
+/* Hold back data. Returns 0 if it does not fit, the sequence has to stream */
+static uint8_t sss_se05x_lazy_append(struct _sss_se05x_lazy *pLazy, const uint8_t *data, size_t dataLen)
+{
+    if (dataLen > (SSS_SE05X_LAZY_ONESHOT_MAX - pLazy->len)) {
+        return 0;
+    }
+    if (dataLen > 0) {
+        if (data == NULL) {
+            return 0;
+        }
+        memcpy(&pLazy->data[pLazy->len], data, dataLen);
+        pLazy->len += dataLen;
+    }
+    return 1;
+}
+
+#endif /* SSS_SE05X_LAZY_ONESHOT_MAX > 0 */
+
+/* End: se05x_lazy */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_symm                                                 */
+/* ************************************************************************** */
+
+sss_status_t sss_se05x_symmetric_context_init(sss_se05x_symmetric_t *context,
+    sss_se05x_session_t *session,
+    sss_se05x_object_t *keyObject,
+    sss_algorithm_t algorithm,
+    sss_mode_t mode)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+    context->session        = session;
+    context->keyObject      = keyObject;
+    context->algorithm      = algorithm;
+    context->mode           = mode;
+    context->cache_data_len = 0;
+    context->cryptoObjectId = kSE05x_CryptoObject_NA;
+    context->lazy           = 0;
+    context->pLazy          = NULL;
+    return retval;
+}
+
+sss_status_t sss_se05x_symmetric_context_set_lazy(sss_se05x_symmetric_t *context, uint8_t enable)
+{
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    context->lazy = enable ? 1 : 0;
+#else
+    AX_UNUSED_ARG(enable);
+#endif
+    return kStatus_SSS_Success;
+}
+
+sss_status_t sss_se05x_cipher_one_go(sss_se05x_symmetric_t *context,
+    uint8_t *iv,
+    size_t ivLen,
+    const uint8_t *srcData,
+    uint8_t *destData,
+    size_t dataLen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    smStatus_t status             = SM_NOT_OK;
+    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
+    SE05x_Cipher_Oper_OneShot_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
+    size_t blockLenModulus = dataLen % CIPHER_BLOCK_SIZE;
+
+    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    ENSURE_OR_GO_EXIT(
+        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
+
+    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
+        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
+    }
+
+    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
+        context->keyObject->keyId,
+        cipherMode,
+        srcData,
+        dataLen,
+        iv,
+        ivLen,
+        destData,
+        &dataLen,
+        OperType);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+sss_status_t sss_se05x_cipher_one_go_v2(sss_se05x_symmetric_t *context,
+    uint8_t *iv,
+    size_t ivLen,
+    const uint8_t *srcData,
+    const size_t srcLen,
+    uint8_t *destData,
+    size_t *pDataLen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    smStatus_t status             = SM_NOT_OK;
+    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
+    SE05x_Cipher_Oper_OneShot_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
+    size_t blockLenModulus = srcLen % CIPHER_BLOCK_SIZE;
+
+    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    ENSURE_OR_GO_EXIT(
+        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
+
+    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
+        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
     }
 
-#if (SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED)
-    // status is set only in case of RSA or ED.
-    if (status == SM_OK) {
-        retval = kStatus_SSS_Success;
+    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
+        context->keyObject->keyId,
+        cipherMode,
+        srcData,
+        srcLen,
+        iv,
+        ivLen,
+        destData,
+        pDataLen,
+        OperType);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
     }
-#endif
+    ENSURE_OR_GO_EXIT(status == SM_OK);
 
+    retval = kStatus_SSS_Success;
+exit:
     return retval;
 }
 
-sss_status_t sss_se05x_asymmetric_verify_digest(sss_se05x_asymmetric_t *context,
-    const uint8_t *digest,
-    size_t digestLen,
-    const uint8_t *signature,
-    size_t signatureLen)
+static sss_status_t sss_se05x_cipher_init_stream(sss_se05x_symmetric_t *context, uint8_t *iv, size_t ivLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
-    smStatus_t status     = SM_NOT_OK;
-    SE05x_Result_t result = kSE05x_Result_FAILURE;
-#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
+    smStatus_t status;
+    bool atomic = false;
+    //size_t retdataLen = 0;
+    SE05x_Cipher_Oper_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
+    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
 
-#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
-    if (kStatus_SSS_Success != se05x_check_input_len(digestLen, context->algorithm)) {
-        LOG_E("Algorithm and digest length do not match");
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    SE05x_CryptoModeSubType_t subtype;
+    uint8_t created = 0;
+
+    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    ENSURE_OR_GO_EXIT(
+        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)))
+
+    subtype.cipher = (cipherMode == kSE05x_CipherMode_AES_CTR_INT_IV) ? kSE05x_CipherMode_AES_CTR : cipherMode;
+    switch (context->algorithm) {
+    case kAlgorithm_SSS_AES_ECB:
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_ECB_NOPAD;
+        break;
+    case kAlgorithm_SSS_AES_CBC:
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_CBC_NOPAD;
+        break;
+    case kAlgorithm_SSS_AES_CTR:
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_CTR;
+        break;
+    case kAlgorithm_SSS_AES_CTR_INT_IV:
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_CTR_INT_IV;
+        break;
+    case kAlgorithm_SSS_DES_ECB:
+    case kAlgorithm_SSS_DES3_ECB:
+        context->cryptoObjectId = kSE05x_CryptoObject_DES_ECB_NOPAD;
+        break;
+    case kAlgorithm_SSS_DES_CBC:
+    case kAlgorithm_SSS_DES3_CBC:
+        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_NOPAD;
+        break;
+    case kAlgorithm_SSS_DES_CBC_ISO9797_M1:
+    case kAlgorithm_SSS_DES3_CBC_ISO9797_M1:
+        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_ISO9797_M1;
+        break;
+    case kAlgorithm_SSS_DES_CBC_ISO9797_M2:
+    case kAlgorithm_SSS_DES3_CBC_ISO9797_M2:
+        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_ISO9797_M2;
+        break;
+    default:
         return kStatus_SSS_Fail;
     }
 
-    switch (context->keyObject->cipherType) {
-#if SSSFTR_SE05X_ECC
-    case kSSS_CipherType_EC_NIST_P:
-#if SSS_HAVE_EC_NIST_K
-    case kSSS_CipherType_EC_NIST_K:
+    status = sss_se05x_cryptoobj_ensure(
+        context->session, context->cryptoObjectId, kSE05x_CryptoContext_CIPHER, subtype, 0, &created);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        return kStatus_SSS_ApduThroughputError;
+    }
+    if (status != SM_OK) {
+        return kStatus_SSS_Fail;
+    }
 #endif
-#if SSS_HAVE_EC_BP
-    case kSSS_CipherType_EC_BRAINPOOL:
+
+    /* ivLen = 0 for all ECB operations */
+    if (cipherMode == kSE05x_CipherMode_AES_ECB_NOPAD || cipherMode == kSE05x_CipherMode_DES_ECB_NOPAD ||
+        cipherMode == kSE05x_CipherMode_DES_ECB_ISO9797_M1 || cipherMode == kSE05x_CipherMode_DES_ECB_ISO9797_M2) {
+        ivLen = 0;
+    }
+
+    /* Init and a re-created crypto object's second init in one go */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+    status = Se05x_API_CipherInit(
+        &context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, iv, ivLen, OperType);
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    if (sss_se05x_cryptoobj_recover(
+            context->session, context->cryptoObjectId, kSE05x_CryptoContext_CIPHER, subtype, status)) {
+        status = Se05x_API_CipherInit(
+            &context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, iv, ivLen, OperType);
+    }
 #endif
-    {
-        SE05x_ECSignatureAlgo_t ecSignAlgo = se05x_get_ec_sign_hash_mode(context->algorithm);
-        status                             = Se05x_API_ECDSAVerify(&context->session->s_ctx,
-            context->keyObject->keyId,
-            ecSignAlgo,
-            digest,
-            digestLen,
-            signature,
-            signatureLen,
-            &result);
-    } break;
-#if SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
-    case kSSS_CipherType_EC_MONTGOMERY: {
-        LOG_W(
-            "Verify operation is not supported for "
-            "kSSS_CipherType_EC_MONTGOMERY curve");
-        return kStatus_SSS_Fail;
-    } break;
-#endif // SSS_HAVE_SE05X_VER_GTE_07_02 && SSS_HAVE_EC_MONT
-#endif // SSSFTR_SE05X_ECC
-#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
-    case kSSS_CipherType_RSA:
-    case kSSS_CipherType_RSA_CRT: {
-        if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) &&
-            (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA1)) {
-            /* clang-format off */
-            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
-            size_t dec_len = sizeof(dec_data);
-            /* clang-format on */
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
 
-            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
-                context->keyObject->keyId,
-                kSE05x_RSAEncryptionAlgo_NO_PAD,
-                signature,
-                signatureLen,
-                dec_data,
-                &dec_len);
-            if (status == SM_OK) {
-                if (SM_OK == emsa_decode_and_compare(context, dec_data, dec_len, digest, digestLen)) {
-                    result = kSE05x_Result_SUCCESS;
-                }
-            }
-        }
-        else if ((context->algorithm <= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512) &&
-                 (context->algorithm >= kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA1)) {
-            /* clang-format off */
-            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
-            size_t dec_len = sizeof(dec_data);
-            uint8_t pkcs1v15_encode_data[512] = { 0, }; /* MAX - SHA512*/
-            size_t encode_data_len = sizeof(pkcs1v15_encode_data);
-            /* clang-format on */
+    retval = kStatus_SSS_Success;
+exit:
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
+    return retval;
+}
 
-            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
-                context->keyObject->keyId,
-                kSE05x_RSAEncryptionAlgo_NO_PAD,
-                signature,
-                signatureLen,
-                dec_data,
-                &dec_len);
-            if (status == SM_OK) {
-                smStatus_t encode_ret = SM_OK;
-                encode_ret = pkcs1_v15_encode(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
-                if (SM_OK != encode_ret) {
-                    if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
-                        return kStatus_SSS_ApduThroughputError;
-                    }
-                    else {
-                        return kStatus_SSS_Fail;
-                    }
-                }
+sss_status_t sss_se05x_cipher_init(sss_se05x_symmetric_t *context, uint8_t *iv, size_t ivLen)
+{
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
 
-                if (memcmp(dec_data, pkcs1v15_encode_data, encode_data_len) == 0) {
-                    result = kSE05x_Result_SUCCESS;
-                }
+    sss_se05x_lazy_free(&context->pLazy);
+    context->cache_data_len = 0;
+    /* CTR_INT_IV streams: the IV generated by the SE is only returned by init */
+    if (context->lazy && (cipherMode != kSE05x_CipherMode_NA) && (ivLen <= CIPHER_BLOCK_SIZE) &&
+        (context->algorithm != kAlgorithm_SSS_AES_CTR_INT_IV)) {
+        context->pLazy = sss_se05x_lazy_alloc();
+        if (context->pLazy != NULL) {
+            if ((iv != NULL) && (ivLen > 0)) {
+                memcpy(context->pLazy->iv, iv, ivLen);
+                context->pLazy->ivLen = ivLen;
             }
+            return kStatus_SSS_Success;
         }
-        else if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_NO_HASH) {
-            /* clang-format off */
-            uint8_t dec_data[512] = { 0, }; /* MAX - SHA512*/
-            size_t dec_len = sizeof(dec_data);
-            uint8_t pkcs1v15_encode_data[512] = { 0, }; /* MAX - SHA512*/
-            size_t encode_data_len = sizeof(pkcs1v15_encode_data);
-            /* clang-format on */
+    }
+#endif
+    return sss_se05x_cipher_init_stream(context, iv, ivLen);
+}
 
-            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
-                context->keyObject->keyId,
-                kSE05x_RSAEncryptionAlgo_NO_PAD,
-                signature,
-                signatureLen,
-                dec_data,
-                &dec_len);
-            if (status == SM_OK) {
-                smStatus_t encode_ret = SM_OK;
-                encode_ret =
-                    pkcs1_v15_encode_no_hash(context, digest, digestLen, pkcs1v15_encode_data, &encode_data_len);
-                if (SM_OK != encode_ret) {
-                    if (encode_ret == SM_ERR_APDU_THROUGHPUT) {
-                        return kStatus_SSS_ApduThroughputError;
-                    }
-                    else {
-                        return kStatus_SSS_Fail;
-                    }
-                }
+static sss_status_t sss_se05x_cipher_update_stream(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen);
+static sss_status_t sss_se05x_cipher_finish_stream(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen);
 
-                if (memcmp(dec_data, pkcs1v15_encode_data, encode_data_len) == 0) {
-                    result = kSE05x_Result_SUCCESS;
-                }
-            }
-        }
-        else if (context->algorithm == kAlgorithm_SSS_RSASSA_NO_PADDING) {
-            uint8_t dec_data[512] = {
-                0,
-            }; /*MAX - RSA4096*/
-            uint8_t padded_data[512]     = {0};
-            size_t dec_len               = sizeof(dec_data);
-            size_t padded_len            = sizeof(padded_data);
-            size_t parsedKeyByteLen      = 0;
-            uint16_t u16parsedKeyByteLen = 0;
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+/* Input held back is too large for one APDU: start on the SE and stream it.
+ * Output of the held back input goes to destData */
+static sss_status_t sss_se05x_cipher_lazy_spill(sss_se05x_symmetric_t *context, uint8_t *destData, size_t *destLen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    struct _sss_se05x_lazy *pLazy = context->pLazy;
 
-            status = Se05x_API_RSAEncrypt(&context->session->s_ctx,
-                context->keyObject->keyId,
-                kSE05x_RSAEncryptionAlgo_NO_PAD,
-                signature,
-                signatureLen,
-                dec_data,
-                &dec_len);
-            if (status == SM_OK) {
-                status = Se05x_API_ReadSize(&context->session->s_ctx, context->keyObject->keyId, &u16parsedKeyByteLen);
-                if (status == SM_OK) {
-                    parsedKeyByteLen = u16parsedKeyByteLen;
+    context->pLazy = NULL;
+    retval         = sss_se05x_cipher_init_stream(context, pLazy->iv, pLazy->ivLen);
+    if (retval != kStatus_SSS_Success) {
+        *destLen = 0;
+        goto exit;
+    }
+    if (pLazy->len > 0) {
+        retval = sss_se05x_cipher_update_stream(context, pLazy->data, pLazy->len, destData, destLen);
+    }
+    else {
+        *destLen = 0;
+    }
+exit:
+    sss_se05x_lazy_free(&pLazy);
+    return retval;
+}
 
-                    if (digestLen <= parsedKeyByteLen && digestLen > 0) {
-                        memset(padded_data, 0x00, padded_len);
-                        memcpy(&padded_data[parsedKeyByteLen - digestLen], &digest[0], digestLen);
-                        padded_len = parsedKeyByteLen;
-                    }
+static sss_status_t sss_se05x_cipher_lazy_finish(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    struct _sss_se05x_lazy *pLazy = context->pLazy;
+    uint8_t appended              = sss_se05x_lazy_append(pLazy, srcData, srcLen);
+    uint8_t held                  = appended;
+    size_t spillLen               = 0;
+    size_t finishLen              = 0;
+    size_t cipherBlockSize        = CIPHER_BLOCK_SIZE;
 
-                    else {
-                        return kStatus_SSS_Fail;
-                    }
+    if (context->algorithm == kAlgorithm_SSS_DES_ECB || context->algorithm == kAlgorithm_SSS_DES_CBC ||
+        context->algorithm == kAlgorithm_SSS_DES3_ECB || context->algorithm == kAlgorithm_SSS_DES3_CBC) {
+        cipherBlockSize = DES_BLOCK_SIZE;
+    }
 
-                    if (memcmp(&dec_data[0], &padded_data[0], padded_len) == 0) {
-                        result = kSE05x_Result_SUCCESS;
-                    }
-                }
-            }
+    if (held && ((pLazy->len % cipherBlockSize) != 0)) {
+        if (context->algorithm == kAlgorithm_SSS_AES_ECB || context->algorithm == kAlgorithm_SSS_AES_CBC) {
+            /* Zero padded, as by sss_se05x_cipher_finish when streaming */
+            memset(&pLazy->data[pLazy->len], 0, cipherBlockSize - (pLazy->len % cipherBlockSize));
+            pLazy->len += cipherBlockSize - (pLazy->len % cipherBlockSize);
         }
-        else {
-            LOG_E("Selected padding is not supported for RSA Sign in SE050");
-            return kStatus_SSS_Fail;
+        else if ((context->algorithm == kAlgorithm_SSS_AES_CTR) ||
+                 (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
+            /* One shot CTR takes full blocks only */
+            held = 0;
         }
-
-    } break;
-#endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA && !SSS_HAVE_HOSTCRYPTO_NONE
-    default:
-        break;
     }
-#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
 
-#if SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
-    if (status == SM_OK) {
-        if (result == kSE05x_Result_SUCCESS) {
-            retval = kStatus_SSS_Success;
+    if (held) {
+        if (pLazy->len == 0) {
+            *destLen = 0;
+            retval   = kStatus_SSS_Success;
         }
+        else if (*destLen < pLazy->len) {
+            LOG_E("Output buffer not sufficient");
+            *destLen = 0;
+        }
+        else {
+            retval = sss_se05x_cipher_one_go_v2(
+                context, pLazy->iv, pLazy->ivLen, pLazy->data, pLazy->len, destData, destLen);
+        }
+        sss_se05x_lazy_free(&context->pLazy);
+        return retval;
     }
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-    }
-#endif // SSSFTR_SE05X_ECC || SSSFTR_SE05X_RSA
 
+    /* Stream what is held back, then finish as usual */
+    spillLen = *destLen;
+    retval   = sss_se05x_cipher_lazy_spill(context, destData, &spillLen);
+    if (retval != kStatus_SSS_Success) {
+        *destLen = 0;
+        return retval;
+    }
+    finishLen = *destLen - spillLen;
+    retval    = sss_se05x_cipher_finish_stream(
+        context, appended ? NULL : srcData, appended ? 0 : srcLen, destData + spillLen, &finishLen);
+    *destLen = (retval == kStatus_SSS_Success) ? (spillLen + finishLen) : 0;
     return retval;
 }
+#endif /* SSS_SE05X_LAZY_ONESHOT_MAX > 0 */
 
-sss_status_t sss_se05x_asymmetric_verify(sss_se05x_asymmetric_t *context,
-    const uint8_t *srcData,
-    size_t srcLen,
-    const uint8_t *signature,
-    size_t signatureLen)
+sss_status_t sss_se05x_cipher_update(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
 {
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
     sss_status_t retval = kStatus_SSS_Fail;
-#if (SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED)
-    smStatus_t status     = SM_NOT_OK;
-    SE05x_Result_t result = kSE05x_Result_FAILURE;
+    size_t spillLen     = 0;
+    size_t updateLen    = 0;
+
+    if (context->pLazy != NULL) {
+        if (destLen == NULL) {
+            return kStatus_SSS_Fail;
+        }
+        if (sss_se05x_lazy_append(context->pLazy, srcData, srcLen)) {
+            *destLen = 0;
+            return kStatus_SSS_Success;
+        }
+        spillLen = *destLen;
+        retval   = sss_se05x_cipher_lazy_spill(context, destData, &spillLen);
+        if (retval != kStatus_SSS_Success) {
+            *destLen = 0;
+            return retval;
+        }
+        updateLen = *destLen - spillLen;
+        retval    = sss_se05x_cipher_update_stream(context, srcData, srcLen, destData + spillLen, &updateLen);
+        *destLen  = (retval == kStatus_SSS_Success) ? (spillLen + updateLen) : 0;
+        return retval;
+    }
 #endif
+    return sss_se05x_cipher_update_stream(context, srcData, srcLen, destData, destLen);
+}
 
-    switch (context->keyObject->cipherType) {
-#if SSSFTR_SE05X_RSA && SSS_HAVE_RSA
-    case kSSS_CipherType_RSA:
-    case kSSS_CipherType_RSA_CRT: {
-        SE05x_RSASignatureAlgo_t rsaSigningAlgo = se05x_get_rsa_sign_hash_mode(context->algorithm);
-        uint16_t key_size_bytes                 = 0;
+static sss_status_t sss_se05x_cipher_update_stream(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+    sss_status_t retval    = kStatus_SSS_Fail;
+    smStatus_t status      = SM_NOT_OK;
+    size_t inputData_len   = 0;
+    size_t src_offset      = 0;
+    size_t output_offset   = 0;
+    size_t blockoutLen     = 0;
+    size_t outBuffSize     = 0;
+    size_t cipherBlockSize = CIPHER_BLOCK_SIZE;
+    bool atomic            = false;
+    const uint8_t *pInput  = NULL;
+    uint8_t coalesced[CIPHER_UPDATE_MAX_CHUNK];
 
-        if (context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_V1_5_SHA512 ||
-            context->algorithm == kAlgorithm_SSS_RSASSA_PKCS1_PSS_MGF1_SHA512) {
-            status = Se05x_API_ReadSize(&context->session->s_ctx, context->keyObject->keyId, &key_size_bytes);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                return kStatus_SSS_ApduThroughputError;
+    if (context->algorithm == kAlgorithm_SSS_DES_ECB || context->algorithm == kAlgorithm_SSS_DES_CBC ||
+        context->algorithm == kAlgorithm_SSS_DES3_ECB || context->algorithm == kAlgorithm_SSS_DES3_CBC) {
+        cipherBlockSize = DES_BLOCK_SIZE;
+    }
+
+    ENSURE_OR_GO_EXIT(srcData != NULL);
+    ENSURE_OR_GO_EXIT(destData != NULL);
+    ENSURE_OR_GO_EXIT(destLen != NULL);
+    ENSURE_OR_GO_EXIT(srcLen > 0);
+
+    outBuffSize = *destLen;
+
+    /* Check overflow */
+    ENSURE_OR_GO_EXIT((context->cache_data_len + srcLen) >= context->cache_data_len);
+
+    if ((context->cache_data_len + srcLen) < cipherBlockSize) {
+        /* Insufficinet data to process . Cache the data */
+        memcpy((context->cache_data + context->cache_data_len), srcData, srcLen);
+        context->cache_data_len = context->cache_data_len + srcLen;
+        *destLen                = 0;
+        return kStatus_SSS_Success;
+    }
+    else {
+        /* All chunks of this update are sent in one go */
+        ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+        atomic = true;
+
+        while (context->cache_data_len + (srcLen - src_offset) >= cipherBlockSize) {
+            size_t rem_srcData = context->cache_data_len + (srcLen - src_offset);
+
+            if (rem_srcData > CIPHER_UPDATE_MAX_CHUNK) {
+                inputData_len = CIPHER_UPDATE_MAX_CHUNK;
             }
-            if (status != SM_OK) {
-                return kStatus_SSS_Fail;
+            else {
+                inputData_len = rem_srcData - (rem_srcData % cipherBlockSize);
             }
 
-            if ((key_size_bytes * 8) == 512) {
-                return kStatus_SSS_Fail;
+            if (context->cache_data_len > 0) {
+                /* Complete the cached tail with new input, in the same APDU */
+                memcpy(coalesced, context->cache_data, context->cache_data_len);
+                memcpy((coalesced + context->cache_data_len),
+                    (srcData + src_offset),
+                    (inputData_len - context->cache_data_len));
+                src_offset += inputData_len - context->cache_data_len;
+                context->cache_data_len = 0;
+                pInput                  = coalesced;
+            }
+            else {
+                pInput = srcData + src_offset;
+                src_offset += inputData_len;
             }
-        }
 
-        status = Se05x_API_RSAVerify(&context->session->s_ctx,
-            context->keyObject->keyId,
-            rsaSigningAlgo,
-            srcData,
-            srcLen,
-            signature,
-            signatureLen,
-            &result);
-    } break;
-#endif // SSSFTR_SE05X_RSA && SSS_HAVE_RSA
-#if SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
-    case kSSS_CipherType_EC_TWISTED_ED: {
-#ifdef TMP_ENDIAN_VERBOSE
-        {
-            printf("Signature before Reverse:\n");
-            for (size_t z = 0; z < signatureLen; z++) {
-                printf("%02X.", signature[z]);
+            blockoutLen = outBuffSize;
+            status      = Se05x_API_CipherUpdate(&context->session->s_ctx,
+                context->cryptoObjectId,
+                pInput,
+                inputData_len,
+                (destData + output_offset),
+                &blockoutLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
             }
-            printf("\n");
+            ENSURE_OR_GO_EXIT(status == SM_OK);
+
+            outBuffSize -= blockoutLen;
+            output_offset += blockoutLen;
         }
-#endif
 
-        // Revert Endianness
-        uint8_t signature_temp[64] = {0};
-        size_t offset              = 0;
+        *destLen = output_offset;
 
-        if (signatureLen <= sizeof(signature_temp)) {
-            memcpy(signature_temp, &signature[0], signatureLen);
+        /* Copy unprocessed data to cache */
+        if ((srcLen - src_offset) > 0) {
+            memcpy(context->cache_data, (srcData + src_offset), (srcLen - src_offset));
+            context->cache_data_len = (srcLen - src_offset);
         }
-        else {
-            return kStatus_SSS_Fail;
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
+    if (retval != kStatus_SSS_Success) {
+        if (destLen) {
+            *destLen = 0;
         }
+    }
+    return retval;
+}
 
-        for (size_t keyValueIdx = 0; keyValueIdx < (signatureLen >> 2); keyValueIdx++) {
-            uint8_t swapByte = signature_temp[keyValueIdx];
-            if (offset + (signatureLen >> 1) - 1 - keyValueIdx < signatureLen) {
-                signature_temp[offset + keyValueIdx] = signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx];
-                signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx] = swapByte;
-            }
-            else {
-                return kStatus_SSS_Fail;
-            }
+sss_status_t sss_se05x_cipher_finish(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    if (context->pLazy != NULL) {
+        if (destLen == NULL) {
+            return kStatus_SSS_Fail;
         }
+        return sss_se05x_cipher_lazy_finish(context, srcData, srcLen, destData, destLen);
+    }
+#endif
+    return sss_se05x_cipher_finish_stream(context, srcData, srcLen, destData, destLen);
+}
 
-        offset = signatureLen >> 1;
+static sss_status_t sss_se05x_cipher_finish_stream(
+    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+{
+    sss_status_t retval                            = kStatus_SSS_Fail;
+    smStatus_t status                              = SM_NOT_OK;
+    uint8_t srcdata_updated[2 * CIPHER_BLOCK_SIZE] = {
+        0,
+    };
+    size_t srcdata_updated_len = 0;
+    size_t cipherBlockSize     = CIPHER_BLOCK_SIZE;
 
-        for (size_t keyValueIdx = 0; keyValueIdx < (signatureLen >> 2); keyValueIdx++) {
-            uint8_t swapByte = signature_temp[offset + keyValueIdx];
-            if ((SIZE_MAX - offset) < keyValueIdx) {
-                return kStatus_SSS_Fail;
-            }
-            signature_temp[offset + keyValueIdx] = signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx];
-            if (offset + (signatureLen >> 1) - 1 - keyValueIdx < signatureLen) {
-                signature_temp[offset + (signatureLen >> 1) - 1 - keyValueIdx] = swapByte;
-            }
-            else {
-                return kStatus_SSS_Fail;
-            }
-        }
+    if (context->algorithm == kAlgorithm_SSS_DES_ECB || context->algorithm == kAlgorithm_SSS_DES_CBC ||
+        context->algorithm == kAlgorithm_SSS_DES3_ECB || context->algorithm == kAlgorithm_SSS_DES3_CBC) {
+        cipherBlockSize = DES_BLOCK_SIZE;
+    }
+    ENSURE_OR_GO_EXIT(destLen != NULL);
 
-#ifdef TMP_ENDIAN_VERBOSE
-        {
-            printf("Signature after Reverse:\n");
-            for (size_t z = 0; z < signatureLen; z++) {
-                printf("%02X.", signature_temp[z]);
+    if (srcLen > cipherBlockSize) {
+        LOG_E("srcLen cannot be grater than 16 bytes. Call update function ");
+        *destLen = 0;
+        goto exit;
+    }
+
+    if (context->cache_data_len != 0) {
+        memcpy(srcdata_updated, context->cache_data, context->cache_data_len);
+        srcdata_updated_len     = context->cache_data_len;
+        context->cache_data_len = 0;
+    }
+    if (srcLen != 0) {
+        ENSURE_OR_GO_EXIT(srcData != NULL);
+        memcpy((srcdata_updated + srcdata_updated_len), srcData, srcLen);
+        srcdata_updated_len += srcLen;
+    }
+
+    if (context->algorithm == kAlgorithm_SSS_AES_ECB || context->algorithm == kAlgorithm_SSS_AES_CBC) {
+        if (srcdata_updated_len > 0) {
+            if (srcdata_updated_len % cipherBlockSize != 0) {
+                srcdata_updated_len = srcdata_updated_len + (cipherBlockSize - (srcdata_updated_len % cipherBlockSize));
             }
-            printf("\n");
         }
-#endif
+    }
 
-        if (context->algorithm == kAlgorithm_SSS_SHA512) {
-            SE05x_EDSignatureAlgo_t ecSignAlgo = kSE05x_EDSignatureAlgo_ED25519PURE_SHA_512;
-            status                             = Se05x_API_EdDSAVerify(&context->session->s_ctx,
-                context->keyObject->keyId,
-                ecSignAlgo,
-                srcData,
-                srcLen,
-                signature_temp,
-                signatureLen,
-                &result);
-        }
-    } break;
-#endif // SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED
-    default:
-        break;
+    if (*destLen < srcdata_updated_len) {
+        LOG_E("Output buffer not sufficient");
+        goto exit;
     }
 
-#if ((SSSFTR_SE05X_RSA && SSS_HAVE_RSA) || (SSSFTR_SE05X_ECC && SSS_HAVE_EC_ED))
-    // status is set only in case of RSA or ED.
-    if (status == SM_OK) {
-        if (result == kSE05x_Result_SUCCESS) {
-            retval = kStatus_SSS_Success;
-        }
+    status = Se05x_API_CipherFinal(
+        &context->session->s_ctx, context->cryptoObjectId, srcdata_updated, srcdata_updated_len, destData, destLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
+    }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+sss_status_t sss_se05x_cipher_crypt_ctr(sss_se05x_symmetric_t *context,
+    const uint8_t *srcData,
+    uint8_t *destData,
+    size_t size,
+    uint8_t *initialCounter,
+    uint8_t *lastEncryptedCounter,
+    size_t *szLeft)
+{
+    sss_status_t retval           = kStatus_SSS_Fail;
+    smStatus_t status             = SM_NOT_OK;
+    size_t outputDataLen          = size;
+    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
+    SE05x_Cipher_Oper_OneShot_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
+    size_t blockLenModulus = size % CIPHER_BLOCK_SIZE;
+
+    AX_UNUSED_ARG(lastEncryptedCounter);
+    AX_UNUSED_ARG(szLeft);
+
+    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    ENSURE_OR_GO_EXIT(
+        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
+
+    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
+        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
     }
+
+    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
+        context->keyObject->keyId,
+        cipherMode,
+        srcData,
+        size,
+        initialCounter,
+        16,
+        destData,
+        &outputDataLen,
+        OperType);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
     }
-#endif
+    ENSURE_OR_GO_EXIT(status == SM_OK);
 
+    retval = kStatus_SSS_Success;
+exit:
     return retval;
 }
 
-void sss_se05x_asymmetric_context_free(sss_se05x_asymmetric_t *context)
+void sss_se05x_symmetric_context_free(sss_se05x_symmetric_t *context)
 {
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    sss_se05x_lazy_free(&context->pLazy);
+#endif
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    smStatus_t status;
+    uint8_t object_exists = 0;
+
+    if ((context->cryptoObjectId != 0) && !sss_se05x_cryptoobj_keep(context->session, context->cryptoObjectId)) {
+        status = sss_se05x_cryptoobj_read(context->session, context->cryptoObjectId, &object_exists);
+        if (object_exists) {
+            status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
+            if (status != SM_OK) {
+                LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
+                return;
+            }
+            sss_se05x_cryptoobj_record(context->session, context->cryptoObjectId, 0);
+        }
+    }
+#endif
     memset(context, 0, sizeof(*context));
 }
 
-/* End: se05x_asym */
+/* End: se05x_symm */
 
 /* ************************************************************************** */
-/* Functions : sss_se05x_symm                                                 */
+/* Functions : sss_se05x_aead                                                 */
 /* ************************************************************************** */
 
-sss_status_t sss_se05x_symmetric_context_init(sss_se05x_symmetric_t *context,
+sss_status_t sss_se05x_aead_context_init(sss_se05x_aead_t *context,
     sss_se05x_session_t *session,
     sss_se05x_object_t *keyObject,
     sss_algorithm_t algorithm,
     sss_mode_t mode)
 {
-    sss_status_t retval = kStatus_SSS_Success;
+    sss_status_t retval = kStatus_SSS_Fail;
     if (context == NULL) {
         return kStatus_SSS_Fail;
     }
-    context->session        = session;
-    context->keyObject      = keyObject;
-    context->algorithm      = algorithm;
-    context->mode           = mode;
-    context->cache_data_len = 0;
+    context->session   = session;
+    context->keyObject = keyObject;
+    if ((algorithm == kAlgorithm_SSS_AES_CCM) || (algorithm == kAlgorithm_SSS_AES_GCM) ||
+        (algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) || (algorithm == kAlgorithm_SSS_AES_CCM_INT_IV)) {
+        context->algorithm = algorithm;
+    }
+    else {
+        LOG_E("Improper Algorithm provided!!!");
+        goto exit;
+    }
+    context->mode = mode;
+    retval        = kStatus_SSS_Success;
+exit:
     return retval;
 }
 
-sss_status_t sss_se05x_cipher_one_go(sss_se05x_symmetric_t *context,
-    uint8_t *iv,
-    size_t ivLen,
+sss_status_t sss_se05x_aead_one_go(sss_se05x_aead_t *context,
     const uint8_t *srcData,
     uint8_t *destData,
-    size_t dataLen)
+    size_t size,
+    uint8_t *nonce,
+    size_t nonceLen,
+    const uint8_t *aad,
+    size_t aadLen,
+    uint8_t *tag,
+    size_t *tagLen)
 {
-    sss_status_t retval           = kStatus_SSS_Fail;
-    smStatus_t status             = SM_NOT_OK;
-    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    smStatus_t status  = SM_NOT_OK;
+    size_t destDataLen = size;
+    SE05x_CipherMode_t cipherMode =
+        (context->algorithm == kAlgorithm_SSS_AES_GCM) ? kSE05x_CipherMode_AES_GCM : kSE05x_CipherMode_AES_GCM_INT_IV;
     SE05x_Cipher_Oper_OneShot_t OperType =
         (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
-    size_t blockLenModulus = dataLen % CIPHER_BLOCK_SIZE;
 
-    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    // Not support decrypt with internal IV.
     ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
-
-    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
-        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
-    }
+        !((context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
 
-    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
+    ENSURE_OR_GO_EXIT(context->keyObject != NULL);
+    status = Se05x_API_AeadOneShot(&context->session->s_ctx,
         context->keyObject->keyId,
         cipherMode,
         srcData,
-        dataLen,
-        iv,
-        ivLen,
+        size,
+        aad,
+        aadLen,
+        nonce,
+        nonceLen,
+        tag,
+        tagLen,
         destData,
-        &dataLen,
+        &destDataLen,
         OperType);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
@@ -6226,42 +8073,122 @@ sss_status_t sss_se05x_cipher_one_go(sss_se05x_symmetric_t *context,
 
     retval = kStatus_SSS_Success;
 exit:
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(srcData);
+    AX_UNUSED_ARG(destData);
+    AX_UNUSED_ARG(size);
+    AX_UNUSED_ARG(nonce);
+    AX_UNUSED_ARG(nonceLen);
+    AX_UNUSED_ARG(aad);
+    AX_UNUSED_ARG(aadLen);
+    AX_UNUSED_ARG(tag);
+    AX_UNUSED_ARG(tagLen);
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_cipher_one_go_v2(sss_se05x_symmetric_t *context,
-    uint8_t *iv,
-    size_t ivLen,
-    const uint8_t *srcData,
-    const size_t srcLen,
-    uint8_t *destData,
-    size_t *pDataLen)
+sss_status_t sss_se05x_aead_init(
+    sss_se05x_aead_t *context, uint8_t *nonce, size_t nonceLen, size_t tagLen, size_t aadLen, size_t payloadLen)
 {
-    sss_status_t retval           = kStatus_SSS_Fail;
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
     smStatus_t status             = SM_NOT_OK;
-    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
-    SE05x_Cipher_Oper_OneShot_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
-    size_t blockLenModulus = srcLen % CIPHER_BLOCK_SIZE;
+    SE05x_CipherMode_t cipherMode = kSE05x_CipherMode_NA;
+    SE05x_Cipher_Oper_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
+    bool atomic = false;
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    SE05x_CryptoModeSubType_t subtype;
+    uint8_t created = 0;
+    uint8_t attempt;
+#endif
 
-    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
+    context->cache_data_len = 0;
+
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    // Not support decrypt with internal IV.
     ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
+        !((context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)));
+    ENSURE_OR_GO_EXIT(
+        !((context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)));
 
-    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
-        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
+    if (context->algorithm == kAlgorithm_SSS_AES_GCM) {
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_GCM;
+        subtype.aead            = kSE05x_AeadGCMAlgo;
+    }
+    else if (context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) {
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_GCM_INT_IV;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+        subtype.aead = kSE05x_AeadGCMAlgo;
+#else
+        subtype.aead = kSE05x_AeadGCM_IVAlgo;
+#endif
+    }
+    else if (context->algorithm == kAlgorithm_SSS_AES_CCM) {
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_CCM;
+        subtype.aead            = kSE05x_AeadCCMAlgo;
+    }
+    else if (context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV) {
+        context->cryptoObjectId = kSE05x_CryptoObject_AES_CCM_INT_IV;
+        subtype.aead            = kSE05x_AeadCCMAlgo;
+    }
+    else {
+        goto exit;
+    }
+    status = sss_se05x_cryptoobj_ensure(
+        context->session, context->cryptoObjectId, kSE05x_CryptoContext_AEAD, subtype, 0, &created);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        return kStatus_SSS_ApduThroughputError;
+    }
+    if (status != SM_OK) {
+        LOG_W("CreateCryptoObject Failed");
+        return kStatus_SSS_Fail;
+    }
+#endif
+    memset(context->cache_data, 0x00, sizeof(context->cache_data));
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    /* Second attempt only if the crypto object had to be re-created */
+    for (attempt = 0; attempt < 2; attempt++) {
+#endif
+        if ((context->algorithm == (kAlgorithm_SSS_AES_GCM)) ||
+            (context->algorithm == (kAlgorithm_SSS_AES_GCM_INT_IV))) {
+            cipherMode = (context->algorithm == kAlgorithm_SSS_AES_GCM) ? kSE05x_CipherMode_AES_GCM :
+                                                                          kSE05x_CipherMode_AES_GCM_INT_IV;
+            status     = Se05x_API_AeadInit(&context->session->s_ctx,
+                context->keyObject->keyId,
+                cipherMode,
+                context->cryptoObjectId,
+                nonce,
+                nonceLen,
+                OperType);
+        }
+        else {
+            cipherMode = (context->algorithm == kAlgorithm_SSS_AES_CCM) ? kSE05x_CipherMode_AES_CCM :
+                                                                          kSE05x_CipherMode_AES_CCM_INT_IV;
+            status     = Se05x_API_AeadCCMInit(&context->session->s_ctx,
+                context->keyObject->keyId,
+                cipherMode,
+                context->cryptoObjectId,
+                nonce,
+                nonceLen,
+                aadLen,
+                payloadLen,
+                tagLen,
+                OperType);
+        }
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+        if ((attempt > 0) || !sss_se05x_cryptoobj_recover(context->session,
+                                 context->cryptoObjectId,
+                                 kSE05x_CryptoContext_AEAD,
+                                 subtype,
+                                 status)) {
+            break;
+        }
     }
-
-    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
-        context->keyObject->keyId,
-        cipherMode,
-        srcData,
-        srcLen,
-        iv,
-        ivLen,
-        destData,
-        pDataLen,
-        OperType);
+#endif
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -6270,123 +8197,79 @@ sss_status_t sss_se05x_cipher_one_go_v2(sss_se05x_symmetric_t *context,
 
     retval = kStatus_SSS_Success;
 exit:
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(nonce);
+    AX_UNUSED_ARG(nonceLen);
+    AX_UNUSED_ARG(tagLen);
+    AX_UNUSED_ARG(aadLen);
+    AX_UNUSED_ARG(payloadLen);
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_cipher_init(sss_se05x_symmetric_t *context, uint8_t *iv, size_t ivLen)
+sss_status_t sss_se05x_aead_update_aad(sss_se05x_aead_t *context, const uint8_t *aadData, size_t aadDataLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status;
-    //size_t retdataLen = 0;
-    SE05x_Cipher_Oper_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
-    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
-
-#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
-    SE05x_CryptoModeSubType_t subtype;
-    uint8_t list[1024] = {
-        0,
-    };
-    size_t listlen = sizeof(list);
-    size_t i;
-    uint8_t create_crypto_obj = 1;
-
-    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
-    ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)))
-
-    subtype.cipher = (cipherMode == kSE05x_CipherMode_AES_CTR_INT_IV) ? kSE05x_CipherMode_AES_CTR : cipherMode;
-    switch (context->algorithm) {
-    case kAlgorithm_SSS_AES_ECB:
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_ECB_NOPAD;
-        break;
-    case kAlgorithm_SSS_AES_CBC:
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_CBC_NOPAD;
-        break;
-    case kAlgorithm_SSS_AES_CTR:
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_CTR;
-        break;
-    case kAlgorithm_SSS_AES_CTR_INT_IV:
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_CTR_INT_IV;
-        break;
-    case kAlgorithm_SSS_DES_ECB:
-    case kAlgorithm_SSS_DES3_ECB:
-        context->cryptoObjectId = kSE05x_CryptoObject_DES_ECB_NOPAD;
-        break;
-    case kAlgorithm_SSS_DES_CBC:
-    case kAlgorithm_SSS_DES3_CBC:
-        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_NOPAD;
-        break;
-    case kAlgorithm_SSS_DES_CBC_ISO9797_M1:
-    case kAlgorithm_SSS_DES3_CBC_ISO9797_M1:
-        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_ISO9797_M1;
-        break;
-    case kAlgorithm_SSS_DES_CBC_ISO9797_M2:
-    case kAlgorithm_SSS_DES3_CBC_ISO9797_M2:
-        context->cryptoObjectId = kSE05x_CryptoObject_DES_CBC_ISO9797_M2;
-        break;
-    default:
-        return kStatus_SSS_Fail;
-    }
-
-    status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        return kStatus_SSS_ApduThroughputError;
-    }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-    for (i = 0; i < listlen; i += 4) {
-        uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-        if (cryptoObjectId == context->cryptoObjectId) {
-            create_crypto_obj = 0;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    smStatus_t status = SM_NOT_OK;
+    size_t src_offset = 0;
+    if (aadDataLen > AEAD_BLOCK_SIZE) {
+        while ((aadDataLen - src_offset) >= AEAD_BLOCK_SIZE) {
+            /*For the subsequent blocks which are of block size 16*/
+            status = Se05x_API_AeadUpdate_aad(
+                &context->session->s_ctx, context->cryptoObjectId, (aadData + src_offset), AEAD_BLOCK_SIZE);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
+            }
+            ENSURE_OR_GO_EXIT(status == SM_OK);
+            src_offset += AEAD_BLOCK_SIZE;
+        }
+        if ((aadDataLen - src_offset) > 0) {
+            /*For the subsequent blocks which are yet to process*/
+            status = Se05x_API_AeadUpdate_aad(
+                &context->session->s_ctx, context->cryptoObjectId, (aadData + src_offset), (aadDataLen - src_offset));
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
+            }
+            ENSURE_OR_GO_EXIT(status == SM_OK);
         }
     }
-
-    if (create_crypto_obj) {
-        status = Se05x_API_CreateCryptoObject(
-            &context->session->s_ctx, context->cryptoObjectId, kSE05x_CryptoContext_CIPHER, subtype);
+    else {
+        status = Se05x_API_AeadUpdate_aad(&context->session->s_ctx, context->cryptoObjectId, aadData, aadDataLen);
         if (status == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
-        }
-        if (status != SM_OK) {
-            return kStatus_SSS_Fail;
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
         }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
     }
-#endif
-
-    /* ivLen = 0 for all ECB operations */
-    if (cipherMode == kSE05x_CipherMode_AES_ECB_NOPAD || cipherMode == kSE05x_CipherMode_DES_ECB_NOPAD ||
-        cipherMode == kSE05x_CipherMode_DES_ECB_ISO9797_M1 || cipherMode == kSE05x_CipherMode_DES_ECB_ISO9797_M2) {
-        ivLen = 0;
-    }
-
-    status = Se05x_API_CipherInit(
-        &context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, iv, ivLen, OperType);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        return kStatus_SSS_ApduThroughputError;
-    }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-
     retval = kStatus_SSS_Success;
 exit:
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(aadData);
+    AX_UNUSED_ARG(aadDataLen);
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_cipher_update(
-    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+sss_status_t sss_se05x_aead_update(
+    sss_se05x_aead_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
 {
-    sss_status_t retval    = kStatus_SSS_Fail;
-    smStatus_t status      = SM_NOT_OK;
-    size_t inputData_len   = 0;
-    size_t src_offset      = 0;
-    size_t output_offset   = 0;
-    size_t blockoutLen     = 0;
-    size_t outBuffSize     = 0;
-    size_t cipherBlockSize = CIPHER_BLOCK_SIZE;
-
-    if (context->algorithm == kAlgorithm_SSS_DES_ECB || context->algorithm == kAlgorithm_SSS_DES_CBC ||
-        context->algorithm == kAlgorithm_SSS_DES3_ECB || context->algorithm == kAlgorithm_SSS_DES3_CBC) {
-        cipherBlockSize = DES_BLOCK_SIZE;
-    }
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    smStatus_t status    = SM_NOT_OK;
+    size_t inputData_len = 0;
+    size_t src_offset    = 0;
+    size_t output_offset = 0;
+    size_t outBuffSize   = 0;
+    size_t blockoutLen   = 0;
+    bool atomic          = false;
 
     ENSURE_OR_GO_EXIT(srcData != NULL);
     ENSURE_OR_GO_EXIT(destData != NULL);
@@ -6396,9 +8279,10 @@ sss_status_t sss_se05x_cipher_update(
     outBuffSize = *destLen;
 
     /* Check overflow */
+    ENSURE_OR_GO_EXIT((SIZE_MAX - context->cache_data_len) >= srcLen);
     ENSURE_OR_GO_EXIT((context->cache_data_len + srcLen) >= context->cache_data_len);
 
-    if ((context->cache_data_len + srcLen) < cipherBlockSize) {
+    if ((context->cache_data_len + srcLen) < AEAD_BLOCK_SIZE) {
         /* Insufficinet data to process . Cache the data */
         memcpy((context->cache_data + context->cache_data_len), srcData, srcLen);
         context->cache_data_len = context->cache_data_len + srcLen;
@@ -6406,18 +8290,22 @@ sss_status_t sss_se05x_cipher_update(
         return kStatus_SSS_Success;
     }
     else {
+        /* All chunks of this update are sent in one go */
+        ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+        atomic = true;
+
         if (context->cache_data_len > 0) {
-            if (cipherBlockSize - context->cache_data_len > 0) {
+            if (CIPHER_BLOCK_SIZE - context->cache_data_len > 0) {
                 memcpy((context->cache_data + context->cache_data_len),
                     srcData,
-                    (cipherBlockSize - context->cache_data_len));
+                    (CIPHER_BLOCK_SIZE - context->cache_data_len));
             }
 
             blockoutLen = outBuffSize;
-            status      = Se05x_API_CipherUpdate(&context->session->s_ctx,
+            status      = Se05x_API_AeadUpdate(&context->session->s_ctx,
                 context->cryptoObjectId,
                 context->cache_data,
-                cipherBlockSize,
+                CIPHER_BLOCK_SIZE,
                 destData,
                 &blockoutLen);
             if (status == SM_ERR_APDU_THROUGHPUT) {
@@ -6426,25 +8314,25 @@ sss_status_t sss_se05x_cipher_update(
             }
             ENSURE_OR_GO_EXIT(status == SM_OK);
 
-            src_offset = cipherBlockSize - context->cache_data_len;
+            src_offset = CIPHER_BLOCK_SIZE - context->cache_data_len;
             outBuffSize -= blockoutLen;
             output_offset += blockoutLen;
 
             context->cache_data_len = 0;
         }
 
-        while (srcLen - src_offset >= cipherBlockSize) {
+        while (srcLen - src_offset >= CIPHER_BLOCK_SIZE) {
             size_t rem_srcData = srcLen - src_offset;
 
-            if (rem_srcData > CIPHER_UPDATE_MAX_DATA) {
-                inputData_len = CIPHER_UPDATE_MAX_DATA;
+            if (rem_srcData > AEAD_UPDATE_MAX_DATA) {
+                inputData_len = AEAD_UPDATE_MAX_DATA;
             }
             else {
-                inputData_len = rem_srcData - (rem_srcData % cipherBlockSize);
+                inputData_len = rem_srcData - (rem_srcData % CIPHER_BLOCK_SIZE);
             }
 
             blockoutLen = outBuffSize;
-            status      = Se05x_API_CipherUpdate(&context->session->s_ctx,
+            status      = Se05x_API_AeadUpdate(&context->session->s_ctx,
                 context->cryptoObjectId,
                 (srcData + src_offset),
                 inputData_len,
@@ -6460,363 +8348,459 @@ sss_status_t sss_se05x_cipher_update(
             outBuffSize -= blockoutLen;
             output_offset += blockoutLen;
         }
-
-        *destLen = output_offset;
-
-        /* Copy unprocessed data to cache */
-        if ((srcLen - src_offset) > 0) {
-            memcpy(context->cache_data, (srcData + src_offset), (srcLen - src_offset));
-            context->cache_data_len = (srcLen - src_offset);
+
+        *destLen = output_offset;
+
+        /* Copy unprocessed data to cache */
+        if ((srcLen - src_offset) > 0) {
+            memcpy(context->cache_data, (srcData + src_offset), (srcLen - src_offset));
+            context->cache_data_len = (srcLen - src_offset);
+        }
+    }
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
+    if (retval != kStatus_SSS_Success) {
+        if (destLen) {
+            *destLen = 0;
+        }
+    }
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(srcData);
+    AX_UNUSED_ARG(srcLen);
+    AX_UNUSED_ARG(destData);
+    AX_UNUSED_ARG(destLen);
+#endif
+    return retval;
+}
+
+sss_status_t sss_se05x_aead_finish(sss_se05x_aead_t *context,
+    const uint8_t *srcData,
+    size_t srcLen,
+    uint8_t *destData,
+    size_t *destLen,
+    uint8_t *tag,
+    size_t *tagLen)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+    smStatus_t status = SM_NOT_OK;
+
+    SE05x_Cipher_Oper_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
+    uint8_t srcdata_updated[2 * CIPHER_BLOCK_SIZE] = {
+        0,
+    };
+    size_t srcdata_updated_len = 0;
+    bool atomic                = false;
+
+    if (srcLen > CIPHER_BLOCK_SIZE) {
+        LOG_E("srcLen cannot be grater than 16 bytes. Call update function ");
+        if (destLen != NULL) {
+            *destLen = 0;
+        }
+        goto exit;
+    }
+
+    /* The last update and the final in one go */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+
+    if ((context->algorithm == kAlgorithm_SSS_AES_CCM) || (context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV)) {
+        retval = sss_se05x_aead_CCMfinish(context, srcData, srcLen, destData, destLen, tag, tagLen);
+    }
+    else {
+        if (context->cache_data_len != 0) {
+            memcpy(srcdata_updated, context->cache_data, context->cache_data_len);
+            srcdata_updated_len = context->cache_data_len;
+        }
+        if (srcLen != 0) {
+            ENSURE_OR_GO_EXIT(srcData != NULL);
+            memcpy((srcdata_updated + srcdata_updated_len), srcData, srcLen);
+            srcdata_updated_len += srcLen;
+        }
+        if (srcdata_updated_len > 0) {
+            status = Se05x_API_AeadUpdate(&context->session->s_ctx,
+                context->cryptoObjectId,
+                srcdata_updated,
+                srcdata_updated_len,
+                destData,
+                destLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
+            }
+            ENSURE_OR_GO_EXIT(status == SM_OK);
+        }
+        else {
+            /* This condition will occur if all data including cache is alread processed */
+            LOG_D("No Data in cache, All data are already processed");
+            *destLen = 0;
+        }
+        status = Se05x_API_AeadFinal(&context->session->s_ctx, context->cryptoObjectId, tag, tagLen, OperType);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
         }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
+        retval = kStatus_SSS_Success;
     }
-
-    retval = kStatus_SSS_Success;
 exit:
-    if (retval != kStatus_SSS_Success) {
-        if (destLen) {
-            *destLen = 0;
-        }
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
     }
+#else
+    AX_UNUSED_ARG(context);
+    AX_UNUSED_ARG(srcData);
+    AX_UNUSED_ARG(srcLen);
+    AX_UNUSED_ARG(destData);
+    AX_UNUSED_ARG(destLen);
+    AX_UNUSED_ARG(tag);
+    AX_UNUSED_ARG(tagLen);
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_cipher_finish(
-    sss_se05x_symmetric_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+#if SSS_HAVE_SE05X_VER_GTE_07_02
+static sss_status_t sss_se05x_aead_CCMfinish(sss_se05x_aead_t *context,
+    const uint8_t *srcData,
+    size_t srcLen,
+    uint8_t *destData,
+    size_t *destLen,
+    uint8_t *tag,
+    size_t *tagLen)
 {
-    sss_status_t retval                            = kStatus_SSS_Fail;
-    smStatus_t status                              = SM_NOT_OK;
+    sss_status_t retval   = kStatus_SSS_Fail;
+    smStatus_t status     = SM_NOT_OK;
+    uint8_t dataprocessed = 1;
+    SE05x_Cipher_Oper_t OperType =
+        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
     uint8_t srcdata_updated[2 * CIPHER_BLOCK_SIZE] = {
         0,
     };
     size_t srcdata_updated_len = 0;
-    size_t cipherBlockSize     = CIPHER_BLOCK_SIZE;
-
-    if (context->algorithm == kAlgorithm_SSS_DES_ECB || context->algorithm == kAlgorithm_SSS_DES_CBC ||
-        context->algorithm == kAlgorithm_SSS_DES3_ECB || context->algorithm == kAlgorithm_SSS_DES3_CBC) {
-        cipherBlockSize = DES_BLOCK_SIZE;
-    }
-    ENSURE_OR_GO_EXIT(destLen != NULL);
-
-    if (srcLen > cipherBlockSize) {
-        LOG_E("srcLen cannot be grater than 16 bytes. Call update function ");
-        *destLen = 0;
-        goto exit;
-    }
+    size_t outLen              = 0;
+    size_t tempoutLen          = 0;
+    size_t destBufLen          = *destLen;
 
     if (context->cache_data_len != 0) {
         memcpy(srcdata_updated, context->cache_data, context->cache_data_len);
-        srcdata_updated_len     = context->cache_data_len;
-        context->cache_data_len = 0;
+        srcdata_updated_len = context->cache_data_len;
     }
     if (srcLen != 0) {
-        ENSURE_OR_GO_EXIT(srcData != NULL);
         memcpy((srcdata_updated + srcdata_updated_len), srcData, srcLen);
         srcdata_updated_len += srcLen;
     }
+    if (srcdata_updated_len > 0) {
+        if (srcdata_updated_len < CIPHER_BLOCK_SIZE) {
+            status = Se05x_API_AeadCCMLastUpdate(
+                &context->session->s_ctx, context->cryptoObjectId, srcdata_updated, srcdata_updated_len);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
+            }
+            ENSURE_OR_GO_EXIT(status == SM_OK);
+            dataprocessed = 0;
+        }
+        else if (srcdata_updated_len >= CIPHER_BLOCK_SIZE) {
+            tempoutLen = destBufLen - outLen;
+            status     = Se05x_API_AeadUpdate(&context->session->s_ctx,
+                context->cryptoObjectId,
+                srcdata_updated,
+                CIPHER_BLOCK_SIZE,
+                destData,
+                &tempoutLen);
+            if (status == SM_ERR_APDU_THROUGHPUT) {
+                retval = kStatus_SSS_ApduThroughputError;
+                goto exit;
+            }
+            ENSURE_OR_GO_EXIT(status == SM_OK);
+            srcdata_updated_len = srcdata_updated_len - CIPHER_BLOCK_SIZE;
+            outLen              = outLen + tempoutLen;
 
-    if (context->algorithm == kAlgorithm_SSS_AES_ECB || context->algorithm == kAlgorithm_SSS_AES_CBC) {
-        if (srcdata_updated_len > 0) {
-            if (srcdata_updated_len % cipherBlockSize != 0) {
-                srcdata_updated_len = srcdata_updated_len + (cipherBlockSize - (srcdata_updated_len % cipherBlockSize));
+            /* Put the remaining data in CCMLastUpdate if present (will always be less than CIPHER_BLOCK_SIZE) */
+            if (srcdata_updated_len) {
+                status = Se05x_API_AeadCCMLastUpdate(&context->session->s_ctx,
+                    context->cryptoObjectId,
+                    srcdata_updated + CIPHER_BLOCK_SIZE,
+                    srcdata_updated_len);
+                if (status == SM_ERR_APDU_THROUGHPUT) {
+                    retval = kStatus_SSS_ApduThroughputError;
+                    goto exit;
+                }
+                ENSURE_OR_GO_EXIT(status == SM_OK);
+                dataprocessed = 0;
             }
         }
     }
-
-    if (*destLen < srcdata_updated_len) {
-        LOG_E("Output buffer not sufficient");
-        goto exit;
+    else {
+        /* This condition will occur if all data including
+        cache is already processed just send final*/
+        dataprocessed = 1;
     }
 
-    status = Se05x_API_CipherFinal(
-        &context->session->s_ctx, context->cryptoObjectId, srcdata_updated, srcdata_updated_len, destData, destLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-        goto exit;
+    if (dataprocessed == 0) {
+        /*All data is updated, lastupdate datalen < 16 o/p
+          is expected here */
+        tempoutLen = destBufLen - outLen;
+        status     = Se05x_API_AeadCCMFinal(
+            &context->session->s_ctx, context->cryptoObjectId, (destData + outLen), &tempoutLen, tag, tagLen, OperType);
+        outLen = outLen + tempoutLen;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
-}
-
-sss_status_t sss_se05x_cipher_crypt_ctr(sss_se05x_symmetric_t *context,
-    const uint8_t *srcData,
-    uint8_t *destData,
-    size_t size,
-    uint8_t *initialCounter,
-    uint8_t *lastEncryptedCounter,
-    size_t *szLeft)
-{
-    sss_status_t retval           = kStatus_SSS_Fail;
-    smStatus_t status             = SM_NOT_OK;
-    size_t outputDataLen          = size;
-    SE05x_CipherMode_t cipherMode = se05x_get_cipher_mode(context->algorithm);
-    SE05x_Cipher_Oper_OneShot_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
-    size_t blockLenModulus = size % CIPHER_BLOCK_SIZE;
-
-    AX_UNUSED_ARG(lastEncryptedCounter);
-    AX_UNUSED_ARG(szLeft);
-
-    ENSURE_OR_GO_EXIT(cipherMode != kSE05x_CipherMode_NA);
-    ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
-
-    if ((context->algorithm == kAlgorithm_SSS_AES_CTR) || (context->algorithm == kAlgorithm_SSS_AES_CTR_INT_IV)) {
-        ENSURE_OR_GO_EXIT(blockLenModulus == 0);
+    else {
+        /*All data is processed no destination data*/
+        status = Se05x_API_AeadFinal(&context->session->s_ctx, context->cryptoObjectId, tag, tagLen, OperType);
     }
-
-    status = Se05x_API_CipherOneShot(&context->session->s_ctx,
-        context->keyObject->keyId,
-        cipherMode,
-        srcData,
-        size,
-        initialCounter,
-        16,
-        destData,
-        &outputDataLen,
-        OperType);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
     }
     ENSURE_OR_GO_EXIT(status == SM_OK);
-
-    retval = kStatus_SSS_Success;
+    retval   = kStatus_SSS_Success;
+    *destLen = outLen;
 exit:
     return retval;
 }
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
 
-void sss_se05x_symmetric_context_free(sss_se05x_symmetric_t *context)
+void sss_se05x_aead_context_free(sss_se05x_aead_t *context)
 {
+#if SSS_HAVE_SE05X_VER_GTE_07_02
 #if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
     smStatus_t status;
-    uint8_t list[1024] = {
-        0,
-    };
     uint8_t object_exists = 0;
-    size_t listlen        = sizeof(list);
-
-    if (context->cryptoObjectId != 0) {
-        status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
-        for (size_t i = 0; i < listlen; i += 4) {
-            uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-            if (cryptoObjectId == context->cryptoObjectId) {
-                object_exists = 1;
-            }
-        }
 
+    if ((context->cryptoObjectId != 0) && !sss_se05x_cryptoobj_keep(context->session, context->cryptoObjectId)) {
+        status = sss_se05x_cryptoobj_read(context->session, context->cryptoObjectId, &object_exists);
         if (object_exists) {
             status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
             if (status != SM_OK) {
                 LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
                 return;
             }
+            sss_se05x_cryptoobj_record(context->session, context->cryptoObjectId, 0);
         }
     }
-#endif
+#endif /* SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ */
     memset(context, 0, sizeof(*context));
+#else
+    AX_UNUSED_ARG(context);
+#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
 }
 
-/* End: se05x_symm */
+/* End: se05x_aead */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_mac                                                  */
+/* ************************************************************************** */
+
+sss_status_t sss_se05x_mac_context_init(sss_se05x_mac_t *context,
+    sss_se05x_session_t *session,
+    sss_se05x_object_t *keyObject,
+    sss_algorithm_t algorithm,
+    sss_mode_t mode)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+    context->session        = session;
+    context->keyObject      = keyObject;
+    context->algorithm      = algorithm;
+    context->mode           = mode;
+    context->cryptoObjectId = kSE05x_CryptoObject_NA;
+    context->lazy           = 0;
+    context->pLazy          = NULL;
+    return retval;
+}
+
+sss_status_t sss_se05x_mac_context_set_lazy(sss_se05x_mac_t *context, uint8_t enable)
+{
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    context->lazy = enable ? 1 : 0;
+#else
+    AX_UNUSED_ARG(enable);
+#endif
+    return kStatus_SSS_Success;
+}
+
+sss_status_t sss_se05x_mac_one_go(
+    sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen, uint8_t *mac, size_t *macLen)
+{
+    sss_status_t retval          = kStatus_SSS_Fail;
+    smStatus_t status            = SM_NOT_OK;
+    SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
+
+    ENSURE_OR_GO_EXIT(message != NULL);
+    ENSURE_OR_GO_EXIT(mac != NULL);
+    ENSURE_OR_GO_EXIT(macLen != NULL);
+
+    ENSURE_OR_GO_EXIT(macOperation != kSE05x_MACAlgo_NA);
+
+    if (context->mode == kMode_SSS_Mac) {
+        status = Se05x_API_MACOneShot_G(
+            &context->session->s_ctx, context->keyObject->keyId, macOperation, message, messageLen, mac, macLen);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
+    }
+    else if (context->mode == kMode_SSS_Mac_Validate) {
+        SE05x_Result_t result = kSE05x_Result_FAILURE;
+        size_t result_size    = sizeof(result);
 
-/* ************************************************************************** */
-/* Functions : sss_se05x_aead                                                 */
-/* ************************************************************************** */
+        status = Se05x_API_MACOneShot_V(&context->session->s_ctx,
+            context->keyObject->keyId,
+            macOperation,
+            message,
+            messageLen,
+            mac,
+            *macLen,
+            (uint8_t *)&result,
+            &result_size);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
 
-sss_status_t sss_se05x_aead_context_init(sss_se05x_aead_t *context,
-    sss_se05x_session_t *session,
-    sss_se05x_object_t *keyObject,
-    sss_algorithm_t algorithm,
-    sss_mode_t mode)
-{
-    sss_status_t retval = kStatus_SSS_Fail;
-    if (context == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    context->session   = session;
-    context->keyObject = keyObject;
-    if ((algorithm == kAlgorithm_SSS_AES_CCM) || (algorithm == kAlgorithm_SSS_AES_GCM) ||
-        (algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) || (algorithm == kAlgorithm_SSS_AES_CCM_INT_IV)) {
-        context->algorithm = algorithm;
+        ENSURE_OR_GO_EXIT(result == kSE05x_Result_SUCCESS);
     }
     else {
-        LOG_E("Improper Algorithm provided!!!");
+        LOG_E("Unknown mode");
         goto exit;
     }
-    context->mode = mode;
-    retval        = kStatus_SSS_Success;
+
+    retval = kStatus_SSS_Success;
 exit:
     return retval;
 }
 
-sss_status_t sss_se05x_aead_one_go(sss_se05x_aead_t *context,
-    const uint8_t *srcData,
-    uint8_t *destData,
-    size_t size,
-    uint8_t *nonce,
-    size_t nonceLen,
-    const uint8_t *aad,
-    size_t aadLen,
-    uint8_t *tag,
-    size_t *tagLen)
+sss_status_t sss_se05x_mac_validate_one_go(
+    sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen, uint8_t *mac, size_t macLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    smStatus_t status  = SM_NOT_OK;
-    size_t destDataLen = size;
-    SE05x_CipherMode_t cipherMode =
-        (context->algorithm == kAlgorithm_SSS_AES_GCM) ? kSE05x_CipherMode_AES_GCM : kSE05x_CipherMode_AES_GCM_INT_IV;
-    SE05x_Cipher_Oper_OneShot_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_OneShot_Encrypt : kSE05x_Cipher_Oper_OneShot_Decrypt;
+    smStatus_t status   = SM_NOT_OK;
+    SE05x_MACAlgo_t macOperation;
+    SE05x_Result_t result = kSE05x_Result_FAILURE;
+    size_t result_size    = sizeof(result);
 
-    // Not support decrypt with internal IV.
-    ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_OneShot_Decrypt)));
+    if (context == NULL) {
+        goto exit;
+    }
 
-    ENSURE_OR_GO_EXIT(context->keyObject != NULL);
-    status = Se05x_API_AeadOneShot(&context->session->s_ctx,
+    macOperation = se05x_get_mac_algo(context->algorithm);
+
+    ENSURE_OR_GO_EXIT(macOperation != kSE05x_MACAlgo_NA);
+
+    status = Se05x_API_MACOneShot_V(&context->session->s_ctx,
         context->keyObject->keyId,
-        cipherMode,
-        srcData,
-        size,
-        aad,
-        aadLen,
-        nonce,
-        nonceLen,
-        tag,
-        tagLen,
-        destData,
-        &destDataLen,
-        OperType);
+        macOperation,
+        message,
+        messageLen,
+        mac,
+        macLen,
+        (uint8_t *)&result,
+        &result_size);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
+    if (status == SM_OK) {
+        if (result == kSE05x_Result_SUCCESS) {
+            retval = kStatus_SSS_Success;
+        }
+    }
 
-    retval = kStatus_SSS_Success;
 exit:
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(srcData);
-    AX_UNUSED_ARG(destData);
-    AX_UNUSED_ARG(size);
-    AX_UNUSED_ARG(nonce);
-    AX_UNUSED_ARG(nonceLen);
-    AX_UNUSED_ARG(aad);
-    AX_UNUSED_ARG(aadLen);
-    AX_UNUSED_ARG(tag);
-    AX_UNUSED_ARG(tagLen);
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_aead_init(
-    sss_se05x_aead_t *context, uint8_t *nonce, size_t nonceLen, size_t tagLen, size_t aadLen, size_t payloadLen)
+static sss_status_t sss_se05x_mac_init_stream(sss_se05x_mac_t *context)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    smStatus_t status             = SM_NOT_OK;
-    SE05x_CipherMode_t cipherMode = kSE05x_CipherMode_NA;
-    SE05x_Cipher_Oper_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
+    sss_status_t retval       = kStatus_SSS_Fail;
+    smStatus_t status         = SM_NOT_OK;
+    SE05x_Mac_Oper_t operType = kSE05x_Mac_Oper_NA;
+    bool atomic               = false;
 #if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
     SE05x_CryptoModeSubType_t subtype;
-    uint8_t list[1024] = {
-        0,
-    };
-    size_t listlen = sizeof(list);
-    size_t i;
-    uint8_t create_crypto_obj = 1;
-#endif
-
-    context->cache_data_len = 0;
-
-#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
-    // Not support decrypt with internal IV.
-    ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)));
-    ENSURE_OR_GO_EXIT(
-        !((context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV) && (OperType == kSE05x_Cipher_Oper_Decrypt)));
+    uint8_t created = 0;
+    SE05x_CryptoContext_t cryptoContext;
 
-    if (context->algorithm == kAlgorithm_SSS_AES_GCM) {
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_GCM;
-        subtype.aead            = kSE05x_AeadGCMAlgo;
-    }
-    else if (context->algorithm == kAlgorithm_SSS_AES_GCM_INT_IV) {
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_GCM_INT_IV;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-        subtype.aead = kSE05x_AeadGCMAlgo;
-#else
-        subtype.aead = kSE05x_AeadGCM_IVAlgo;
+    switch (context->algorithm) {
+    case kAlgorithm_SSS_CMAC_AES:
+        subtype.mac             = kSE05x_MACAlgo_CMAC_128;
+        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
+        context->cryptoObjectId = kSE05x_CryptoObject_CMAC_128;
+        break;
+#if SSS_HAVE_HASH_1
+    case kAlgorithm_SSS_HMAC_SHA1:
+        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA1;
+        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
+        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA1;
+        break;
 #endif
+    case kAlgorithm_SSS_HMAC_SHA256:
+        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA256;
+        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
+        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA256;
+        break;
+    case kAlgorithm_SSS_HMAC_SHA384:
+        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA384;
+        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
+        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA384;
+        break;
+#if SSS_HAVE_HASH_512
+    case kAlgorithm_SSS_HMAC_SHA512:
+        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA512;
+        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
+        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA512;
+        break;
+#endif
+    default:
+        return kStatus_SSS_Fail;
     }
-    else if (context->algorithm == kAlgorithm_SSS_AES_CCM) {
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_CCM;
-        subtype.aead            = kSE05x_AeadCCMAlgo;
-    }
-    else if (context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV) {
-        context->cryptoObjectId = kSE05x_CryptoObject_AES_CCM_INT_IV;
-        subtype.aead            = kSE05x_AeadCCMAlgo;
-    }
-    else {
-        goto exit;
-    }
-    status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
+
+    status = sss_se05x_cryptoobj_ensure(
+        context->session, context->cryptoObjectId, cryptoContext, subtype, 0, &created);
     if (status == SM_ERR_APDU_THROUGHPUT) {
         return kStatus_SSS_ApduThroughputError;
     }
-    for (i = 0; i < listlen; i += 4) {
-        uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-        if (cryptoObjectId == context->cryptoObjectId) {
-            create_crypto_obj = 0;
-        }
-    }
-
-    if (create_crypto_obj) {
-        status = Se05x_API_CreateCryptoObject(
-            &context->session->s_ctx, context->cryptoObjectId, kSE05x_CryptoContext_AEAD, subtype);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
-        }
-        if (status != SM_OK) {
-            return kStatus_SSS_Fail;
-        }
-    }
-
     if (status != SM_OK) {
         LOG_W("CreateCryptoObject Failed");
         return kStatus_SSS_Fail;
     }
 #endif
-    memset(context->cache_data, 0x00, sizeof(context->cache_data));
-    if ((context->algorithm == (kAlgorithm_SSS_AES_GCM)) || (context->algorithm == (kAlgorithm_SSS_AES_GCM_INT_IV))) {
-        cipherMode = (context->algorithm == kAlgorithm_SSS_AES_GCM) ? kSE05x_CipherMode_AES_GCM :
-                                                                      kSE05x_CipherMode_AES_GCM_INT_IV;
-        status     = Se05x_API_AeadInit(&context->session->s_ctx,
-            context->keyObject->keyId,
-            cipherMode,
-            context->cryptoObjectId,
-            nonce,
-            nonceLen,
-            OperType);
+
+    if (context->mode == kMode_SSS_Mac) {
+        operType = kSE05x_Mac_Oper_Generate;
+    }
+    else if (context->mode == kMode_SSS_Mac_Validate) {
+        operType = kSE05x_Mac_Oper_Validate;
     }
     else {
-        cipherMode = (context->algorithm == kAlgorithm_SSS_AES_CCM) ? kSE05x_CipherMode_AES_CCM :
-                                                                      kSE05x_CipherMode_AES_CCM_INT_IV;
-        status     = Se05x_API_AeadCCMInit(&context->session->s_ctx,
-            context->keyObject->keyId,
-            cipherMode,
-            context->cryptoObjectId,
-            nonce,
-            nonceLen,
-            aadLen,
-            payloadLen,
-            tagLen,
-            OperType);
+        LOG_E("Unknown mode");
+        goto exit;
     }
+
+    /* Init and a re-created crypto object's second init in one go */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+    status = Se05x_API_MACInit(&context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, operType);
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    if (sss_se05x_cryptoobj_recover(context->session, context->cryptoObjectId, cryptoContext, subtype, status)) {
+        status =
+            Se05x_API_MACInit(&context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, operType);
+    }
+#endif
     if (status == SM_ERR_APDU_THROUGHPUT) {
         retval = kStatus_SSS_ApduThroughputError;
         goto exit;
@@ -6825,847 +8809,1161 @@ sss_status_t sss_se05x_aead_init(
 
     retval = kStatus_SSS_Success;
 exit:
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(nonce);
-    AX_UNUSED_ARG(nonceLen);
-    AX_UNUSED_ARG(tagLen);
-    AX_UNUSED_ARG(aadLen);
-    AX_UNUSED_ARG(payloadLen);
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
+    return retval;
+}
+
+sss_status_t sss_se05x_mac_init(sss_se05x_mac_t *context)
+{
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    sss_se05x_lazy_free(&context->pLazy);
+    if (context->lazy && (se05x_get_mac_algo(context->algorithm) != kSE05x_MACAlgo_NA) &&
+        ((context->mode == kMode_SSS_Mac) || (context->mode == kMode_SSS_Mac_Validate))) {
+        /* Sent with MACOneShot at finish, or started on the SE once it grows */
+        context->pLazy = sss_se05x_lazy_alloc();
+        if (context->pLazy != NULL) {
+            return kStatus_SSS_Success;
+        }
+    }
+#endif
+    return sss_se05x_mac_init_stream(context);
+}
+
+sss_status_t sss_se05x_mac_update(sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    size_t offset       = 0;
+    size_t chunk        = 0;
+    bool atomic         = false;
+
+    //SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
+
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    if (context->pLazy != NULL) {
+        struct _sss_se05x_lazy *pLazy = context->pLazy;
+
+        if (sss_se05x_lazy_append(pLazy, message, messageLen)) {
+            return kStatus_SSS_Success;
+        }
+        /* Too large for one APDU, continue streaming */
+        context->pLazy = NULL;
+        retval         = sss_se05x_mac_init_stream(context);
+        if ((retval == kStatus_SSS_Success) && (pLazy->len > 0)) {
+            status = Se05x_API_MACUpdate(&context->session->s_ctx, pLazy->data, pLazy->len, context->cryptoObjectId);
+            retval = (status == SM_OK) ? kStatus_SSS_Success :
+                                         ((status == SM_ERR_APDU_THROUGHPUT) ? kStatus_SSS_ApduThroughputError :
+                                                                               kStatus_SSS_Fail);
+        }
+        sss_se05x_lazy_free(&pLazy);
+        if (retval != kStatus_SSS_Success) {
+            goto exit;
+        }
+        retval = kStatus_SSS_Fail;
+    }
+#endif
+
+    ENSURE_OR_GO_EXIT((message != NULL) || (messageLen == 0));
+
+    /* Split to what fits one APDU. All chunks of this update are sent in one go */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+    do {
+        chunk  = ((messageLen - offset) > DIGEST_UPDATE_MAX_CHUNK) ? DIGEST_UPDATE_MAX_CHUNK : (messageLen - offset);
+        status = Se05x_API_MACUpdate(&context->session->s_ctx, message + offset, chunk, context->cryptoObjectId);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
+        }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
+        offset += chunk;
+    } while (offset < messageLen);
+
+    retval = kStatus_SSS_Success;
+exit:
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
     return retval;
 }
 
-sss_status_t sss_se05x_aead_update_aad(sss_se05x_aead_t *context, const uint8_t *aadData, size_t aadDataLen)
+sss_status_t sss_se05x_mac_finish(sss_se05x_mac_t *context, uint8_t *mac, size_t *macLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    smStatus_t status = SM_NOT_OK;
-    size_t src_offset = 0;
-    if (aadDataLen > AEAD_BLOCK_SIZE) {
-        while ((aadDataLen - src_offset) >= AEAD_BLOCK_SIZE) {
-            /*For the subsequent blocks which are of block size 16*/
-            status = Se05x_API_AeadUpdate_aad(
-                &context->session->s_ctx, context->cryptoObjectId, (aadData + src_offset), AEAD_BLOCK_SIZE);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
-            src_offset += AEAD_BLOCK_SIZE;
-        }
-        if ((aadDataLen - src_offset) > 0) {
-            /*For the subsequent blocks which are yet to process*/
-            status = Se05x_API_AeadUpdate_aad(
-                &context->session->s_ctx, context->cryptoObjectId, (aadData + src_offset), (aadDataLen - src_offset));
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
+    smStatus_t status   = SM_NOT_OK;
+
+    //SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
+
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    if (context->pLazy != NULL) {
+        retval = sss_se05x_mac_one_go(context, context->pLazy->data, context->pLazy->len, mac, macLen);
+        sss_se05x_lazy_free(&context->pLazy);
+        return retval;
+    }
+#endif
+
+    if (context->mode == kMode_SSS_Mac) {
+        status = Se05x_API_MACFinal(&context->session->s_ctx, NULL, 0, context->cryptoObjectId, NULL, 0, mac, macLen);
+        if (status == SM_ERR_APDU_THROUGHPUT) {
+            retval = kStatus_SSS_ApduThroughputError;
+            goto exit;
         }
+        ENSURE_OR_GO_EXIT(status == SM_OK);
     }
-    else {
-        status = Se05x_API_AeadUpdate_aad(&context->session->s_ctx, context->cryptoObjectId, aadData, aadDataLen);
+    else if (context->mode == kMode_SSS_Mac_Validate) {
+        SE05x_Result_t result = kSE05x_Result_FAILURE;
+        size_t result_size    = sizeof(result);
+
+        ENSURE_OR_GO_EXIT(macLen != NULL);
+        status = Se05x_API_MACFinal(
+            &context->session->s_ctx, NULL, 0, context->cryptoObjectId, mac, *macLen, (uint8_t *)&result, &result_size);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
         }
         ENSURE_OR_GO_EXIT(status == SM_OK);
+
+        ENSURE_OR_GO_EXIT(result == kSE05x_Result_SUCCESS);
+    }
+    else {
+        LOG_E("Unknown mode");
+        goto exit;
     }
+
     retval = kStatus_SSS_Success;
 exit:
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(aadData);
-    AX_UNUSED_ARG(aadDataLen);
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
     return retval;
 }
 
-sss_status_t sss_se05x_aead_update(
-    sss_se05x_aead_t *context, const uint8_t *srcData, size_t srcLen, uint8_t *destData, size_t *destLen)
+void sss_se05x_mac_context_free(sss_se05x_mac_t *context)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    smStatus_t status    = SM_NOT_OK;
-    size_t inputData_len = 0;
-    size_t src_offset    = 0;
-    size_t output_offset = 0;
-    size_t outBuffSize   = 0;
-    size_t blockoutLen   = 0;
-
-    ENSURE_OR_GO_EXIT(srcData != NULL);
-    ENSURE_OR_GO_EXIT(destData != NULL);
-    ENSURE_OR_GO_EXIT(destLen != NULL);
-    ENSURE_OR_GO_EXIT(srcLen > 0);
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    sss_se05x_lazy_free(&context->pLazy);
+#endif
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    if ((context->cryptoObjectId != 0) && !sss_se05x_cryptoobj_keep(context->session, context->cryptoObjectId)) {
+#else
+    if (context->cryptoObjectId != 0) {
+#endif
+        smStatus_t status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
+        if (status != SM_OK) {
+            LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
+            return;
+        }
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+        sss_se05x_cryptoobj_record(context->session, context->cryptoObjectId, 0);
+#endif
+    }
+    memset(context, 0, sizeof(*context));
+}
 
-    outBuffSize = *destLen;
+/* End: se05x_mac */
 
-    /* Check overflow */
-    ENSURE_OR_GO_EXIT((SIZE_MAX - context->cache_data_len) >= srcLen);
-    ENSURE_OR_GO_EXIT((context->cache_data_len + srcLen) >= context->cache_data_len);
+/* ************************************************************************** */
+/* Functions : sss_se05x_md                                                   */
+/* ************************************************************************** */
 
-    if ((context->cache_data_len + srcLen) < AEAD_BLOCK_SIZE) {
-        /* Insufficinet data to process . Cache the data */
-        memcpy((context->cache_data + context->cache_data_len), srcData, srcLen);
-        context->cache_data_len = context->cache_data_len + srcLen;
-        *destLen                = 0;
-        return kStatus_SSS_Success;
+sss_status_t sss_se05x_digest_context_init(
+    sss_se05x_digest_t *context, sss_se05x_session_t *session, sss_algorithm_t algorithm, sss_mode_t mode)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
     }
-    else {
-        if (context->cache_data_len > 0) {
-            if (CIPHER_BLOCK_SIZE - context->cache_data_len > 0) {
-                memcpy((context->cache_data + context->cache_data_len),
-                    srcData,
-                    (CIPHER_BLOCK_SIZE - context->cache_data_len));
-            }
-
-            blockoutLen = outBuffSize;
-            status      = Se05x_API_AeadUpdate(&context->session->s_ctx,
-                context->cryptoObjectId,
-                context->cache_data,
-                CIPHER_BLOCK_SIZE,
-                destData,
-                &blockoutLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
+    context->session        = session;
+    context->algorithm      = algorithm;
+    context->mode           = mode;
+    context->cryptoObjectId = kSE05x_CryptoObject_NA;
+    context->lazy           = 0;
+    context->pLazy          = NULL;
+    return retval;
+}
 
-            src_offset = CIPHER_BLOCK_SIZE - context->cache_data_len;
-            outBuffSize -= blockoutLen;
-            output_offset += blockoutLen;
+sss_status_t sss_se05x_digest_context_set_lazy(sss_se05x_digest_t *context, uint8_t enable)
+{
+    if (context == NULL) {
+        return kStatus_SSS_Fail;
+    }
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    context->lazy = enable ? 1 : 0;
+#else
+    AX_UNUSED_ARG(enable);
+#endif
+    return kStatus_SSS_Success;
+}
 
-            context->cache_data_len = 0;
-        }
+sss_status_t sss_se05x_digest_one_go(
+    sss_se05x_digest_t *context, const uint8_t *message, size_t messageLen, uint8_t *digest, size_t *digestLen)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    uint8_t sha_type    = se05x_get_sha_algo(context->algorithm);
 
-        while (srcLen - src_offset >= CIPHER_BLOCK_SIZE) {
-            size_t rem_srcData = srcLen - src_offset;
+    ENSURE_OR_GO_EXIT(sha_type != kSE05x_DigestMode_NA);
 
-            if (rem_srcData > AEAD_UPDATE_MAX_DATA) {
-                inputData_len = AEAD_UPDATE_MAX_DATA;
-            }
-            else {
-                inputData_len = rem_srcData - (rem_srcData % CIPHER_BLOCK_SIZE);
-            }
+    status = Se05x_API_SHAOneShot(&context->session->s_ctx, sha_type, message, messageLen, digest, digestLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval     = kStatus_SSS_ApduThroughputError;
+        *digestLen = 0;
+        goto exit;
+    }
+    if (status != SM_OK) {
+        *digestLen = 0;
+        goto exit;
+    }
 
-            blockoutLen = outBuffSize;
-            status      = Se05x_API_AeadUpdate(&context->session->s_ctx,
-                context->cryptoObjectId,
-                (srcData + src_offset),
-                inputData_len,
-                (destData + output_offset),
-                &blockoutLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
 
-            src_offset += inputData_len;
-            outBuffSize -= blockoutLen;
-            output_offset += blockoutLen;
-        }
+static sss_status_t sss_se05x_digest_init_stream(sss_se05x_digest_t *context)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    SE05x_CryptoModeSubType_t subtype;
+    uint8_t created = 0;
 
-        *destLen = output_offset;
+    switch (context->algorithm) {
+#if SSS_HAVE_HASH_1
+    case kAlgorithm_SSS_SHA1:
+        subtype.digest          = kSE05x_DigestMode_SHA;
+        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA;
+        break;
+#endif
+#if SSS_HAVE_HASH_224
+    case kAlgorithm_SSS_SHA224:
+        subtype.digest          = kSE05x_DigestMode_SHA224;
+        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA224;
+        break;
+#endif
+    case kAlgorithm_SSS_SHA256:
+        subtype.digest          = kSE05x_DigestMode_SHA256;
+        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA256;
+        break;
+    case kAlgorithm_SSS_SHA384:
+        subtype.digest          = kSE05x_DigestMode_SHA384;
+        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA384;
+        break;
+#if SSS_HAVE_HASH_512
+    case kAlgorithm_SSS_SHA512:
+        subtype.digest          = kSE05x_DigestMode_SHA512;
+        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA512;
+        break;
+#endif
+    default:
+        return kStatus_SSS_Fail;
+    }
 
-        /* Copy unprocessed data to cache */
-        if ((srcLen - src_offset) > 0) {
-            memcpy(context->cache_data, (srcData + src_offset), (srcLen - src_offset));
-            context->cache_data_len = (srcLen - src_offset);
-        }
+    status = sss_se05x_cryptoobj_ensure(
+        context->session, context->cryptoObjectId, kSE05x_CryptoContext_DIGEST, subtype, 0, &created);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        return kStatus_SSS_ApduThroughputError;
+    }
+    if (status != SM_OK) {
+        return kStatus_SSS_Fail;
+    }
+#endif
+
+    status = Se05x_API_DigestInit(&context->session->s_ctx, context->cryptoObjectId);
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    if (sss_se05x_cryptoobj_recover(
+            context->session, context->cryptoObjectId, kSE05x_CryptoContext_DIGEST, subtype, status)) {
+        status = Se05x_API_DigestInit(&context->session->s_ctx, context->cryptoObjectId);
+    }
+#endif
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
     }
+    ENSURE_OR_GO_EXIT(status == SM_OK);
 
     retval = kStatus_SSS_Success;
 exit:
-    if (retval != kStatus_SSS_Success) {
-        if (destLen) {
-            *destLen = 0;
+    return retval;
+}
+
+sss_status_t sss_se05x_digest_init(sss_se05x_digest_t *context)
+{
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    sss_se05x_lazy_free(&context->pLazy);
+    if (context->lazy && (se05x_get_sha_algo(context->algorithm) != kSE05x_DigestMode_NA)) {
+        /* Sent with SHAOneShot at finish, or started on the SE once it grows */
+        context->pLazy = sss_se05x_lazy_alloc();
+        if (context->pLazy != NULL) {
+            return kStatus_SSS_Success;
         }
     }
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(srcData);
-    AX_UNUSED_ARG(srcLen);
-    AX_UNUSED_ARG(destData);
-    AX_UNUSED_ARG(destLen);
 #endif
-    return retval;
+    return sss_se05x_digest_init_stream(context);
 }
 
-sss_status_t sss_se05x_aead_finish(sss_se05x_aead_t *context,
-    const uint8_t *srcData,
-    size_t srcLen,
-    uint8_t *destData,
-    size_t *destLen,
-    uint8_t *tag,
-    size_t *tagLen)
+sss_status_t sss_se05x_digest_update(sss_se05x_digest_t *context, const uint8_t *message, size_t messageLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-    smStatus_t status = SM_NOT_OK;
-
-    SE05x_Cipher_Oper_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
-    uint8_t srcdata_updated[2 * CIPHER_BLOCK_SIZE] = {
-        0,
-    };
-    size_t srcdata_updated_len = 0;
+    smStatus_t status   = SM_NOT_OK;
+    size_t offset       = 0;
+    size_t chunk        = 0;
+    bool atomic         = false;
 
-    if (srcLen > CIPHER_BLOCK_SIZE) {
-        LOG_E("srcLen cannot be grater than 16 bytes. Call update function ");
-        if (destLen != NULL) {
-            *destLen = 0;
-        }
-        goto exit;
-    }
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    if (context->pLazy != NULL) {
+        struct _sss_se05x_lazy *pLazy = context->pLazy;
 
-    if ((context->algorithm == kAlgorithm_SSS_AES_CCM) || (context->algorithm == kAlgorithm_SSS_AES_CCM_INT_IV)) {
-        retval = sss_se05x_aead_CCMfinish(context, srcData, srcLen, destData, destLen, tag, tagLen);
-    }
-    else {
-        if (context->cache_data_len != 0) {
-            memcpy(srcdata_updated, context->cache_data, context->cache_data_len);
-            srcdata_updated_len = context->cache_data_len;
-        }
-        if (srcLen != 0) {
-            ENSURE_OR_GO_EXIT(srcData != NULL);
-            memcpy((srcdata_updated + srcdata_updated_len), srcData, srcLen);
-            srcdata_updated_len += srcLen;
+        if (sss_se05x_lazy_append(pLazy, message, messageLen)) {
+            return kStatus_SSS_Success;
         }
-        if (srcdata_updated_len > 0) {
-            status = Se05x_API_AeadUpdate(&context->session->s_ctx,
-                context->cryptoObjectId,
-                srcdata_updated,
-                srcdata_updated_len,
-                destData,
-                destLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
+        /* Too large for one APDU, continue streaming */
+        context->pLazy = NULL;
+        retval         = sss_se05x_digest_init_stream(context);
+        if ((retval == kStatus_SSS_Success) && (pLazy->len > 0)) {
+            status = Se05x_API_DigestUpdate(&context->session->s_ctx, context->cryptoObjectId, pLazy->data, pLazy->len);
+            retval = (status == SM_OK) ? kStatus_SSS_Success :
+                                         ((status == SM_ERR_APDU_THROUGHPUT) ? kStatus_SSS_ApduThroughputError :
+                                                                               kStatus_SSS_Fail);
         }
-        else {
-            /* This condition will occur if all data including cache is alread processed */
-            LOG_D("No Data in cache, All data are already processed");
-            *destLen = 0;
+        sss_se05x_lazy_free(&pLazy);
+        if (retval != kStatus_SSS_Success) {
+            goto exit;
         }
-        status = Se05x_API_AeadFinal(&context->session->s_ctx, context->cryptoObjectId, tag, tagLen, OperType);
+        retval = kStatus_SSS_Fail;
+    }
+#endif
+
+    ENSURE_OR_GO_EXIT((message != NULL) || (messageLen == 0));
+
+    /* Split to what fits one APDU. All chunks of this update are sent in one go */
+    ENSURE_OR_GO_EXIT(sss_se05x_begin_atomic(context->session) == kStatus_SSS_Success);
+    atomic = true;
+    do {
+        chunk  = ((messageLen - offset) > DIGEST_UPDATE_MAX_CHUNK) ? DIGEST_UPDATE_MAX_CHUNK : (messageLen - offset);
+        status = Se05x_API_DigestUpdate(&context->session->s_ctx, context->cryptoObjectId, message + offset, chunk);
         if (status == SM_ERR_APDU_THROUGHPUT) {
             retval = kStatus_SSS_ApduThroughputError;
             goto exit;
         }
         ENSURE_OR_GO_EXIT(status == SM_OK);
-        retval = kStatus_SSS_Success;
-    }
+        offset += chunk;
+    } while (offset < messageLen);
+
+    retval = kStatus_SSS_Success;
 exit:
-#else
-    AX_UNUSED_ARG(context);
-    AX_UNUSED_ARG(srcData);
-    AX_UNUSED_ARG(srcLen);
-    AX_UNUSED_ARG(destData);
-    AX_UNUSED_ARG(destLen);
-    AX_UNUSED_ARG(tag);
-    AX_UNUSED_ARG(tagLen);
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
+    if (atomic) {
+        sss_se05x_end_atomic(context->session);
+    }
     return retval;
 }
 
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-static sss_status_t sss_se05x_aead_CCMfinish(sss_se05x_aead_t *context,
-    const uint8_t *srcData,
-    size_t srcLen,
-    uint8_t *destData,
-    size_t *destLen,
-    uint8_t *tag,
-    size_t *tagLen)
+sss_status_t sss_se05x_digest_finish(sss_se05x_digest_t *context, uint8_t *digest, size_t *digestLen)
 {
-    sss_status_t retval   = kStatus_SSS_Fail;
-    smStatus_t status     = SM_NOT_OK;
-    uint8_t dataprocessed = 1;
-    SE05x_Cipher_Oper_t OperType =
-        (context->mode == kMode_SSS_Encrypt) ? kSE05x_Cipher_Oper_Encrypt : kSE05x_Cipher_Oper_Decrypt;
-    uint8_t srcdata_updated[2 * CIPHER_BLOCK_SIZE] = {
-        0,
-    };
-    size_t srcdata_updated_len = 0;
-    size_t outLen              = 0;
-    size_t tempoutLen          = 0;
-    size_t destBufLen          = *destLen;
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
 
-    if (context->cache_data_len != 0) {
-        memcpy(srcdata_updated, context->cache_data, context->cache_data_len);
-        srcdata_updated_len = context->cache_data_len;
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    if (context->pLazy != NULL) {
+        retval = sss_se05x_digest_one_go(context, context->pLazy->data, context->pLazy->len, digest, digestLen);
+        sss_se05x_lazy_free(&context->pLazy);
+        return retval;
     }
-    if (srcLen != 0) {
-        memcpy((srcdata_updated + srcdata_updated_len), srcData, srcLen);
-        srcdata_updated_len += srcLen;
+#endif
+
+    status = Se05x_API_DigestFinal(&context->session->s_ctx, context->cryptoObjectId, NULL, 0, digest, digestLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
+        goto exit;
     }
-    if (srcdata_updated_len > 0) {
-        if (srcdata_updated_len < CIPHER_BLOCK_SIZE) {
-            status = Se05x_API_AeadCCMLastUpdate(
-                &context->session->s_ctx, context->cryptoObjectId, srcdata_updated, srcdata_updated_len);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
-            dataprocessed = 0;
-        }
-        else if (srcdata_updated_len >= CIPHER_BLOCK_SIZE) {
-            tempoutLen = destBufLen - outLen;
-            status     = Se05x_API_AeadUpdate(&context->session->s_ctx,
-                context->cryptoObjectId,
-                srcdata_updated,
-                CIPHER_BLOCK_SIZE,
-                destData,
-                &tempoutLen);
-            if (status == SM_ERR_APDU_THROUGHPUT) {
-                retval = kStatus_SSS_ApduThroughputError;
-                goto exit;
-            }
-            ENSURE_OR_GO_EXIT(status == SM_OK);
-            srcdata_updated_len = srcdata_updated_len - CIPHER_BLOCK_SIZE;
-            outLen              = outLen + tempoutLen;
+    ENSURE_OR_GO_EXIT(status == SM_OK);
 
-            /* Put the remaining data in CCMLastUpdate if present (will always be less than CIPHER_BLOCK_SIZE) */
-            if (srcdata_updated_len) {
-                status = Se05x_API_AeadCCMLastUpdate(&context->session->s_ctx,
-                    context->cryptoObjectId,
-                    srcdata_updated + CIPHER_BLOCK_SIZE,
-                    srcdata_updated_len);
-                if (status == SM_ERR_APDU_THROUGHPUT) {
-                    retval = kStatus_SSS_ApduThroughputError;
-                    goto exit;
-                }
-                ENSURE_OR_GO_EXIT(status == SM_OK);
-                dataprocessed = 0;
-            }
+    retval = kStatus_SSS_Success;
+exit:
+    return retval;
+}
+
+void sss_se05x_digest_context_free(sss_se05x_digest_t *context)
+{
+#if SSS_SE05X_LAZY_ONESHOT_MAX > 0
+    sss_se05x_lazy_free(&context->pLazy);
+#endif
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+    if ((context->cryptoObjectId != 0) && !sss_se05x_cryptoobj_keep(context->session, context->cryptoObjectId)) {
+#else
+    if (context->cryptoObjectId != 0) {
+#endif
+        smStatus_t status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
+        if (status != SM_OK) {
+            LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
+            return;
         }
+#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
+        sss_se05x_cryptoobj_record(context->session, context->cryptoObjectId, 0);
+#endif
     }
-    else {
-        /* This condition will occur if all data including
-        cache is already processed just send final*/
-        dataprocessed = 1;
-    }
+    memset(context, 0, sizeof(*context));
+}
 
-    if (dataprocessed == 0) {
-        /*All data is updated, lastupdate datalen < 16 o/p
-          is expected here */
-        tempoutLen = destBufLen - outLen;
-        status     = Se05x_API_AeadCCMFinal(
-            &context->session->s_ctx, context->cryptoObjectId, (destData + outLen), &tempoutLen, tag, tagLen, OperType);
-        outLen = outLen + tempoutLen;
+/* End: se05x_md */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_drbg                                                 */
+/* ************************************************************************** */
+
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS || SSS_HAVE_HOSTCRYPTO_OPENSSL
+
+/* HMAC_DRBG with SHA-256, NIST SP 800-90A 10.1.2.
+ * Security strength 256 bits: 32 bytes entropy input, 16 bytes nonce. */
+#define DRBG_OUTLEN 32
+#define DRBG_ENTROPY_LEN 32
+#define DRBG_NONCE_LEN 16
+/* max_number_of_bits_per_request is 2^19 */
+#define DRBG_MAX_REQUEST (1u << 16)
+
+struct _sss_se05x_drbg
+{
+#if defined(USE_THREADX_RTOS)
+    TX_MUTEX lock;
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    SemaphoreHandle_t lock;
+#elif (__GNUC__ && !AX_EMBEDDED)
+    pthread_mutex_t lock;
+#endif
+    /* The session's reference and one per request in progress */
+    uint32_t refCount;
+    uint8_t key[DRBG_OUTLEN];
+    uint8_t v[DRBG_OUTLEN];
+    uint64_t bytesSinceSeed;
+    uint64_t seededAtUs;
+    sss_se05x_drbg_config_t config;
+    /* HMAC-SHA256 of the host crypto, keyed with key */
+    sss_session_t hostSession;
+    sss_key_store_t hostKs;
+    sss_object_t hostKey;
+    sss_mac_t hostMac;
+    /* hostKey holds the current key */
+    uint8_t keyLoaded;
+};
+
+#if USE_LOCK
+#define DRBG_LOCK(pDrbg) LOCK_TXN((pDrbg)->lock)
+#define DRBG_UNLOCK(pDrbg) UNLOCK_TXN((pDrbg)->lock)
+#else
+#define DRBG_LOCK(pDrbg)
+#define DRBG_UNLOCK(pDrbg)
+#endif
+
+#if (__GNUC__ && !AX_EMBEDDED)
+/* Only held to take and drop references to a session's DRBG */
+static pthread_mutex_t gDrbgRefLock = PTHREAD_MUTEX_INITIALIZER;
+#define DRBG_REF_LOCK() (void)pthread_mutex_lock(&gDrbgRefLock)
+#define DRBG_REF_UNLOCK() (void)pthread_mutex_unlock(&gDrbgRefLock)
+#else
+#define DRBG_REF_LOCK()
+#define DRBG_REF_UNLOCK()
+#endif
+
+/* Host session and key object used for HMAC. pDrbg is zeroed. */
+static sss_status_t sss_se05x_drbg_host_open(struct _sss_se05x_drbg *pDrbg)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS
+    const sss_type_t host_crypto = kType_SSS_mbedTLS;
+#else
+    const sss_type_t host_crypto = kType_SSS_OpenSSL;
+#endif
+
+    retval = sss_host_session_open(&pDrbg->hostSession, host_crypto, 0, kSSS_ConnectionType_Plain, NULL);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_host_key_store_context_init(&pDrbg->hostKs, &pDrbg->hostSession);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_host_key_store_allocate(&pDrbg->hostKs, __LINE__);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_host_key_object_init(&pDrbg->hostKey, &pDrbg->hostKs);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_host_key_object_allocate_handle(
+        &pDrbg->hostKey, __LINE__, kSSS_KeyPart_Default, kSSS_CipherType_HMAC, DRBG_OUTLEN, kKeyObject_Mode_Transient);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    retval = sss_host_mac_context_init(
+        &pDrbg->hostMac, &pDrbg->hostSession, &pDrbg->hostKey, kAlgorithm_SSS_HMAC_SHA256, kMode_SSS_Mac);
+exit:
+    return retval;
+}
+
+static void sss_se05x_drbg_host_close(struct _sss_se05x_drbg *pDrbg)
+{
+    if (pDrbg->hostMac.session != NULL) {
+        sss_host_mac_context_free(&pDrbg->hostMac);
     }
-    else {
-        /*All data is processed no destination data*/
-        status = Se05x_API_AeadFinal(&context->session->s_ctx, context->cryptoObjectId, tag, tagLen, OperType);
+    if (pDrbg->hostKey.keyStore != NULL) {
+        sss_host_key_object_free(&pDrbg->hostKey);
+    }
+    if (pDrbg->hostKs.session != NULL) {
+        sss_host_key_store_context_free(&pDrbg->hostKs);
+    }
+    if (pDrbg->hostSession.subsystem != kType_SSS_SubSystem_NONE) {
+        sss_host_session_close(&pDrbg->hostSession);
+    }
+}
+
+/* out = HMAC-SHA256(pDrbg->key, data). out may be pDrbg->key. */
+static sss_status_t sss_se05x_drbg_hmac(
+    struct _sss_se05x_drbg *pDrbg, const uint8_t *data, size_t dataLen, uint8_t *out)
+{
+    sss_status_t retval = kStatus_SSS_Fail;
+    size_t outLen       = DRBG_OUTLEN;
+
+    if (!pDrbg->keyLoaded) {
+        retval = sss_host_key_store_set_key(
+            &pDrbg->hostKs, &pDrbg->hostKey, pDrbg->key, DRBG_OUTLEN, DRBG_OUTLEN * 8, NULL, 0);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        pDrbg->keyLoaded = 1;
     }
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-        goto exit;
+    if (out == pDrbg->key) {
+        pDrbg->keyLoaded = 0;
+    }
+    retval = sss_host_mac_one_go(&pDrbg->hostMac, data, dataLen, out, &outLen);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    if (outLen != DRBG_OUTLEN) {
+        retval = kStatus_SSS_Fail;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-    retval   = kStatus_SSS_Success;
-    *destLen = outLen;
 exit:
     return retval;
 }
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
 
-void sss_se05x_aead_context_free(sss_se05x_aead_t *context)
+/* HMAC_DRBG_Update */
+static sss_status_t sss_se05x_drbg_update(struct _sss_se05x_drbg *pDrbg, const uint8_t *pData, size_t dataLen)
 {
-#if SSS_HAVE_SE05X_VER_GTE_07_02
-#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
-    smStatus_t status;
-    uint8_t list[1024] = {
-        0,
-    };
-    uint8_t object_exists = 0;
-    size_t listlen        = sizeof(list);
+    sss_status_t retval = kStatus_SSS_Fail;
+    uint8_t buf[DRBG_OUTLEN + 1 + DRBG_ENTROPY_LEN + DRBG_NONCE_LEN];
+    uint8_t round;
 
-    if (context->cryptoObjectId != 0) {
-        status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
-        for (size_t i = 0; i < listlen; i += 4) {
-            uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-            if (cryptoObjectId == context->cryptoObjectId) {
-                object_exists = 1;
-            }
+    ENSURE_OR_GO_EXIT(dataLen <= sizeof(buf) - DRBG_OUTLEN - 1);
+
+    for (round = 0; round < 2; round++) {
+        memcpy(buf, pDrbg->v, DRBG_OUTLEN);
+        buf[DRBG_OUTLEN] = round;
+        if (dataLen > 0) {
+            memcpy(&buf[DRBG_OUTLEN + 1], pData, dataLen);
         }
-        if (object_exists) {
-            status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
-            if (status != SM_OK) {
-                LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
-                return;
-            }
+        retval = sss_se05x_drbg_hmac(pDrbg, buf, DRBG_OUTLEN + 1 + dataLen, pDrbg->key);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        retval = sss_se05x_drbg_hmac(pDrbg, pDrbg->v, DRBG_OUTLEN, pDrbg->v);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        if (dataLen == 0) {
+            break;
         }
     }
-#endif /* SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ */
-    memset(context, 0, sizeof(*context));
-#else
-    AX_UNUSED_ARG(context);
-#endif /* SSS_HAVE_SE05X_VER_GTE_07_02 */
+exit:
+    memset(buf, 0, sizeof(buf));
+    return retval;
 }
 
-/* End: se05x_aead */
-
-/* ************************************************************************** */
-/* Functions : sss_se05x_mac                                                  */
-/* ************************************************************************** */
-
-sss_status_t sss_se05x_mac_context_init(sss_se05x_mac_t *context,
-    sss_se05x_session_t *session,
-    sss_se05x_object_t *keyObject,
-    sss_algorithm_t algorithm,
-    sss_mode_t mode)
+/* Instantiate (seed is entropy input || nonce) or reseed (seed is entropy
+ * input). Called with the DRBG locked. */
+static sss_status_t sss_se05x_drbg_seed(
+    struct _sss_se05x_drbg *pDrbg, const uint8_t *seed, size_t seedLen, uint8_t instantiate)
 {
-    sss_status_t retval = kStatus_SSS_Success;
-    if (context == NULL) {
-        return kStatus_SSS_Fail;
+    sss_status_t retval = kStatus_SSS_Fail;
+
+    if (instantiate) {
+        memset(pDrbg->key, 0x00, sizeof(pDrbg->key));
+        memset(pDrbg->v, 0x01, sizeof(pDrbg->v));
+        pDrbg->keyLoaded = 0;
     }
-    context->session   = session;
-    context->keyObject = keyObject;
-    context->algorithm = algorithm;
-    context->mode      = mode;
+    retval = sss_se05x_drbg_update(pDrbg, seed, seedLen);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    pDrbg->bytesSinceSeed = 0;
+    pDrbg->seededAtUs     = sm_get_time_us();
+exit:
     return retval;
 }
 
-sss_status_t sss_se05x_mac_one_go(
-    sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen, uint8_t *mac, size_t *macLen)
+/* Entropy from the SE. Called with the DRBG locked, the DRBG lock is
+ * always taken before the device. */
+static sss_status_t sss_se05x_drbg_entropy(sss_se05x_session_t *session, uint8_t *seed, size_t seedLen)
 {
-    sss_status_t retval          = kStatus_SSS_Fail;
-    smStatus_t status            = SM_NOT_OK;
-    SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
-
-    ENSURE_OR_GO_EXIT(message != NULL);
-    ENSURE_OR_GO_EXIT(mac != NULL);
-    ENSURE_OR_GO_EXIT(macLen != NULL);
-
-    ENSURE_OR_GO_EXIT(macOperation != kSE05x_MACAlgo_NA);
-
-    if (context->mode == kMode_SSS_Mac) {
-        status = Se05x_API_MACOneShot_G(
-            &context->session->s_ctx, context->keyObject->keyId, macOperation, message, messageLen, mac, macLen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
-        }
-        ENSURE_OR_GO_EXIT(status == SM_OK);
-    }
-    else if (context->mode == kMode_SSS_Mac_Validate) {
-        SE05x_Result_t result = kSE05x_Result_FAILURE;
-        size_t result_size    = sizeof(result);
-
-        status = Se05x_API_MACOneShot_V(&context->session->s_ctx,
-            context->keyObject->keyId,
-            macOperation,
-            message,
-            messageLen,
-            mac,
-            *macLen,
-            (uint8_t *)&result,
-            &result_size);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
-        }
-        ENSURE_OR_GO_EXIT(status == SM_OK);
+    sss_status_t retval = kStatus_SSS_Fail;
+    smStatus_t status   = SM_NOT_OK;
+    size_t gotLen       = seedLen;
 
-        ENSURE_OR_GO_EXIT(result == kSE05x_Result_SUCCESS);
-    }
-    else {
-        LOG_E("Unknown mode");
+    status = Se05x_API_GetRandom(&session->s_ctx, (uint16_t)seedLen, seed, &gotLen);
+    if (status == SM_ERR_APDU_THROUGHPUT) {
+        retval = kStatus_SSS_ApduThroughputError;
         goto exit;
     }
-
+    ENSURE_OR_GO_EXIT(status == SM_OK);
+    ENSURE_OR_GO_EXIT(gotLen == seedLen);
     retval = kStatus_SSS_Success;
 exit:
     return retval;
 }
 
-sss_status_t sss_se05x_mac_validate_one_go(
-    sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen, uint8_t *mac, size_t macLen)
+static uint8_t sss_se05x_drbg_reseed_due(struct _sss_se05x_drbg *pDrbg)
+{
+    if (pDrbg->config.predictionResistance) {
+        return 1;
+    }
+    if ((pDrbg->config.reseedIntervalBytes > 0) && (pDrbg->bytesSinceSeed >= pDrbg->config.reseedIntervalBytes)) {
+        return 1;
+    }
+    if ((pDrbg->config.reseedIntervalMs > 0) &&
+        ((sm_get_time_us() - pDrbg->seededAtUs) >= ((uint64_t)pDrbg->config.reseedIntervalMs * 1000))) {
+        return 1;
+    }
+    return 0;
+}
+
+/* HMAC_DRBG_Generate of at most DRBG_MAX_REQUEST bytes, no additional
+ * input. Called with the DRBG locked. */
+static sss_status_t sss_se05x_drbg_generate(struct _sss_se05x_drbg *pDrbg, uint8_t *random_data, size_t dataLen)
 {
     sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-    SE05x_MACAlgo_t macOperation;
-    SE05x_Result_t result = kSE05x_Result_FAILURE;
-    size_t result_size    = sizeof(result);
+    size_t left         = dataLen;
 
-    if (context == NULL) {
-        goto exit;
+    ENSURE_OR_GO_EXIT(dataLen <= DRBG_MAX_REQUEST);
+    while (left > 0) {
+        size_t chunk = (left > DRBG_OUTLEN) ? DRBG_OUTLEN : left;
+        retval       = sss_se05x_drbg_hmac(pDrbg, pDrbg->v, DRBG_OUTLEN, pDrbg->v);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        memcpy(random_data, pDrbg->v, chunk);
+        random_data += chunk;
+        left -= chunk;
     }
+    retval = sss_se05x_drbg_update(pDrbg, NULL, 0);
+    ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+    pDrbg->bytesSinceSeed += dataLen;
+exit:
+    return retval;
+}
 
-    macOperation = se05x_get_mac_algo(context->algorithm);
+/* Serve a request, reseeding from the SE when due. The DRBG stays locked
+ * for the whole request, entropy fetch included. */
+static sss_status_t sss_se05x_drbg_read(
+    sss_se05x_session_t *session, struct _sss_se05x_drbg *pDrbg, uint8_t *random_data, size_t dataLen)
+{
+    sss_status_t retval = kStatus_SSS_Success;
+    uint8_t seed[DRBG_ENTROPY_LEN];
 
-    ENSURE_OR_GO_EXIT(macOperation != kSE05x_MACAlgo_NA);
+    DRBG_LOCK(pDrbg);
+    while (dataLen > 0) {
+        size_t request = (dataLen > DRBG_MAX_REQUEST) ? DRBG_MAX_REQUEST : dataLen;
 
-    status = Se05x_API_MACOneShot_V(&context->session->s_ctx,
-        context->keyObject->keyId,
-        macOperation,
-        message,
-        messageLen,
-        mac,
-        macLen,
-        (uint8_t *)&result,
-        &result_size);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-        goto exit;
-    }
-    if (status == SM_OK) {
-        if (result == kSE05x_Result_SUCCESS) {
-            retval = kStatus_SSS_Success;
+        if (sss_se05x_drbg_reseed_due(pDrbg)) {
+            retval = sss_se05x_drbg_entropy(session, seed, sizeof(seed));
+            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+            retval = sss_se05x_drbg_seed(pDrbg, seed, sizeof(seed), 0);
+            ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
         }
+        retval = sss_se05x_drbg_generate(pDrbg, random_data, request);
+        ENSURE_OR_GO_EXIT(retval == kStatus_SSS_Success);
+        random_data += request;
+        dataLen -= request;
     }
-
 exit:
+    DRBG_UNLOCK(pDrbg);
+    memset(seed, 0, sizeof(seed));
     return retval;
 }
 
-sss_status_t sss_se05x_mac_init(sss_se05x_mac_t *context)
-{
-    sss_status_t retval       = kStatus_SSS_Fail;
-    smStatus_t status         = SM_NOT_OK;
-    SE05x_Mac_Oper_t operType = kSE05x_Mac_Oper_NA;
-#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
-    SE05x_CryptoModeSubType_t subtype;
-
-    uint8_t list[1024] = {
-        0,
-    };
-    size_t listlen = sizeof(list);
-    size_t i;
-    uint8_t create_crypto_obj = 1;
+static void sss_se05x_drbg_free(struct _sss_se05x_drbg *pDrbg);
 
-    SE05x_CryptoContext_t cryptoContext;
+/* Reference to the DRBG of the session, NULL if it has none. Release with
+ * sss_se05x_drbg_put(). */
+static struct _sss_se05x_drbg *sss_se05x_drbg_get(sss_se05x_session_t *session)
+{
+    struct _sss_se05x_drbg *pDrbg = NULL;
 
-    switch (context->algorithm) {
-    case kAlgorithm_SSS_CMAC_AES:
-        subtype.mac             = kSE05x_MACAlgo_CMAC_128;
-        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
-        context->cryptoObjectId = kSE05x_CryptoObject_CMAC_128;
-        break;
-#if SSS_HAVE_HASH_1
-    case kAlgorithm_SSS_HMAC_SHA1:
-        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA1;
-        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
-        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA1;
-        break;
-#endif
-    case kAlgorithm_SSS_HMAC_SHA256:
-        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA256;
-        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
-        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA256;
-        break;
-    case kAlgorithm_SSS_HMAC_SHA384:
-        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA384;
-        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
-        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA384;
-        break;
-#if SSS_HAVE_HASH_512
-    case kAlgorithm_SSS_HMAC_SHA512:
-        subtype.mac             = kSE05x_MACAlgo_HMAC_SHA512;
-        cryptoContext           = kSE05x_CryptoContext_SIGNATURE;
-        context->cryptoObjectId = kSE05x_CryptoObject_HMAC_SHA512;
-        break;
-#endif
-    default:
-        return kStatus_SSS_Fail;
+    DRBG_REF_LOCK();
+    pDrbg = session->pDrbg;
+    if (pDrbg != NULL) {
+        pDrbg->refCount++;
     }
+    DRBG_REF_UNLOCK();
+    return pDrbg;
+}
 
-    status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        return kStatus_SSS_ApduThroughputError;
-    }
-    for (i = 0; i < listlen; i += 4) {
-        uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-        if (cryptoObjectId == context->cryptoObjectId) {
-            create_crypto_obj = 0;
-        }
+/* Drop a reference, the last one frees the DRBG */
+static void sss_se05x_drbg_put(struct _sss_se05x_drbg *pDrbg)
+{
+    uint32_t left;
+
+    DRBG_REF_LOCK();
+    left = --pDrbg->refCount;
+    DRBG_REF_UNLOCK();
+    if (left == 0) {
+        sss_se05x_drbg_free(pDrbg);
     }
+}
 
-    if (create_crypto_obj) {
-        status =
-            Se05x_API_CreateCryptoObject(&context->session->s_ctx, context->cryptoObjectId, cryptoContext, subtype);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
-        }
-        if (status != SM_OK) {
-            LOG_W("CreateCryptoObject Failed");
-            return kStatus_SSS_Fail;
-        }
+static void sss_se05x_drbg_free(struct _sss_se05x_drbg *pDrbg)
+{
+    sss_se05x_drbg_host_close(pDrbg);
+#if defined(USE_THREADX_RTOS)
+    tx_mutex_delete(&pDrbg->lock);
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    vSemaphoreDelete(pDrbg->lock);
+#elif (__GNUC__ && !AX_EMBEDDED)
+    if (pthread_mutex_destroy(&pDrbg->lock) != 0) {
+        LOG_E("pthread_mutex_destroy failed");
     }
 #endif
+    memset(pDrbg, 0, sizeof(*pDrbg));
+    SSS_FREE(pDrbg);
+}
 
-    if (context->mode == kMode_SSS_Mac) {
-        operType = kSE05x_Mac_Oper_Generate;
+/* DRBG with its lock and host session, not yet instantiated */
+static struct _sss_se05x_drbg *sss_se05x_drbg_new(const sss_se05x_drbg_config_t *pConfig)
+{
+    struct _sss_se05x_drbg *pDrbg = NULL;
+
+    pDrbg = (struct _sss_se05x_drbg *)SSS_MALLOC(sizeof(*pDrbg));
+    ENSURE_OR_GO_EXIT(pDrbg != NULL);
+    memset(pDrbg, 0, sizeof(*pDrbg));
+#if defined(USE_THREADX_RTOS)
+    if (tx_mutex_create(&pDrbg->lock, "drbg", TX_NO_INHERIT) != TX_SUCCESS) {
+        LOG_E("tx_mutex_create failed");
+        SSS_FREE(pDrbg);
+        pDrbg = NULL;
+        goto exit;
     }
-    else if (context->mode == kMode_SSS_Mac_Validate) {
-        operType = kSE05x_Mac_Oper_Validate;
+#elif (defined(USE_RTOS) && (USE_RTOS == 1))
+    pDrbg->lock = xSemaphoreCreateMutex();
+    if (pDrbg->lock == NULL) {
+        LOG_E("xSemaphoreCreateMutex failed");
+        SSS_FREE(pDrbg);
+        pDrbg = NULL;
+        goto exit;
     }
-    else {
-        LOG_E("Unknown mode");
+#elif (__GNUC__ && !AX_EMBEDDED)
+    if (pthread_mutex_init(&pDrbg->lock, NULL) != 0) {
+        LOG_E("mutex init has failed");
+        SSS_FREE(pDrbg);
+        pDrbg = NULL;
         goto exit;
     }
+#endif
 
-    status = Se05x_API_MACInit(&context->session->s_ctx, context->keyObject->keyId, context->cryptoObjectId, operType);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        return kStatus_SSS_ApduThroughputError;
+    if (pConfig != NULL) {
+        pDrbg->config = *pConfig;
+    }
+    else {
+        pDrbg->config.reseedIntervalBytes = SSS_SE05X_DRBG_RESEED_BYTES;
+        pDrbg->config.reseedIntervalMs    = SSS_SE05X_DRBG_RESEED_MS;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
 
-    retval = kStatus_SSS_Success;
+    if (sss_se05x_drbg_host_open(pDrbg) != kStatus_SSS_Success) {
+        LOG_E("Host DRBG: no host HMAC");
+        sss_se05x_drbg_free(pDrbg);
+        pDrbg = NULL;
+    }
 exit:
-    return retval;
+    return pDrbg;
 }
 
-sss_status_t sss_se05x_mac_update(sss_se05x_mac_t *context, const uint8_t *message, size_t messageLen)
+sss_status_t sss_se05x_session_enable_drbg(sss_se05x_session_t *session, const sss_se05x_drbg_config_t *pConfig)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
+    sss_status_t retval           = kStatus_SSS_Fail;
+    struct _sss_se05x_drbg *pDrbg = NULL;
+    uint8_t seed[DRBG_ENTROPY_LEN + DRBG_NONCE_LEN];
 
-    //SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
+    ENSURE_OR_GO_EXIT(session != NULL);
+    sss_se05x_session_disable_drbg(session);
 
-    status = Se05x_API_MACUpdate(&context->session->s_ctx, message, messageLen, context->cryptoObjectId);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+    pDrbg = sss_se05x_drbg_new(pConfig);
+    ENSURE_OR_GO_EXIT(pDrbg != NULL);
+
+    retval = sss_se05x_drbg_entropy(session, seed, sizeof(seed));
+    if (retval == kStatus_SSS_Success) {
+        retval = sss_se05x_drbg_seed(pDrbg, seed, sizeof(seed), 1);
+    }
+    if (retval != kStatus_SSS_Success) {
+        LOG_E("Host DRBG could not be instantiated");
+        sss_se05x_drbg_free(pDrbg);
         goto exit;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-
-    retval = kStatus_SSS_Success;
+    pDrbg->refCount = 1;
+    DRBG_REF_LOCK();
+    session->pDrbg = pDrbg;
+    DRBG_REF_UNLOCK();
 exit:
+    memset(seed, 0, sizeof(seed));
     return retval;
 }
 
-sss_status_t sss_se05x_mac_finish(sss_se05x_mac_t *context, uint8_t *mac, size_t *macLen)
+void sss_se05x_session_disable_drbg(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-
-    //SE05x_MACAlgo_t macOperation = se05x_get_mac_algo(context->algorithm);
+    struct _sss_se05x_drbg *pDrbg = NULL;
 
-    if (context->mode == kMode_SSS_Mac) {
-        status = Se05x_API_MACFinal(&context->session->s_ctx, NULL, 0, context->cryptoObjectId, NULL, 0, mac, macLen);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
-        }
-        ENSURE_OR_GO_EXIT(status == SM_OK);
+    if (session == NULL) {
+        return;
     }
-    else if (context->mode == kMode_SSS_Mac_Validate) {
-        SE05x_Result_t result = kSE05x_Result_FAILURE;
-        size_t result_size    = sizeof(result);
+    DRBG_REF_LOCK();
+    pDrbg          = session->pDrbg;
+    session->pDrbg = NULL;
+    DRBG_REF_UNLOCK();
+    /* New requests read from the SE. A request in progress still holds a
+     * reference, the DRBG is freed when the last one is dropped. */
+    if (pDrbg != NULL) {
+        sss_se05x_drbg_put(pDrbg);
+    }
+}
 
-        if (macLen == NULL) {
-            return kStatus_SSS_Fail;
-        }
-        status = Se05x_API_MACFinal(
-            &context->session->s_ctx, NULL, 0, context->cryptoObjectId, mac, *macLen, (uint8_t *)&result, &result_size);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            retval = kStatus_SSS_ApduThroughputError;
-            goto exit;
+sss_status_t sss_se05x_rng_reseed(sss_se05x_rng_context_t *context)
+{
+    sss_status_t retval           = kStatus_SSS_Success;
+    struct _sss_se05x_drbg *pDrbg = NULL;
+    uint8_t seed[DRBG_ENTROPY_LEN];
+
+    ENSURE_OR_RETURN_ON_ERROR(context != NULL, kStatus_SSS_Fail);
+    pDrbg = sss_se05x_drbg_get(context->session);
+    if (pDrbg != NULL) {
+        DRBG_LOCK(pDrbg);
+        retval = sss_se05x_drbg_entropy(context->session, seed, sizeof(seed));
+        if (retval == kStatus_SSS_Success) {
+            retval = sss_se05x_drbg_seed(pDrbg, seed, sizeof(seed), 0);
         }
-        ENSURE_OR_GO_EXIT(status == SM_OK);
-
-        ENSURE_OR_GO_EXIT(result == kSE05x_Result_SUCCESS);
-    }
-    else {
-        LOG_E("Unknown mode");
-        goto exit;
+        DRBG_UNLOCK(pDrbg);
+        memset(seed, 0, sizeof(seed));
+        sss_se05x_drbg_put(pDrbg);
     }
-
-    retval = kStatus_SSS_Success;
-exit:
     return retval;
 }
 
-void sss_se05x_mac_context_free(sss_se05x_mac_t *context)
+/* NIST CAVP HMAC_DRBG.rsp, [SHA-256] [PredictionResistance = False]
+ * [EntropyInputLen = 256] [NonceLen = 128] [PersonalizationStringLen = 0]
+ * [AdditionalInputLen = 0] [ReturnedBitsLen = 1024], COUNT = 0 */
+/* clang-format off */
+static const uint8_t gDrbgKatEntropyNonce[DRBG_ENTROPY_LEN + DRBG_NONCE_LEN] = {
+    0xca, 0x85, 0x19, 0x11, 0x34, 0x93, 0x84, 0xbf, 0xfe, 0x89, 0xde, 0x1c, 0xbd, 0xc4, 0x6e, 0x68,
+    0x31, 0xe4, 0x4d, 0x34, 0xa4, 0xfb, 0x93, 0x5e, 0xe2, 0x85, 0xdd, 0x14, 0xb7, 0x1a, 0x74, 0x88,
+    0x65, 0x9b, 0xa9, 0x6c, 0x60, 0x1d, 0xc6, 0x9f, 0xc9, 0x02, 0x94, 0x08, 0x05, 0xec, 0x0c, 0xa8 };
+static const uint8_t gDrbgKatReturnedBits[128] = {
+    0xe5, 0x28, 0xe9, 0xab, 0xf2, 0xde, 0xce, 0x54, 0xd4, 0x7c, 0x7e, 0x75, 0xe5, 0xfe, 0x30, 0x21,
+    0x49, 0xf8, 0x17, 0xea, 0x9f, 0xb4, 0xbe, 0xe6, 0xf4, 0x19, 0x96, 0x97, 0xd0, 0x4d, 0x5b, 0x89,
+    0xd5, 0x4f, 0xbb, 0x97, 0x8a, 0x15, 0xb5, 0xc4, 0x43, 0xc9, 0xec, 0x21, 0x03, 0x6d, 0x24, 0x60,
+    0xb6, 0xf7, 0x3e, 0xba, 0xd0, 0xdc, 0x2a, 0xba, 0x6e, 0x62, 0x4a, 0xbf, 0x07, 0x74, 0x5b, 0xc1,
+    0x07, 0x69, 0x4b, 0xb7, 0x54, 0x7b, 0xb0, 0x99, 0x5f, 0x70, 0xde, 0x25, 0xd6, 0xb2, 0x9e, 0x2d,
+    0x30, 0x11, 0xbb, 0x19, 0xd2, 0x76, 0x76, 0xc0, 0x71, 0x62, 0xc8, 0xb5, 0xcc, 0xde, 0x06, 0x68,
+    0x96, 0x1d, 0xf8, 0x68, 0x03, 0x48, 0x2c, 0xb3, 0x7e, 0xd6, 0xd5, 0xc0, 0xbb, 0x8d, 0x50, 0xcf,
+    0x1f, 0x50, 0xd4, 0x76, 0xaa, 0x04, 0x58, 0xbd, 0xab, 0xa8, 0x06, 0xf4, 0x8b, 0xe9, 0xdc, 0xb8 };
+/* clang-format on */
+
+sss_status_t sss_se05x_drbg_self_test(void)
 {
-    if (context->cryptoObjectId != 0) {
-        smStatus_t status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
-        if (status != SM_OK) {
-            LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
-            return;
-        }
+    sss_status_t retval           = kStatus_SSS_Fail;
+    struct _sss_se05x_drbg *pDrbg = NULL;
+    uint8_t out[sizeof(gDrbgKatReturnedBits)];
+    const sss_se05x_drbg_config_t noReseed = {0};
+
+    pDrbg = sss_se05x_drbg_new(&noReseed);
+    ENSURE_OR_GO_EXIT(pDrbg != NULL);
+    retval = sss_se05x_drbg_seed(pDrbg, gDrbgKatEntropyNonce, sizeof(gDrbgKatEntropyNonce), 1);
+    ENSURE_OR_GO_CLEANUP(retval == kStatus_SSS_Success);
+    /* The first output is discarded by the test procedure */
+    retval = sss_se05x_drbg_generate(pDrbg, out, sizeof(out));
+    ENSURE_OR_GO_CLEANUP(retval == kStatus_SSS_Success);
+    retval = sss_se05x_drbg_generate(pDrbg, out, sizeof(out));
+    ENSURE_OR_GO_CLEANUP(retval == kStatus_SSS_Success);
+    if (memcmp(out, gDrbgKatReturnedBits, sizeof(out)) != 0) {
+        LOG_E("Host DRBG: known answer test failed");
+        retval = kStatus_SSS_Fail;
     }
-    memset(context, 0, sizeof(*context));
+cleanup:
+    sss_se05x_drbg_free(pDrbg);
+exit:
+    return retval;
 }
 
-/* End: se05x_mac */
+#else /* SSS_HAVE_HOSTCRYPTO_MBEDTLS || SSS_HAVE_HOSTCRYPTO_OPENSSL */
 
-/* ************************************************************************** */
-/* Functions : sss_se05x_md                                                   */
-/* ************************************************************************** */
+sss_status_t sss_se05x_session_enable_drbg(sss_se05x_session_t *session, const sss_se05x_drbg_config_t *pConfig)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(pConfig);
+    LOG_E("Host DRBG needs host crypto");
+    return kStatus_SSS_InvalidArgument;
+}
 
-sss_status_t sss_se05x_digest_context_init(
-    sss_se05x_digest_t *context, sss_se05x_session_t *session, sss_algorithm_t algorithm, sss_mode_t mode)
+void sss_se05x_session_disable_drbg(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Success;
-    if (context == NULL) {
-        return kStatus_SSS_Fail;
-    }
-    context->session   = session;
-    context->algorithm = algorithm;
-    context->mode      = mode;
-    return retval;
+    AX_UNUSED_ARG(session);
 }
 
-sss_status_t sss_se05x_digest_one_go(
-    sss_se05x_digest_t *context, const uint8_t *message, size_t messageLen, uint8_t *digest, size_t *digestLen)
+sss_status_t sss_se05x_rng_reseed(sss_se05x_rng_context_t *context)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-    uint8_t sha_type    = se05x_get_sha_algo(context->algorithm);
+    AX_UNUSED_ARG(context);
+    return kStatus_SSS_Success;
+}
 
-    ENSURE_OR_GO_EXIT(sha_type != kSE05x_DigestMode_NA);
+sss_status_t sss_se05x_drbg_self_test(void)
+{
+    return kStatus_SSS_InvalidArgument;
+}
 
-    status = Se05x_API_SHAOneShot(&context->session->s_ctx, sha_type, message, messageLen, digest, digestLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval     = kStatus_SSS_ApduThroughputError;
-        *digestLen = 0;
-        goto exit;
+#endif /* SSS_HAVE_HOSTCRYPTO_MBEDTLS || SSS_HAVE_HOSTCRYPTO_OPENSSL */
+
+/* End: se05x_drbg */
+
+/* ************************************************************************** */
+/* Functions : sss_se05x_rng_prefetch                                         */
+/* ************************************************************************** */
+
+#if (__GNUC__ && !AX_EMBEDDED)
+
+/* Single producer (the prefetch thread), multiple consumers. The producer
+ * publishes head after writing, consumers claim [tail, tail + n) with a
+ * compare and swap on tail. head and tail run freely, size is a power of 2. */
+struct _sss_se05x_rng_prefetch
+{
+    sss_se05x_session_t *session;
+    pthread_t thread;
+    pthread_mutex_t lock; /* Only for the producer to sleep on wake */
+    pthread_cond_t wake;  /* Signalled by consumers when the ring drains */
+    volatile int stop;
+    uint8_t *ring;
+    size_t size;
+    size_t head;
+    size_t tail;
+    /* Counters */
+    uint64_t produced; /* Written by the producer only */
+    uint64_t fetchUs;  /* Written by the producer only */
+    size_t consumed;
+    uint32_t misses;
+};
+
+/* Sleep for ms unless woken by a consumer or stop */
+static void sss_se05x_prefetch_sleep(struct _sss_se05x_rng_prefetch *pPrefetch, uint32_t ms)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
     }
-    if (status != SM_OK) {
-        *digestLen = 0;
-        goto exit;
+    pthread_mutex_lock(&pPrefetch->lock);
+    if (!pPrefetch->stop) {
+        (void)pthread_cond_timedwait(&pPrefetch->wake, &pPrefetch->lock, &deadline);
     }
+    pthread_mutex_unlock(&pPrefetch->lock);
+}
 
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
+static void *sss_se05x_prefetch_thread(void *arg)
+{
+    struct _sss_se05x_rng_prefetch *pPrefetch = (struct _sss_se05x_rng_prefetch *)arg;
+    uint8_t buf[GET_RANDOM_MAX_CHUNK];
+    size_t minFetch = (pPrefetch->size < sizeof(buf)) ? pPrefetch->size : sizeof(buf);
+
+    /* Random bytes are fetched while nobody else needs the bus */
+    smCom_SetPriority(SMCOM_PRIO_LOW, 0);
+
+    while (!pPrefetch->stop) {
+        size_t head      = pPrefetch->head;
+        size_t tail      = __atomic_load_n(&pPrefetch->tail, __ATOMIC_ACQUIRE);
+        size_t space     = pPrefetch->size - (head - tail);
+        size_t fetchLen  = (space < sizeof(buf)) ? space : sizeof(buf);
+        size_t offset    = 0;
+        size_t first     = 0;
+        uint64_t startUs = 0;
+        smStatus_t status = SM_NOT_OK;
+
+        if (space < minFetch) {
+            sss_se05x_prefetch_sleep(pPrefetch, 10);
+            continue;
+        }
+
+        startUs = sm_get_time_us();
+        /* Device first, the secure channel of the session is only locked
+         * inside, by sss_se05x_TXn. Same order as the application threads. */
+        if (sss_se05x_begin_atomic(pPrefetch->session) != kStatus_SSS_Success) {
+            sss_se05x_prefetch_sleep(pPrefetch, 10);
+            continue;
+        }
+        status = Se05x_API_GetRandom(&pPrefetch->session->s_ctx, (uint16_t)fetchLen, buf, &fetchLen);
+        sss_se05x_end_atomic(pPrefetch->session);
+        if ((status != SM_OK) || (fetchLen > space)) {
+            LOG_W("Random prefetch failed, retrying");
+            sss_se05x_prefetch_sleep(pPrefetch, 100);
+            continue;
+        }
+        pPrefetch->fetchUs += sm_get_time_us() - startUs;
+
+        offset = head & (pPrefetch->size - 1);
+        first  = pPrefetch->size - offset;
+        if (first > fetchLen) {
+            first = fetchLen;
+        }
+        memcpy(&pPrefetch->ring[offset], buf, first);
+        memcpy(&pPrefetch->ring[0], &buf[first], fetchLen - first);
+        __atomic_store_n(&pPrefetch->head, head + fetchLen, __ATOMIC_RELEASE);
+        pPrefetch->produced += fetchLen;
+    }
+    memset(buf, 0, sizeof(buf));
+    return NULL;
 }
 
-sss_status_t sss_se05x_digest_init(sss_se05x_digest_t *context)
+/* Take up to dataLen bytes from the ring. Returns the number of bytes taken */
+static size_t sss_se05x_prefetch_take(struct _sss_se05x_rng_prefetch *pPrefetch, uint8_t *random_data, size_t dataLen)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
-#if SSSFTR_SE05X_CREATE_DELETE_CRYPTOOBJ
-    SE05x_CryptoModeSubType_t subtype;
-    uint8_t list[1024] = {
-        0,
-    };
-    size_t listlen = sizeof(list);
-    size_t i;
-    uint8_t create_crypto_obj = 1;
+    size_t tail = __atomic_load_n(&pPrefetch->tail, __ATOMIC_ACQUIRE);
+    size_t head = 0;
+    size_t n    = 0;
 
-    switch (context->algorithm) {
-#if SSS_HAVE_HASH_1
-    case kAlgorithm_SSS_SHA1:
-        subtype.digest          = kSE05x_DigestMode_SHA;
-        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA;
-        break;
-#endif
-#if SSS_HAVE_HASH_224
-    case kAlgorithm_SSS_SHA224:
-        subtype.digest          = kSE05x_DigestMode_SHA224;
-        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA224;
-        break;
-#endif
-    case kAlgorithm_SSS_SHA256:
-        subtype.digest          = kSE05x_DigestMode_SHA256;
-        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA256;
-        break;
-    case kAlgorithm_SSS_SHA384:
-        subtype.digest          = kSE05x_DigestMode_SHA384;
-        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA384;
-        break;
-#if SSS_HAVE_HASH_512
-    case kAlgorithm_SSS_SHA512:
-        subtype.digest          = kSE05x_DigestMode_SHA512;
-        context->cryptoObjectId = kSE05x_CryptoObject_DIGEST_SHA512;
-        break;
-#endif
-    default:
-        return kStatus_SSS_Fail;
-    }
+    do {
+        size_t offset, first;
 
-    status = Se05x_API_ReadCryptoObjectList(&context->session->s_ctx, list, &listlen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        return kStatus_SSS_ApduThroughputError;
-    }
-    for (i = 0; i < listlen; i += 4) {
-        uint16_t cryptoObjectId = list[i + 1] | (list[i + 0] << 8);
-        if (cryptoObjectId == context->cryptoObjectId) {
-            create_crypto_obj = 0;
+        head = __atomic_load_n(&pPrefetch->head, __ATOMIC_ACQUIRE);
+        n    = head - tail;
+        if (n > dataLen) {
+            n = dataLen;
         }
-    }
-
-    if (create_crypto_obj) {
-        status = Se05x_API_CreateCryptoObject(
-            &context->session->s_ctx, context->cryptoObjectId, kSE05x_CryptoContext_DIGEST, subtype);
-        if (status == SM_ERR_APDU_THROUGHPUT) {
-            return kStatus_SSS_ApduThroughputError;
+        if (n == 0) {
+            break;
         }
-        if (status != SM_OK) {
-            return kStatus_SSS_Fail;
+        offset = tail & (pPrefetch->size - 1);
+        first  = pPrefetch->size - offset;
+        if (first > n) {
+            first = n;
         }
-    }
-#endif
+        memcpy(random_data, &pPrefetch->ring[offset], first);
+        memcpy(&random_data[first], &pPrefetch->ring[0], n - first);
+        /* On failure tail is reloaded, and the copy is repeated */
+    } while (!__atomic_compare_exchange_n(&pPrefetch->tail, &tail, tail + n, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
 
-    status = Se05x_API_DigestInit(&context->session->s_ctx, context->cryptoObjectId);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-        goto exit;
+    if (n > 0) {
+        __atomic_fetch_add(&pPrefetch->consumed, n, __ATOMIC_RELAXED);
+        if ((head - (tail + n)) < (pPrefetch->size / 2)) {
+            pthread_cond_signal(&pPrefetch->wake);
+        }
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
-
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
+    return n;
 }
 
-sss_status_t sss_se05x_digest_update(sss_se05x_digest_t *context, const uint8_t *message, size_t messageLen)
+sss_status_t sss_se05x_session_start_rng_prefetch(sss_se05x_session_t *session, size_t ringSize)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
+    sss_status_t retval                       = kStatus_SSS_Fail;
+    struct _sss_se05x_rng_prefetch *pPrefetch = NULL;
 
-    status = Se05x_API_DigestUpdate(&context->session->s_ctx, context->cryptoObjectId, message, messageLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
+    ENSURE_OR_GO_EXIT(session != NULL);
+    ENSURE_OR_GO_EXIT(session->pRngPrefetch == NULL);
+    if (ringSize == 0) {
+        ringSize = SSS_SE05X_RNG_RING_SIZE;
+    }
+    if ((ringSize & (ringSize - 1)) != 0) {
+        LOG_E("Random prefetch ring size must be a power of 2");
+        retval = kStatus_SSS_InvalidArgument;
         goto exit;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
 
-    retval = kStatus_SSS_Success;
+    pPrefetch = (struct _sss_se05x_rng_prefetch *)SSS_MALLOC(sizeof(*pPrefetch));
+    ENSURE_OR_GO_EXIT(pPrefetch != NULL);
+    memset(pPrefetch, 0, sizeof(*pPrefetch));
+    pPrefetch->ring = (uint8_t *)SSS_MALLOC(ringSize);
+    if (pPrefetch->ring == NULL) {
+        SSS_FREE(pPrefetch);
+        goto exit;
+    }
+    pPrefetch->size    = ringSize;
+    pPrefetch->session = session;
+
+    if (pthread_mutex_init(&pPrefetch->lock, NULL) != 0) {
+        LOG_E("mutex init has failed");
+        SSS_FREE(pPrefetch->ring);
+        SSS_FREE(pPrefetch);
+        goto exit;
+    }
+    pthread_cond_init(&pPrefetch->wake, NULL);
+    if (pthread_create(&pPrefetch->thread, NULL, &sss_se05x_prefetch_thread, pPrefetch) != 0) {
+        LOG_E("Random prefetch thread could not be created");
+        pthread_cond_destroy(&pPrefetch->wake);
+        pthread_mutex_destroy(&pPrefetch->lock);
+        SSS_FREE(pPrefetch->ring);
+        SSS_FREE(pPrefetch);
+        goto exit;
+    }
+    session->pRngPrefetch = pPrefetch;
+    retval                = kStatus_SSS_Success;
 exit:
     return retval;
 }
 
-sss_status_t sss_se05x_digest_finish(sss_se05x_digest_t *context, uint8_t *digest, size_t *digestLen)
+void sss_se05x_session_stop_rng_prefetch(sss_se05x_session_t *session)
 {
-    sss_status_t retval = kStatus_SSS_Fail;
-    smStatus_t status   = SM_NOT_OK;
+    struct _sss_se05x_rng_prefetch *pPrefetch = NULL;
 
-    status = Se05x_API_DigestFinal(&context->session->s_ctx, context->cryptoObjectId, NULL, 0, digest, digestLen);
-    if (status == SM_ERR_APDU_THROUGHPUT) {
-        retval = kStatus_SSS_ApduThroughputError;
-        goto exit;
+    if ((session == NULL) || (session->pRngPrefetch == NULL)) {
+        return;
     }
-    ENSURE_OR_GO_EXIT(status == SM_OK);
+    pPrefetch             = session->pRngPrefetch;
+    session->pRngPrefetch = NULL;
 
-    retval = kStatus_SSS_Success;
-exit:
-    return retval;
+    pthread_mutex_lock(&pPrefetch->lock);
+    pPrefetch->stop = 1;
+    pthread_cond_signal(&pPrefetch->wake);
+    pthread_mutex_unlock(&pPrefetch->lock);
+    pthread_join(pPrefetch->thread, NULL);
+
+    pthread_cond_destroy(&pPrefetch->wake);
+    pthread_mutex_destroy(&pPrefetch->lock);
+    memset(pPrefetch->ring, 0, pPrefetch->size);
+    SSS_FREE(pPrefetch->ring);
+    SSS_FREE(pPrefetch);
 }
 
-void sss_se05x_digest_context_free(sss_se05x_digest_t *context)
+sss_status_t sss_se05x_session_get_rng_prefetch_stats(
+    sss_se05x_session_t *session, sss_se05x_rng_prefetch_stats_t *pStats)
 {
-    if (context->cryptoObjectId != 0) {
-        smStatus_t status = Se05x_API_DeleteCryptoObject(&context->session->s_ctx, context->cryptoObjectId);
-        if (status != SM_OK) {
-            LOG_D("Could not delete crypto object 0x04X", context->cryptoObjectId);
-            return;
-        }
+    struct _sss_se05x_rng_prefetch *pPrefetch = NULL;
+    size_t head, tail;
+
+    ENSURE_OR_RETURN_ON_ERROR(session != NULL, kStatus_SSS_Fail);
+    ENSURE_OR_RETURN_ON_ERROR(pStats != NULL, kStatus_SSS_Fail);
+    pPrefetch = session->pRngPrefetch;
+    ENSURE_OR_RETURN_ON_ERROR(pPrefetch != NULL, kStatus_SSS_Fail);
+
+    tail = __atomic_load_n(&pPrefetch->tail, __ATOMIC_ACQUIRE);
+    head = __atomic_load_n(&pPrefetch->head, __ATOMIC_ACQUIRE);
+    memset(pStats, 0, sizeof(*pStats));
+    pStats->capacity  = pPrefetch->size;
+    pStats->fillLevel = head - tail;
+    pStats->produced  = pPrefetch->produced;
+    pStats->consumed  = __atomic_load_n(&pPrefetch->consumed, __ATOMIC_RELAXED);
+    pStats->misses    = __atomic_load_n(&pPrefetch->misses, __ATOMIC_RELAXED);
+    if (pPrefetch->fetchUs > 0) {
+        pStats->refillBytesPerSec = (uint32_t)((pPrefetch->produced * 1000000) / pPrefetch->fetchUs);
     }
-    memset(context, 0, sizeof(*context));
+    return kStatus_SSS_Success;
 }
 
-/* End: se05x_md */
+#else /* (__GNUC__ && !AX_EMBEDDED) */
+
+sss_status_t sss_se05x_session_start_rng_prefetch(sss_se05x_session_t *session, size_t ringSize)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(ringSize);
+    LOG_E("Random prefetch needs a POSIX host");
+    return kStatus_SSS_InvalidArgument;
+}
+
+void sss_se05x_session_stop_rng_prefetch(sss_se05x_session_t *session)
+{
+    AX_UNUSED_ARG(session);
+}
+
+sss_status_t sss_se05x_session_get_rng_prefetch_stats(
+    sss_se05x_session_t *session, sss_se05x_rng_prefetch_stats_t *pStats)
+{
+    AX_UNUSED_ARG(session);
+    AX_UNUSED_ARG(pStats);
+    return kStatus_SSS_Fail;
+}
+
+#endif /* (__GNUC__ && !AX_EMBEDDED) */
+
+/* End: se05x_rng_prefetch */
 
 /* ************************************************************************** */
 /* Functions : sss_se05x_rng                                                  */
@@ -7685,6 +9983,24 @@ sss_status_t sss_se05x_rng_get_random(sss_se05x_rng_context_t *context, uint8_t
     size_t chunk        = 0;
     size_t offset       = 0;
 
+#if SSS_HAVE_HOSTCRYPTO_MBEDTLS || SSS_HAVE_HOSTCRYPTO_OPENSSL
+    struct _sss_se05x_drbg *pDrbg = sss_se05x_drbg_get(context->session);
+    if (pDrbg != NULL) {
+        retval = sss_se05x_drbg_read(context->session, pDrbg, random_data, dataLen);
+        sss_se05x_drbg_put(pDrbg);
+        return retval;
+    }
+#endif
+#if (__GNUC__ && !AX_EMBEDDED)
+    if (context->session->pRngPrefetch != NULL) {
+        offset = sss_se05x_prefetch_take(context->session->pRngPrefetch, random_data, dataLen);
+        dataLen -= offset;
+        if (dataLen > 0) {
+            __atomic_fetch_add(&context->session->pRngPrefetch->misses, 1, __ATOMIC_RELAXED);
+        }
+    }
+#endif
+
     while (dataLen > 0) {
         /* TODO - Replace 512 with max rsp buffer size based on with/without SCP */
         if (dataLen > 512) {
@@ -7769,6 +10085,37 @@ void sss_se05x_tunnel_context_free(sss_se05x_tunnel_context_t *context)
     memset(context, 0, sizeof(*context));
 }
 
+/* Connection context the commands of a session finally go to. Tunneled
+ * sessions use the connection of the session carrying the tunnel.
+ *
+ * Lock order: the device is always taken first, see sss_se05x_TXn, then the
+ * secure channel (scp03_lock) and tunnel (channelLock) locks. Once a thread
+ * holds the device, reserving it again only nests. */
+static void *sss_se05x_device_conn_ctx(struct Se05xSession *pSession)
+{
+    while ((pSession->pChannelCtx != NULL) && (pSession->pChannelCtx->se05x_session != NULL) &&
+           (&pSession->pChannelCtx->se05x_session->s_ctx != pSession)) {
+        pSession = &pSession->pChannelCtx->se05x_session->s_ctx;
+    }
+    return pSession->conn_ctx;
+}
+
+/* Keep the device for the commands of one operation, e.g. all chunks of an
+ * update. Other threads are served between operations. */
+static sss_status_t sss_se05x_begin_atomic(sss_se05x_session_t *session)
+{
+    ENSURE_OR_RETURN_ON_ERROR(session != NULL, kStatus_SSS_Fail);
+    if (smCom_BeginAtomic(sss_se05x_device_conn_ctx(&session->s_ctx)) != SMCOM_OK) {
+        return kStatus_SSS_Fail;
+    }
+    return kStatus_SSS_Success;
+}
+
+static void sss_se05x_end_atomic(sss_se05x_session_t *session)
+{
+    smCom_EndAtomic(sss_se05x_device_conn_ctx(&session->s_ctx));
+}
+
 static smStatus_t sss_se05x_TXn(struct Se05xSession *pSession,
     const tlvHeader_t *hdr,
     uint8_t *cmdBuf,
@@ -7781,14 +10128,21 @@ static smStatus_t sss_se05x_TXn(struct Se05xSession *pSession,
     tlvHeader_t outHdr = {
         0,
     };
-    uint8_t txBuf[SE05X_MAX_BUF_SIZE_CMD] = {
-        0,
-    };
-    size_t txBufLen = sizeof(txBuf);
+    /* Not cleared, fp_Transform writes every byte that is sent.
+     * See fp_RawTXn for the head and tail room. */
+    uint8_t txBuf[SE05X_TXN_HEADROOM + SE05X_MAX_BUF_SIZE_CMD + SE05X_TXN_TAILROOM];
+    size_t txBufLen = SE05X_MAX_BUF_SIZE_CMD;
 
     const tlvHeader_t *sendHdr = NULL;
     uint8_t *sendBuf           = NULL;
     size_t sendBufLen          = 0;
+    void *deviceCtx            = sss_se05x_device_conn_ctx(pSession);
+
+    /* Device first, then the channel locks. Wrapping, sending and unwrapping
+     * are one step for the other threads. */
+    if (smCom_BeginAtomic(deviceCtx) != SMCOM_OK) {
+        return SM_NOT_OK;
+    }
 
     if (pSession->fp_Transform) {
 #ifdef SSS_USE_SCP03_THREAD_SAFETY
@@ -7801,19 +10155,29 @@ static smStatus_t sss_se05x_TXn(struct Se05xSession *pSession,
         }
 #endif // SSS_HAVE_SCP_SCP03_SSS && USE_LOCK
 #endif //#ifdef SSS_USE_SCP03_THREAD_SAFETY
-        ret        = pSession->fp_Transform(pSession, hdr, cmdBuf, cmdBufLen, &outHdr, txBuf, &txBufLen, hasle);
+        ret = pSession->fp_Transform(
+            pSession, hdr, cmdBuf, cmdBufLen, &outHdr, &txBuf[SE05X_TXN_HEADROOM], &txBufLen, hasle);
         sendHdr    = &outHdr;
-        sendBuf    = txBuf;
+        sendBuf    = &txBuf[SE05X_TXN_HEADROOM];
         sendBufLen = txBufLen;
     }
     else {
+        ENSURE_OR_GO_EXIT(cmdBufLen <= SE05X_MAX_BUF_SIZE_CMD);
+        if (cmdBufLen > 0) {
+            memcpy(&txBuf[SE05X_TXN_HEADROOM], cmdBuf, cmdBufLen);
+        }
         ret        = SM_OK;
         sendHdr    = hdr;
-        sendBuf    = cmdBuf;
+        sendBuf    = &txBuf[SE05X_TXN_HEADROOM];
         sendBufLen = cmdBufLen;
     }
     ENSURE_OR_GO_EXIT(ret == SM_OK);
 
+#if SSS_HAVE_SCP_SCP03_SSS && NX_SCP03_PIPELINED_ICV
+    if ((pSession->fp_Transform == &se05x_Transform_scp) && (pSession->pdynScp03Ctx != NULL)) {
+        smCom_SetIdleWork(&nxScp03_Precompute_ICV, pSession->pdynScp03Ctx);
+    }
+#endif
     if (pSession->fp_RawTXn) {
         ret = pSession->fp_RawTXn(pSession->conn_ctx,
             pSession->pChannelCtx,
@@ -7832,6 +10196,10 @@ static smStatus_t sss_se05x_TXn(struct Se05xSession *pSession,
     else {
         goto exit;
     }
+#if SSS_HAVE_SCP_SCP03_SSS && NX_SCP03_PIPELINED_ICV
+    /* Not run if the communication layer did not poll */
+    smCom_SetIdleWork(NULL, NULL);
+#endif
 
     if (pSession->fp_DeCrypt) {
         ret = pSession->fp_DeCrypt(pSession, cmdBufLen, rsp, rspLen, hasle);
@@ -7850,6 +10218,7 @@ exit:
     }
 #endif // SSS_HAVE_SCP_SCP03_SSS && USE_LOCK
 #endif //#ifdef SSS_USE_SCP03_THREAD_SAFETY
+    smCom_EndAtomic(deviceCtx);
     return ret;
 }
 
@@ -7861,20 +10230,28 @@ static smStatus_t sss_se05x_channel_txnRaw(void *conn_ctx,
     size_t *rspLen,
     uint8_t hasle)
 {
-    uint8_t txBuf[SE05X_MAX_BUF_SIZE_CMD] = {0};
-    size_t i                              = 0;
-    uint32_t U32rspLen                    = 0;
-    smStatus_t ret                        = SM_NOT_OK;
+    /* Header and Lc go into the head room in front of cmdBuf, Le into the
+     * tail room behind it. See fp_RawTXn. */
+    uint8_t *txBuf     = NULL;
+    size_t lcLen       = 1;
+    size_t i           = 0;
+    uint32_t U32rspLen = 0;
+    smStatus_t ret     = SM_NOT_OK;
 
-    memcpy(&txBuf[i], hdr, sizeof(*hdr));
+    ENSURE_OR_GO_EXIT(cmdBufLen <= SE05X_MAX_BUF_SIZE_CMD);
+    // The Lc field must be extended in case the length does not fit
+    // into a single byte (Note, while the standard would allow to
+    // encode 0x100 as 0x00 in the Lc field, nobody who is sane in his mind
+    // would actually do that).
+    if ((cmdBufLen > 0) && ((cmdBufLen >= 0xFF) || hasle)) {
+        lcLen = 3;
+    }
+    txBuf = cmdBuf - (sizeof(*hdr) + lcLen);
 
+    memcpy(&txBuf[i], hdr, sizeof(*hdr));
     i += sizeof(*hdr);
     if (cmdBufLen > 0) {
-        // The Lc field must be extended in case the length does not fit
-        // into a single byte (Note, while the standard would allow to
-        // encode 0x100 as 0x00 in the Lc field, nobody who is sane in his mind
-        // would actually do that).
-        if ((cmdBufLen < 0xFF) && !hasle) {
+        if (lcLen == 1) {
             txBuf[i++] = (uint8_t)cmdBufLen;
         }
         else {
@@ -7882,16 +10259,10 @@ static smStatus_t sss_se05x_channel_txnRaw(void *conn_ctx,
             txBuf[i++] = 0xFFu & (cmdBufLen >> 8);
             txBuf[i++] = 0xFFu & (cmdBufLen);
         }
-        memcpy(&txBuf[i], cmdBuf, cmdBufLen);
-        if ((SIZE_MAX - i) < cmdBufLen) {
-            goto exit;
-        }
         i += cmdBufLen;
     }
     else {
-        if (cmdBufLen == 0) {
-            txBuf[i++] = 0x00;
-        }
+        txBuf[i++] = 0x00;
     }
 
     if (hasle) {
@@ -8478,8 +10849,9 @@ static smStatus_t se05x_CreateECKeySession(
     if (status == SM_OK) {
         uint8_t sePubEcka[150] = {0};
         size_t sePubEckaLen    = sizeof(sePubEcka);
-        retval                 = nxECKey_ReadEckaPublicKey(se05xSession,
-            pFScpCtx->pStatic_ctx->HostEcKeypair.keyStore,
+        /* HostEcKeypair is freed after each authentication; HostEcdsaObj stays for the session lifetime */
+        retval = nxECKey_ReadEckaPublicKey(se05xSession,
+            pFScpCtx->pStatic_ctx->HostEcdsaObj.keyStore,
             sePubEcka,
             &sePubEckaLen,
             kSE05x_AppletResID_KP_ECKEY_USER);
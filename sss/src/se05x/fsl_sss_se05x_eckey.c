@@ -22,6 +22,11 @@
 #include <sm_const.h>
 #include <string.h>
 #include <limits.h>
+#if (__GNUC__ && !AX_EMBEDDED)
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#endif
 
 #if SSS_HAVE_HOSTCRYPTO_MBEDTLS
 #include "fsl_sss_mbedtls_types.h"
@@ -57,6 +62,14 @@ static sss_status_t nxECKey_Calculate_Shared_secret(
 
 static void set_secp256r1nist_header(uint8_t *pbKey, size_t *pbKeyByteLen);
 
+static sss_status_t nxECKey_Get_HostEphemeralKey(NXECKey03_StaticCtx_t *pStatic_ctx);
+
+static sss_status_t nxECKey_Generate_EphemeralKey(sss_key_store_t *pKs, sss_object_t *pKeyPair);
+
+#if (__GNUC__ && !AX_EMBEDDED)
+static sss_status_t nxECKey_Take_EphemeralKey(struct _nxECKey_ephemeral_pool *pPool, sss_object_t *pKeyPair);
+#endif
+
 int get_u8buf_2bTag(uint8_t *buf, size_t *pBufIndex, const size_t bufLen, uint16_t tag, uint8_t *rsp, size_t *pRspLen);
 
 /* ************************************************************************** */
@@ -90,6 +103,8 @@ sss_status_t nxECKey_AuthenticateChannel(
 
     /* Get the Host ephemeral key */
     uint8_t hostPubkey[100];
+    status = nxECKey_Get_HostEphemeralKey(pStatic_ctx);
+    ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
     status = sss_host_key_store_get_key(
         pStatic_ctx->HostEcKeypair.keyStore, &pStatic_ctx->HostEcKeypair, hostPubkey, &hostEckaPubLen, &hostEckabitLen);
     ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
@@ -149,6 +164,10 @@ sss_status_t nxECKey_AuthenticateChannel(
     ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
     pDyn_ctx->SecurityLevel = (uint8_t)SECURITY_LEVEL;
 exit:
+    /* Never reuse an ephemeral key pair, also not after a failed attempt */
+    if (pStatic_ctx->HostEcKeypair.keyStore != NULL) {
+        sss_key_object_free(&pStatic_ctx->HostEcKeypair);
+    }
     return status;
 }
 
@@ -187,6 +206,9 @@ static sss_status_t nxECKey_HostLocal_CalculateSessionKeys(SE05x_AuthCtx_ECKey_t
     NXECKey03_StaticCtx_t *pStatic_ctx        = pAuthFScp->pStatic_ctx;
     NXSCP03_DynCtx_t *pDyn_ctx                = pAuthFScp->pDyn_ctx;
 
+    /* Host contexts of a previous session must not outlive its keys */
+    nxScp03_Free_HostContexts(pDyn_ctx);
+
     /* Generation and Creation of Session ENC SSS Key Object */
 
     // Set the Derviation data
@@ -285,6 +307,50 @@ cleanup:
     return status;
 }
 
+static sss_status_t nxECKey_Generate_EphemeralKey(sss_key_store_t *pKs, sss_object_t *pKeyPair)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+
+    status = sss_host_key_object_init(pKeyPair, pKs);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    /* Transient: no key store bookkeeping, so it can run on the pool thread */
+    status = sss_host_key_object_allocate_handle(
+        pKeyPair, __LINE__, kSSS_KeyPart_Pair, kSSS_CipherType_EC_NIST_P, 256, kKeyObject_Mode_Transient);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+    status = sss_host_key_store_generate_key(pKs, pKeyPair, 256, NULL);
+    ENSURE_OR_GO_CLEANUP(status == kStatus_SSS_Success);
+cleanup:
+    if (status != kStatus_SSS_Success) {
+        sss_host_key_object_free(pKeyPair);
+    }
+    return status;
+}
+
+/* Host ephemeral key pair for this session open: the one prepared with the
+ * static keys, else one from the pool, else a new one. A key pair is freed
+ * once it has been used. */
+static sss_status_t nxECKey_Get_HostEphemeralKey(NXECKey03_StaticCtx_t *pStatic_ctx)
+{
+    sss_status_t status = kStatus_SSS_Success;
+
+    if (pStatic_ctx->HostEcKeypair.keyStore != NULL) {
+        goto exit;
+    }
+#if (__GNUC__ && !AX_EMBEDDED)
+    if (pStatic_ctx->pEphemeralPool != NULL) {
+        if (nxECKey_Take_EphemeralKey(pStatic_ctx->pEphemeralPool, &pStatic_ctx->HostEcKeypair) ==
+            kStatus_SSS_Success) {
+            goto exit;
+        }
+    }
+#endif
+    status = kStatus_SSS_Fail;
+    ENSURE_OR_GO_EXIT(pStatic_ctx->HostEcdsaObj.keyStore != NULL);
+    status = nxECKey_Generate_EphemeralKey(pStatic_ctx->HostEcdsaObj.keyStore, &pStatic_ctx->HostEcKeypair);
+exit:
+    return status;
+}
+
 static void set_secp256r1nist_header(uint8_t *pbKey, size_t *pbKeyByteLen)
 {
     unsigned int i = 0;
@@ -536,5 +602,233 @@ cleanup:
     return status;
 }
 
+/* ************************************************************************** */
+/* Functions : Ephemeral key pool                                             */
+/* ************************************************************************** */
+
+#if (__GNUC__ && !AX_EMBEDDED)
+
+/* Key pairs are generated outside the lock, only moving them in and out of
+ * key[] is done under it. key[0 .. count) are ready. */
+struct _nxECKey_ephemeral_pool
+{
+    sss_key_store_t *pKs;
+    sss_object_t key[NX_ECKEY_EPHEMERAL_POOL_MAX];
+    size_t depth;
+    size_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake; /* Signalled when a key pair is taken, and on stop */
+    pthread_t thread;
+    int hasThread;
+    volatile int stop;
+    /* Counters */
+    uint32_t generated;
+    uint32_t taken;
+    uint32_t misses;
+};
+
+/* Returns 1 if the key pair went into the pool, 0 if the pool is full or stopping */
+static int nxECKey_Put_EphemeralKey(struct _nxECKey_ephemeral_pool *pPool, sss_object_t *pKeyPair)
+{
+    int stored = 0;
+
+    pthread_mutex_lock(&pPool->lock);
+    if ((!pPool->stop) && (pPool->count < pPool->depth)) {
+        memcpy(&pPool->key[pPool->count], pKeyPair, sizeof(*pKeyPair));
+        pPool->count++;
+        pPool->generated++;
+        stored = 1;
+    }
+    pthread_mutex_unlock(&pPool->lock);
+    return stored;
+}
+
+static sss_status_t nxECKey_Take_EphemeralKey(struct _nxECKey_ephemeral_pool *pPool, sss_object_t *pKeyPair)
+{
+    sss_status_t status = kStatus_SSS_Fail;
+
+    pthread_mutex_lock(&pPool->lock);
+    if (pPool->count > 0) {
+        pPool->count--;
+        memcpy(pKeyPair, &pPool->key[pPool->count], sizeof(*pKeyPair));
+        memset(&pPool->key[pPool->count], 0, sizeof(pPool->key[0]));
+        pPool->taken++;
+        pthread_cond_signal(&pPool->wake);
+        status = kStatus_SSS_Success;
+    }
+    else {
+        pPool->misses++;
+    }
+    pthread_mutex_unlock(&pPool->lock);
+    return status;
+}
+
+#if SSS_HAVE_HOSTCRYPTO_OPENSSL
+static void *nxECKey_EphemeralPool_Thread(void *arg)
+{
+    struct _nxECKey_ephemeral_pool *pPool = (struct _nxECKey_ephemeral_pool *)arg;
+    sss_object_t keyPair;
+
+    for (;;) {
+        pthread_mutex_lock(&pPool->lock);
+        while ((!pPool->stop) && (pPool->count >= pPool->depth)) {
+            pthread_cond_wait(&pPool->wake, &pPool->lock);
+        }
+        pthread_mutex_unlock(&pPool->lock);
+        if (pPool->stop) {
+            break;
+        }
+
+        memset(&keyPair, 0, sizeof(keyPair));
+        if (nxECKey_Generate_EphemeralKey(pPool->pKs, &keyPair) != kStatus_SSS_Success) {
+            struct timespec deadline;
+            LOG_W("Ephemeral key generation failed, retrying");
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += 1;
+            pthread_mutex_lock(&pPool->lock);
+            if (!pPool->stop) {
+                (void)pthread_cond_timedwait(&pPool->wake, &pPool->lock, &deadline);
+            }
+            pthread_mutex_unlock(&pPool->lock);
+            continue;
+        }
+        if (!nxECKey_Put_EphemeralKey(pPool, &keyPair)) {
+            sss_host_key_object_free(&keyPair);
+        }
+    }
+    return NULL;
+}
+#endif
+
+sss_status_t nxECKey_StartEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx, size_t depth)
+{
+    sss_status_t status                   = kStatus_SSS_Fail;
+    struct _nxECKey_ephemeral_pool *pPool = NULL;
+
+    ENSURE_OR_GO_EXIT(pStatic_ctx != NULL);
+    ENSURE_OR_GO_EXIT(pStatic_ctx->HostEcdsaObj.keyStore != NULL);
+    if (pStatic_ctx->pEphemeralPool != NULL) {
+        status = kStatus_SSS_Success;
+        goto exit;
+    }
+    if (depth == 0) {
+        depth = NX_ECKEY_EPHEMERAL_POOL_DEPTH;
+    }
+    ENSURE_OR_GO_EXIT(depth <= NX_ECKEY_EPHEMERAL_POOL_MAX);
+
+    pPool = (struct _nxECKey_ephemeral_pool *)calloc(1, sizeof(*pPool));
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+    pPool->pKs   = pStatic_ctx->HostEcdsaObj.keyStore;
+    pPool->depth = depth;
+    if (pthread_mutex_init(&pPool->lock, NULL) != 0) {
+        LOG_E("Ephemeral key pool: mutex init has failed");
+        free(pPool);
+        goto exit;
+    }
+    pthread_cond_init(&pPool->wake, NULL);
+    pStatic_ctx->pEphemeralPool = pPool;
+
+#if SSS_HAVE_HOSTCRYPTO_OPENSSL
+    if (pthread_create(&pPool->thread, NULL, &nxECKey_EphemeralPool_Thread, pPool) == 0) {
+        pPool->hasThread = 1;
+        status           = kStatus_SSS_Success;
+        goto exit;
+    }
+    LOG_W("Ephemeral key pool: no refill thread");
+#endif
+    /* The host crypto session is not shared with another thread, fill it here */
+    status = nxECKey_RefillEphemeralPool(pStatic_ctx);
+    if (status != kStatus_SSS_Success) {
+        nxECKey_StopEphemeralPool(pStatic_ctx);
+    }
+exit:
+    return status;
+}
+
+sss_status_t nxECKey_RefillEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx)
+{
+    sss_status_t status                   = kStatus_SSS_Fail;
+    struct _nxECKey_ephemeral_pool *pPool = NULL;
+    sss_object_t keyPair;
+
+    ENSURE_OR_GO_EXIT(pStatic_ctx != NULL);
+    pPool = pStatic_ctx->pEphemeralPool;
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+
+    status = kStatus_SSS_Success;
+    for (;;) {
+        size_t count;
+        pthread_mutex_lock(&pPool->lock);
+        count = pPool->count;
+        pthread_mutex_unlock(&pPool->lock);
+        if (count >= pPool->depth) {
+            break;
+        }
+        memset(&keyPair, 0, sizeof(keyPair));
+        status = nxECKey_Generate_EphemeralKey(pPool->pKs, &keyPair);
+        ENSURE_OR_GO_EXIT(status == kStatus_SSS_Success);
+        if (!nxECKey_Put_EphemeralKey(pPool, &keyPair)) {
+            /* Filled by the refill thread meanwhile */
+            sss_host_key_object_free(&keyPair);
+            break;
+        }
+    }
+exit:
+    return status;
+}
+
+void nxECKey_StopEphemeralPool(NXECKey03_StaticCtx_t *pStatic_ctx)
+{
+    struct _nxECKey_ephemeral_pool *pPool = NULL;
+    size_t i;
+
+    if ((pStatic_ctx == NULL) || (pStatic_ctx->pEphemeralPool == NULL)) {
+        return;
+    }
+    pPool = pStatic_ctx->pEphemeralPool;
+
+    pthread_mutex_lock(&pPool->lock);
+    pPool->stop = 1;
+    pthread_cond_signal(&pPool->wake);
+    pthread_mutex_unlock(&pPool->lock);
+    if (pPool->hasThread) {
+        pthread_join(pPool->thread, NULL);
+    }
+
+    /* Unused key pairs are never handed out, free them */
+    for (i = 0; i < pPool->count; i++) {
+        sss_host_key_object_free(&pPool->key[i]);
+    }
+    pthread_cond_destroy(&pPool->wake);
+    pthread_mutex_destroy(&pPool->lock);
+    memset(pPool, 0, sizeof(*pPool));
+    free(pPool);
+    pStatic_ctx->pEphemeralPool = NULL;
+}
+
+sss_status_t nxECKey_GetEphemeralPoolStats(NXECKey03_StaticCtx_t *pStatic_ctx, NXECKey03_EphemeralPoolStats_t *pStats)
+{
+    sss_status_t status                   = kStatus_SSS_Fail;
+    struct _nxECKey_ephemeral_pool *pPool = NULL;
+
+    ENSURE_OR_GO_EXIT(pStatic_ctx != NULL);
+    ENSURE_OR_GO_EXIT(pStats != NULL);
+    pPool = pStatic_ctx->pEphemeralPool;
+    ENSURE_OR_GO_EXIT(pPool != NULL);
+
+    pthread_mutex_lock(&pPool->lock);
+    pStats->depth     = pPool->depth;
+    pStats->available = pPool->count;
+    pStats->generated = pPool->generated;
+    pStats->taken     = pPool->taken;
+    pStats->misses    = pPool->misses;
+    pthread_mutex_unlock(&pPool->lock);
+    status = kStatus_SSS_Success;
+exit:
+    return status;
+}
+
+#endif // (__GNUC__ && !AX_EMBEDDED)
+
 #endif /* defined SSS_HAVE_SCP_SCP03_SSS */
 #endif /* SSS_HAVE_APPLET_SE05X_IOT */
@@ -338,6 +338,9 @@ static sss_status_t nxScp03_HostLocal_CalculateSessionKeys(
     LOG_MAU8_D(" Input:hostChallenge", hostChallenge, SCP_GP_HOST_CHALLENGE_LEN);
     LOG_MAU8_D(" Input:cardChallenge", cardChallenge, SCP_GP_CARD_CHALLENGE_LEN);
 
+    /* Host contexts of a previous session must not outlive its keys */
+    nxScp03_Free_HostContexts(pDyn_ctx);
+
     /* Generation and Creation of Session ENC SSS Key Object */
 
     // Set the Derviation data